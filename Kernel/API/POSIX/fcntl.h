@@ -46,6 +46,11 @@ extern "C" {
 #define F_WRLCK ((short)1)
 #define F_UNLCK ((short)2)
 
+#define SPLICE_F_MOVE (1 << 0)
+#define SPLICE_F_NONBLOCK (1 << 1)
+#define SPLICE_F_MORE (1 << 2)
+#define SPLICE_F_GIFT (1 << 3)
+
 #define AT_FDCWD -100
 #define AT_SYMLINK_NOFOLLOW 0x100
 #define AT_REMOVEDIR 0x200
@@ -17,6 +17,7 @@
 #endif
 
 extern "C" {
+struct epoll_event;
 struct pollfd;
 struct timeval;
 struct timespec;
@@ -69,6 +70,9 @@ enum class NeedsBigProcessLock {
     S(disown, NeedsBigProcessLock::No)                     \
     S(dump_backtrace, NeedsBigProcessLock::No)             \
     S(dup2, NeedsBigProcessLock::No)                       \
+    S(epoll_create, NeedsBigProcessLock::No)               \
+    S(epoll_ctl, NeedsBigProcessLock::No)                  \
+    S(epoll_wait, NeedsBigProcessLock::No)                 \
     S(execve, NeedsBigProcessLock::Yes)                    \
     S(exit, NeedsBigProcessLock::Yes)                      \
     S(exit_thread, NeedsBigProcessLock::Yes)               \
@@ -155,6 +159,7 @@ enum class NeedsBigProcessLock {
     S(scheduler_get_parameters, NeedsBigProcessLock::No)   \
     S(scheduler_set_parameters, NeedsBigProcessLock::No)   \
     S(sendfd, NeedsBigProcessLock::No)                     \
+    S(sendfile, NeedsBigProcessLock::Yes)                  \
     S(sendmsg, NeedsBigProcessLock::Yes)                   \
     S(set_mmap_name, NeedsBigProcessLock::No)              \
     S(setegid, NeedsBigProcessLock::No)                    \
@@ -181,6 +186,7 @@ enum class NeedsBigProcessLock {
     S(sigtimedwait, NeedsBigProcessLock::No)               \
     S(socket, NeedsBigProcessLock::No)                     \
     S(socketpair, NeedsBigProcessLock::No)                 \
+    S(splice, NeedsBigProcessLock::Yes)                    \
     S(stat, NeedsBigProcessLock::No)                       \
     S(statvfs, NeedsBigProcessLock::No)                    \
     S(symlink, NeedsBigProcessLock::No)                    \
@@ -264,6 +270,37 @@ struct SC_poll_params {
     u32 const* sigmask;
 };
 
+struct SC_sendfile_params {
+    int out_fd;
+    int in_fd;
+    off_t* offset;
+    size_t count;
+};
+
+struct SC_splice_params {
+    int in_fd;
+    off_t* in_offset;
+    int out_fd;
+    off_t* out_offset;
+    size_t length;
+    unsigned flags;
+};
+
+struct SC_epoll_ctl_params {
+    int epoll_fd;
+    int op;
+    int fd;
+    struct epoll_event const* event;
+};
+
+struct SC_epoll_wait_params {
+    int epoll_fd;
+    struct epoll_event* events;
+    int max_events;
+    int timeout;
+    u32 const* sigmask;
+};
+
 struct SC_clock_nanosleep_params {
     int clock_id;
     int flags;
@@ -55,6 +55,8 @@ namespace Kernel::VirtIO {
 #define COMMON_CFG_QUEUE_DRIVER 0x28
 #define COMMON_CFG_QUEUE_DEVICE 0x30
 
+#define VIRTIO_MSI_NO_VECTOR 0xffff
+
 #define QUEUE_INTERRUPT 0x1
 #define DEVICE_CONFIG_INTERRUPT 0x2
 
@@ -87,7 +87,7 @@ ErrorOr<void> Device::setup_queue(u16 queue_index)
     return {};
 }
 
-ErrorOr<void> Device::setup_queues(u16 requested_queue_count)
+ErrorOr<void> Device::setup_queues(u16 requested_queue_count, QueueInterrupts queue_interrupts)
 {
     VERIFY(!m_did_setup_queues.was_set());
     m_did_setup_queues.set();
@@ -108,6 +108,9 @@ ErrorOr<void> Device::setup_queues(u16 requested_queue_count)
         dbgln("{}: device's available queue count could not be determined!", m_class_name);
     }
 
+    if (queue_interrupts == QueueInterrupts::PerQueue)
+        m_has_per_queue_interrupts = TRY(m_transport_entity->setup_queue_interrupts({}, *this, m_queue_count));
+
     dbgln_if(VIRTIO_DEBUG, "{}: Setting up {} queues", m_class_name, m_queue_count);
     for (u16 i = 0; i < m_queue_count; i++)
         TRY(setup_queue(i));
@@ -144,17 +147,29 @@ bool Device::handle_irq(Badge<TransportInterruptHandler>)
     }
     if (isr_type & QUEUE_INTERRUPT) {
         dbgln_if(VIRTIO_DEBUG, "{}: VirtIO Queue interrupt!", class_name());
-        for (size_t i = 0; i < m_queues.size(); i++) {
-            if (get_queue(i).new_data_available()) {
-                handle_queue_update(i);
-                return true;
-            }
-        }
-        dbgln_if(VIRTIO_DEBUG, "{}: Got queue interrupt but all queues are up to date!", class_name());
+        // All queues share this interrupt, so any number of them may have been updated.
+        for (u16 i = 0; i < m_queues.size(); i++)
+            handle_queue_update_if_needed(i);
     }
     return true;
 }
 
+bool Device::handle_queue_irq(Badge<TransportInterruptHandler>, u16 queue_index)
+{
+    dbgln_if(VIRTIO_DEBUG, "{}: VirtIO Queue[{}] interrupt!", class_name(), queue_index);
+    // The interrupt may arrive before we got around to setting up every queue.
+    if (queue_index >= m_queues.size())
+        return true;
+    handle_queue_update_if_needed(queue_index);
+    return true;
+}
+
+void Device::handle_queue_update_if_needed(u16 queue_index)
+{
+    if (get_queue(queue_index).new_data_available())
+        handle_queue_update(queue_index);
+}
+
 void Device::supply_chain_and_notify(u16 queue_index, QueueChain& chain)
 {
     auto& queue = get_queue(queue_index);
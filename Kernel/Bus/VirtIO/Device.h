@@ -26,6 +26,7 @@ public:
     virtual ErrorOr<void> initialize_virtio_resources();
 
     bool handle_irq(Badge<TransportInterruptHandler>);
+    bool handle_queue_irq(Badge<TransportInterruptHandler>, u16 queue_index);
 
 protected:
     virtual StringView class_name() const { return "VirtIO::Device"sv; }
@@ -34,8 +35,13 @@ protected:
 
     void mask_status_bits(u8 status_mask);
     void set_status_bit(u8);
-    ErrorOr<void> setup_queues(u16 requested_queue_count = 0);
+    enum class QueueInterrupts {
+        Shared,
+        PerQueue,
+    };
+    ErrorOr<void> setup_queues(u16 requested_queue_count = 0, QueueInterrupts = QueueInterrupts::Shared);
     void finish_init();
+    bool has_per_queue_interrupts() const { return m_has_per_queue_interrupts; }
 
     Queue& get_queue(u16 queue_index)
     {
@@ -82,12 +88,14 @@ private:
     ErrorOr<void> setup_queue(u16 queue_index);
     ErrorOr<void> activate_queue(u16 queue_index);
     void notify_queue(u16 queue_index);
+    void handle_queue_update_if_needed(u16 queue_index);
 
     Vector<NonnullOwnPtr<Queue>> m_queues;
 
     StringView const m_class_name;
 
     u16 m_queue_count { 0 };
+    bool m_has_per_queue_interrupts { false };
     u8 m_status { 0 };
     u64 m_accepted_features { 0 };
     SetOnce m_did_accept_features;
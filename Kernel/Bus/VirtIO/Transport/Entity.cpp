@@ -96,6 +96,15 @@ ErrorOr<NonnullOwnPtr<Queue>> TransportEntity::setup_queue(Badge<VirtIO::Device>
     config_write64(*m_common_cfg, COMMON_CFG_QUEUE_DESC, queue->descriptor_area().get());
     config_write64(*m_common_cfg, COMMON_CFG_QUEUE_DRIVER, queue->driver_area().get());
     config_write64(*m_common_cfg, COMMON_CFG_QUEUE_DEVICE, queue->device_area().get());
+
+    if (m_use_queue_interrupt_vectors.was_set()) {
+        // Vector 0 is reserved for configuration changes.
+        config_write16(*m_common_cfg, COMMON_CFG_QUEUE_MSIX_VECTOR, queue_index + 1);
+        if (config_read16(*m_common_cfg, COMMON_CFG_QUEUE_MSIX_VECTOR) == VIRTIO_MSI_NO_VECTOR) {
+            dbgln("Queue[{}]: Device failed to assign an interrupt vector", queue_index);
+            return Error::from_errno(EIO);
+        }
+    }
     return queue;
 }
 
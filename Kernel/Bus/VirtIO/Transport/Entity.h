@@ -22,6 +22,10 @@ public:
     virtual void disable_interrupts(Badge<VirtIO::Device>) = 0;
     virtual void enable_interrupts(Badge<VirtIO::Device>) = 0;
 
+    // Tries to give each queue an interrupt of its own, returns false if all of them have to share one.
+    // Must be called before the queues are set up.
+    virtual ErrorOr<bool> setup_queue_interrupts(Badge<VirtIO::Device>, VirtIO::Device&, u16 queue_count) = 0;
+
     virtual StringView determine_device_class_name() const = 0;
 
     void accept_device_features(Badge<VirtIO::Device>, u64 accepted_features);
@@ -92,6 +96,7 @@ protected:
     IOWindow& base_io_window();
     Array<OwnPtr<IOWindow>, 6> m_register_bases;
     SetOnce m_use_mmio;
+    SetOnce m_use_queue_interrupt_vectors;
 
     u32 m_notify_multiplier { 0 };
 };
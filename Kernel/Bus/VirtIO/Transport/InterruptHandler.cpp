@@ -9,13 +9,16 @@
 
 namespace Kernel::VirtIO {
 
-TransportInterruptHandler::TransportInterruptHandler(VirtIO::Device& parent_device)
+TransportInterruptHandler::TransportInterruptHandler(VirtIO::Device& parent_device, Optional<u16> queue_index)
     : m_parent_device(parent_device)
+    , m_queue_index(queue_index)
 {
 }
 
 bool TransportInterruptHandler::notify_parent_device_on_interrupt()
 {
+    if (m_queue_index.has_value())
+        return m_parent_device.handle_queue_irq({}, m_queue_index.value());
     return m_parent_device.handle_irq({});
 }
 
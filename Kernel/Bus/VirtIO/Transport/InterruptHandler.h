@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Optional.h>
 #include <AK/Types.h>
 
 namespace Kernel::VirtIO {
@@ -13,12 +14,14 @@ namespace Kernel::VirtIO {
 class Device;
 class TransportInterruptHandler {
 protected:
-    TransportInterruptHandler(VirtIO::Device&);
+    TransportInterruptHandler(VirtIO::Device&, Optional<u16> queue_index = {});
 
     bool notify_parent_device_on_interrupt();
 
 private:
     VirtIO::Device& m_parent_device;
+    // Set if this interrupt is dedicated to a single queue, rather than shared by the whole device.
+    Optional<u16> m_queue_index;
 };
 
 }
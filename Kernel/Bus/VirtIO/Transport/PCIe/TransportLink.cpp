@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NumericLimits.h>
 #include <Kernel/Bus/PCI/API.h>
 #include <Kernel/Bus/PCI/IDs.h>
 #include <Kernel/Bus/VirtIO/Transport/PCIe/InterruptHandler.h>
@@ -154,12 +155,52 @@ void PCIeTransportLink::disable_interrupts(Badge<VirtIO::Device>)
 {
     disable_pin_based_interrupts();
     m_irq_handler->disable_irq();
+    for (auto& handler : m_queue_irq_handlers)
+        handler->disable_irq();
 }
 
 void PCIeTransportLink::enable_interrupts(Badge<VirtIO::Device>)
 {
+    for (auto& handler : m_queue_irq_handlers)
+        handler->enable_irq();
     m_irq_handler->enable_irq();
-    enable_pin_based_interrupts();
+    if (get_interrupt_type() == PCI::InterruptType::PIN)
+        enable_pin_based_interrupts();
+}
+
+ErrorOr<bool> PCIeTransportLink::setup_queue_interrupts(Badge<VirtIO::Device>, VirtIO::Device& parent_device, u16 queue_count)
+{
+    VERIFY(m_queue_irq_handlers.is_empty());
+
+    // MSI-X vector 0 is used for configuration changes, followed by one vector per queue.
+    if (!m_common_cfg || !is_msix_capable() || queue_count >= NumericLimits<u8>::max())
+        return false;
+    auto interrupt_type_or_error = reserve_irqs(queue_count + 1, true);
+    if (interrupt_type_or_error.is_error() || interrupt_type_or_error.value() != PCI::InterruptType::MSIX)
+        return false;
+
+    // The pin-based interrupt handler we started out with won't fire anymore, so replace it.
+    m_irq_handler->disable_irq();
+    m_irq_handler->unregister_interrupt_handler();
+    m_irq_handler = TRY(PCIeTransportInterruptHandler::create(*this, parent_device, TRY(allocate_irq(0))));
+    config_write16(*m_common_cfg, COMMON_CFG_MSIX_CONFIG, 0);
+    if (config_read16(*m_common_cfg, COMMON_CFG_MSIX_CONFIG) == VIRTIO_MSI_NO_VECTOR) {
+        dbgln("{}: Device failed to assign the configuration interrupt vector", device_name());
+        return Error::from_errno(EIO);
+    }
+    m_irq_handler->enable_irq();
+
+    TRY(m_queue_irq_handlers.try_ensure_capacity(queue_count));
+    for (u16 queue_index = 0; queue_index < queue_count; ++queue_index) {
+        auto irq = TRY(allocate_irq(queue_index + 1));
+        auto handler = TRY(PCIeTransportInterruptHandler::create(*this, parent_device, irq, queue_index));
+        handler->enable_irq();
+        m_queue_irq_handlers.unchecked_append(move(handler));
+    }
+
+    m_use_queue_interrupt_vectors.set();
+    dbgln_if(VIRTIO_DEBUG, "{}: Using {} MSI-X interrupt vectors", device_name(), queue_count + 1);
+    return true;
 }
 
 }
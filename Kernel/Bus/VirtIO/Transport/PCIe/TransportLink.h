@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Types.h>
+#include <AK/Vector.h>
 #include <Kernel/Bus/PCI/Device.h>
 #include <Kernel/Bus/VirtIO/Transport/Entity.h>
 #include <Kernel/Interrupts/PCIIRQHandler.h>
@@ -29,12 +30,12 @@ private:
     virtual ErrorOr<void> locate_configurations_and_resources(Badge<VirtIO::Device>, VirtIO::Device&) override;
     virtual void disable_interrupts(Badge<VirtIO::Device>) override;
     virtual void enable_interrupts(Badge<VirtIO::Device>) override;
+    virtual ErrorOr<bool> setup_queue_interrupts(Badge<VirtIO::Device>, VirtIO::Device&, u16 queue_count) override;
 
     ErrorOr<void> create_interrupt_handler(VirtIO::Device&);
 
-    // FIXME: There could be multiple IRQ (MSI-X) handlers for a VirtIO device.
-    // Find a way to use all of them.
     OwnPtr<PCI::IRQHandler> m_irq_handler;
+    Vector<NonnullOwnPtr<PCI::IRQHandler>> m_queue_irq_handlers;
 };
 
 };
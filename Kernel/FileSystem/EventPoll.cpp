@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/EventPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Thread.h>
+
+namespace Kernel {
+
+static u32 ready_events_for(OpenFileDescription const& description, u32 requested_events)
+{
+    using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+    BlockFlags block_flags = BlockFlags::None;
+    if (requested_events & EPOLLIN)
+        block_flags |= BlockFlags::Read;
+    if (requested_events & EPOLLOUT)
+        block_flags |= BlockFlags::Write;
+    if (block_flags == BlockFlags::None)
+        return 0;
+
+    // FIXME: Report EPOLLERR and EPOLLHUP once OpenFileDescription::should_unblock() knows about exceptional conditions.
+    auto unblocked_flags = description.should_unblock(block_flags);
+    u32 ready_events = 0;
+    if (has_flag(unblocked_flags, BlockFlags::Read))
+        ready_events |= EPOLLIN;
+    if (has_flag(unblocked_flags, BlockFlags::Write))
+        ready_events |= EPOLLOUT;
+    return ready_events;
+}
+
+EventPoll::Watch::Watch(EventPoll& event_poll, OpenFileDescription& description, epoll_event const& event)
+    : events(event.events)
+    , data(event.data.u64)
+    , m_event_poll(&event_poll)
+    , m_description(&description)
+{
+}
+
+bool EventPoll::Watch::block_conditions_may_have_changed()
+{
+    RefPtr<EventPoll> event_poll;
+    {
+        SpinlockLocker locker(m_lock);
+        // If the EventPoll is already being destroyed, it is about to detach us anyway.
+        if (!m_event_poll || !m_event_poll->try_ref())
+            return false;
+        event_poll = adopt_ref(*m_event_poll);
+    }
+    event_poll->queue_watch(*this);
+    return true;
+}
+
+bool EventPoll::Watch::is_interested() const
+{
+    SpinlockLocker locker(m_lock);
+    return m_event_poll != nullptr;
+}
+
+OpenFileDescription const* EventPoll::Watch::description() const
+{
+    SpinlockLocker locker(m_lock);
+    return m_description;
+}
+
+void EventPoll::Watch::description_will_be_destroyed()
+{
+    SpinlockLocker locker(m_lock);
+    m_description = nullptr;
+}
+
+RefPtr<OpenFileDescription> EventPoll::Watch::strong_description()
+{
+    SpinlockLocker locker(m_lock);
+    if (!m_description || !m_description->try_ref())
+        return nullptr;
+    return adopt_ref(*m_description);
+}
+
+void EventPoll::Watch::detach_from_event_poll()
+{
+    SpinlockLocker locker(m_lock);
+    m_event_poll = nullptr;
+}
+
+ErrorOr<NonnullRefPtr<EventPoll>> EventPoll::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) EventPoll);
+}
+
+EventPoll::~EventPoll()
+{
+    // Watches only hand out references to us while we're alive, so nobody else can get here any more.
+    for (auto& it : m_interests)
+        it.value->detach_from_event_poll();
+    m_interests.clear();
+    m_ready_watches.clear();
+}
+
+bool EventPoll::can_read(OpenFileDescription const&, u64) const
+{
+    SpinlockLocker locker(m_lock);
+    return !m_ready_watches.is_empty();
+}
+
+ErrorOr<NonnullOwnPtr<KString>> EventPoll::pseudo_path(OpenFileDescription const&) const
+{
+    return KString::formatted("EventPoll:({})", m_interests.size());
+}
+
+void EventPoll::queue_watch(Watch& watch)
+{
+    {
+        SpinlockLocker locker(m_lock);
+        if (!watch.enabled || watch.ready_list_node.is_in_list())
+            return;
+        m_ready_watches.append(watch);
+    }
+    evaluate_block_conditions();
+}
+
+void EventPoll::forget_watch(Watch& watch)
+{
+    watch.detach_from_event_poll();
+    SpinlockLocker locker(m_lock);
+    watch.enabled = false;
+    watch.ready_list_node.remove();
+}
+
+RefPtr<EventPoll::Watch> EventPoll::find_watch(int fd, OpenFileDescription const& description)
+{
+    VERIFY(m_interests_lock.is_locked());
+    auto watch = m_interests.get(fd);
+    if (!watch.has_value())
+        return nullptr;
+    // The file descriptor may have been closed and reused since it was added, in which case the entry is stale.
+    if ((*watch)->description() != &description)
+        return nullptr;
+    return *watch;
+}
+
+ErrorOr<void> EventPoll::add(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    if (description.is_event_poll())
+        return EINVAL;
+
+    auto watch = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) Watch(*this, description, event)));
+    {
+        MutexLocker locker(m_interests_lock);
+        if (find_watch(fd, description))
+            return EEXIST;
+        if (auto stale_watch = m_interests.get(fd); stale_watch.has_value())
+            forget_watch(**stale_watch);
+        TRY(m_interests.try_set(fd, watch));
+        description.blocker_set().add_event_poll_watch(*watch);
+    }
+
+    // Let the next wait find out whether the description is ready already.
+    queue_watch(*watch);
+    return {};
+}
+
+ErrorOr<void> EventPoll::modify(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    MutexLocker locker(m_interests_lock);
+    auto watch = find_watch(fd, description);
+    if (!watch)
+        return ENOENT;
+    {
+        SpinlockLocker spinlock_locker(m_lock);
+        watch->events = event.events;
+        watch->data = event.data.u64;
+        watch->enabled = true;
+    }
+
+    queue_watch(*watch);
+    return {};
+}
+
+ErrorOr<void> EventPoll::remove(int fd, OpenFileDescription& description)
+{
+    MutexLocker locker(m_interests_lock);
+    auto watch = find_watch(fd, description);
+    if (!watch)
+        return ENOENT;
+    m_interests.remove(fd);
+    forget_watch(*watch);
+    return {};
+}
+
+size_t EventPoll::collect_ready_events(Span<epoll_event> events)
+{
+    // Level-triggered watches go back onto the ready list once we're done, so that the next wait checks them again.
+    Vector<NonnullRefPtr<Watch>, 16> watches_to_requeue;
+    size_t count = 0;
+    while (count < events.size()) {
+        RefPtr<Watch> watch;
+        u32 requested_events = 0;
+        u64 data = 0;
+        {
+            SpinlockLocker locker(m_lock);
+            if (m_ready_watches.is_empty())
+                break;
+            watch = m_ready_watches.take_first();
+            requested_events = watch->events;
+            data = watch->data;
+        }
+
+        auto description = watch->strong_description();
+        if (!description)
+            continue;
+        auto ready_events = ready_events_for(*description, requested_events);
+        if (ready_events == 0)
+            continue;
+        events[count++] = { .events = ready_events, .data = { .u64 = data } };
+
+        bool should_requeue = false;
+        {
+            SpinlockLocker locker(m_lock);
+            if (requested_events & EPOLLONESHOT)
+                watch->enabled = false;
+            else
+                should_requeue = !(requested_events & EPOLLET);
+        }
+        if (should_requeue && watches_to_requeue.try_append(*watch).is_error())
+            queue_watch(*watch);
+    }
+
+    if (!watches_to_requeue.is_empty()) {
+        {
+            SpinlockLocker locker(m_lock);
+            for (auto& watch : watches_to_requeue) {
+                if (watch->enabled && !watch->ready_list_node.is_in_list())
+                    m_ready_watches.append(*watch);
+            }
+        }
+        // Other threads waiting on us should get a chance to look at them as well.
+        evaluate_block_conditions();
+    }
+    return count;
+}
+
+}
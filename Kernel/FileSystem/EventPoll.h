@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullRefPtr.h>
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Locking/Spinlock.h>
+
+namespace Kernel {
+
+// An EventPoll keeps a persistent set of file descriptions that userspace is interested in, along with
+// a list of those that may be ready. Files report changes to their block conditions through their blocker
+// set, so waiting takes time proportional to the number of ready descriptions instead of watched ones.
+class EventPoll final : public File {
+public:
+    static ErrorOr<NonnullRefPtr<EventPoll>> try_create();
+    virtual ~EventPoll() override;
+
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    // Can't write to an event poll.
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "EventPoll"sv; }
+    virtual bool is_event_poll() const override { return true; }
+
+    ErrorOr<void> add(int fd, OpenFileDescription&, epoll_event const&);
+    ErrorOr<void> modify(int fd, OpenFileDescription&, epoll_event const&);
+    ErrorOr<void> remove(int fd, OpenFileDescription&);
+
+    // Fills in events for descriptions that are ready and returns how many there were.
+    size_t collect_ready_events(Span<epoll_event>);
+
+    class Watch final : public EventPollWatch {
+    public:
+        Watch(EventPoll&, OpenFileDescription&, epoll_event const&);
+
+        virtual bool block_conditions_may_have_changed() override;
+        virtual bool is_interested() const override;
+        virtual OpenFileDescription const* description() const override;
+        virtual void description_will_be_destroyed() override;
+
+        RefPtr<OpenFileDescription> strong_description();
+        void detach_from_event_poll();
+
+        // These are protected by the lock of the EventPoll.
+        u32 events { 0 };
+        u64 data { 0 };
+        bool enabled { true };
+        IntrusiveListNode<Watch, NonnullRefPtr<Watch>> ready_list_node;
+
+    private:
+        mutable Spinlock<LockRank::None> m_lock {};
+        EventPoll* m_event_poll { nullptr };
+        OpenFileDescription* m_description { nullptr };
+    };
+
+private:
+    EventPoll() = default;
+
+    void queue_watch(Watch&);
+    void forget_watch(Watch&);
+    RefPtr<Watch> find_watch(int fd, OpenFileDescription const&);
+
+    // Watches are keyed by file descriptor; an entry for a description that has since been closed is stale.
+    HashMap<int, NonnullRefPtr<Watch>> m_interests;
+    Mutex m_interests_lock { "EventPoll"sv };
+
+    mutable Spinlock<LockRank::None> m_lock {};
+    IntrusiveList<&Watch::ready_list_node> m_ready_watches;
+};
+
+}
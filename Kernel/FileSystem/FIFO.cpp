@@ -104,6 +104,14 @@ bool FIFO::can_write(OpenFileDescription const&, u64) const
     return m_buffer->space_for_writing() || !m_readers;
 }
 
+Optional<size_t> FIFO::space_for_writing(OpenFileDescription const&) const
+{
+    // Without readers, writes fail instead.
+    if (!m_readers)
+        return {};
+    return m_buffer->space_for_writing();
+}
+
 ErrorOr<size_t> FIFO::read(OpenFileDescription& fd, u64, UserOrKernelBuffer& buffer, size_t size)
 {
     if (m_buffer->is_empty()) {
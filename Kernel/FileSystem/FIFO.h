@@ -40,6 +40,7 @@ private:
     virtual void detach(OpenFileDescription&) override;
     virtual bool can_read(OpenFileDescription const&, u64) const override;
     virtual bool can_write(OpenFileDescription const&, u64) const override;
+    virtual Optional<size_t> space_for_writing(OpenFileDescription const&) const override;
     virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
     virtual StringView class_name() const override { return "FIFO"sv; }
     virtual bool is_fifo() const override { return true; }
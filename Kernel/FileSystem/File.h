@@ -8,6 +8,8 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/Error.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullRefPtr.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <Kernel/Forward.h>
@@ -21,6 +23,26 @@ namespace Kernel {
 
 class File;
 
+// An EventPollWatch is how an EventPoll learns that the block conditions of a file it is interested in
+// may have changed. Watches are kept alive by the blocker set they are linked into and stay there until
+// they are no longer interested in the file, or until their file description is destroyed.
+class EventPollWatch : public AtomicRefCounted<EventPollWatch> {
+    friend class FileBlockerSet;
+
+public:
+    virtual ~EventPollWatch() = default;
+
+    // Returns false once the watch isn't interested in the file any more, so that it can be dropped.
+    virtual bool block_conditions_may_have_changed() = 0;
+    virtual bool is_interested() const = 0;
+
+    virtual OpenFileDescription const* description() const = 0;
+    virtual void description_will_be_destroyed() = 0;
+
+private:
+    IntrusiveListNode<EventPollWatch, NonnullRefPtr<EventPollWatch>> m_blocker_set_list_node;
+};
+
 class FileBlockerSet final : public Thread::BlockerSet {
 public:
     FileBlockerSet() { }
@@ -40,7 +62,52 @@ public:
             auto& blocker = static_cast<Thread::FileBlocker&>(b);
             return blocker.unblock_if_conditions_are_met(false, data);
         });
+        lock.unlock();
+
+        notify_event_poll_watches();
+    }
+
+    void add_event_poll_watch(EventPollWatch& watch)
+    {
+        SpinlockLocker lock(m_event_poll_watches_lock);
+        // Watches that were abandoned while their file was quiet are dropped here, so that repeatedly
+        // adding and removing a file to an EventPoll doesn't pile them up.
+        for (auto it = m_event_poll_watches.begin(); it != m_event_poll_watches.end();) {
+            auto& other = *it;
+            ++it;
+            if (!other.is_interested())
+                m_event_poll_watches.remove(other);
+        }
+        m_event_poll_watches.append(watch);
+    }
+
+    void description_will_be_destroyed(OpenFileDescription const& description)
+    {
+        SpinlockLocker lock(m_event_poll_watches_lock);
+        for (auto it = m_event_poll_watches.begin(); it != m_event_poll_watches.end();) {
+            auto& watch = *it;
+            ++it;
+            if (watch.description() != &description)
+                continue;
+            watch.description_will_be_destroyed();
+            m_event_poll_watches.remove(watch);
+        }
+    }
+
+private:
+    void notify_event_poll_watches()
+    {
+        SpinlockLocker lock(m_event_poll_watches_lock);
+        for (auto it = m_event_poll_watches.begin(); it != m_event_poll_watches.end();) {
+            auto& watch = *it;
+            ++it;
+            if (!watch.block_conditions_may_have_changed())
+                m_event_poll_watches.remove(watch);
+        }
     }
+
+    Spinlock<LockRank::None> m_event_poll_watches_lock {};
+    IntrusiveList<&EventPollWatch::m_blocker_set_list_node> m_event_poll_watches;
 };
 
 // File is the base class for anything that can be referenced by a OpenFileDescription.
@@ -84,6 +151,9 @@ public:
     virtual bool can_read(OpenFileDescription const&, u64) const = 0;
     virtual bool can_write(OpenFileDescription const&, u64) const = 0;
 
+    // How many bytes write() can take right now without blocking, if the File knows.
+    virtual Optional<size_t> space_for_writing(OpenFileDescription const&) const { return {}; }
+
     virtual ErrorOr<void> attach(OpenFileDescription&);
     virtual void detach(OpenFileDescription&);
     virtual void did_seek(OpenFileDescription&, off_t) { }
@@ -119,6 +189,7 @@ public:
     virtual bool is_character_device() const { return false; }
     virtual bool is_socket() const { return false; }
     virtual bool is_inode_watcher() const { return false; }
+    virtual bool is_event_poll() const { return false; }
     virtual bool is_mount_file() const { return false; }
     virtual bool is_loop_device() const { return false; }
 
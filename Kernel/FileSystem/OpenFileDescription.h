@@ -80,6 +80,9 @@ public:
     InodeWatcher const* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_event_poll() const;
+    EventPoll* event_poll();
+
     bool is_mount_file() const;
     MountFile const* mount_file() const;
     MountFile* mount_file();
@@ -27,6 +27,7 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     get_kmalloc_stats(stats);
 
     auto system_memory = MM.get_system_memory_info();
+    auto page_cache = MM.get_physical_page_cache_statistics();
 
     auto json = TRY(JsonObjectSerializer<>::try_create(builder));
     TRY(json.add("kmalloc_allocated"sv, stats.bytes_allocated));
@@ -37,6 +38,12 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+    TRY(json.add("physical_cached"sv, page_cache.cached_pages));
+    TRY(json.add("physical_cache_hits"sv, page_cache.cache_hits));
+    TRY(json.add("physical_cache_misses"sv, page_cache.cache_misses));
+    TRY(json.add("physical_zeroed"sv, page_cache.zeroed_pages));
+    TRY(json.add("physical_zeroed_hits"sv, page_cache.zeroed_page_hits));
+    TRY(json.add("physical_zeroed_misses"sv, page_cache.zeroed_page_misses));
     TRY(json.finish());
     return {};
 }
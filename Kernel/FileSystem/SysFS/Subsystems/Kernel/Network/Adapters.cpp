@@ -51,6 +51,15 @@ ErrorOr<void> SysFSNetworkAdaptersStats::try_generate(KBufferBuilder& builder)
         TRY(obj.add("link_full_duplex"sv, adapter.link_full_duplex()));
         TRY(obj.add("mtu"sv, adapter.mtu()));
         TRY(obj.add("packets_dropped"sv, adapter.packets_dropped()));
+        auto receive_queues = TRY(obj.add_array("receive_queues"sv));
+        for (size_t i = 0; i < adapter.receive_queue_count(); ++i) {
+            auto statistics = adapter.receive_queue_statistics(i);
+            auto receive_queue = TRY(receive_queues.add_object());
+            TRY(receive_queue.add("packets"sv, statistics.packets));
+            TRY(receive_queue.add("bytes"sv, statistics.bytes));
+            TRY(receive_queue.finish());
+        }
+        TRY(receive_queues.finish());
         TRY(obj.finish());
         return {};
     }));
@@ -90,6 +90,7 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
         size_t amount_dirty_private = 0;
         size_t amount_clean_inode = 0;
         size_t amount_shared = 0;
+        size_t amount_large_pages = 0;
         size_t amount_purgeable_volatile = 0;
         size_t amount_purgeable_nonvolatile = 0;
 
@@ -99,6 +100,7 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
             amount_dirty_private = space->amount_dirty_private();
             amount_clean_inode = TRY(space->amount_clean_inode());
             amount_shared = space->amount_shared();
+            amount_large_pages = space->amount_large_pages();
             amount_purgeable_volatile = space->amount_purgeable_volatile();
             amount_purgeable_nonvolatile = space->amount_purgeable_nonvolatile();
             return {};
@@ -109,6 +111,7 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
         TRY(process_object.add("amount_dirty_private"sv, amount_dirty_private));
         TRY(process_object.add("amount_clean_inode"sv, amount_clean_inode));
         TRY(process_object.add("amount_shared"sv, amount_shared));
+        TRY(process_object.add("amount_large_pages"sv, amount_large_pages));
         TRY(process_object.add("amount_purgeable_volatile"sv, amount_purgeable_volatile));
         TRY(process_object.add("amount_purgeable_nonvolatile"sv, amount_purgeable_nonvolatile));
         TRY(process_object.add("dumpable"sv, process.is_dumpable()));
@@ -148,6 +148,7 @@ ErrorOr<Region*> AddressSpace::try_allocate_split_region(Region const& source_re
     new_region->set_syscall_region(source_region.is_syscall_region());
     new_region->set_mmap(source_region.is_mmap(), source_region.mmapped_from_readable(), source_region.mmapped_from_writable());
     new_region->set_stack(source_region.is_stack());
+    new_region->set_wants_large_pages(source_region.wants_large_pages());
     TRY(m_region_tree.place_specifically(*new_region, range));
     return new_region.leak_ptr();
 }
@@ -389,6 +390,15 @@ size_t AddressSpace::amount_shared() const
     return amount;
 }
 
+size_t AddressSpace::amount_large_pages() const
+{
+    size_t amount = 0;
+    for (auto const& region : m_region_tree.regions()) {
+        amount += region.amount_mapped_with_large_pages();
+    }
+    return amount;
+}
+
 size_t AddressSpace::amount_purgeable_volatile() const
 {
     size_t amount = 0;
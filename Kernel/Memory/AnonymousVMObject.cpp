@@ -267,6 +267,33 @@ NonnullRefPtr<PhysicalRAMPage> AnonymousVMObject::allocate_committed_page(Badge<
     return m_unused_committed_pages->take_one();
 }
 
+bool AnonymousVMObject::try_install_large_page(Badge<Region>, size_t first_page_index, Span<NonnullRefPtr<PhysicalRAMPage>> physical_pages)
+{
+    SpinlockLocker locker(m_lock);
+    VERIFY(first_page_index + physical_pages.size() <= page_count());
+
+    // Someone else may have faulted in one of these pages in the meantime.
+    size_t lazy_committed_page_count = 0;
+    for (size_t i = 0; i < physical_pages.size(); ++i) {
+        auto const& page = m_physical_pages[first_page_index + i];
+        if (!page || !(page->is_shared_zero_page() || page->is_lazy_committed_page()))
+            return false;
+        if (page->is_lazy_committed_page())
+            ++lazy_committed_page_count;
+    }
+
+    for (size_t i = 0; i < physical_pages.size(); ++i) {
+        m_physical_pages[first_page_index + i] = physical_pages[i];
+        if (!m_cow_map.is_null())
+            m_cow_map.set(first_page_index + i, false);
+    }
+
+    // The new pages didn't come out of our commitment, so give back what the lazy pages were holding on to.
+    if (lazy_committed_page_count > 0)
+        m_unused_committed_pages->uncommit(lazy_committed_page_count);
+    return true;
+}
+
 void AnonymousVMObject::reset_cow_map()
 {
     for (size_t i = 0; i < page_count(); ++i) {
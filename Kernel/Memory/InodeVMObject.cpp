@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/Library/UserOrKernelBuffer.h>
 #include <Kernel/Memory/InodeVMObject.h>
+#include <Kernel/Memory/MemoryManager.h>
 
 namespace Kernel::Memory {
 
@@ -60,6 +63,64 @@ void InodeVMObject::set_page_dirty(size_t page_index, bool is_dirty)
     m_dirty_pages.set(page_index, is_dirty);
 }
 
+ErrorOr<void> InodeVMObject::read_in_pages(size_t first_page_index, size_t page_count, bool will_be_executed)
+{
+    VERIFY(first_page_index + page_count <= this->page_count());
+
+    // Only read the range between the first and the last missing page with a single read.
+    // Pages in between that are already present are read as well, but are left alone.
+    {
+        SpinlockLocker locker(m_lock);
+        while (page_count > 0 && m_physical_pages[first_page_index]) {
+            ++first_page_index;
+            --page_count;
+        }
+        while (page_count > 0 && m_physical_pages[first_page_index + page_count - 1])
+            --page_count;
+    }
+    if (page_count == 0)
+        return {};
+
+    Vector<NonnullRefPtr<PhysicalRAMPage>> new_physical_pages;
+    TRY(new_physical_pages.try_ensure_capacity(page_count));
+    for (size_t i = 0; i < page_count; ++i)
+        new_physical_pages.unchecked_append(TRY(MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No)));
+
+    size_t pages_read = 0;
+    {
+        // Read straight into the new pages instead of going through a bounce buffer.
+        auto region = TRY(MM.allocate_kernel_region_with_physical_pages(new_physical_pages, "InodeVMObject Read-In"sv, Region::Access::ReadWrite));
+        auto buffer = UserOrKernelBuffer::for_kernel_buffer(region->vaddr().as_ptr());
+        auto nread = TRY(m_inode->read_bytes(first_page_index * PAGE_SIZE, page_count * PAGE_SIZE, buffer, nullptr));
+        // NOTE: Pages past the end of the inode are left empty, so that touching them results in a bus error.
+        pages_read = ceil_div(nread, static_cast<size_t>(PAGE_SIZE));
+
+        // If we read less than a page, zero out the rest to avoid leaking uninitialized data.
+        if (nread % PAGE_SIZE != 0)
+            memset(region->vaddr().offset(nread).as_ptr(), 0, PAGE_SIZE - (nread % PAGE_SIZE));
+
+        if (will_be_executed) {
+            // Some architectures require an explicit synchronization operation after writing to memory that will be executed.
+            // This is required even if no instructions were previously fetched from that (physical) memory location,
+            // because some systems have an I-cache that is not coherent with the D-cache,
+            // resulting in the I-cache being filled with old values if the contents of the D-cache aren't written back yet.
+            Processor::flush_instruction_cache(region->vaddr(), pages_read * PAGE_SIZE);
+        }
+    }
+
+    SpinlockLocker locker(m_lock);
+    for (size_t i = 0; i < pages_read; ++i) {
+        auto& physical_page_slot = m_physical_pages[first_page_index + i];
+        // Someone else can assign a new page while we were reading, so only fill in the slots that are still empty.
+        if (!physical_page_slot.is_null())
+            continue;
+        physical_page_slot = new_physical_pages[i];
+        // Something went wrong if a newly loaded page is already marked dirty
+        VERIFY(!m_dirty_pages.get(first_page_index + i));
+    }
+    return {};
+}
+
 int InodeVMObject::release_all_clean_pages()
 {
     return try_release_clean_pages(page_count());
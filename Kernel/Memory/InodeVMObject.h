@@ -25,6 +25,8 @@ public:
     bool is_page_dirty(size_t page_index) const;
     void set_page_dirty(size_t page_index, bool is_dirty);
 
+    ErrorOr<void> read_in_pages(size_t first_page_index, size_t page_count, bool will_be_executed);
+
     int release_all_clean_pages();
     int try_release_clean_pages(int page_amount);
 
@@ -29,6 +29,7 @@
 #include <Kernel/Prekernel/Prekernel.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Security/AddressSanitizer.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
 #include <Kernel/Tasks/Process.h>
 #include <Userland/Libraries/LibDeviceTree/FlattenedDeviceTree.h>
 
@@ -971,6 +972,9 @@ PageTableEntry* MemoryManager::pte(PageDirectory& page_directory, VirtualAddress
     PageDirectoryEntry const& pde = pd[page_directory_index];
     if (!pde.is_present())
         return nullptr;
+#if ARCH(X86_64)
+    VERIFY(!pde.is_huge());
+#endif
 
     return &quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()))[page_table_index];
 }
@@ -985,6 +989,15 @@ PageTableEntry* MemoryManager::ensure_pte(PageDirectory& page_directory, Virtual
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     auto& pde = pd[page_directory_index];
+#if ARCH(X86_64)
+    if (pde.is_present() && pde.is_huge()) {
+        // Someone wants to change a single page of a large page, so it has to be broken up into small pages first.
+        if (!split_large_page(page_directory, vaddr))
+            return nullptr;
+        pd = quickmap_pd(page_directory, page_directory_table_index);
+        VERIFY(&pde == &pd[page_directory_index]);
+    }
+#endif
     if (pde.is_present())
         return &quickmap_pt(PhysicalAddress(pde.page_table_base()))[page_table_index];
 
@@ -1026,6 +1039,10 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     PageDirectoryEntry& pde = pd[page_directory_index];
+#if ARCH(X86_64)
+    // Large pages are always released as a whole by release_large_page().
+    VERIFY(!pde.is_present() || !pde.is_huge());
+#endif
     if (pde.is_present()) {
         auto* page_table = quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()));
         auto& pte = page_table[page_table_index];
@@ -1049,6 +1066,132 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
     }
 }
 
+bool MemoryManager::map_large_page(PageDirectory& page_directory, VirtualAddress vaddr, PhysicalAddress paddr, bool writable, bool executable, bool user_allowed)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+    VERIFY(vaddr.get() % LARGE_PAGE_SIZE == 0);
+    VERIFY(paddr.get() % LARGE_PAGE_SIZE == 0);
+#if ARCH(X86_64)
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    auto& pde = pd[page_directory_index];
+    Optional<PhysicalAddress> replaced_page_table;
+    if (pde.is_present() && !pde.is_huge())
+        replaced_page_table = PhysicalAddress { pde.page_table_base() };
+
+    pde.clear();
+    pde.set_page_table_base(paddr.get());
+    pde.set_huge(true);
+    pde.set_present(true);
+    pde.set_writable(writable);
+    pde.set_user_allowed(user_allowed);
+    if (Processor::current().has_nx())
+        pde.set_execute_disabled(!executable);
+
+    if (replaced_page_table.has_value()) {
+        // The page table only covered the range we just mapped, so we no longer need it.
+        // Make sure no CPU is still walking it before giving it back.
+        flush_tlb(&page_directory, vaddr, PAGES_PER_LARGE_PAGE);
+        // NOTE: This matches the leaked ref in MemoryManager::ensure_pte()
+        get_physical_page_entry(replaced_page_table.value()).allocated.physical_page.unref();
+    }
+    return true;
+#else
+    (void)page_directory;
+    (void)writable;
+    (void)executable;
+    (void)user_allowed;
+    return false;
+#endif
+}
+
+bool MemoryManager::is_mapped_with_large_page(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+#if ARCH(X86_64)
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto const& pde = quickmap_pd(page_directory, page_directory_table_index)[page_directory_index];
+    return pde.is_present() && pde.is_huge();
+#else
+    (void)page_directory;
+    (void)vaddr;
+    return false;
+#endif
+}
+
+void MemoryManager::release_large_page(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+#if ARCH(X86_64)
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto& pde = quickmap_pd(page_directory, page_directory_table_index)[page_directory_index];
+    VERIFY(pde.is_present() && pde.is_huge());
+    pde.clear();
+#else
+    (void)page_directory;
+    (void)vaddr;
+    VERIFY_NOT_REACHED();
+#endif
+}
+
+bool MemoryManager::split_large_page(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+#if ARCH(X86_64)
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto page_table_or_error = allocate_physical_page(ShouldZeroFill::No);
+    if (page_table_or_error.is_error()) {
+        dbgln("MM: Unable to allocate page table to split large page at {}", vaddr);
+        return false;
+    }
+    auto page_table = page_table_or_error.release_value();
+
+    // NOTE: Allocating may have quickmapped something else, so only look at the page directory now.
+    auto& pde = quickmap_pd(page_directory, page_directory_table_index)[page_directory_index];
+    VERIFY(pde.is_present() && pde.is_huge());
+
+    // Map the same physical memory with the same permissions, just with small pages.
+    auto* ptes = quickmap_pt(page_table->paddr());
+    for (size_t i = 0; i < PAGES_PER_LARGE_PAGE; ++i) {
+        auto& pte = ptes[i];
+        pte.clear();
+        pte.set_physical_page_base(pde.page_table_base() + i * PAGE_SIZE);
+        pte.set_present(true);
+        pte.set_writable(pde.is_writable());
+        pte.set_user_allowed(pde.is_user_allowed());
+        pte.set_execute_disabled(pde.is_execute_disabled());
+        pte.set_global(pde.is_global());
+    }
+
+    pde.clear();
+    pde.set_page_table_base(page_table->paddr().get());
+    pde.set_user_allowed(true);
+    pde.set_present(true);
+    pde.set_writable(true);
+    pde.set_global(&page_directory == m_kernel_page_directory.ptr());
+
+    // NOTE: This leaked ref is matched by the unref in MemoryManager::release_pte()
+    (void)page_table.leak_ref();
+    return true;
+#else
+    (void)page_directory;
+    (void)vaddr;
+    VERIFY_NOT_REACHED();
+#endif
+}
+
 UNMAP_AFTER_INIT void MemoryManager::initialize(u32 cpu)
 {
     dmesgln("Initialize MMU");
@@ -1277,16 +1420,26 @@ ErrorOr<NonnullOwnPtr<Region>> MemoryManager::allocate_kernel_region_with_vmobje
 ErrorOr<CommittedPhysicalPageSet> MemoryManager::commit_physical_pages(size_t page_count)
 {
     VERIFY(page_count > 0);
-    auto result = m_global_data.with([&](auto& global_data) -> ErrorOr<CommittedPhysicalPageSet> {
-        if (global_data.system_memory_info.physical_pages_uncommitted < page_count) {
-            dbgln("MM: Unable to commit {} pages, have only {}", page_count, global_data.system_memory_info.physical_pages_uncommitted);
-            return ENOMEM;
-        }
+    auto try_commit = [&](bool log_failure) {
+        return m_global_data.with([&](auto& global_data) -> ErrorOr<CommittedPhysicalPageSet> {
+            flush_cached_commitments(global_data);
+            if (global_data.system_memory_info.physical_pages_uncommitted < page_count) {
+                if (log_failure)
+                    dbgln("MM: Unable to commit {} pages, have only {}", page_count, global_data.system_memory_info.physical_pages_uncommitted);
+                return ENOMEM;
+            }
 
-        global_data.system_memory_info.physical_pages_uncommitted -= page_count;
-        global_data.system_memory_info.physical_pages_committed += page_count;
-        return CommittedPhysicalPageSet { {}, page_count };
-    });
+            global_data.system_memory_info.physical_pages_uncommitted -= page_count;
+            global_data.system_memory_info.physical_pages_committed += page_count;
+            return CommittedPhysicalPageSet { {}, page_count };
+        });
+    };
+    auto result = try_commit(false);
+    if (result.is_error()) {
+        // The page caches might be holding on to just the pages we need.
+        release_cached_physical_pages();
+        result = try_commit(true);
+    }
     if (result.is_error()) {
         Process::for_each_ignoring_process_lists([&](Process const& process) {
             size_t amount_resident = 0;
@@ -1325,23 +1478,233 @@ void MemoryManager::uncommit_physical_pages(Badge<CommittedPhysicalPageSet>, siz
 
 void MemoryManager::deallocate_physical_page(PhysicalAddress paddr)
 {
-    return m_global_data.with([&](auto& global_data) {
-        // Are we returning a user page?
+    Array<PhysicalAddress, PhysicalPageCache::batch_size> pages_to_return;
+    bool cache_was_full = false;
+    get_data().m_physical_page_cache.with([&](auto& cache) {
+        if (cache.page_count == cache.capacity) {
+            // Hand the pages at the bottom of the stack back, as they are the ones that were freed the longest time ago.
+            cache_was_full = true;
+            auto pages = cache.pages.span();
+            pages.slice(0, cache.batch_size).copy_to(pages_to_return);
+            pages.slice(cache.batch_size).copy_to(pages);
+            cache.page_count -= cache.batch_size;
+        }
+        cache.pages[cache.page_count++] = paddr;
+    });
+    m_cached_physical_page_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+    if (cache_was_full)
+        return_cached_physical_pages(pages_to_return);
+}
+
+size_t MemoryManager::take_free_physical_pages_for_cache(Span<PhysicalAddress> pages, size_t pages_to_keep_uncommitted)
+{
+    return m_global_data.with([&](auto& global_data) -> size_t {
+        auto& info = global_data.system_memory_info;
+        if (info.physical_pages_uncommitted <= pages_to_keep_uncommitted)
+            return 0;
+
+        auto page_count = min<size_t>(pages.size(), info.physical_pages_uncommitted - pages_to_keep_uncommitted);
+        size_t taken_page_count = 0;
         for (auto& region : global_data.physical_regions) {
-            if (!region->contains(paddr))
-                continue;
+            while (taken_page_count < page_count) {
+                auto paddr = region->take_free_page();
+                if (!paddr.has_value())
+                    break;
+                pages[taken_page_count++] = *paddr;
+            }
+        }
+
+        info.physical_pages_uncommitted -= taken_page_count;
+        info.physical_pages_used += taken_page_count;
+        m_cached_physical_page_count.fetch_add(taken_page_count, AK::MemoryOrder::memory_order_relaxed);
+        return taken_page_count;
+    });
+}
+
+void MemoryManager::return_cached_physical_pages(ReadonlySpan<PhysicalAddress> pages)
+{
+    if (pages.is_empty())
+        return;
+
+    m_global_data.with([&](auto& global_data) {
+        for (auto paddr : pages) {
+            auto region = global_data.physical_regions.find_if([&](auto& region) { return region->contains(paddr); });
+            if (region == global_data.physical_regions.end())
+                PANIC("MM: deallocate_physical_page couldn't figure out region for page @ {}", paddr);
+            (*region)->return_page(paddr);
+        }
+
+        // Always return pages to the uncommitted pool. Pages that were
+        // committed and allocated are only freed upon request. Once
+        // returned there is no guarantee being able to get them back.
+        global_data.system_memory_info.physical_pages_used -= pages.size();
+        global_data.system_memory_info.physical_pages_uncommitted += pages.size();
+        m_cached_physical_page_count.fetch_sub(pages.size(), AK::MemoryOrder::memory_order_relaxed);
+    });
+}
+
+void MemoryManager::flush_cached_commitments(GlobalData& global_data)
+{
+    auto page_count = m_committed_pages_taken_from_cache.exchange(0, AK::MemoryOrder::memory_order_relaxed);
+    VERIFY(global_data.system_memory_info.physical_pages_committed >= page_count);
+    global_data.system_memory_info.physical_pages_committed -= page_count;
+    global_data.system_memory_info.physical_pages_uncommitted += page_count;
+}
+
+template<typename Callback>
+static void for_each_physical_page_cache(Callback callback)
+{
+    for (u32 cpu = 0; cpu < Processor::count(); ++cpu) {
+        auto* data = Processor::by_id(cpu).get_specific<MemoryManagerData>();
+        if (data)
+            callback(data->m_physical_page_cache);
+    }
+}
+
+void MemoryManager::release_cached_physical_pages()
+{
+    // NOTE: We never take the global lock while holding the lock of a cache, so we move the pages out first.
+    Array<PhysicalAddress, PhysicalPageCache::capacity> pages;
+    for_each_physical_page_cache([&](auto& locked_cache) {
+        auto page_count = locked_cache.with([&](auto& cache) {
+            cache.pages.span().trim(cache.page_count).copy_to(pages);
+            return exchange(cache.page_count, 0);
+        });
+        return_cached_physical_pages(pages.span().trim(page_count));
+    });
+
+    for (;;) {
+        auto page_count = m_zeroed_physical_page_pool.with([&](auto& pool) {
+            auto page_count = min(pool.page_count, pages.size());
+            pool.page_count -= page_count;
+            pool.pages.span().slice(pool.page_count, page_count).copy_to(pages);
+            return page_count;
+        });
+        if (page_count == 0)
+            break;
+        return_cached_physical_pages(pages.span().trim(page_count));
+    }
+
+    m_global_data.with([&](auto& global_data) {
+        flush_cached_commitments(global_data);
+    });
+}
+
+void MemoryManager::zero_physical_page(PhysicalAddress paddr)
+{
+    InterruptDisabler disabler;
+    // FIXME: To prevent aliasing memory with different memory types, this page should be mapped using the same memory type it will use later for the actual mapping.
+    //        (See the comment above the memset in allocate_contiguous_physical_pages.)
+    auto* ptr = quickmap_page(paddr);
+    memset(ptr, 0, PAGE_SIZE);
+    unquickmap_page();
+}
+
+RefPtr<PhysicalRAMPage> MemoryManager::take_cached_physical_page(bool committed, ShouldZeroFill should_zero_fill)
+{
+    Optional<PhysicalAddress> paddr;
+    bool is_zeroed = false;
+
+    if (should_zero_fill == ShouldZeroFill::Yes) {
+        bool should_notify_page_zeroing_task = false;
+        m_zeroed_physical_page_pool.with([&](auto& pool) {
+            if (pool.page_count == 0) {
+                ++pool.misses;
+                should_notify_page_zeroing_task = true;
+                return;
+            }
+            ++pool.hits;
+            paddr = pool.pages[--pool.page_count];
+            should_notify_page_zeroing_task = pool.page_count == pool.low_watermark;
+        });
+        is_zeroed = paddr.has_value();
+        if (should_notify_page_zeroing_task)
+            PageZeroingTask::notify();
+    }
+
+    if (!paddr.has_value()) {
+        paddr = get_data().m_physical_page_cache.with([&](auto& cache) -> Optional<PhysicalAddress> {
+            if (cache.page_count == 0) {
+                ++cache.misses;
+                return {};
+            }
+            ++cache.hits;
+            return cache.pages[--cache.page_count];
+        });
+    }
+
+    if (!paddr.has_value()) {
+        Array<PhysicalAddress, PhysicalPageCache::batch_size> pages;
+        auto page_count = take_free_physical_pages_for_cache(pages);
+        if (page_count == 0)
+            return nullptr;
+        paddr = pages[--page_count];
+
+        // We may have been moved to another processor in the meantime, which is fine,
+        // and some other thread might have filled up the cache, which is unlikely.
+        auto stored_page_count = get_data().m_physical_page_cache.with([&](auto& cache) {
+            auto stored_page_count = min(page_count, cache.capacity - cache.page_count);
+            pages.span().trim(stored_page_count).copy_to(cache.pages.span().slice(cache.page_count));
+            cache.page_count += stored_page_count;
+            return stored_page_count;
+        });
+        return_cached_physical_pages(pages.span().slice(stored_page_count, page_count - stored_page_count));
+    }
 
-            region->return_page(paddr);
-            --global_data.system_memory_info.physical_pages_used;
+    m_cached_physical_page_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    if (committed)
+        m_committed_pages_taken_from_cache.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
 
-            // Always return pages to the uncommitted pool. Pages that were
-            // committed and allocated are only freed upon request. Once
-            // returned there is no guarantee being able to get them back.
-            ++global_data.system_memory_info.physical_pages_uncommitted;
+    auto page = PhysicalRAMPage::create(*paddr);
+    if (should_zero_fill == ShouldZeroFill::Yes && !is_zeroed)
+        zero_physical_page(*paddr);
+    return page;
+}
+
+void MemoryManager::refill_zeroed_physical_page_pool()
+{
+    while (!Process::current().is_dying()) {
+        auto is_full = m_zeroed_physical_page_pool.with([](auto& pool) { return pool.page_count == pool.capacity; });
+        if (is_full)
+            return;
+
+        // Don't take pages for the pool when memory is getting tight, they are better off serving actual allocations.
+        PhysicalAddress paddr;
+        if (take_free_physical_pages_for_cache({ &paddr, 1 }, ZeroedPhysicalPagePool::capacity) == 0)
+            return;
+
+        zero_physical_page(paddr);
+
+        auto did_store_page = m_zeroed_physical_page_pool.with([&](auto& pool) {
+            if (pool.page_count == pool.capacity)
+                return false;
+            pool.pages[pool.page_count++] = paddr;
+            return true;
+        });
+        if (!did_store_page) {
+            return_cached_physical_pages({ &paddr, 1 });
             return;
         }
-        PANIC("MM: deallocate_physical_page couldn't figure out region for page @ {}", paddr);
+    }
+}
+
+MemoryManager::PhysicalPageCacheStatistics MemoryManager::get_physical_page_cache_statistics()
+{
+    PhysicalPageCacheStatistics statistics;
+    for_each_physical_page_cache([&](auto& locked_cache) {
+        locked_cache.with([&](auto& cache) {
+            statistics.cached_pages += cache.page_count;
+            statistics.cache_hits += cache.hits;
+            statistics.cache_misses += cache.misses;
+        });
+    });
+    m_zeroed_physical_page_pool.with([&](auto& pool) {
+        statistics.zeroed_pages = pool.page_count;
+        statistics.zeroed_page_hits = pool.hits;
+        statistics.zeroed_page_misses = pool.misses;
     });
+    return statistics;
 }
 
 RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed)
@@ -1359,8 +1722,8 @@ RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed)
             global_data.system_memory_info.physical_pages_uncommitted--;
         }
         for (auto& region : global_data.physical_regions) {
-            page = region->take_free_page();
-            if (!page.is_null()) {
+            if (auto paddr = region->take_free_page(); paddr.has_value()) {
+                page = PhysicalRAMPage::create(*paddr);
                 ++global_data.system_memory_info.physical_pages_used;
                 break;
             }
@@ -1375,21 +1738,27 @@ RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed)
 
 NonnullRefPtr<PhysicalRAMPage> MemoryManager::allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill should_zero_fill)
 {
+    if (auto page = take_cached_physical_page(true, should_zero_fill))
+        return page.release_nonnull();
+
     auto page = find_free_physical_page(true);
     VERIFY(page);
-    if (should_zero_fill == ShouldZeroFill::Yes) {
-        InterruptDisabler disabler;
-        // FIXME: To prevent aliasing memory with different memory types, this page should be mapped using the same memory type it will use later for the actual mapping.
-        //        (See the comment above the memset in allocate_contiguous_physical_pages.)
-        auto* ptr = quickmap_page(*page);
-        memset(ptr, 0, PAGE_SIZE);
-        unquickmap_page();
-    }
+    if (should_zero_fill == ShouldZeroFill::Yes)
+        zero_physical_page(page->paddr());
     return page.release_nonnull();
 }
 
 ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge)
 {
+    if (auto page = take_cached_physical_page(false, should_zero_fill)) {
+        if (did_purge)
+            *did_purge = false;
+        return page.release_nonnull();
+    }
+
+    // We couldn't refill the page cache, so give back whatever the other caches are holding on to before trying harder.
+    release_cached_physical_pages();
+
     return m_global_data.with([&](auto&) -> ErrorOr<NonnullRefPtr<PhysicalRAMPage>> {
         auto page = find_free_physical_page(false);
         bool purged_pages = false;
@@ -1433,13 +1802,8 @@ ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(Sh
             return ENOMEM;
         }
 
-        if (should_zero_fill == ShouldZeroFill::Yes) {
-            // FIXME: To prevent aliasing memory with different memory types, this page should be mapped using the same memory type it will use later for the actual mapping.
-            //        (See the comment above the memset in allocate_contiguous_physical_pages.)
-            auto* ptr = quickmap_page(*page);
-            memset(ptr, 0, PAGE_SIZE);
-            unquickmap_page();
-        }
+        if (should_zero_fill == ShouldZeroFill::Yes)
+            zero_physical_page(page->paddr());
 
         if (did_purge)
             *did_purge = purged_pages;
@@ -1452,22 +1816,34 @@ ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> MemoryManager::allocate_contiguo
     VERIFY(!(size % PAGE_SIZE));
     size_t page_count = ceil_div(size, static_cast<size_t>(PAGE_SIZE));
 
-    auto physical_pages = TRY(m_global_data.with([&](auto& global_data) -> ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> {
-        // We need to make sure we don't touch pages that we have committed to
-        if (global_data.system_memory_info.physical_pages_uncommitted < page_count)
-            return ENOMEM;
-
-        for (auto& physical_region : global_data.physical_regions) {
-            auto physical_pages = physical_region->take_contiguous_free_pages(page_count);
-            if (!physical_pages.is_empty()) {
-                global_data.system_memory_info.physical_pages_uncommitted -= page_count;
-                global_data.system_memory_info.physical_pages_used += page_count;
-                return physical_pages;
+    auto try_take_contiguous_pages = [&](bool log_failure) {
+        return m_global_data.with([&](auto& global_data) -> ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> {
+            // We need to make sure we don't touch pages that we have committed to
+            if (global_data.system_memory_info.physical_pages_uncommitted < page_count)
+                return ENOMEM;
+
+            for (auto& physical_region : global_data.physical_regions) {
+                auto physical_pages = physical_region->take_contiguous_free_pages(page_count);
+                if (!physical_pages.is_empty()) {
+                    global_data.system_memory_info.physical_pages_uncommitted -= page_count;
+                    global_data.system_memory_info.physical_pages_used += page_count;
+                    return physical_pages;
+                }
             }
-        }
-        dmesgln("MM: no contiguous physical pages available");
-        return ENOMEM;
-    }));
+            if (log_failure)
+                dmesgln("MM: no contiguous physical pages available");
+            return ENOMEM;
+        });
+    };
+    auto physical_pages_or_error = try_take_contiguous_pages(false);
+    if (physical_pages_or_error.is_error()) {
+        // The page caches might be holding on to pages that would complete a contiguous range.
+        release_cached_physical_pages();
+        physical_pages_or_error = try_take_contiguous_pages(true);
+    }
+    if (physical_pages_or_error.is_error())
+        return physical_pages_or_error.release_error();
+    auto physical_pages = physical_pages_or_error.release_value();
 
     {
         // The memory_type_for_zero_fill argument ensures that the cleanup region is mapped using the same memory type as the subsequent actual mapping, preventing aliasing of physical memory with mismatched memory types.
@@ -1478,6 +1854,20 @@ ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> MemoryManager::allocate_contiguo
     return physical_pages;
 }
 
+ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> MemoryManager::allocate_large_physical_page()
+{
+    if (!has_large_page_support())
+        return ENOTSUP;
+
+    // Blocks of this size only come from the large physical zones, which start at a large page boundary.
+    auto physical_pages = TRY(allocate_contiguous_physical_pages(LARGE_PAGE_SIZE, MemoryType::Normal));
+    if (physical_pages.first()->paddr().get() % LARGE_PAGE_SIZE != 0) {
+        dbgln("MM: Contiguous allocation for a large page at {} is misaligned", physical_pages.first()->paddr());
+        return ENOMEM;
+    }
+    return physical_pages;
+}
+
 void MemoryManager::enter_process_address_space(Process& process)
 {
     process.address_space().with([](auto& space) {
@@ -1649,6 +2039,13 @@ void CommittedPhysicalPageSet::uncommit_one()
     MM.uncommit_physical_pages({}, 1);
 }
 
+void CommittedPhysicalPageSet::uncommit(size_t page_count)
+{
+    VERIFY(m_page_count >= page_count);
+    m_page_count -= page_count;
+    MM.uncommit_physical_pages({}, page_count);
+}
+
 void MemoryManager::copy_physical_page(PhysicalRAMPage& physical_page, u8 page_buffer[PAGE_SIZE])
 {
     auto* quickmapped_page = quickmap_page(physical_page);
@@ -1676,9 +2073,16 @@ ErrorOr<NonnullOwnPtr<Region>> MemoryManager::allocate_unbacked_region_anywhere(
 MemoryManager::SystemMemoryInfo MemoryManager::get_system_memory_info()
 {
     return m_global_data.with([&](auto& global_data) {
+        flush_cached_commitments(global_data);
         auto physical_pages_unused = global_data.system_memory_info.physical_pages_committed + global_data.system_memory_info.physical_pages_uncommitted;
         VERIFY(global_data.system_memory_info.physical_pages == (global_data.system_memory_info.physical_pages_used + physical_pages_unused));
-        return global_data.system_memory_info;
+
+        // Pages sitting in the page caches are free as far as anyone else is concerned.
+        auto info = global_data.system_memory_info;
+        auto cached_page_count = m_cached_physical_page_count.load(AK::MemoryOrder::memory_order_relaxed);
+        info.physical_pages_used -= cached_page_count;
+        info.physical_pages_uncommitted += cached_page_count;
+        return info;
     });
 }
 }
@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Concepts.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveRedBlackTree.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Locking/Spinlock.h>
+#include <Kernel/Locking/SpinlockProtected.h>
 #include <Kernel/Memory/AllocationStrategy.h>
 #include <Kernel/Memory/MemorySections.h>
 #include <Kernel/Memory/PhysicalRAMPage.h>
@@ -29,6 +32,10 @@ class PageTableEntry;
 
 ErrorOr<FlatPtr> page_round_up(FlatPtr x);
 
+// Anonymous memory can be mapped with pages of this size on architectures that support it (currently only x86_64).
+constexpr size_t LARGE_PAGE_SIZE = 2 * MiB;
+constexpr size_t PAGES_PER_LARGE_PAGE = LARGE_PAGE_SIZE / PAGE_SIZE;
+
 constexpr FlatPtr page_round_down(FlatPtr x)
 {
     return x & ~(PAGE_SIZE - 1);
@@ -85,11 +92,42 @@ struct PhysicalMemoryRange {
 
 #define MM Kernel::Memory::MemoryManager::the()
 
+// A small stack of free physical pages owned by a single processor, so that most page allocations
+// and deallocations don't have to take the global MemoryManager lock and search the physical regions.
+// It is refilled from (and drained back to) the physical regions in batches.
+// NOTE: Pages in this cache count as used, and have already been taken out of the uncommitted pool.
+struct PhysicalPageCache {
+    static constexpr size_t capacity = 64;
+    static constexpr size_t batch_size = capacity / 2;
+
+    Array<PhysicalAddress, capacity> pages;
+    size_t page_count { 0 };
+
+    u64 hits { 0 };
+    u64 misses { 0 };
+};
+
+// Pages that have been zeroed ahead of time by the page zeroing task, so that page faults on
+// anonymous memory don't have to clear the page themselves.
+// NOTE: Like the pages in a PhysicalPageCache, these count as used and are no longer uncommitted.
+struct ZeroedPhysicalPagePool {
+    static constexpr size_t capacity = 512;
+    static constexpr size_t low_watermark = capacity / 4;
+
+    Array<PhysicalAddress, capacity> pages;
+    size_t page_count { 0 };
+
+    u64 hits { 0 };
+    u64 misses { 0 };
+};
+
 struct MemoryManagerData {
     static ProcessorSpecificDataID processor_specific_data_id() { return ProcessorSpecificDataID::MemoryManager; }
 
     Spinlock<LockRank::None> m_quickmap_in_use {};
     InterruptsState m_quickmap_previous_interrupts_state;
+
+    SpinlockProtected<PhysicalPageCache, LockRank::None> m_physical_page_cache {};
 };
 
 // This class represents a set of committed physical pages.
@@ -117,6 +155,7 @@ public:
 
     [[nodiscard]] NonnullRefPtr<PhysicalRAMPage> take_one();
     void uncommit_one();
+    void uncommit(size_t page_count);
 
     void operator=(CommittedPhysicalPageSet&&) = delete;
 
@@ -168,6 +207,7 @@ public:
     NonnullRefPtr<PhysicalRAMPage> allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill = ShouldZeroFill::Yes);
     ErrorOr<NonnullRefPtr<PhysicalRAMPage>> allocate_physical_page(ShouldZeroFill = ShouldZeroFill::Yes, bool* did_purge = nullptr);
     ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> allocate_contiguous_physical_pages(size_t size, MemoryType memory_type_for_zero_fill);
+    ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> allocate_large_physical_page();
     void deallocate_physical_page(PhysicalAddress);
 
     ErrorOr<NonnullOwnPtr<Region>> allocate_contiguous_kernel_region(size_t, StringView name, Region::Access access, MemoryType = MemoryType::Normal);
@@ -191,6 +231,20 @@ public:
 
     SystemMemoryInfo get_system_memory_info();
 
+    struct PhysicalPageCacheStatistics {
+        PhysicalSize cached_pages { 0 };
+        u64 cache_hits { 0 };
+        u64 cache_misses { 0 };
+        PhysicalSize zeroed_pages { 0 };
+        u64 zeroed_page_hits { 0 };
+        u64 zeroed_page_misses { 0 };
+    };
+
+    PhysicalPageCacheStatistics get_physical_page_cache_statistics();
+
+    // Called by the page zeroing task to top up the pool of pre-zeroed pages.
+    void refill_zeroed_physical_page_pool();
+
     template<IteratorFunction<VMObject&> Callback>
     static void for_each_vmobject(Callback callback)
     {
@@ -277,6 +331,13 @@ private:
 
     RefPtr<PhysicalRAMPage> find_free_physical_page(bool);
 
+    RefPtr<PhysicalRAMPage> take_cached_physical_page(bool committed, ShouldZeroFill);
+    size_t take_free_physical_pages_for_cache(Span<PhysicalAddress>, size_t pages_to_keep_uncommitted = 0);
+    void return_cached_physical_pages(ReadonlySpan<PhysicalAddress>);
+    void release_cached_physical_pages();
+    void flush_cached_commitments(GlobalData&);
+    void zero_physical_page(PhysicalAddress);
+
     ALWAYS_INLINE u8* quickmap_page(PhysicalRAMPage& page)
     {
         return quickmap_page(page.paddr());
@@ -295,6 +356,19 @@ private:
     };
     void release_pte(PageDirectory&, VirtualAddress, IsLastPTERelease);
 
+    static constexpr bool has_large_page_support()
+    {
+#if ARCH(X86_64)
+        return true;
+#else
+        return false;
+#endif
+    }
+    bool map_large_page(PageDirectory&, VirtualAddress, PhysicalAddress, bool writable, bool executable, bool user_allowed);
+    bool is_mapped_with_large_page(PageDirectory&, VirtualAddress);
+    void release_large_page(PageDirectory&, VirtualAddress);
+    bool split_large_page(PageDirectory&, VirtualAddress);
+
     // NOTE: These are outside of GlobalData as they are only assigned on startup,
     //       and then never change. Atomic ref-counting covers that case without
     //       the need for additional synchronization.
@@ -308,6 +382,16 @@ private:
     size_t m_physical_page_entries_count { 0 };
 
     SpinlockProtected<GlobalData, LockRank::None> m_global_data;
+
+    SpinlockProtected<ZeroedPhysicalPagePool, LockRank::None> m_zeroed_physical_page_pool {};
+
+    // Number of pages in the per-processor caches and the zeroed page pool.
+    Atomic<size_t> m_cached_physical_page_count { 0 };
+
+    // Committed pages that were handed out from a cache. Their commitment is returned to the
+    // uncommitted pool lazily (see flush_cached_commitments()), so handing them out doesn't have
+    // to take the global lock.
+    Atomic<size_t> m_committed_pages_taken_from_cache { 0 };
 };
 
 inline bool PhysicalRAMPage::is_shared_zero_page() const
@@ -55,6 +55,25 @@ void PhysicalRegion::initialize_zones()
         return zone_count;
     };
 
+    // Start the large zones at a large page boundary, so that the large pages they hand out are suitably aligned.
+    // The pages before that go into a few naturally aligned power-of-two sized zones.
+    auto misalignment = base_address.get() % LARGE_PAGE_SIZE;
+    if (misalignment != 0 && remaining_pages * PAGE_SIZE >= large_zone_size + LARGE_PAGE_SIZE) {
+        m_head_zone_pages = (LARGE_PAGE_SIZE - misalignment) / PAGE_SIZE;
+        size_t pages_left_in_head = m_head_zone_pages;
+        while (pages_left_in_head > 0) {
+            size_t zone_page_count = 1u << count_trailing_zeroes(base_address.get() / PAGE_SIZE);
+            while (zone_page_count > pages_left_in_head)
+                zone_page_count /= 2;
+            m_zones.append(adopt_nonnull_own_or_enomem(new (nothrow) PhysicalZone(base_address, zone_page_count)).release_value_but_fixme_should_propagate_errors());
+            m_usable_zones.append(*m_zones.last());
+            base_address = base_address.offset(zone_page_count * PAGE_SIZE);
+            pages_left_in_head -= zone_page_count;
+            ++m_head_zones;
+        }
+        remaining_pages -= m_head_zone_pages;
+    }
+
     // First make 16 MiB zones (with 4096 pages each)
     m_large_zones = make_zones(large_zone_size);
 
@@ -102,10 +121,10 @@ Vector<NonnullRefPtr<PhysicalRAMPage>> PhysicalRegion::take_contiguous_free_page
     return physical_pages;
 }
 
-RefPtr<PhysicalRAMPage> PhysicalRegion::take_free_page()
+Optional<PhysicalAddress> PhysicalRegion::take_free_page()
 {
     if (m_usable_zones.is_empty())
-        return nullptr;
+        return {};
 
     auto& zone = *m_usable_zones.first();
     auto page = zone.allocate_block(0);
@@ -116,19 +135,24 @@ RefPtr<PhysicalRAMPage> PhysicalRegion::take_free_page()
         m_full_zones.append(zone);
     }
 
-    return PhysicalRAMPage::create(page.value());
+    return page.value();
 }
 
 void PhysicalRegion::return_page(PhysicalAddress paddr)
 {
-    auto large_zone_base = lower().get();
-    auto small_zone_base = lower().get() + (m_large_zones * large_zone_size);
-
-    size_t zone_index;
-    if (paddr.get() < small_zone_base)
-        zone_index = (paddr.get() - large_zone_base) / large_zone_size;
-    else
-        zone_index = m_large_zones + (paddr.get() - small_zone_base) / small_zone_size;
+    auto large_zone_base = lower().get() + m_head_zone_pages * PAGE_SIZE;
+    auto small_zone_base = large_zone_base + (m_large_zones * large_zone_size);
+
+    size_t zone_index = 0;
+    if (paddr.get() < large_zone_base) {
+        while (!m_zones[zone_index]->contains(paddr))
+            ++zone_index;
+        VERIFY(zone_index < m_head_zones);
+    } else if (paddr.get() < small_zone_base) {
+        zone_index = m_head_zones + (paddr.get() - large_zone_base) / large_zone_size;
+    } else {
+        zone_index = m_head_zones + m_large_zones + (paddr.get() - small_zone_base) / small_zone_size;
+    }
 
     auto& zone = m_zones[zone_index];
     VERIFY(zone->contains(paddr));
@@ -34,7 +34,7 @@ public:
 
     OwnPtr<PhysicalRegion> try_take_pages_from_beginning(size_t);
 
-    RefPtr<PhysicalRAMPage> take_free_page();
+    Optional<PhysicalAddress> take_free_page();
     Vector<NonnullRefPtr<PhysicalRAMPage>> take_contiguous_free_pages(size_t count);
     void return_page(PhysicalAddress);
 
@@ -46,6 +46,8 @@ private:
 
     Vector<NonnullOwnPtr<PhysicalZone>> m_zones;
 
+    size_t m_head_zones { 0 };
+    size_t m_head_zone_pages { 0 };
     size_t m_large_zones { 0 };
 
     PhysicalZone::List m_usable_zones;
@@ -9,7 +9,6 @@
 #include <Kernel/Arch/PageFault.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/Inode.h>
-#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Library/Panic.h>
 #include <Kernel/Memory/AnonymousVMObject.h>
 #include <Kernel/Memory/MMIOVMObject.h>
@@ -19,6 +18,7 @@
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/Thread.h>
+#include <Kernel/Tasks/WorkQueue.h>
 
 namespace Kernel::Memory {
 
@@ -116,6 +116,7 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
         region->set_mmap(m_mmap, m_mmapped_from_readable, m_mmapped_from_writable);
         region->set_shared(m_shared);
         region->set_syscall_region(is_syscall_region());
+        region->set_wants_large_pages(wants_large_pages());
         return region;
     }
 
@@ -141,6 +142,7 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
     }
     clone_region->set_syscall_region(is_syscall_region());
     clone_region->set_mmap(m_mmap, m_mmapped_from_readable, m_mmapped_from_writable);
+    clone_region->set_wants_large_pages(wants_large_pages());
     return clone_region;
 }
 
@@ -178,6 +180,11 @@ size_t Region::amount_resident() const
     return bytes;
 }
 
+size_t Region::amount_mapped_with_large_pages() const
+{
+    return m_large_page_count * LARGE_PAGE_SIZE;
+}
+
 size_t Region::amount_shared() const
 {
     size_t bytes = 0;
@@ -232,10 +239,17 @@ bool Region::map_individual_page_impl(size_t page_index, PhysicalAddress paddr,
         PANIC("About to map mmap'ed page at a kernel address");
     }
 
+    // Mapping a single page inside a large page breaks the large page up. That may fail for lack of memory for the
+    // page table, in which case the large page is still there and still ours to release.
+    bool was_mapped_with_large_page = m_large_page_count > 0 && MM.is_mapped_with_large_page(*m_page_directory, page_vaddr);
+
     auto* pte = MM.ensure_pte(*m_page_directory, page_vaddr);
     if (!pte)
         return false;
 
+    if (was_mapped_with_large_page)
+        --m_large_page_count;
+
     if (!readable && !writable) {
         pte->clear();
         return true;
@@ -254,6 +268,47 @@ bool Region::map_individual_page_impl(size_t page_index, PhysicalAddress paddr,
     return true;
 }
 
+bool Region::try_map_large_page(size_t page_index)
+{
+    VERIFY(m_page_directory->get_lock().is_locked_by_current_processor());
+
+    if (!MemoryManager::has_large_page_support())
+        return false;
+
+    auto page_vaddr = vaddr_from_page_index(page_index);
+    if (page_vaddr.get() % LARGE_PAGE_SIZE != 0 || page_index + PAGES_PER_LARGE_PAGE > page_count())
+        return false;
+    if (!is_user() || !is_readable() || m_memory_type != MemoryType::Normal || !vmobject().is_anonymous())
+        return false;
+
+    // Only physically contiguous and suitably aligned memory that doesn't need any per-page
+    // fault handling (lazy commits, zero pages, CoW) can be covered by a single large page.
+    PhysicalAddress base;
+    {
+        SpinlockLocker vmobject_locker(vmobject().m_lock);
+        auto first_page = physical_page(page_index);
+        if (!first_page || first_page->paddr().get() % LARGE_PAGE_SIZE != 0)
+            return false;
+        base = first_page->paddr();
+        for (size_t i = 0; i < PAGES_PER_LARGE_PAGE; ++i) {
+            auto page = physical_page(page_index + i);
+            if (!page || page->paddr() != base.offset(i * PAGE_SIZE))
+                return false;
+            if (page->is_shared_zero_page() || page->is_lazy_committed_page())
+                return false;
+            if (is_writable() && should_cow(page_index + i))
+                return false;
+        }
+    }
+
+    bool was_mapped_with_large_page = MM.is_mapped_with_large_page(*m_page_directory, page_vaddr);
+    if (!MM.map_large_page(*m_page_directory, page_vaddr, base, is_writable(), is_executable(), true))
+        return false;
+    if (!was_mapped_with_large_page)
+        ++m_large_page_count;
+    return true;
+}
+
 bool Region::map_individual_page_impl(size_t page_index)
 {
     RefPtr<PhysicalRAMPage> page;
@@ -293,8 +348,15 @@ void Region::unmap_with_locks_held(ShouldFlushTLB should_flush_tlb, SpinlockLock
     size_t count = page_count();
     for (size_t i = 0; i < count; ++i) {
         auto vaddr = vaddr_from_page_index(i);
+        if (m_large_page_count > 0 && vaddr.get() % LARGE_PAGE_SIZE == 0 && i + PAGES_PER_LARGE_PAGE <= count && MM.is_mapped_with_large_page(*m_page_directory, vaddr)) {
+            MM.release_large_page(*m_page_directory, vaddr);
+            --m_large_page_count;
+            i += PAGES_PER_LARGE_PAGE - 1;
+            continue;
+        }
         MM.release_pte(*m_page_directory, vaddr, i == count - 1 ? MemoryManager::IsLastPTERelease::Yes : MemoryManager::IsLastPTERelease::No);
     }
+    VERIFY(m_large_page_count == 0);
     if (should_flush_tlb == ShouldFlushTLB::Yes)
         MemoryManager::flush_tlb(m_page_directory, vaddr(), page_count());
     m_page_directory = nullptr;
@@ -318,6 +380,10 @@ ErrorOr<void> Region::map(PageDirectory& page_directory, ShouldFlushTLB should_f
     set_page_directory(page_directory);
     size_t page_index = 0;
     while (page_index < page_count()) {
+        if (try_map_large_page(page_index)) {
+            page_index += PAGES_PER_LARGE_PAGE;
+            continue;
+        }
         if (!map_individual_page_impl(page_index))
             break;
         ++page_index;
@@ -502,6 +568,9 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     if (current_thread != nullptr)
         current_thread->did_zero_fault();
 
+    if (auto response = try_handle_zero_fault_with_large_page(page_index_in_region); response.has_value())
+        return response.value();
+
     RefPtr<PhysicalRAMPage> new_physical_page;
 
     if (page_in_slot_at_time_of_fault.is_lazy_committed_page()) {
@@ -544,6 +613,50 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     return PageFaultResponse::Continue;
 }
 
+Optional<PageFaultResponse> Region::try_handle_zero_fault_with_large_page(size_t page_index_in_region)
+{
+    if (!m_wants_large_pages || m_shared || !MemoryManager::has_large_page_support())
+        return {};
+
+    // Fill the whole large page around the faulting address at once, but only if none of it has been touched yet.
+    auto index_in_large_page = (vaddr_from_page_index(page_index_in_region).get() % LARGE_PAGE_SIZE) / PAGE_SIZE;
+    if (index_in_large_page > page_index_in_region)
+        return {};
+    auto first_page_index = page_index_in_region - index_in_large_page;
+    if (first_page_index + PAGES_PER_LARGE_PAGE > page_count())
+        return {};
+
+    {
+        SpinlockLocker vmobject_locker(vmobject().m_lock);
+        for (size_t i = 0; i < PAGES_PER_LARGE_PAGE; ++i) {
+            auto page = physical_page(first_page_index + i);
+            if (!page || !(page->is_shared_zero_page() || page->is_lazy_committed_page()))
+                return {};
+        }
+    }
+
+    auto physical_pages_or_error = MM.allocate_large_physical_page();
+    if (physical_pages_or_error.is_error())
+        return {};
+    auto physical_pages = physical_pages_or_error.release_value();
+
+    auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
+    if (!anonymous_vmobject.try_install_large_page({}, translate_to_vmobject_page(first_page_index), physical_pages))
+        return {};
+
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    if (!try_map_large_page(first_page_index)) {
+        for (size_t i = 0; i < PAGES_PER_LARGE_PAGE; ++i) {
+            if (!map_individual_page_impl(first_page_index + i)) {
+                dmesgln("MM: handle_zero_fault was unable to map a large page");
+                return PageFaultResponse::OutOfMemory;
+            }
+        }
+    }
+    MemoryManager::flush_tlb(m_page_directory, vaddr_from_page_index(first_page_index), PAGES_PER_LARGE_PAGE);
+    return PageFaultResponse::Continue;
+}
+
 PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
 {
     auto current_thread = Thread::current();
@@ -571,88 +684,94 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region, bool m
     auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
     auto& physical_page_slot = inode_vmobject.physical_pages()[page_index_in_vmobject];
 
+    // Fault in (and map) the whole naturally aligned window around the faulting page at once,
+    // since neighbouring pages are very likely to be touched soon as well.
+    auto window_start = max(first_page_index(), align_down_to(page_index_in_vmobject, fault_around_page_count));
+    auto window_end = min(first_page_index() + page_count(), align_down_to(page_index_in_vmobject, fault_around_page_count) + fault_around_page_count);
+
+    bool page_is_present = false;
+    size_t read_ahead_page_count = 0;
     {
         // NOTE: The VMObject lock is required when manipulating the VMObject's physical page slot.
         SpinlockLocker locker(inode_vmobject.m_lock);
+        page_is_present = !physical_page_slot.is_null();
 
-        if (!physical_page_slot.is_null()) {
-            dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else before reading, remapping.");
-            if (mark_page_dirty)
-                inode_vmobject.set_page_dirty(page_index_in_vmobject, true);
-            if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot))
+        // Faults that keep hitting the window right after the previous one are most likely a sequential scan.
+        if (page_index_in_vmobject == m_next_sequential_inode_fault_index)
+            m_inode_read_ahead_page_count = clamp(m_inode_read_ahead_page_count * 2, fault_around_page_count, max_inode_read_ahead_page_count);
+        else
+            m_inode_read_ahead_page_count = 0;
+        m_next_sequential_inode_fault_index = window_end;
+        read_ahead_page_count = min(m_inode_read_ahead_page_count, first_page_index() + page_count() - window_end);
+    }
+
+    if (page_is_present) {
+        dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else before reading, remapping.");
+    } else {
+        dbgln_if(PAGE_FAULT_DEBUG, "Inode fault in {} page index: {}", name(), page_index_in_region);
+
+        auto current_thread = Thread::current();
+        if (current_thread)
+            current_thread->did_inode_fault();
+
+        auto result = inode_vmobject.read_in_pages(window_start, window_end - window_start, is_executable());
+        if (result.is_error() && result.error().code() == ENOMEM && window_end - window_start > 1) {
+            // There isn't enough memory for the whole window, but there may be for the one page we actually need.
+            // Memory is tight, so don't read ahead either.
+            dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Out of memory for the fault-around window, reading in the faulting page only");
+            result = inode_vmobject.read_in_pages(page_index_in_vmobject, 1, is_executable());
+            read_ahead_page_count = 0;
+        }
+        if (result.is_error()) {
+            if (result.error().code() == ENOMEM) {
+                dmesgln("MM: handle_inode_fault was unable to allocate physical pages");
                 return PageFaultResponse::OutOfMemory;
-            return PageFaultResponse::Continue;
+            }
+            dmesgln("handle_inode_fault: Error ({}) while reading from inode", result.error());
+            return PageFaultResponse::ShouldCrash;
         }
     }
 
-    dbgln_if(PAGE_FAULT_DEBUG, "Inode fault in {} page index: {}", name(), page_index_in_region);
-
-    auto current_thread = Thread::current();
-    if (current_thread)
-        current_thread->did_inode_fault();
-
-    u8 page_buffer[PAGE_SIZE];
-    auto& inode = inode_vmobject.inode();
+    if (read_ahead_page_count > 0)
+        queue_inode_read_ahead(window_end, read_ahead_page_count);
 
-    auto buffer = UserOrKernelBuffer::for_kernel_buffer(page_buffer);
-    auto result = inode.read_bytes(page_index_in_vmobject * PAGE_SIZE, PAGE_SIZE, buffer, nullptr);
-
-    if (result.is_error()) {
-        dmesgln("handle_inode_fault: Error ({}) while reading from inode", result.error());
-        return PageFaultResponse::ShouldCrash;
-    }
+    SpinlockLocker locker(inode_vmobject.m_lock);
 
-    auto nread = result.value();
-    // Note: If we received 0, it means we are at the end of file or after it,
+    // Note: If the page is still missing, it's at the end of file or after it,
     // which means we should return bus error.
-    if (nread == 0)
+    if (physical_page_slot.is_null())
         return PageFaultResponse::BusError;
 
-    // If we read less than a page, zero out the rest to avoid leaking uninitialized data.
-    if (nread < PAGE_SIZE)
-        memset(page_buffer + nread, 0, PAGE_SIZE - nread);
-
-    // Allocate a new physical page, and copy the read inode contents into it.
-    auto new_physical_page_or_error = MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No);
-    if (new_physical_page_or_error.is_error()) {
-        dmesgln("MM: handle_inode_fault was unable to allocate a physical page");
-        return PageFaultResponse::OutOfMemory;
-    }
-    auto new_physical_page = new_physical_page_or_error.release_value();
-    {
-        InterruptDisabler disabler;
-        u8* dest_ptr = MM.quickmap_page(*new_physical_page);
-        memcpy(dest_ptr, page_buffer, PAGE_SIZE);
-
-        if (is_executable()) {
-            // Some architectures require an explicit synchronization operation after writing to memory that will be executed.
-            // This is required even if no instructions were previously fetched from that (physical) memory location,
-            // because some systems have an I-cache that is not coherent with the D-cache,
-            // resulting in the I-cache being filled with old values if the contents of the D-cache aren't written back yet.
-            Processor::flush_instruction_cache(VirtualAddress { dest_ptr }, PAGE_SIZE);
-        }
+    if (mark_page_dirty)
+        inode_vmobject.set_page_dirty(page_index_in_vmobject, true);
 
-        MM.unquickmap_page();
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    for (auto index = window_start; index < window_end; ++index) {
+        auto page_index = index - first_page_index();
+        auto page = physical_page(page_index);
+        if (!page)
+            continue;
+        if (!map_individual_page_impl(page_index, page))
+            return PageFaultResponse::OutOfMemory;
     }
+    MemoryManager::flush_tlb(m_page_directory, vaddr_from_page_index(window_start - first_page_index()), window_end - window_start);
+    return PageFaultResponse::Continue;
+}
 
+void Region::queue_inode_read_ahead(size_t first_page_index_in_vmobject, size_t page_count)
+{
+    NonnullLockRefPtr<InodeVMObject> inode_vmobject = static_cast<InodeVMObject&>(vmobject());
     {
-        SpinlockLocker locker(inode_vmobject.m_lock);
-
-        // Someone else can assign a new page before we get here, so check if physical_page_slot is still null.
-        if (physical_page_slot.is_null()) {
-            physical_page_slot = new_physical_page;
-            // Something went wrong if a newly loaded page is already marked dirty
-            VERIFY(!inode_vmobject.is_page_dirty(page_index_in_vmobject));
-        } else {
-            dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else, remapping.");
-        }
-
-        if (mark_page_dirty)
-            inode_vmobject.set_page_dirty(page_index_in_vmobject, true);
-        if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot))
-            return PageFaultResponse::OutOfMemory;
-        return PageFaultResponse::Continue;
+        SpinlockLocker locker(inode_vmobject->m_lock);
+        if (!inode_vmobject->physical_pages()[first_page_index_in_vmobject].is_null())
+            return;
     }
+
+    // Read the next pages in the background, so that the next fault only has to map them.
+    // Failing to do so isn't a problem, as the pages will then simply be read in when they are faulted on.
+    (void)g_io_work->try_queue([inode_vmobject = move(inode_vmobject), first_page_index_in_vmobject, page_count, is_executable = is_executable()] {
+        (void)inode_vmobject->read_in_pages(first_page_index_in_vmobject, page_count, is_executable);
+    });
 }
 
 PageFaultResponse Region::handle_dirty_on_write_fault(size_t page_index_in_region)
@@ -85,6 +85,9 @@ public:
     [[nodiscard]] bool is_stack() const { return m_stack; }
     void set_stack(bool stack) { m_stack = stack; }
 
+    [[nodiscard]] bool wants_large_pages() const { return m_wants_large_pages; }
+    void set_wants_large_pages(bool wants_large_pages) { m_wants_large_pages = wants_large_pages; }
+
     [[nodiscard]] bool is_immutable() const { return m_immutable.was_set(); }
     void set_immutable() { m_immutable.set(); }
 
@@ -174,6 +177,7 @@ public:
     [[nodiscard]] size_t amount_resident() const;
     [[nodiscard]] size_t amount_shared() const;
     [[nodiscard]] size_t amount_dirty() const;
+    [[nodiscard]] size_t amount_mapped_with_large_pages() const;
 
     [[nodiscard]] bool should_cow(size_t page_index) const;
 
@@ -240,6 +244,7 @@ private:
 
     [[nodiscard]] PageFaultResponse handle_cow_fault(size_t page_index);
     [[nodiscard]] PageFaultResponse handle_inode_fault(size_t page_index, bool mark_page_dirty = false);
+    void queue_inode_read_ahead(size_t first_page_index_in_vmobject, size_t page_count);
     [[nodiscard]] PageFaultResponse handle_zero_fault(size_t page_index, PhysicalRAMPage& page_in_slot_at_time_of_fault);
     [[nodiscard]] PageFaultResponse handle_dirty_on_write_fault(size_t page_index);
 
@@ -247,6 +252,8 @@ private:
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, RefPtr<PhysicalRAMPage>);
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, PhysicalAddress);
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, PhysicalAddress, bool readable, bool writeable);
+    [[nodiscard]] bool try_map_large_page(size_t page_index);
+    [[nodiscard]] Optional<PageFaultResponse> try_handle_zero_fault_with_large_page(size_t page_index);
 
     LockRefPtr<PageDirectory> m_page_directory;
     VirtualRange m_range;
@@ -254,6 +261,14 @@ private:
     LockRefPtr<VMObject> m_vmobject;
     OwnPtr<KString> m_name;
     Atomic<u32> m_in_progress_page_faults;
+    Atomic<u32> m_large_page_count;
+
+    static constexpr size_t fault_around_page_count = 16;
+    static constexpr size_t max_inode_read_ahead_page_count = 128;
+
+    // NOTE: These are protected by the VMObject lock.
+    size_t m_next_sequential_inode_fault_index { 0 };
+    size_t m_inode_read_ahead_page_count { 0 };
     u8 m_access { Region::None };
     bool m_shared : 1 { false };
     bool m_stack : 1 { false };
@@ -261,6 +276,7 @@ private:
     bool m_syscall_region : 1 { false };
     bool m_mmapped_from_readable : 1 { false };
     bool m_mmapped_from_writable : 1 { false };
+    bool m_wants_large_pages : 1 { false };
 
     MemoryType m_memory_type;
 
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <AK/Endian.h>
+#include <AK/Span.h>
 #include <AK/Types.h>
 
 namespace Kernel {
@@ -22,31 +24,90 @@ enum class TransportProtocol : u8 {
     ICMPv6 = 58,
 };
 
+// The one's complement sum from RFC 1071.
+// As the sum doesn't depend on byte order, the data is summed up in native order a whole word at a time,
+// and only the final 16-bit result is converted to network byte order.
 class InternetChecksum {
 public:
     void add(ReadonlyBytes bytes)
+    {
+        add_impl<false>(nullptr, bytes);
+    }
+
+    // Copies the bytes to the destination while summing them up, so that the data only has to be read once.
+    void copy_and_add(u8* destination, ReadonlyBytes bytes)
+    {
+        add_impl<true>(destination, bytes);
+    }
+
+    // Adds the sum of another part of the same packet, which has to start at an even offset.
+    void add(InternetChecksum const& other)
     {
         VERIFY(!m_uneven_payload);
-        Span<u16 const> words { bit_cast<u16 const*>(bytes.data()), bytes.size() / 2 };
-        for (u16 w : words) {
-            m_checksum += AK::convert_between_host_and_network_endian(w);
-            if (m_checksum & 0x80000000)
-                m_checksum = (m_checksum & 0xffff) | (m_checksum >> 16);
-        }
-        if (bytes.size() % 2 == 1) {
-            m_checksum += (bytes.last()) << 8;
-            m_uneven_payload = true;
-        }
+        m_uneven_payload = other.m_uneven_payload;
+        m_sum += other.m_sum;
+        if (m_sum < other.m_sum)
+            ++m_sum;
     }
+
     NetworkOrdered<u16> finish()
     {
-        while (m_checksum >> 16)
-            m_checksum = (m_checksum & 0xffff) + (m_checksum >> 16);
-        return ~m_checksum & 0xffff;
+        u64 sum = m_sum;
+        while (sum >> 16)
+            sum = (sum & 0xffff) + (sum >> 16);
+        return ~AK::convert_between_host_and_network_endian(static_cast<u16>(sum)) & 0xffff;
     }
 
 private:
-    u32 m_checksum { 0 };
+    template<bool copy>
+    ALWAYS_INLINE void add_impl(u8* destination, ReadonlyBytes bytes)
+    {
+        VERIFY(!m_uneven_payload);
+        auto const* data = bytes.data();
+        size_t size = bytes.size();
+
+        // Summing 32-bit words into a 64-bit accumulator can't overflow for any packet size, so the carries can be folded in at the end.
+        // Splitting the sum over a few accumulators lets the additions run in parallel.
+        u64 sums[4] {};
+        auto load_word = [&](size_t offset) {
+            u32 word;
+            __builtin_memcpy(&word, data + offset, sizeof(word));
+            if constexpr (copy)
+                __builtin_memcpy(destination + offset, &word, sizeof(word));
+            return word;
+        };
+        size_t offset = 0;
+        for (; offset + 4 * sizeof(u32) <= size; offset += 4 * sizeof(u32)) {
+            sums[0] += load_word(offset);
+            sums[1] += load_word(offset + 4);
+            sums[2] += load_word(offset + 8);
+            sums[3] += load_word(offset + 12);
+        }
+        for (; offset + sizeof(u32) <= size; offset += sizeof(u32))
+            sums[0] += load_word(offset);
+
+        // The remaining bytes are summed up as 16-bit words, with the last odd byte being padded with a zero byte.
+        u8 tail[4] {};
+        size_t tail_size = size - offset;
+        __builtin_memcpy(tail, data + offset, tail_size);
+        if constexpr (copy)
+            __builtin_memcpy(destination + offset, tail, tail_size);
+        u16 tail_words[2];
+        __builtin_memcpy(tail_words, tail, sizeof(tail_words));
+        sums[0] += tail_words[0];
+        sums[0] += tail_words[1];
+        m_uneven_payload = (size % 2) == 1;
+
+        for (auto sum : sums) {
+            // Fold each accumulator to 32 bits first, so that adding it can't overflow.
+            sum = (sum & 0xffffffff) + (sum >> 32);
+            m_sum += sum;
+            if (m_sum < sum)
+                ++m_sum;
+        }
+    }
+
+    u64 m_sum { 0 };
     bool m_uneven_payload { false };
 };
 
@@ -301,6 +301,18 @@ bool LocalSocket::can_write(OpenFileDescription const& description, u64) const
     return false;
 }
 
+Optional<size_t> LocalSocket::space_for_writing(OpenFileDescription const& description) const
+{
+    if (!has_attached_peer(description))
+        return {};
+    auto role = this->role(description);
+    if (role == Role::Accepted)
+        return m_for_client->space_for_writing();
+    if (role == Role::Connected)
+        return m_for_server->space_for_writing();
+    return {};
+}
+
 ErrorOr<size_t> LocalSocket::sendto(OpenFileDescription& description, UserOrKernelBuffer const& data, size_t data_size, int, Userspace<sockaddr const*>, socklen_t)
 {
     if (!has_attached_peer(description))
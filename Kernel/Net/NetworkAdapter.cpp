@@ -4,8 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashFunctions.h>
 #include <Kernel/Heap/kmalloc.h>
-#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Library/StdLib.h>
 #include <Kernel/Net/EtherType.h>
 #include <Kernel/Net/NetworkAdapter.h>
@@ -21,10 +21,16 @@ NetworkAdapter::NetworkAdapter(StringView interface_name)
 
 NetworkAdapter::~NetworkAdapter() = default;
 
-void NetworkAdapter::send_packet(ReadonlyBytes packet)
+void NetworkAdapter::send_packet(ReadonlyBytes packet, Optional<PacketOffload> const& offload)
 {
     m_packets_out++;
     m_bytes_out += packet.size();
+    if (offload.has_value()) {
+        VERIFY(supports_checksum_offload());
+        VERIFY(offload->segment_size == 0 || max_tcp_segmentation_offload_size() > 0);
+        send_raw_with_offload(packet, offload.value());
+        return;
+    }
     send_raw(packet);
 }
 
@@ -47,7 +53,7 @@ void NetworkAdapter::send(MACAddress const& destination, ARPPacket const& packet
 void NetworkAdapter::fill_in_ipv4_header(PacketWithTimestamp& packet, IPv4Address const& source_ipv4, MACAddress const& destination_mac, IPv4Address const& destination_ipv4, TransportProtocol protocol, size_t payload_size, u8 type_of_service, u8 ttl)
 {
     size_t ipv4_packet_size = sizeof(IPv4Packet) + payload_size;
-    VERIFY(ipv4_packet_size <= mtu());
+    VERIFY(ipv4_packet_size <= max<size_t>(mtu(), max_tcp_segmentation_offload_size()));
 
     size_t ethernet_frame_size = ipv4_payload_offset() + payload_size;
     VERIFY(packet.buffer->size() == ethernet_frame_size);
@@ -103,16 +109,38 @@ void NetworkAdapter::fill_in_ipv6_header(PacketWithTimestamp& packet, IPv6Addres
     ipv6.set_hop_limit(hop_limit);
 }
 
+void NetworkAdapter::set_receive_queue_count(size_t count)
+{
+    VERIFY(count > 0 && count <= max_receive_queues);
+    m_receive_queue_count = count;
+}
+
+size_t NetworkAdapter::receive_queue_for_frame(ReadonlyBytes frame) const
+{
+    if (m_receive_queue_count == 1)
+        return 0;
+
+    // Keep all packets of a flow on the same queue, so that they are processed in order.
+    // Anything that isn't IPv4 is rare enough to just go to the first queue.
+    if (frame.size() < sizeof(EthernetFrameHeader) + sizeof(IPv4Packet))
+        return 0;
+    auto const& eth = *bit_cast<EthernetFrameHeader const*>(frame.data());
+    if (eth.ether_type() != EtherType::IPv4)
+        return 0;
+    auto const& ipv4 = *static_cast<IPv4Packet const*>(eth.payload());
+
+    // Only the first fragment of a datagram carries its ports, so they can't be part of the hash without
+    // splitting fragmented and unfragmented packets of the same flow across queues.
+    auto hash = pair_int_hash(pair_int_hash(ipv4.source().to_u32(), ipv4.destination().to_u32()), ipv4.protocol());
+    return hash % m_receive_queue_count;
+}
+
 void NetworkAdapter::did_receive(ReadonlyBytes payload)
 {
-    InterruptDisabler disabler;
     m_packets_in++;
     m_bytes_in += payload.size();
 
-    if (m_packet_queue_size == max_packet_buffers) {
-        m_packets_dropped++;
-        return;
-    }
+    auto receive_queue = receive_queue_for_frame(payload);
 
     auto packet = acquire_packet_buffer(payload.size());
     if (!packet) {
@@ -122,20 +150,39 @@ void NetworkAdapter::did_receive(ReadonlyBytes payload)
 
     memcpy(packet->buffer->data(), payload.data(), payload.size());
 
-    m_packet_queue.append(*packet);
-    m_packet_queue_size++;
+    // Each queue gets its share of the packet buffers, so that a busy queue can't starve the others.
+    auto max_queued_packets = max_packet_buffers / m_receive_queue_count;
+    bool queued = m_receive_queues[receive_queue].with([&](auto& queue) {
+        if (queue.size >= max_queued_packets)
+            return false;
+        queue.packets.append(*packet);
+        queue.size++;
+        return true;
+    });
+    if (!queued) {
+        release_packet_buffer(*packet);
+        m_packets_dropped++;
+        return;
+    }
 
     if (on_receive)
-        on_receive();
+        on_receive(receive_queue);
 }
 
-size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp)
+size_t NetworkAdapter::dequeue_packet(size_t receive_queue, u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp)
 {
-    InterruptDisabler disabler;
-    if (m_packet_queue.is_empty())
+    VERIFY(receive_queue < m_receive_queue_count);
+    auto packet_with_timestamp = m_receive_queues[receive_queue].with([&](auto& queue) -> RefPtr<PacketWithTimestamp> {
+        if (queue.packets.is_empty())
+            return nullptr;
+        auto packet = queue.packets.take_first();
+        queue.size--;
+        queue.dequeued.packets++;
+        queue.dequeued.bytes += packet->buffer->size();
+        return packet;
+    });
+    if (!packet_with_timestamp)
         return 0;
-    auto packet_with_timestamp = m_packet_queue.take_first();
-    m_packet_queue_size--;
     packet_timestamp = packet_with_timestamp->timestamp;
     auto& packet_buffer = packet_with_timestamp->buffer;
     size_t packet_size = packet_buffer->size();
@@ -145,6 +192,12 @@ size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTi
     return packet_size;
 }
 
+NetworkAdapter::ReceiveQueueStatistics NetworkAdapter::receive_queue_statistics(size_t receive_queue) const
+{
+    VERIFY(receive_queue < m_receive_queue_count);
+    return m_receive_queues[receive_queue].with([](auto const& queue) { return queue.dequeued; });
+}
+
 RefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t size)
 {
     auto packet = m_unused_packets.with([size](auto& unused_packets) -> RefPtr<PacketWithTimestamp> {
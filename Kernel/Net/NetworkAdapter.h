@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Function.h>
@@ -45,6 +47,17 @@ struct PacketWithTimestamp final : public AtomicRefCounted<PacketWithTimestamp>
     IntrusiveListNode<PacketWithTimestamp, RefPtr<PacketWithTimestamp>> packet_node;
 };
 
+// Work that the network stack hands off to the adapter when sending a packet.
+struct PacketOffload {
+    // The adapter computes the Internet checksum from checksum_start (relative to the start of the frame) to the end of the packet,
+    // and stores it checksum_offset bytes after checksum_start. That field has to contain the checksum of the pseudo-header already.
+    u16 checksum_start { 0 };
+    u16 checksum_offset { 0 };
+    // If non-zero, the adapter cuts the TCP payload following the first header_size bytes into segments of this size.
+    u16 segment_size { 0 };
+    u16 header_size { 0 };
+};
+
 class NetworkingManagement;
 class NetworkAdapter
     : public AtomicRefCounted<NetworkAdapter>
@@ -57,6 +70,9 @@ public:
 
     static constexpr i32 LINKSPEED_INVALID = -1;
 
+    // Received packets are spread over up to this many queues by flow, so that each queue can be processed by a thread of its own.
+    static constexpr size_t max_receive_queues = 8;
+
     virtual ~NetworkAdapter();
 
     virtual StringView class_name() const = 0;
@@ -82,6 +98,10 @@ public:
     }
     virtual bool link_full_duplex() { return false; }
 
+    virtual bool supports_checksum_offload() const { return false; }
+    // The largest IPv4 packet that the adapter will cut into TCP segments for us, or 0 if it can't do that.
+    virtual size_t max_tcp_segmentation_offload_size() const { return 0; }
+
     void set_ipv4_address(IPv4Address const&);
     void set_ipv4_netmask(IPv4Address const&);
 
@@ -92,9 +112,16 @@ public:
     void fill_in_ipv4_header(PacketWithTimestamp&, IPv4Address const&, MACAddress const&, IPv4Address const&, TransportProtocol, size_t, u8 type_of_service, u8 ttl);
     void fill_in_ipv6_header(PacketWithTimestamp&, IPv6Address const&, MACAddress const&, IPv6Address const&, TransportProtocol, size_t, u8 hop_limit);
 
-    size_t dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp);
+    size_t receive_queue_count() const { return m_receive_queue_count; }
+    void set_receive_queue_count(size_t);
 
-    bool has_queued_packets() const { return !m_packet_queue.is_empty(); }
+    size_t dequeue_packet(size_t receive_queue, u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp);
+
+    struct ReceiveQueueStatistics {
+        u64 packets { 0 };
+        u64 bytes { 0 };
+    };
+    ReceiveQueueStatistics receive_queue_statistics(size_t receive_queue) const;
 
     u32 mtu() const { return m_mtu; }
     void set_mtu(u32 mtu) { m_mtu = mtu; }
@@ -112,15 +139,17 @@ public:
     constexpr size_t ipv4_payload_offset() const { return layer3_payload_offset() + sizeof(IPv4Packet); }
     constexpr size_t ipv6_payload_offset() const { return layer3_payload_offset() + sizeof(IPv6PacketHeader); }
 
-    Function<void()> on_receive;
+    // Called with the index of the receive queue that a packet was put on.
+    Function<void(size_t receive_queue)> on_receive;
 
-    void send_packet(ReadonlyBytes);
+    void send_packet(ReadonlyBytes, Optional<PacketOffload> const& = {});
 
 protected:
     NetworkAdapter(StringView);
     void set_mac_address(MACAddress const& mac_address) { m_mac_address = mac_address; }
     void did_receive(ReadonlyBytes);
     virtual void send_raw(ReadonlyBytes) = 0;
+    virtual void send_raw_with_offload(ReadonlyBytes, PacketOffload const&) { VERIFY_NOT_REACHED(); }
     void autoconfigure_link_local_ipv6();
 
 private:
@@ -136,16 +165,24 @@ private:
 
     using PacketList = IntrusiveList<&PacketWithTimestamp::packet_node>;
 
-    PacketList m_packet_queue;
-    size_t m_packet_queue_size { 0 };
+    struct ReceiveQueue {
+        PacketList packets;
+        size_t size { 0 };
+        ReceiveQueueStatistics dequeued;
+    };
+
+    size_t receive_queue_for_frame(ReadonlyBytes) const;
+
+    Array<SpinlockProtected<ReceiveQueue, LockRank::None>, max_receive_queues> m_receive_queues;
+    size_t m_receive_queue_count { 1 };
     SpinlockProtected<PacketList, LockRank::None> m_unused_packets {};
     FixedStringBuffer<IFNAMSIZ> m_name;
-    u32 m_packets_in { 0 };
-    u32 m_bytes_in { 0 };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_packets_in { 0 };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_bytes_in { 0 };
     u32 m_packets_out { 0 };
     u32 m_bytes_out { 0 };
     u32 m_mtu { 1500 };
-    u32 m_packets_dropped { 0 };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_packets_dropped { 0 };
 };
 
 }
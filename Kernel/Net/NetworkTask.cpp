@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Locking/MutexProtected.h>
@@ -39,100 +41,164 @@ static void handle_udp(IPv4Packet const&, UnixDateTime const& packet_timestamp);
 static void handle_tcp(IPv4Packet const&, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter);
 static void send_delayed_tcp_ack(TCPSocket& socket);
 static void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, RefPtr<NetworkAdapter> adapter);
-static void flush_delayed_tcp_acks();
 static void retransmit_tcp_packets();
 
-static Thread* network_task = nullptr;
-static HashTable<NonnullRefPtr<TCPSocket>>* delayed_ack_sockets;
+// Packets are handed to the thread that owns their receive queue in batches of up to this many.
+static constexpr size_t max_packets_per_batch = 32;
+static constexpr size_t packet_buffer_size = 64 * KiB;
+
+// Every receive worker processes the packets from one receive queue of each adapter.
+// As adapters steer packets to their receive queues by flow, all packets of a TCP connection are handled by the same worker.
+struct ReceiveWorker {
+    size_t receive_queue { 0 };
+    Thread* thread { nullptr };
+    WaitQueue wait_queue;
+    Atomic<bool> has_pending_packets { false };
+    HashTable<NonnullRefPtr<TCPSocket>> delayed_ack_sockets;
+};
+
+static Array<ReceiveWorker*, NetworkAdapter::max_receive_queues> receive_workers {};
+
+static void flush_delayed_tcp_acks(ReceiveWorker&);
 
 [[noreturn]] static void NetworkTask_main(void*);
 
 void NetworkTask::spawn()
 {
-    auto [_, first_thread] = MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, nullptr));
-    network_task = first_thread;
+    (void)MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, nullptr));
+}
+
+static ReceiveWorker* current_receive_worker()
+{
+    auto* current_thread = Thread::current();
+    for (auto* worker : receive_workers) {
+        if (worker && worker->thread == current_thread)
+            return worker;
+    }
+    return nullptr;
 }
 
 bool NetworkTask::is_current()
 {
-    return Thread::current() == network_task;
+    return current_receive_worker() != nullptr;
 }
 
-void NetworkTask_main(void*)
+static void handle_packet(NetworkAdapter& adapter, u8 const* buffer, size_t packet_size, UnixDateTime const& packet_timestamp)
 {
-    delayed_ack_sockets = new HashTable<NonnullRefPtr<TCPSocket>>;
+    dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
+    if (packet_size < sizeof(EthernetFrameHeader)) {
+        dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", packet_size);
+        return;
+    }
+    auto& eth = *(EthernetFrameHeader const*)buffer;
+    dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), packet_size);
 
-    WaitQueue packet_wait_queue;
-    int pending_packets = 0;
+    switch (eth.ether_type()) {
+    case EtherType::ARP:
+        handle_arp(eth, packet_size, adapter);
+        break;
+    case EtherType::IPv4:
+        handle_ipv4(eth, packet_size, packet_timestamp, adapter);
+        break;
+    case EtherType::IPv6:
+        handle_ipv6(eth, packet_size, packet_timestamp, adapter);
+        break;
+    default:
+        dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
+    }
+}
+
+// Returns the number of packets that were processed.
+static size_t process_packet_batch(ReceiveWorker& worker, u8* buffer)
+{
+    // Don't hold on to the adapter list while processing packets, as that may block.
+    Vector<NonnullRefPtr<NetworkAdapter>, 8> adapters;
     NetworkingManagement::the().for_each([&](auto& adapter) {
-        dmesgln("NetworkTask: {} network adapter found: hw={}", adapter.class_name(), adapter.mac_address().to_string());
+        (void)adapters.try_append(adapter);
+    });
 
-        if (adapter.class_name() == "LoopbackAdapter"sv) {
-            adapter.set_ipv4_address({ 127, 0, 0, 1 });
-            adapter.set_ipv4_netmask({ 255, 0, 0, 0 });
+    size_t processed = 0;
+    bool dequeued_any = true;
+    while (dequeued_any && processed < max_packets_per_batch) {
+        // Take turns between adapters, so that a busy one can't starve the others.
+        dequeued_any = false;
+        for (auto& adapter : adapters) {
+            if (processed == max_packets_per_batch)
+                break;
+            UnixDateTime packet_timestamp;
+            auto packet_size = adapter->dequeue_packet(worker.receive_queue, buffer, packet_buffer_size, packet_timestamp);
+            if (packet_size == 0)
+                continue;
+            handle_packet(*adapter, buffer, packet_size, packet_timestamp);
+            dequeued_any = true;
+            ++processed;
         }
+    }
+    return processed;
+}
 
-        adapter.on_receive = [&]() {
-            pending_packets++;
-            packet_wait_queue.wake_all();
-        };
-    });
+static void run_receive_worker(ReceiveWorker& worker)
+{
+    worker.thread = Thread::current();
 
-    size_t buffer_size = 64 * KiB;
-    auto region_or_error = MM.allocate_kernel_region(buffer_size, "Kernel Packet Buffer"sv, Memory::Region::Access::ReadWrite);
+    auto region_or_error = MM.allocate_kernel_region(packet_buffer_size, "Kernel Packet Buffer"sv, Memory::Region::Access::ReadWrite);
     if (region_or_error.is_error())
         TODO();
     auto buffer_region = region_or_error.release_value();
-
-    struct {
-        u8* buffer;
-        UnixDateTime packet_timestamp;
-        RefPtr<NetworkAdapter> adapter;
-    } meta;
-
-    meta.buffer = (u8*)buffer_region->vaddr().get();
+    auto* buffer = buffer_region->vaddr().as_ptr();
 
     while (!Process::current().is_dying()) {
-        flush_delayed_tcp_acks();
-        retransmit_tcp_packets();
-        size_t packet_size = 0;
-        if (!pending_packets) {
+        flush_delayed_tcp_acks(worker);
+        // Retransmissions aren't tied to any receive queue, so leave them to the first worker.
+        if (worker.receive_queue == 0)
+            retransmit_tcp_packets();
+
+        if (!worker.has_pending_packets.exchange(false)) {
             auto timeout_time = Duration::from_milliseconds(500);
             auto timeout = Thread::BlockTimeout { false, &timeout_time };
-            [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
-            continue;
-        } else {
-            NetworkingManagement::the().for_each([&](auto& adapter) {
-                if (packet_size || !adapter.has_queued_packets()) {
-                    return;
-                }
-                packet_size = adapter.dequeue_packet(meta.buffer, buffer_size, meta.packet_timestamp);
-                pending_packets--;
-                dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
-                meta.adapter = adapter;
-            });
-        }
-        if (packet_size < sizeof(EthernetFrameHeader)) {
-            dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", packet_size);
+            [[maybe_unused]] auto result = worker.wait_queue.wait_on(timeout, "NetworkTask"sv);
             continue;
         }
-        auto& eth = *(EthernetFrameHeader const*)meta.buffer;
-        dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), packet_size);
-
-        switch (eth.ether_type()) {
-        case EtherType::ARP:
-            handle_arp(eth, packet_size, meta.adapter);
-            break;
-        case EtherType::IPv4:
-            handle_ipv4(eth, packet_size, meta.packet_timestamp, meta.adapter);
-            break;
-        case EtherType::IPv6:
-            handle_ipv6(eth, packet_size, meta.packet_timestamp, meta.adapter);
-            break;
-        default:
-            dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
+
+        // If the batch was full, there may be more packets waiting for us once we have sent out our ACKs.
+        if (process_packet_batch(worker, buffer) == max_packets_per_batch)
+            worker.has_pending_packets.store(true);
+    }
+}
+
+void NetworkTask_main(void*)
+{
+    size_t worker_count = min<size_t>(Processor::count(), NetworkAdapter::max_receive_queues);
+    for (size_t i = 0; i < worker_count; ++i)
+        receive_workers[i] = new ReceiveWorker { .receive_queue = i };
+
+    NetworkingManagement::the().for_each([&](auto& adapter) {
+        dmesgln("NetworkTask: {} network adapter found: hw={}", adapter.class_name(), adapter.mac_address().to_string());
+
+        if (adapter.class_name() == "LoopbackAdapter"sv) {
+            adapter.set_ipv4_address({ 127, 0, 0, 1 });
+            adapter.set_ipv4_netmask({ 255, 0, 0, 0 });
         }
+
+        adapter.on_receive = [](size_t receive_queue) {
+            auto& worker = *receive_workers[receive_queue];
+            worker.has_pending_packets.store(true);
+            worker.wait_queue.wake_one();
+        };
+        adapter.set_receive_queue_count(worker_count);
+    });
+
+    for (size_t i = 1; i < worker_count; ++i) {
+        auto* worker = receive_workers[i];
+        auto name = MUST(KString::formatted("Network Task #{}", i));
+        (void)MUST(Process::current().create_kernel_thread(name->view(), [worker]() {
+            run_receive_worker(*worker);
+            Thread::current()->exit();
+        }));
     }
+    dmesgln("NetworkTask: Processing received packets on {} thread(s)", worker_count);
+
+    run_receive_worker(*receive_workers[0]);
     Process::current().sys$exit(0);
     VERIFY_NOT_REACHED();
 }
@@ -476,13 +542,17 @@ void send_delayed_tcp_ack(TCPSocket& socket)
         return;
     }
 
-    delayed_ack_sockets->set(move(socket));
+    // Only the worker that handles the socket's flow will ever touch it here.
+    auto* worker = current_receive_worker();
+    VERIFY(worker);
+    worker->delayed_ack_sockets.set(move(socket));
 }
 
-void flush_delayed_tcp_acks()
+void flush_delayed_tcp_acks(ReceiveWorker& worker)
 {
+    auto& delayed_ack_sockets = worker.delayed_ack_sockets;
     Vector<NonnullRefPtr<TCPSocket>, 32> remaining_sockets;
-    for (auto& socket : *delayed_ack_sockets) {
+    for (auto& socket : delayed_ack_sockets) {
         MutexLocker locker(socket->mutex());
         if (socket->should_delay_next_ack()) {
             MUST(remaining_sockets.try_append(*socket));
@@ -491,12 +561,12 @@ void flush_delayed_tcp_acks()
         [[maybe_unused]] auto result = socket->send_ack();
     }
 
-    if (remaining_sockets.size() != delayed_ack_sockets->size()) {
-        delayed_ack_sockets->clear();
+    if (remaining_sockets.size() != delayed_ack_sockets.size()) {
+        delayed_ack_sockets.clear();
         if (remaining_sockets.size() > 0)
             dbgln("flush_delayed_tcp_acks: {} sockets remaining", remaining_sockets.size());
         for (auto&& socket : remaining_sockets)
-            delayed_ack_sockets->set(move(socket));
+            delayed_ack_sockets.set(move(socket));
     }
 }
 
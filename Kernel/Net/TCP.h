@@ -111,6 +111,7 @@ public:
 
     u16 checksum() const { return m_checksum; }
     void set_checksum(u16 checksum) { m_checksum = checksum; }
+    static constexpr size_t checksum_offset = 16;
 
     u16 urgent() const { return m_urgent; }
     void set_urgent(u16 urgent) { m_urgent = urgent; }
@@ -234,6 +234,11 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
         return set_so_error(EHOSTUNREACH);
     size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
 
+    // If the adapter can cut up large packets into segments for us, hand it as much as it takes at once.
+    size_t max_payload_size = mss;
+    if (auto max_offload_size = routing_decision.adapter->max_tcp_segmentation_offload_size(); max_offload_size > 0)
+        max_payload_size = max(mss, max_offload_size - sizeof(IPv4Packet) - sizeof(TCPPacket));
+
     if (!m_no_delay) {
         // RFC 896 (Nagle’s algorithm): https://www.ietf.org/rfc/rfc0896
         // "The solution is to inhibit the sending of new TCP  segments when
@@ -246,7 +251,7 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
             return set_so_error(EAGAIN);
     }
 
-    data_length = min(data_length, mss);
+    data_length = min(data_length, max_payload_size);
     TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
     return data_length;
 }
@@ -291,8 +296,13 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     tcp_packet.set_data_offset(tcp_header_size / sizeof(u32));
     tcp_packet.set_flags(flags);
 
+    Optional<InternetChecksum> payload_checksum;
     if (payload) {
-        if (auto result = payload->read(tcp_packet.payload(), payload_size); result.is_error()) {
+        if (payload->is_kernel_buffer() && !routing_decision.adapter->supports_checksum_offload()) {
+            // The payload is already in kernel memory (e.g. with sendfile()), so we can sum it up while copying it.
+            payload_checksum = InternetChecksum {};
+            payload_checksum->copy_and_add(static_cast<u8*>(tcp_packet.payload()), { payload->user_or_kernel_ptr(), payload_size });
+        } else if (auto result = payload->read(tcp_packet.payload(), payload_size); result.is_error()) {
             routing_decision.adapter->release_packet_buffer(*packet);
             return set_so_error(result.release_error());
         }
@@ -325,13 +335,28 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     if ((options_size % 4) != 0)
         *next_option = to_underlying(TCPOptionKind::End);
 
-    tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    Optional<PacketOffload> offload;
+    if (routing_decision.adapter->supports_checksum_offload()) {
+        offload = PacketOffload {
+            .checksum_start = static_cast<u16>(ipv4_payload_offset),
+            .checksum_offset = TCPPacket::checksum_offset,
+            .header_size = static_cast<u16>(ipv4_payload_offset + tcp_header_size),
+        };
+        size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - tcp_header_size;
+        if (payload_size > mss)
+            offload->segment_size = mss;
+        tcp_packet.set_checksum(compute_tcp_pseudo_header_checksum(local_address(), peer_address(), tcp_header_size + payload_size));
+    } else if (payload_checksum.has_value()) {
+        tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size, payload_checksum.value()));
+    } else {
+        tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    }
 
     bool expect_ack { tcp_packet.has_syn() || payload_size > 0 };
     if (expect_ack) {
         bool append_failed { false };
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter, offload });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
@@ -346,7 +371,7 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     m_packets_out++;
     m_bytes_out += buffer_size;
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet(packet->bytes(), offload);
     if (!expect_ack)
         routing_decision.adapter->release_packet_buffer(*packet);
 
@@ -416,51 +441,49 @@ bool TCPSocket::should_delay_next_ack() const
 
 NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const& packet, u16 payload_size)
 {
-    union PseudoHeader {
-        struct [[gnu::packed]] {
-            IPv4Address source;
-            IPv4Address destination;
-            u8 zero;
-            u8 protocol;
-            NetworkOrdered<u16> payload_size;
-        } header;
-        u16 raw[6];
-    };
-    static_assert(sizeof(PseudoHeader) == 12);
+    InternetChecksum payload_checksum;
+    payload_checksum.add({ packet.payload(), payload_size });
+    return compute_tcp_checksum(source, destination, packet, payload_size, payload_checksum);
+}
 
+NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const& packet, u16 payload_size, InternetChecksum const& payload_checksum)
+{
     Checked<u16> packet_size = packet.header_size();
     packet_size += payload_size;
     VERIFY(!packet_size.has_overflow());
 
-    PseudoHeader pseudo_header { .header = { source, destination, 0, (u8)TransportProtocol::TCP, packet_size.value() } };
+    struct [[gnu::packed]] {
+        IPv4Address source;
+        IPv4Address destination;
+        u8 zero;
+        u8 protocol;
+        NetworkOrdered<u16> packet_size;
+    } pseudo_header { source, destination, 0, (u8)TransportProtocol::TCP, packet_size.value() };
+    static_assert(sizeof(pseudo_header) == 12);
 
-    u32 checksum = 0;
-    auto* raw_pseudo_header = pseudo_header.raw;
-    for (size_t i = 0; i < sizeof(pseudo_header) / sizeof(u16); ++i) {
-        checksum += AK::convert_between_host_and_network_endian(raw_pseudo_header[i]);
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    auto* raw_packet = bit_cast<u16*>(&packet);
-    for (size_t i = 0; i < packet.header_size() / sizeof(u16); ++i) {
-        checksum += AK::convert_between_host_and_network_endian(raw_packet[i]);
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
     VERIFY(packet.data_offset() * 4 == packet.header_size());
-    auto* raw_payload = bit_cast<u16*>(packet.payload());
-    for (size_t i = 0; i < payload_size / sizeof(u16); ++i) {
-        checksum += AK::convert_between_host_and_network_endian(raw_payload[i]);
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    if (payload_size & 1) {
-        u16 expanded_byte = ((u8 const*)packet.payload())[payload_size - 1] << 8;
-        checksum += expanded_byte;
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    return ~(checksum & 0xffff);
+    InternetChecksum checksum;
+    checksum.add({ &pseudo_header, sizeof(pseudo_header) });
+    checksum.add({ &packet, packet.header_size() });
+    checksum.add(payload_checksum);
+    return checksum.finish();
+}
+
+NetworkOrdered<u16> TCPSocket::compute_tcp_pseudo_header_checksum(IPv4Address const& source, IPv4Address const& destination, u16 tcp_length)
+{
+    struct [[gnu::packed]] {
+        IPv4Address source;
+        IPv4Address destination;
+        u8 zero;
+        u8 protocol;
+        NetworkOrdered<u16> tcp_length;
+    } pseudo_header { source, destination, 0, (u8)TransportProtocol::TCP, tcp_length };
+    static_assert(sizeof(pseudo_header) == 12);
+
+    // With checksum offloading, the adapter sums up the rest of the packet and complements the result.
+    InternetChecksum checksum;
+    checksum.add({ &pseudo_header, sizeof(pseudo_header) });
+    return static_cast<u16>(~checksum.finish());
 }
 
 ErrorOr<void> TCPSocket::setsockopt(int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
@@ -757,16 +780,79 @@ void TCPSocket::retransmit_packets()
 
             auto packet_buffer = packet.buffer->bytes();
 
+            if (packet.offload.has_value() && !routing_decision.adapter->supports_checksum_offload()) {
+                // We have been rerouted through an adapter that can't finish the packet for us.
+                if (packet.offload->segment_size != 0) {
+                    // The segments get their own headers and checksums, so the packet itself is left as it is
+                    // in case a later retransmit goes through an adapter that can segment it again.
+                    send_packet_in_segments(routing_decision, packet);
+                    continue;
+                }
+                auto& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+                auto payload_size = packet_buffer.size() - packet.ipv4_payload_offset - tcp_packet.header_size();
+                tcp_packet.set_checksum(0);
+                tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+                packet.offload = {};
+            }
+
             routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
                 local_address(), routing_decision.next_hop, peer_address(),
                 TransportProtocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
+            routing_decision.adapter->send_packet(packet_buffer, packet.offload);
             m_packets_out++;
             m_bytes_out += packet_buffer.size();
         }
     });
 }
 
+void TCPSocket::send_packet_in_segments(RoutingDecision const& routing_decision, OutgoingPacket const& packet)
+{
+    auto& adapter = *routing_decision.adapter;
+    auto ipv4_payload_offset = packet.ipv4_payload_offset;
+    auto const& large_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + ipv4_payload_offset);
+    size_t const tcp_header_size = large_packet.header_size();
+    auto payload = packet.buffer->bytes().slice(ipv4_payload_offset + tcp_header_size);
+
+    // The segment size was picked for the original adapter, so it may have to shrink for this one.
+    size_t segment_size = packet.offload->segment_size;
+    size_t const max_segment_size = adapter.mtu() - sizeof(IPv4Packet) - tcp_header_size;
+    if (segment_size > max_segment_size)
+        segment_size = max_segment_size;
+
+    for (size_t offset = 0; offset < payload.size(); offset += segment_size) {
+        auto segment_payload = payload.slice(offset, min(segment_size, payload.size() - offset));
+        bool const is_last_segment = offset + segment_payload.size() == payload.size();
+
+        size_t const buffer_size = ipv4_payload_offset + tcp_header_size + segment_payload.size();
+        auto segment = adapter.acquire_packet_buffer(buffer_size);
+        if (!segment) {
+            // The rest will be sent on the next retransmit.
+            dbgln("TCPSocket: Ran out of packet buffers while segmenting a retransmit on {}", adapter.name());
+            return;
+        }
+        adapter.fill_in_ipv4_header(*segment, local_address(),
+            routing_decision.next_hop, peer_address(), TransportProtocol::TCP,
+            buffer_size - ipv4_payload_offset, type_of_service(), ttl());
+
+        auto* segment_data = segment->buffer->data() + ipv4_payload_offset;
+        memcpy(segment_data, &large_packet, tcp_header_size);
+        memcpy(segment_data + tcp_header_size, segment_payload.data(), segment_payload.size());
+
+        // Like a segmentation offload engine, only the last segment keeps PSH and FIN.
+        auto& tcp_segment = *(TCPPacket*)segment_data;
+        tcp_segment.set_sequence_number(large_packet.sequence_number() + static_cast<u32>(offset));
+        if (!is_last_segment)
+            tcp_segment.set_flags(large_packet.flags() & ~(TCPFlags::PSH | TCPFlags::FIN));
+        tcp_segment.set_checksum(0);
+        tcp_segment.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_segment, segment_payload.size()));
+
+        adapter.send_packet(segment->bytes(), {});
+        adapter.release_packet_buffer(*segment);
+        m_packets_out++;
+        m_bytes_out += buffer_size;
+    }
+}
+
 bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
 {
     if (!IPv4Socket::can_write(file_description, size))
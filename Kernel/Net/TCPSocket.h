@@ -14,6 +14,7 @@
 #include <AK/Time.h>
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
+#include <Kernel/Net/IP/IP.h>
 #include <Kernel/Net/IP/Socket.h>
 #include <Kernel/Time/TimerQueue.h>
 
@@ -172,6 +173,9 @@ public:
     virtual bool can_write(OpenFileDescription const&, u64) const override;
 
     static NetworkOrdered<u16> compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const&, u16 payload_size);
+    // For when the payload has already been summed up, e.g. while it was being copied into the packet.
+    static NetworkOrdered<u16> compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const&, u16 payload_size, InternetChecksum const& payload_checksum);
+    static NetworkOrdered<u16> compute_tcp_pseudo_header_checksum(IPv4Address const& source, IPv4Address const& destination, u16 tcp_length);
 
     virtual ErrorOr<void> setsockopt(int level, int option, Userspace<void const*>, socklen_t) override;
     virtual ErrorOr<void> getsockopt(OpenFileDescription&, int level, int option, Userspace<void*>, Userspace<socklen_t*>) override;
@@ -224,6 +228,7 @@ private:
         RefPtr<PacketWithTimestamp> buffer;
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
+        Optional<PacketOffload> offload;
         int tx_counter { 0 };
     };
 
@@ -234,6 +239,8 @@ private:
 
     MutexProtected<UnackedPackets> m_unacked_packets;
 
+    void send_packet_in_segments(RoutingDecision const&, OutgoingPacket const&);
+
     u32 m_duplicate_acks { 0 };
 
     u32 m_last_ack_number_sent { 0 };
@@ -4,8 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
+#include <Kernel/Arch/Delay.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Bus/PCI/IDs.h>
 #include <Kernel/Bus/VirtIO/Transport/PCIe/TransportLink.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Net/NetworkingManagement.h>
 #include <Kernel/Net/VirtIO/VirtIONetworkAdapter.h>
 
@@ -57,6 +61,12 @@ static constexpr u8 VIRTIO_NET_HDR_GSO_TCPV6 = 4;
 static constexpr u8 VIRTIO_NET_HDR_GSO_UDP_L4 = 5;
 static constexpr u8 VIRTIO_NET_HDR_GSO_ECN = 0x80;
 
+static constexpr u8 VIRTIO_NET_OK = 0;
+static constexpr u8 VIRTIO_NET_ERR = 1;
+
+static constexpr u8 VIRTIO_NET_CTRL_MQ = 4;
+static constexpr u8 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET = 0;
+
 struct [[gnu::packed]] VirtIONetConfig {
     u8 mac[6];
     LittleEndian<u16> status;
@@ -88,8 +98,14 @@ static constexpr u16 RECEIVEQ = 0;
 static constexpr u16 TRANSMITQ = 1;
 
 static constexpr size_t MAX_RX_FRAME_SIZE = 1514; // Non-jumbo Ethernet frame limit.
-static constexpr size_t RX_BUFFER_SIZE = sizeof(VirtIONetHdr) * MAX_RX_FRAME_SIZE;
+static constexpr size_t MAX_MERGED_PACKET_SIZE = 64 * KiB;
+static constexpr size_t TX_BUFFER_SIZE = 512 * KiB; // Has to fit a few packets for segmentation offload.
 static constexpr u16 MAX_INFLIGHT_PACKETS = 128;
+static constexpr size_t MAX_TCP_SEGMENTATION_OFFLOAD_SIZE = 65535; // Largest possible IPv4 packet.
+static constexpr size_t CONTROL_COMMAND_TIMEOUT_US = 100000;
+
+static constexpr u16 receive_queue_index(u16 queue_pair) { return 2 * queue_pair + RECEIVEQ; }
+static constexpr u16 transmit_queue_index(u16 queue_pair) { return 2 * queue_pair + TRANSMITQ; }
 
 UNMAP_AFTER_INIT ErrorOr<bool> VirtIONetworkAdapter::probe(PCI::DeviceIdentifier const& pci_device_identifier)
 {
@@ -115,9 +131,6 @@ UNMAP_AFTER_INIT VirtIONetworkAdapter::VirtIONetworkAdapter(StringView interface
 
 UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize(Badge<NetworkingManagement>)
 {
-    m_rx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Rx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
-    m_tx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
-
     return initialize_virtio_resources();
 }
 
@@ -137,30 +150,98 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize_virtio_resources
             negotiated |= VIRTIO_NET_F_SPEED_DUPLEX;
         if (is_feature_set(supported_features, VIRTIO_NET_F_MTU))
             negotiated |= VIRTIO_NET_F_MTU;
+        if (is_feature_set(supported_features, VIRTIO_NET_F_CSUM)) {
+            negotiated |= VIRTIO_NET_F_CSUM;
+            // FIXME: Also accept VIRTIO_NET_F_HOST_TSO6 once we can send TCP over IPv6.
+            if (is_feature_set(supported_features, VIRTIO_NET_F_HOST_TSO4))
+                negotiated |= VIRTIO_NET_F_HOST_TSO4;
+        }
+        if (is_feature_set(supported_features, VIRTIO_NET_F_GUEST_CSUM))
+            negotiated |= VIRTIO_NET_F_GUEST_CSUM;
+        if (is_feature_set(supported_features, VIRTIO_NET_F_MRG_RXBUF))
+            negotiated |= VIRTIO_NET_F_MRG_RXBUF;
+        if (is_feature_set(supported_features, VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ))
+            negotiated |= VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ;
         return negotiated;
     }));
 
     TRY(handle_device_config_change());
-    TRY(setup_queues(2)); // receive & transmit
+
+    u16 max_queue_pairs = 1;
+    if (is_feature_accepted(VIRTIO_NET_F_MQ))
+        max_queue_pairs = max<u16>(1, transport_entity().config_read16(*m_device_config, offsetof(VirtIONetConfig, max_virtqueue_pairs)));
+    m_queue_pair_count = min<u16>(max_queue_pairs, Processor::count());
+
+    // The control queue comes after all the queue pairs the device supports, even if we don't use all of them.
+    u16 queue_count = 2 * max_queue_pairs;
+    if (is_feature_accepted(VIRTIO_NET_F_CTRL_VQ))
+        m_control_queue_index = queue_count++;
+    TRY(setup_queues(queue_count, QueueInterrupts::PerQueue));
+
+    // With mergeable buffers, the device spreads packets that don't fit into one buffer over several of them.
+    if (is_feature_accepted(VIRTIO_NET_F_MRG_RXBUF))
+        m_rx_buffer_size = sizeof(VirtIONetHdr) + MAX_RX_FRAME_SIZE;
+    else
+        m_rx_buffer_size = sizeof(VirtIONetHdr) + max<size_t>(MAX_RX_FRAME_SIZE, sizeof(EthernetFrameHeader) + mtu());
+
+    TRY(m_receive_queues.try_ensure_capacity(m_queue_pair_count));
+    TRY(m_transmit_buffers.try_ensure_capacity(m_queue_pair_count));
+    for (u16 queue_pair = 0; queue_pair < m_queue_pair_count; ++queue_pair) {
+        ReceiveQueue receive_queue;
+        receive_queue.buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Rx buffer"sv, m_rx_buffer_size * MAX_INFLIGHT_PACKETS));
+        if (is_feature_accepted(VIRTIO_NET_F_MRG_RXBUF))
+            receive_queue.merge_buffer = TRY(KBuffer::try_create_with_size("VirtIONetworkAdapter Rx merge buffer"sv, MAX_MERGED_PACKET_SIZE));
+        m_receive_queues.unchecked_append(move(receive_queue));
+        m_transmit_buffers.unchecked_append(TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, TX_BUFFER_SIZE)));
+    }
+
+    if (m_control_queue_index.has_value())
+        m_control_buffer = TRY(MM.allocate_contiguous_kernel_region(PAGE_SIZE, "VirtIONetworkAdapter control buffer"sv, Memory::Region::Access::ReadWrite));
 
     finish_init();
 
-    {
+    for (u16 queue_pair = 0; queue_pair < m_queue_pair_count; ++queue_pair) {
         // Supply receive buffers.
-        auto& rx_queue = get_queue(RECEIVEQ);
+        auto queue_index = receive_queue_index(queue_pair);
+        auto& rx_buffers = *m_receive_queues[queue_pair].buffers;
+        auto& rx_queue = get_queue(queue_index);
         SpinlockLocker queue_lock(rx_queue.lock());
         VirtIO::QueueChain chain(rx_queue);
-        while (m_rx_buffers->available_bytes() > RX_BUFFER_SIZE) {
+        while (rx_buffers.available_bytes() >= m_rx_buffer_size && rx_queue.has_free_slots()) {
             // We know that the RingBuffer will not wraparound in this loop. But it's still awkward.
-            auto buffer_start = MUST(m_rx_buffers->reserve_space(RX_BUFFER_SIZE));
-            VERIFY(chain.add_buffer_to_chain(buffer_start, RX_BUFFER_SIZE, VirtIO::BufferType::DeviceWritable));
-            supply_chain_and_notify(RECEIVEQ, chain);
+            auto buffer_start = MUST(rx_buffers.reserve_space(m_rx_buffer_size));
+            VERIFY(chain.add_buffer_to_chain(buffer_start, m_rx_buffer_size, VirtIO::BufferType::DeviceWritable));
+            supply_chain_and_notify(queue_index, chain);
         }
     }
 
+    if (m_queue_pair_count > 1) {
+        // The device only uses the first queue pair until we tell it otherwise.
+        LittleEndian<u16> queue_pair_count = m_queue_pair_count;
+        if (auto result = send_control_command(VIRTIO_NET_CTRL_MQ, VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET, { &queue_pair_count, sizeof(queue_pair_count) }); result.is_error()) {
+            dmesgln("VirtIONetworkAdapter: Failed to enable {} queue pairs: {}", m_queue_pair_count, result.error());
+            m_queue_pair_count = 1;
+        }
+    }
+
+    dmesgln("VirtIONetworkAdapter: Using {} queue pair(s){}, checksum offload: {}, segmentation offload: {}",
+        m_queue_pair_count,
+        has_per_queue_interrupts() ? " with an interrupt each"sv : ""sv,
+        supports_checksum_offload(),
+        max_tcp_segmentation_offload_size() > 0);
     return {};
 }
 
+bool VirtIONetworkAdapter::supports_checksum_offload() const
+{
+    return is_feature_accepted(VIRTIO_NET_F_CSUM);
+}
+
+size_t VirtIONetworkAdapter::max_tcp_segmentation_offload_size() const
+{
+    return is_feature_accepted(VIRTIO_NET_F_HOST_TSO4) ? MAX_TCP_SEGMENTATION_OFFLOAD_SIZE : 0;
+}
+
 ErrorOr<void> VirtIONetworkAdapter::handle_device_config_change()
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: handle_device_config_change");
@@ -197,40 +278,120 @@ void VirtIONetworkAdapter::handle_queue_update(u16 queue_index)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: handle_queue_update {}", queue_index);
 
-    if (queue_index == RECEIVEQ) {
-        // FIXME: Disable interrupts while receiving as recommended by the spec.
-        auto& queue = get_queue(RECEIVEQ);
-        SpinlockLocker queue_lock(queue.lock());
-        size_t used;
-        VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
-
-        while (!popped_chain.is_empty()) {
-            VERIFY(popped_chain.length() == 1);
-            popped_chain.for_each([&](PhysicalAddress addr, size_t length) {
-                size_t offset = addr.as_ptr() - m_rx_buffers->start_of_region().as_ptr();
-                auto* message = reinterpret_cast<VirtIONetHdr*>(m_rx_buffers->vaddr().offset(offset).as_ptr());
-                did_receive({ message->frame, length - sizeof(VirtIONetHdr) });
-            });
-
-            supply_chain_and_notify(RECEIVEQ, popped_chain);
-            popped_chain = queue.pop_used_buffer_chain(used);
+    // Control commands are waited for synchronously.
+    if (queue_index == m_control_queue_index)
+        return;
+
+    if (queue_index / 2 >= m_receive_queues.size()) {
+        dmesgln("VirtIONetworkAdapter: unexpected update for queue {}", queue_index);
+        return;
+    }
+
+    if (queue_index % 2 == RECEIVEQ)
+        handle_receive_queue_update(queue_index);
+    else
+        handle_transmit_queue_update(queue_index);
+}
+
+static void complete_partial_checksum(Bytes frame, u16 checksum_start, u16 checksum_offset)
+{
+    if (static_cast<size_t>(checksum_start) + checksum_offset + sizeof(u16) > frame.size()) {
+        dbgln("VirtIONetworkAdapter: Partial checksum is out of bounds");
+        return;
+    }
+    // The checksum field holds the checksum of the pseudo-header, so all that's left is to sum up the rest of the packet.
+    InternetChecksum checksum;
+    checksum.add(frame.slice(checksum_start));
+    auto result = checksum.finish();
+    memcpy(frame.offset(checksum_start + checksum_offset), &result, sizeof(result));
+}
+
+void VirtIONetworkAdapter::receive_buffer(ReceiveQueue& receive_queue, Bytes buffer)
+{
+    if (receive_queue.buffers_left_to_merge == 0) {
+        if (buffer.size() < sizeof(VirtIONetHdr)) {
+            dbgln("VirtIONetworkAdapter: Received buffer is too small to hold a header ({})", buffer.size());
+            return;
         }
-    } else if (queue_index == TRANSMITQ) {
-        auto& queue = get_queue(TRANSMITQ);
-        SpinlockLocker queue_lock(queue.lock());
-        SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
-
-        size_t used;
-        VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
-        do {
-            popped_chain.for_each([this](PhysicalAddress address, size_t length) {
-                m_tx_buffers->reclaim_space(address, length);
-            });
-            popped_chain.release_buffer_slots_to_queue();
-            popped_chain = queue.pop_used_buffer_chain(used);
-        } while (!popped_chain.is_empty());
+        auto& header = *reinterpret_cast<VirtIONetHdr*>(buffer.data());
+        auto frame = buffer.slice(sizeof(VirtIONetHdr));
+        u16 buffer_count = is_feature_accepted(VIRTIO_NET_F_MRG_RXBUF) ? static_cast<u16>(header.num_buffers) : 1;
+        if (buffer_count <= 1) {
+            if (header.flags & VIRTIO_NET_HDR_F_NEEDS_CSUM)
+                complete_partial_checksum(frame, header.csum_start, header.csum_offset);
+            did_receive(frame);
+            return;
+        }
+
+        // The rest of the packet follows in the next buffers, without a header of their own.
+        receive_queue.buffers_left_to_merge = buffer_count - 1;
+        receive_queue.merged_size = 0;
+        receive_queue.merge_failed = false;
+        receive_queue.merged_packet_flags = header.flags;
+        receive_queue.merged_packet_checksum_start = header.csum_start;
+        receive_queue.merged_packet_checksum_offset = header.csum_offset;
+        buffer = frame;
     } else {
-        dmesgln("VirtIONetworkAdapter: unexpected update for queue {}", queue_index);
+        --receive_queue.buffers_left_to_merge;
+    }
+
+    auto& merge_buffer = *receive_queue.merge_buffer;
+    if (receive_queue.merged_size + buffer.size() > merge_buffer.size()) {
+        receive_queue.merge_failed = true;
+    } else {
+        memcpy(merge_buffer.data() + receive_queue.merged_size, buffer.data(), buffer.size());
+        receive_queue.merged_size += buffer.size();
+    }
+    if (receive_queue.buffers_left_to_merge > 0)
+        return;
+
+    if (receive_queue.merge_failed) {
+        dbgln("VirtIONetworkAdapter: Dropping packet that is too large to be merged");
+        return;
+    }
+    auto frame = merge_buffer.bytes().trim(receive_queue.merged_size);
+    if (receive_queue.merged_packet_flags & VIRTIO_NET_HDR_F_NEEDS_CSUM)
+        complete_partial_checksum(frame, receive_queue.merged_packet_checksum_start, receive_queue.merged_packet_checksum_offset);
+    did_receive(frame);
+}
+
+void VirtIONetworkAdapter::handle_receive_queue_update(u16 queue_index)
+{
+    // FIXME: Disable interrupts while receiving as recommended by the spec.
+    auto& receive_queue = m_receive_queues[queue_index / 2];
+    auto& queue = get_queue(queue_index);
+    SpinlockLocker queue_lock(queue.lock());
+    size_t used;
+    VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
+
+    while (!popped_chain.is_empty()) {
+        VERIFY(popped_chain.length() == 1);
+        popped_chain.for_each([&](PhysicalAddress addr, size_t length) {
+            size_t offset = addr.as_ptr() - receive_queue.buffers->start_of_region().as_ptr();
+            auto* buffer = receive_queue.buffers->vaddr().offset(offset).as_ptr();
+            receive_buffer(receive_queue, { buffer, min(used, length) });
+        });
+
+        supply_chain_and_notify(queue_index, popped_chain);
+        popped_chain = queue.pop_used_buffer_chain(used);
+    }
+}
+
+void VirtIONetworkAdapter::handle_transmit_queue_update(u16 queue_index)
+{
+    auto& tx_buffers = *m_transmit_buffers[queue_index / 2];
+    auto& queue = get_queue(queue_index);
+    SpinlockLocker queue_lock(queue.lock());
+    SpinlockLocker ringbuffer_lock(tx_buffers.lock());
+
+    size_t used;
+    VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
+    while (!popped_chain.is_empty()) {
+        popped_chain.for_each([&](PhysicalAddress address, size_t length) {
+            tx_buffers.reclaim_space(address, length);
+        });
+        popped_chain.release_buffer_slots_to_queue();
+        popped_chain = queue.pop_used_buffer_chain(used);
     }
 }
 
@@ -255,25 +416,90 @@ static bool copy_data_to_chain(VirtIO::QueueChain& chain, Memory::RingBuffer& ri
 
 void VirtIONetworkAdapter::send_raw(ReadonlyBytes payload)
 {
-    dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: send_raw length={}", payload.size());
+    VirtIONetHdr header {};
+    send_frame(header, payload);
+}
+
+void VirtIONetworkAdapter::send_raw_with_offload(ReadonlyBytes payload, PacketOffload const& offload)
+{
+    VirtIONetHdr header {};
+    header.flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+    header.csum_start = offload.checksum_start;
+    header.csum_offset = offload.checksum_offset;
+    if (offload.segment_size != 0) {
+        header.gso_type = VIRTIO_NET_HDR_GSO_TCPV4;
+        header.gso_size = offload.segment_size;
+        header.hdr_len = offload.header_size;
+    }
+    send_frame(header, payload);
+}
+
+void VirtIONetworkAdapter::send_frame(VirtIONetHdr const& header, ReadonlyBytes payload)
+{
+    dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: send_frame length={}", payload.size());
+
+    // Spread senders on different CPUs over the queue pairs, the device steers replies to the queue pair their flow was sent on.
+    u16 queue_pair = Processor::current_id() % m_queue_pair_count;
+    auto queue_index = transmit_queue_index(queue_pair);
+    auto& tx_buffers = *m_transmit_buffers[queue_pair];
 
-    auto& queue = get_queue(TRANSMITQ);
+    auto& queue = get_queue(queue_index);
     SpinlockLocker queue_lock(queue.lock());
     VirtIO::QueueChain chain(queue);
 
-    SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
-    if (m_tx_buffers->available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
+    SpinlockLocker ringbuffer_lock(tx_buffers.lock());
+    if (tx_buffers.available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
         // We can drop packets that don't fit to apply back pressure on eager senders.
         dmesgln("VirtIONetworkAdapter: not enough space in the buffer. Dropping packet");
         return;
     }
 
     // FIXME: Handle errors from pushing to the chain and rewind the RingBuffer.
-    VirtIONetHdr hdr {};
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, reinterpret_cast<u8*>(&hdr), sizeof(hdr)));
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, payload.data(), payload.size()));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, reinterpret_cast<u8 const*>(&header), sizeof(header)));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, payload.data(), payload.size()));
+
+    supply_chain_and_notify(queue_index, chain);
+}
 
-    supply_chain_and_notify(TRANSMITQ, chain);
+ErrorOr<void> VirtIONetworkAdapter::send_control_command(u8 command_class, u8 command, ReadonlyBytes data)
+{
+    VERIFY(m_control_queue_index.has_value());
+    auto queue_index = m_control_queue_index.value();
+    auto& queue = get_queue(queue_index);
+
+    // Control commands are rare enough that we just poll for them to complete.
+    queue.disable_interrupts();
+    SpinlockLocker lock(queue.lock());
+
+    size_t request_size = 2 + data.size();
+    VERIFY(request_size < PAGE_SIZE);
+    auto* request = m_control_buffer->vaddr().as_ptr();
+    request[0] = command_class;
+    request[1] = command;
+    memcpy(request + 2, data.data(), data.size());
+    auto volatile* ack = request + request_size;
+    *ack = VIRTIO_NET_ERR;
+
+    auto request_start = m_control_buffer->physical_page(0)->paddr();
+    VirtIO::QueueChain chain { queue };
+    VERIFY(chain.add_buffer_to_chain(request_start, request_size, VirtIO::BufferType::DeviceReadable));
+    VERIFY(chain.add_buffer_to_chain(request_start.offset(request_size), sizeof(u8), VirtIO::BufferType::DeviceWritable));
+    supply_chain_and_notify(queue_index, chain);
+    full_memory_barrier();
+
+    ScopeGuard clear_used_buffers([&] {
+        queue.discard_used_buffers();
+    });
+    for (size_t elapsed = 0; elapsed < CONTROL_COMMAND_TIMEOUT_US; ++elapsed) {
+        if (queue.new_data_available()) {
+            full_memory_barrier();
+            if (*ack != VIRTIO_NET_OK)
+                return EIO;
+            return {};
+        }
+        microseconds_delay(1);
+    }
+    return ETIMEDOUT;
 }
 
 }
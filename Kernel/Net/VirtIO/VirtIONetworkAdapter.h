@@ -12,6 +12,10 @@
 
 namespace Kernel {
 
+namespace VirtIO {
+struct VirtIONetHdr;
+}
+
 class VirtIONetworkAdapter
     : public VirtIO::Device
     , public NetworkAdapter {
@@ -33,6 +37,9 @@ public:
     virtual bool link_full_duplex() override { return m_link_duplex; }
     virtual i32 link_speed() override { return m_link_speed; }
 
+    virtual bool supports_checksum_offload() const override;
+    virtual size_t max_tcp_segmentation_offload_size() const override;
+
 private:
     explicit VirtIONetworkAdapter(StringView interface_name, NonnullOwnPtr<VirtIO::TransportEntity>);
 
@@ -42,6 +49,26 @@ private:
 
     // NetworkAdapter
     virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw_with_offload(ReadonlyBytes, PacketOffload const&) override;
+
+    struct ReceiveQueue {
+        OwnPtr<Memory::RingBuffer> buffers;
+
+        // Packets that the device spread over several buffers are put back together here.
+        OwnPtr<KBuffer> merge_buffer;
+        size_t merged_size { 0 };
+        u16 buffers_left_to_merge { 0 };
+        bool merge_failed { false };
+        u8 merged_packet_flags { 0 };
+        u16 merged_packet_checksum_start { 0 };
+        u16 merged_packet_checksum_offset { 0 };
+    };
+
+    void handle_receive_queue_update(u16 queue_index);
+    void handle_transmit_queue_update(u16 queue_index);
+    void receive_buffer(ReceiveQueue&, Bytes);
+    void send_frame(VirtIO::VirtIONetHdr const&, ReadonlyBytes);
+    ErrorOr<void> send_control_command(u8 command_class, u8 command, ReadonlyBytes data);
 
 private:
     VirtIO::Configuration const* m_device_config { nullptr };
@@ -52,8 +79,14 @@ private:
     i32 m_link_speed { LINKSPEED_INVALID };
     bool m_link_duplex { false };
 
-    OwnPtr<Memory::RingBuffer> m_rx_buffers;
-    OwnPtr<Memory::RingBuffer> m_tx_buffers;
+    // Queue pair N consists of receive queue 2N and transmit queue 2N + 1.
+    u16 m_queue_pair_count { 1 };
+    size_t m_rx_buffer_size { 0 };
+    Vector<ReceiveQueue> m_receive_queues;
+    Vector<NonnullOwnPtr<Memory::RingBuffer>> m_transmit_buffers;
+
+    Optional<u16> m_control_queue_index;
+    OwnPtr<Memory::Region> m_control_buffer;
 };
 
 }
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <AK/Time.h>
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/EventPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+// Events are gathered in a kernel buffer before being copied out, so cap how many a single wait returns.
+static constexpr size_t max_events_per_wait = 1024;
+
+ErrorOr<FlatPtr> Process::sys$epoll_create(int flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~EPOLL_CLOEXEC)
+        return EINVAL;
+
+    auto event_poll = TRY(EventPoll::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(event_poll)));
+    description->set_readable(true);
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description));
+
+        if (flags & EPOLL_CLOEXEC)
+            fds[fd_allocation.fd].set_flags(fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_ctl(Userspace<Syscall::SC_epoll_ctl_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    auto epoll_description = TRY(open_file_description(params.epoll_fd));
+    auto* event_poll = epoll_description->event_poll();
+    if (!event_poll)
+        return EINVAL;
+
+    auto description = TRY(open_file_description(params.fd));
+    // Regular files and directories are always ready, so watching them makes no sense.
+    if (description->is_directory() || description->file().is_regular_file())
+        return EPERM;
+
+    epoll_event event {};
+    if (params.op == EPOLL_CTL_ADD || params.op == EPOLL_CTL_MOD)
+        TRY(copy_from_user(&event, params.event));
+
+    switch (params.op) {
+    case EPOLL_CTL_ADD:
+        TRY(event_poll->add(params.fd, *description, event));
+        return 0;
+    case EPOLL_CTL_MOD:
+        TRY(event_poll->modify(params.fd, *description, event));
+        return 0;
+    case EPOLL_CTL_DEL:
+        TRY(event_poll->remove(params.fd, *description));
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_wait(Userspace<Syscall::SC_epoll_wait_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.max_events <= 0)
+        return EINVAL;
+
+    auto description = TRY(open_file_description(params.epoll_fd));
+    auto* event_poll = description->event_poll();
+    if (!event_poll)
+        return EINVAL;
+
+    // Spurious wakeups block again, so the timeout is turned into a deadline for all of them to share.
+    Optional<Duration> deadline;
+    if (params.timeout >= 0)
+        deadline = TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE) + Duration::from_milliseconds(params.timeout);
+
+    sigset_t sigmask = {};
+    if (params.sigmask)
+        TRY(copy_from_user(&sigmask, params.sigmask));
+
+    Vector<epoll_event> events;
+    TRY(events.try_resize(min(static_cast<size_t>(params.max_events), max_events_per_wait)));
+
+    auto* current_thread = Thread::current();
+
+    u32 previous_signal_mask = 0;
+    if (params.sigmask)
+        previous_signal_mask = current_thread->update_signal_mask(sigmask);
+    ScopeGuard rollback_signal_mask([&]() {
+        if (params.sigmask)
+            current_thread->update_signal_mask(previous_signal_mask);
+    });
+
+    for (;;) {
+        auto event_count = event_poll->collect_ready_events(events);
+        if (event_count > 0) {
+            TRY(copy_n_to_user(params.events, events.data(), event_count));
+            return event_count;
+        }
+
+        Thread::BlockTimeout timeout;
+        if (deadline.has_value()) {
+            if (TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE) >= *deadline)
+                return 0;
+            timeout = Thread::BlockTimeout(true, &deadline.value(), nullptr, CLOCK_MONOTONIC_COARSE);
+        }
+
+        // The EventPoll becomes readable as soon as one of its watches may be ready.
+        auto unblocked_flags = Thread::FileBlocker::BlockFlags::None;
+        auto result = current_thread->block<Thread::ReadBlocker>(timeout, *description, unblocked_flags);
+        if (!has_flag(unblocked_flags, Thread::FileBlocker::BlockFlags::Read)) {
+            if (result.was_interrupted())
+                return EINTR;
+
+            // Unblocked due to timeout.
+            return 0;
+        }
+    }
+}
+
+}
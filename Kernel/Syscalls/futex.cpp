@@ -13,23 +13,42 @@
 
 namespace Kernel {
 
-static Singleton<SpinlockProtected<HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>>, LockRank::None>> s_global_futex_queues;
+// Futex queues are spread over a fixed number of buckets, each behind its own lock, so waking and waiting
+// on unrelated futexes (e.g. in different processes) doesn't contend on a single global lock.
+static constexpr size_t futex_bucket_count = 256;
+
+struct FutexBucket {
+    HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>> queues;
+
+    // Queues of futexes that are no longer waited on are kept around, so that waiting on a futex
+    // usually doesn't have to allocate a new queue. This never grows beyond its inline capacity.
+    Vector<NonnullLockRefPtr<FutexQueue>, 4> unused_queues;
+};
+
+static Singleton<Array<SpinlockProtected<FutexBucket, LockRank::None>, futex_bucket_count>> s_futex_buckets;
+
+static SpinlockProtected<FutexBucket, LockRank::None>& futex_bucket_for(GlobalFutexKey const& futex_key)
+{
+    return (*s_futex_buckets)[Traits<GlobalFutexKey>::hash(futex_key) % futex_bucket_count];
+}
 
 void Process::clear_futex_queues_on_exec()
 {
-    s_global_futex_queues->with([this](auto& queues) {
-        auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
-        queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
-            if ((futex_key.raw.offset & futex_key_private_flag) == 0)
-                return false;
-            if (futex_key.private_.address_space != address_space)
-                return false;
-            bool did_wake_all;
-            futex_queue->wake_all(did_wake_all);
-            VERIFY(did_wake_all); // No one should be left behind...
-            return true;
+    auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
+    for (auto& bucket : *s_futex_buckets) {
+        bucket.with([address_space](auto& bucket) {
+            bucket.queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
+                if ((futex_key.raw.offset & futex_key_private_flag) == 0)
+                    return false;
+                if (futex_key.private_.address_space != address_space)
+                    return false;
+                bool did_wake_all;
+                futex_queue->wake_all(did_wake_all);
+                VERIFY(did_wake_all); // No one should be left behind...
+                return true;
+            });
         });
-    });
+    }
 }
 
 ErrorOr<GlobalFutexKey> Process::get_futex_key(FlatPtr user_address, bool shared)
@@ -126,27 +145,40 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
 
     auto find_futex_queue = [&](GlobalFutexKey futex_key, bool create_if_not_found, bool* did_create = nullptr) -> ErrorOr<LockRefPtr<FutexQueue>> {
         VERIFY(!create_if_not_found || did_create != nullptr);
-        return s_global_futex_queues->with([&](auto& queues) -> ErrorOr<LockRefPtr<FutexQueue>> {
-            auto it = queues.find(futex_key);
-            if (it != queues.end())
+        return futex_bucket_for(futex_key).with([&](auto& bucket) -> ErrorOr<LockRefPtr<FutexQueue>> {
+            auto it = bucket.queues.find(futex_key);
+            if (it != bucket.queues.end())
                 return it->value;
             if (!create_if_not_found)
                 return nullptr;
             *did_create = true;
-            auto futex_queue = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) FutexQueue));
-            auto result = TRY(queues.try_set(futex_key, futex_queue));
+            auto futex_queue = bucket.unused_queues.is_empty()
+                ? TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) FutexQueue))
+                : bucket.unused_queues.take_last();
+            auto result = TRY(bucket.queues.try_set(futex_key, futex_queue));
             VERIFY(result == AK::HashSetResult::InsertedNewEntry);
             return futex_queue;
         });
     };
 
-    auto remove_futex_queue = [&](GlobalFutexKey futex_key) {
-        return s_global_futex_queues->with([&](auto& queues) {
-            auto it = queues.find(futex_key);
-            if (it == queues.end())
+    // NOTE: This takes over the caller's reference to the queue, so that a queue nobody refers to anymore can be reused.
+    auto remove_futex_queue = [&](GlobalFutexKey futex_key, LockRefPtr<FutexQueue>&& futex_queue_reference) {
+        return futex_bucket_for(futex_key).with([&](auto& bucket) {
+            futex_queue_reference = nullptr;
+            auto it = bucket.queues.find(futex_key);
+            if (it == bucket.queues.end())
+                return;
+            if (!it->value->try_remove())
                 return;
-            if (it->value->try_remove())
-                queues.remove(it);
+            auto futex_queue = move(it->value);
+            bucket.queues.remove(it);
+
+            // Other references can only be taken while holding the bucket lock, so if the map held
+            // the last one, no other thread can get a hold of the queue anymore.
+            if (futex_queue->ref_count() == 1 && bucket.unused_queues.size() < bucket.unused_queues.capacity()) {
+                futex_queue->prepare_for_reuse();
+                bucket.unused_queues.unchecked_append(move(futex_queue));
+            }
         });
     };
 
@@ -161,7 +193,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         u32 woke_count = futex_queue->wake_n(count, bitmask, is_empty);
         if (is_empty) {
             // If there are no more waiters, we want to get rid of the futex!
-            remove_futex_queue(futex_key);
+            remove_futex_queue(futex_key, move(futex_queue));
         }
         return (int)woke_count;
     };
@@ -197,7 +229,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
 
         if (futex_queue->is_empty_and_no_imminent_waits()) {
             // If there are no more waiters, we want to get rid of the futex!
-            remove_futex_queue(futex_key);
+            remove_futex_queue(futex_key, move(futex_queue));
         }
         if (block_result == Thread::BlockResult::InterruptedByTimeout) {
             return ETIMEDOUT;
@@ -219,6 +251,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
             return 0;
 
         LockRefPtr<FutexQueue> target_futex_queue;
+        bool did_create_target = false;
         bool is_empty = false;
         bool is_target_empty = false;
         auto futex_key2 = TRY(get_futex_key(user_address2, shared));
@@ -227,14 +260,20 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
                 // NOTE: futex_queue's lock is being held while this callback is called
                 // The reason we're doing this in a callback is that we don't want to always
                 // create a target queue, only if we actually have anything to move to it!
-                target_futex_queue = TRY(find_futex_queue(futex_key2, true));
+                target_futex_queue = TRY(find_futex_queue(futex_key2, true, &did_create_target));
                 return target_futex_queue.ptr();
             },
             params.val2, is_empty, is_target_empty));
+        if (did_create_target) {
+            // A new queue expects its creator to wait on it, but we only moved existing waiters over,
+            // so drop that imminent wait now that they are in place.
+            target_futex_queue->cancel_imminent_wait();
+            is_target_empty = target_futex_queue->is_empty_and_no_imminent_waits();
+        }
         if (is_empty)
-            remove_futex_queue(futex_key);
+            remove_futex_queue(futex_key, move(futex_queue));
         if (is_target_empty && target_futex_queue)
-            remove_futex_queue(futex_key2);
+            remove_futex_queue(futex_key2, move(target_futex_queue));
         return woken_or_requeued;
     };
 
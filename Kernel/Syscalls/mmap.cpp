@@ -28,6 +28,9 @@
 
 namespace Kernel {
 
+// MAP_POPULATE reads in file-backed mappings in chunks of this many pages.
+static constexpr size_t populate_chunk_page_count = 256;
+
 ErrorOr<void> Process::validate_mmap_prot(int prot, bool map_stack, bool map_anonymous, Memory::Region const* region) const
 {
     bool make_writable = prot & PROT_WRITE;
@@ -120,6 +123,8 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
     bool map_noreserve = flags & MAP_NORESERVE;
     bool map_randomized = flags & MAP_RANDOMIZED;
     bool map_fixed_noreplace = flags & MAP_FIXED_NOREPLACE;
+    bool map_large_pages = flags & MAP_LARGE_PAGES;
+    bool map_populate = flags & MAP_POPULATE;
 
     if (map_shared && map_private)
         return EINVAL;
@@ -135,6 +140,13 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
     if (map_stack && (!map_private || !map_anonymous))
         return EINVAL;
 
+    if (map_large_pages && (!map_private || !map_anonymous))
+        return EINVAL;
+
+    // Large pages can only be used for naturally aligned parts of the mapping, so try to place it accordingly.
+    if (map_large_pages && !(map_fixed || map_fixed_noreplace) && rounded_size >= Memory::LARGE_PAGE_SIZE)
+        alignment = max(alignment, Memory::LARGE_PAGE_SIZE);
+
     Memory::VirtualRange requested_range { VirtualAddress { addr }, rounded_size };
     if (addr && !(map_fixed || map_fixed_noreplace)) {
         // If there's an address but MAP_FIXED wasn't specified, the address is just a hint.
@@ -150,6 +162,8 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
 
     if (map_anonymous) {
         auto strategy = map_noreserve ? AllocationStrategy::None : AllocationStrategy::Reserve;
+        if (map_populate)
+            strategy = AllocationStrategy::AllocateNow;
 
         if (flags & MAP_PURGEABLE) {
             vmobject = TRY(Memory::AnonymousVMObject::try_create_purgeable_with_size(rounded_size, strategy));
@@ -178,6 +192,18 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
         auto vmobject_and_memory_type = TRY(description->vmobject_for_mmap(*this, requested_range, used_offset, map_shared));
         vmobject = vmobject_and_memory_type.vmobject;
         memory_type = vmobject_and_memory_type.memory_type;
+
+        if (map_populate && vmobject->is_inode()) {
+            // Read in the file contents up front, so that the new region gets mapped with them right away.
+            // Like on other systems, this is only a best effort, so any errors are left for the page faults to report.
+            auto& inode_vmobject = static_cast<Memory::InodeVMObject&>(*vmobject);
+            auto first_page_index = static_cast<size_t>(used_offset / PAGE_SIZE);
+            auto end_page_index = min(inode_vmobject.page_count(), first_page_index + rounded_size / PAGE_SIZE);
+            for (auto page_index = first_page_index; page_index < end_page_index; page_index += populate_chunk_page_count) {
+                if (inode_vmobject.read_in_pages(page_index, min(populate_chunk_page_count, end_page_index - page_index), prot & PROT_EXEC).is_error())
+                    break;
+            }
+        }
     }
 
     return address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
@@ -209,6 +235,8 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
             region->set_shared(true);
         if (map_stack)
             region->set_stack(true);
+        if (map_large_pages)
+            region->set_wants_large_pages(true);
         if (name)
             region->set_name(move(name));
 
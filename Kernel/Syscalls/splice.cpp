@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/API/POSIX/fcntl.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+// Data is moved through a kernel buffer of this size, so it never has to be copied to and from userspace.
+static constexpr size_t transfer_buffer_size = 64 * KiB;
+
+static ErrorOr<void> wait_until_readable(OpenFileDescription& description, bool nonblocking)
+{
+    if (description.can_read())
+        return {};
+    if (nonblocking || !description.is_blocking())
+        return EAGAIN;
+
+    auto unblock_flags = BlockFlags::None;
+    if (Thread::current()->block<Thread::ReadBlocker>({}, description, unblock_flags).was_interrupted())
+        return EINTR;
+    if (!has_flag(unblock_flags, BlockFlags::Read))
+        return EAGAIN;
+    return {};
+}
+
+static ErrorOr<void> wait_until_writable(OpenFileDescription& description)
+{
+    if (description.can_write())
+        return {};
+    if (!description.is_blocking())
+        return EAGAIN;
+
+    auto unblock_flags = BlockFlags::None;
+    if (Thread::current()->block<Thread::WriteBlocker>({}, description, unblock_flags).was_interrupted())
+        return EINTR;
+    if (!has_flag(unblock_flags, BlockFlags::Write))
+        return EAGAIN;
+    return {};
+}
+
+ErrorOr<size_t> Process::do_transfer(OpenFileDescription& source, Optional<off_t> source_offset, OpenFileDescription& destination, Optional<off_t> destination_offset, size_t count, bool nonblocking)
+{
+    auto buffer = TRY(KBuffer::try_create_with_size("Transfer buffer"sv, min(count, transfer_buffer_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+
+    size_t total_transferred = 0;
+    while (total_transferred < count) {
+        // Like read(), only wait for data if nothing has been transferred yet.
+        if (auto result = wait_until_readable(source, nonblocking || total_transferred > 0); result.is_error()) {
+            if (total_transferred > 0)
+                break;
+            return result.release_error();
+        }
+
+        auto chunk_size = min(count - total_transferred, buffer->size());
+
+        // A non-seekable source can't take back data that we fail to write, so only read what the destination takes
+        // right away. Once some of it has been written, a blocking write doesn't give up on the rest.
+        if (!source.file().is_seekable()) {
+            if (auto result = wait_until_writable(destination); result.is_error()) {
+                if (total_transferred > 0)
+                    break;
+                return result.release_error();
+            }
+            if (auto space = destination.file().space_for_writing(destination); space.has_value() && !destination.is_blocking()) {
+                if (space.value() == 0) {
+                    if (total_transferred > 0)
+                        break;
+                    return EAGAIN;
+                }
+                chunk_size = min(chunk_size, space.value());
+            }
+        }
+
+        auto nread_or_error = source_offset.has_value()
+            ? source.read(kernel_buffer, source_offset.value() + total_transferred, chunk_size)
+            : source.read(kernel_buffer, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_transferred > 0)
+                break;
+            return nread_or_error.release_error();
+        }
+        auto nread = nread_or_error.release_value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = do_write(destination, kernel_buffer, nread, destination_offset.has_value() ? destination_offset.value() + total_transferred : Optional<off_t> {});
+        if (nwritten_or_error.is_error() && total_transferred == 0) {
+            if (!source_offset.has_value() && source.file().is_seekable())
+                (void)source.seek(-static_cast<off_t>(nread), SEEK_CUR);
+            return nwritten_or_error.release_error();
+        }
+        size_t nwritten = nwritten_or_error.is_error() ? 0 : nwritten_or_error.value();
+        total_transferred += nwritten;
+
+        if (nwritten < nread) {
+            // Put the file offset back to the first byte that didn't make it. Writes only fall short for a non-seekable
+            // source if the destination failed, and there is nowhere left for the data to go.
+            if (!source_offset.has_value() && source.file().is_seekable())
+                (void)source.seek(-static_cast<off_t>(nread - nwritten), SEEK_CUR);
+            break;
+        }
+    }
+    return total_transferred;
+}
+
+ErrorOr<FlatPtr> Process::sys$sendfile(Userspace<Syscall::SC_sendfile_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.count == 0)
+        return 0;
+    if (params.count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    auto in_description = TRY(open_file_description(params.in_fd));
+    if (!in_description->is_readable())
+        return EBADF;
+    if (in_description->is_directory())
+        return EISDIR;
+    auto out_description = TRY(open_file_description(params.out_fd));
+    if (!out_description->is_writable())
+        return EBADF;
+
+    Optional<off_t> offset;
+    if (params.offset) {
+        if (!in_description->file().is_seekable())
+            return ESPIPE;
+        off_t user_offset;
+        TRY(copy_from_user(&user_offset, params.offset));
+        if (user_offset < 0)
+            return EINVAL;
+        offset = user_offset;
+    }
+
+    auto nsent = TRY(do_transfer(*in_description, offset, *out_description, {}, params.count, false));
+
+    if (offset.has_value()) {
+        off_t new_offset = offset.value() + nsent;
+        TRY(copy_to_user(params.offset, &new_offset));
+    }
+    return nsent;
+}
+
+ErrorOr<FlatPtr> Process::sys$splice(Userspace<Syscall::SC_splice_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.flags & ~(SPLICE_F_MOVE | SPLICE_F_NONBLOCK | SPLICE_F_MORE | SPLICE_F_GIFT))
+        return EINVAL;
+    if (params.length == 0)
+        return 0;
+    if (params.length > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    auto in_description = TRY(open_file_description(params.in_fd));
+    if (!in_description->is_readable())
+        return EBADF;
+    auto out_description = TRY(open_file_description(params.out_fd));
+    if (!out_description->is_writable())
+        return EBADF;
+
+    // One side has to be a pipe.
+    if (!in_description->is_fifo() && !out_description->is_fifo())
+        return EINVAL;
+    if (in_description->is_directory())
+        return EISDIR;
+
+    auto copy_offset_from_user = [&](off_t* user_offset, OpenFileDescription& description) -> ErrorOr<Optional<off_t>> {
+        if (!user_offset)
+            return Optional<off_t> {};
+        if (description.is_fifo() || !description.file().is_seekable())
+            return ESPIPE;
+        off_t offset;
+        TRY(copy_from_user(&offset, user_offset));
+        if (offset < 0)
+            return EINVAL;
+        return offset;
+    };
+    auto in_offset = TRY(copy_offset_from_user(params.in_offset, *in_description));
+    auto out_offset = TRY(copy_offset_from_user(params.out_offset, *out_description));
+
+    // FIXME: SPLICE_F_NONBLOCK should also keep us from waiting for an output pipe to drain.
+    auto nspliced = TRY(do_transfer(*in_description, in_offset, *out_description, out_offset, params.length, params.flags & SPLICE_F_NONBLOCK));
+
+    if (in_offset.has_value()) {
+        off_t new_offset = in_offset.value() + nspliced;
+        TRY(copy_to_user(params.in_offset, &new_offset));
+    }
+    if (out_offset.has_value()) {
+        off_t new_offset = out_offset.value() + nspliced;
+        TRY(copy_to_user(params.out_offset, &new_offset));
+    }
+    return nspliced;
+}
+
+}
@@ -146,6 +146,13 @@ bool FutexQueue::queue_imminent_wait()
     return true;
 }
 
+void FutexQueue::cancel_imminent_wait()
+{
+    SpinlockLocker lock(m_lock);
+    VERIFY(m_imminent_waits > 0);
+    m_imminent_waits--;
+}
+
 bool FutexQueue::try_remove()
 {
     SpinlockLocker lock(m_lock);
@@ -157,4 +164,13 @@ bool FutexQueue::try_remove()
     return true;
 }
 
+void FutexQueue::prepare_for_reuse()
+{
+    SpinlockLocker lock(m_lock);
+    VERIFY(m_was_removed);
+    VERIFY(is_empty_and_no_imminent_waits_locked());
+    m_was_removed = false;
+    m_imminent_waits = 1;
+}
+
 }
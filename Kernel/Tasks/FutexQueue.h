@@ -30,8 +30,12 @@ public:
     }
 
     bool queue_imminent_wait();
+    void cancel_imminent_wait();
     bool try_remove();
 
+    // Returns a queue that was removed and is no longer referenced to its initial state, so it can be used for another futex.
+    void prepare_for_reuse();
+
     bool is_empty_and_no_imminent_waits()
     {
         SpinlockLocker lock(m_lock);
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
+#include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/WaitQueue.h>
+
+namespace Kernel {
+
+static constexpr StringView page_zeroing_task_name = "Page Zeroing Task"sv;
+
+static WaitQueue* s_page_zeroing_wait_queue;
+static Atomic<bool> s_page_zeroing_has_work { true };
+
+static void page_zeroing_task(void*)
+{
+    // Zeroing pages ahead of time is only worth it if nobody else wants the CPU.
+    Thread::current()->set_priority(THREAD_PRIORITY_LOW);
+    while (!Process::current().is_dying()) {
+        if (s_page_zeroing_has_work.exchange(false, AK::MemoryOrder::memory_order_acq_rel) == true)
+            MM.refill_zeroed_physical_page_pool();
+        else
+            s_page_zeroing_wait_queue->wait_forever(page_zeroing_task_name);
+    }
+    Process::current().sys$exit(0);
+    VERIFY_NOT_REACHED();
+}
+
+UNMAP_AFTER_INIT void PageZeroingTask::spawn()
+{
+    s_page_zeroing_wait_queue = new WaitQueue;
+    MUST(Process::create_kernel_process(page_zeroing_task_name, page_zeroing_task, nullptr));
+}
+
+void PageZeroingTask::notify()
+{
+    if (!s_page_zeroing_wait_queue)
+        return;
+    if (!s_page_zeroing_has_work.exchange(true, AK::MemoryOrder::memory_order_acq_rel))
+        s_page_zeroing_wait_queue->wake_all();
+}
+
+}
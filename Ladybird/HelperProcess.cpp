@@ -121,6 +121,8 @@ ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
         arguments.append("--use-gpu-painting"sv);
     if (web_content_options.enable_experimental_cpu_transforms == Ladybird::EnableExperimentalCPUTransforms::Yes)
         arguments.append("--experimental-cpu-transforms"sv);
+    if (web_content_options.enable_tiled_cpu_painting == Ladybird::EnableTiledCPUPainting::Yes)
+        arguments.append("--use-tiled-cpu-painting"sv);
     if (web_content_options.wait_for_debugger == Ladybird::WaitForDebugger::Yes)
         arguments.append("--wait-for-debugger"sv);
     if (web_content_options.log_all_js_exceptions == Ladybird::LogAllJSExceptions::Yes)
@@ -39,13 +39,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     StringView serenity_resource_root;
     Vector<ByteString> certificates;
     StringView mach_server_name;
+    auto& connection_limits = RequestServer::ConnectionCache::g_connection_limits;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(serenity_resource_root, "Absolute path to directory for serenity resources", "serenity-resource-root", 'r', "serenity-resource-root");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
+    args_parser.add_option(connection_limits.max_connections_per_origin, "Maximum number of connections to a single origin", "max-connections-per-origin", 0, "count");
+    args_parser.add_option(connection_limits.max_connections, "Maximum number of connections to all origins combined", "max-connections", 0, "count");
     args_parser.parse(arguments);
 
+    if (connection_limits.max_connections_per_origin == 0 || connection_limits.max_connections == 0) {
+        warnln("Connection limits must not be zero");
+        return 1;
+    }
+
     // Ensure the certificates are read out here.
     if (certificates.is_empty())
         certificates.append(TRY(find_certificates(serenity_resource_root)));
@@ -85,6 +85,7 @@ set(ILBM_DEBUG ON)
 set(IMAGE_DECODER_DEBUG ON)
 set(IMAGE_LOADER_DEBUG ON)
 set(IMAP_PARSER_DEBUG ON)
+set(IPC_DEBUG ON)
 set(INTEL_GRAPHICS_DEBUG ON)
 set(INTEL_HDA_DEBUG ON)
 set(INTERRUPT_DEBUG ON)
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Vector.h>
+#include <Kernel/Net/IP/IP.h>
+#include <LibTest/TestCase.h>
+#include <stdlib.h>
+
+using Kernel::InternetChecksum;
+
+static constexpr size_t PACKET_SIZE = 1460;
+static constexpr size_t ROUNDS = 200'000;
+
+// The scalar routine that InternetChecksum used to be, summing up one 16-bit word at a time.
+static u16 reference_checksum(ReadonlyBytes bytes)
+{
+    u32 checksum = 0;
+    for (size_t i = 0; i + 1 < bytes.size(); i += 2) {
+        checksum += (bytes[i] << 8) | bytes[i + 1];
+        if (checksum & 0x80000000)
+            checksum = (checksum & 0xffff) | (checksum >> 16);
+    }
+    if (bytes.size() % 2 == 1)
+        checksum += bytes.last() << 8;
+    while (checksum >> 16)
+        checksum = (checksum & 0xffff) + (checksum >> 16);
+    return ~checksum & 0xffff;
+}
+
+static Vector<u8> create_random_data(size_t size)
+{
+    Vector<u8> data;
+    data.resize(size);
+    for (auto& byte : data)
+        byte = static_cast<u8>(arc4random());
+    return data;
+}
+
+TEST_CASE(matches_reference)
+{
+    auto data = create_random_data(PACKET_SIZE + 8);
+    // Cover every tail length and misaligned starts.
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t size = 0; size < 64; ++size) {
+            auto bytes = data.span().slice(offset, size);
+            InternetChecksum checksum;
+            checksum.add(bytes);
+            EXPECT_EQ(static_cast<u16>(checksum.finish()), reference_checksum(bytes));
+        }
+    }
+}
+
+TEST_CASE(split_sums_match)
+{
+    auto data = create_random_data(PACKET_SIZE);
+    for (size_t split = 0; split < PACKET_SIZE; split += 2) {
+        InternetChecksum first;
+        first.add(data.span().trim(split));
+        InternetChecksum second;
+        second.add(data.span().slice(split));
+        first.add(second);
+        EXPECT_EQ(static_cast<u16>(first.finish()), reference_checksum(data.span()));
+    }
+}
+
+TEST_CASE(copy_and_add)
+{
+    auto data = create_random_data(PACKET_SIZE + 1);
+    Vector<u8> copy;
+    copy.resize(data.size());
+    InternetChecksum checksum;
+    checksum.copy_and_add(copy.data(), data.span());
+    EXPECT_EQ(copy, data);
+    EXPECT_EQ(static_cast<u16>(checksum.finish()), reference_checksum(data.span()));
+}
+
+BENCHMARK_CASE(scalar_checksum)
+{
+    auto data = create_random_data(PACKET_SIZE);
+    u16 result = 0;
+    for (size_t i = 0; i < ROUNDS; ++i)
+        result ^= reference_checksum(data.span());
+    AK::taint_for_optimizer(result);
+}
+
+BENCHMARK_CASE(wide_checksum)
+{
+    auto data = create_random_data(PACKET_SIZE);
+    u16 result = 0;
+    for (size_t i = 0; i < ROUNDS; ++i) {
+        InternetChecksum checksum;
+        checksum.add(data.span());
+        result ^= checksum.finish();
+    }
+    AK::taint_for_optimizer(result);
+}
+
+BENCHMARK_CASE(copy_then_checksum)
+{
+    auto data = create_random_data(PACKET_SIZE);
+    Array<u8, PACKET_SIZE> destination;
+    u16 result = 0;
+    for (size_t i = 0; i < ROUNDS; ++i) {
+        memcpy(destination.data(), data.data(), data.size());
+        InternetChecksum checksum;
+        checksum.add(destination.span());
+        result ^= checksum.finish();
+    }
+    AK::taint_for_optimizer(result);
+}
+
+BENCHMARK_CASE(copy_and_checksum)
+{
+    auto data = create_random_data(PACKET_SIZE);
+    Array<u8, PACKET_SIZE> destination;
+    u16 result = 0;
+    for (size_t i = 0; i < ROUNDS; ++i) {
+        InternetChecksum checksum;
+        checksum.copy_and_add(destination.data(), data.span());
+        result ^= checksum.finish();
+    }
+    AK::taint_for_optimizer(result);
+}
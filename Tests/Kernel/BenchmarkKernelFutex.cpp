@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <LibTest/TestCase.h>
+#include <pthread.h>
+
+static constexpr size_t THREAD_COUNT = 8;
+static constexpr size_t LOCKS_PER_THREAD = 100'000;
+static constexpr size_t PING_PONG_ROUNDS = 20'000;
+static constexpr size_t BROADCAST_ROUNDS = 2'000;
+
+template<typename Callback>
+static void run_on_threads(size_t thread_count, Callback callback)
+{
+    Array<pthread_t, THREAD_COUNT> threads;
+    VERIFY(thread_count <= threads.size());
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto rc = pthread_create(
+            &threads[i], nullptr, [](void* callback) -> void* {
+                (*static_cast<Callback*>(callback))();
+                return nullptr;
+            },
+            &callback);
+        VERIFY(rc == 0);
+    }
+
+    for (size_t i = 0; i < thread_count; ++i)
+        pthread_join(threads[i], nullptr);
+}
+
+// Every lock and unlock that finds the mutex contended ends up in the kernel as a futex wait or wake.
+BENCHMARK_CASE(contended_mutex)
+{
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    size_t counter = 0;
+
+    run_on_threads(THREAD_COUNT, [&] {
+        for (size_t i = 0; i < LOCKS_PER_THREAD; ++i) {
+            pthread_mutex_lock(&mutex);
+            ++counter;
+            pthread_mutex_unlock(&mutex);
+        }
+    });
+
+    EXPECT_EQ(counter, THREAD_COUNT * LOCKS_PER_THREAD);
+}
+
+// Pairs of threads that each hand a token back and forth, so that waits and wakes happen on several
+// unrelated futexes at the same time.
+BENCHMARK_CASE(condition_variable_ping_pong)
+{
+    struct Pair {
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+        pthread_cond_t condition = PTHREAD_COND_INITIALIZER;
+        size_t turn { 0 };
+    };
+    Array<Pair, THREAD_COUNT / 2> pairs;
+    Atomic<size_t> next_player { 0 };
+
+    run_on_threads(THREAD_COUNT, [&] {
+        auto player = next_player.fetch_add(1);
+        auto& pair = pairs[player / 2];
+        auto side = player % 2;
+
+        pthread_mutex_lock(&pair.mutex);
+        for (size_t round = 0; round < PING_PONG_ROUNDS; ++round) {
+            while (pair.turn % 2 != side)
+                pthread_cond_wait(&pair.condition, &pair.mutex);
+            ++pair.turn;
+            pthread_cond_signal(&pair.condition);
+        }
+        pthread_mutex_unlock(&pair.mutex);
+    });
+
+    for (auto& pair : pairs)
+        EXPECT_EQ(pair.turn, 2 * PING_PONG_ROUNDS);
+}
+
+// pthread_cond_broadcast() moves all waiters over to the mutex with FUTEX_REQUEUE.
+BENCHMARK_CASE(condition_variable_broadcast)
+{
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t condition = PTHREAD_COND_INITIALIZER;
+    size_t generation = 0;
+    size_t arrived = 0;
+
+    run_on_threads(THREAD_COUNT, [&] {
+        pthread_mutex_lock(&mutex);
+        for (size_t round = 0; round < BROADCAST_ROUNDS; ++round) {
+            auto current_generation = generation;
+            if (++arrived == THREAD_COUNT) {
+                arrived = 0;
+                ++generation;
+                pthread_cond_broadcast(&condition);
+                continue;
+            }
+            while (generation == current_generation)
+                pthread_cond_wait(&condition, &mutex);
+        }
+        pthread_mutex_unlock(&mutex);
+    });
+
+    EXPECT_EQ(generation, BROADCAST_ROUNDS);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static constexpr size_t FILE_SIZE = 32 * MiB;
+static constexpr size_t CHUNK_SIZE = 64 * KiB;
+static constexpr size_t ROUNDS = 4;
+
+static int create_test_file()
+{
+    char path[] = "/tmp/sendfile-benchmark.XXXXXX";
+    int fd = mkstemp(path);
+    VERIFY(fd >= 0);
+    unlink(path);
+
+    Array<u8, CHUNK_SIZE> chunk;
+    for (size_t i = 0; i < chunk.size(); ++i)
+        chunk[i] = static_cast<u8>(i);
+    for (size_t written = 0; written < FILE_SIZE; written += chunk.size())
+        VERIFY(write(fd, chunk.data(), chunk.size()) == static_cast<ssize_t>(chunk.size()));
+    return fd;
+}
+
+// Reads everything from the given file descriptor on another thread, so that writers never run out of buffer space.
+class Drain {
+public:
+    explicit Drain(int fd)
+        : m_fd(fd)
+    {
+        auto rc = pthread_create(
+            &m_thread, nullptr, [](void* fd) -> void* {
+                Array<u8, CHUNK_SIZE> buffer;
+                size_t total = 0;
+                for (;;) {
+                    auto nread = read(*static_cast<int*>(fd), buffer.data(), buffer.size());
+                    if (nread <= 0)
+                        break;
+                    total += nread;
+                }
+                return reinterpret_cast<void*>(total);
+            },
+            &m_fd);
+        VERIFY(rc == 0);
+    }
+
+    size_t join()
+    {
+        void* total = nullptr;
+        pthread_join(m_thread, &total);
+        return reinterpret_cast<size_t>(total);
+    }
+
+private:
+    int m_fd;
+    pthread_t m_thread;
+};
+
+template<typename Callback>
+static void run_with_socket_pair(Callback callback)
+{
+    int file_fd = create_test_file();
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        int fds[2];
+        VERIFY(socketpair(AF_LOCAL, SOCK_STREAM, 0, fds) == 0);
+        Drain drain(fds[1]);
+        callback(file_fd, fds[0]);
+        close(fds[0]);
+        EXPECT_EQ(drain.join(), FILE_SIZE);
+        close(fds[1]);
+    }
+    close(file_fd);
+}
+
+BENCHMARK_CASE(read_write_file_to_socket)
+{
+    run_with_socket_pair([](int file_fd, int socket_fd) {
+        Array<u8, CHUNK_SIZE> buffer;
+        off_t offset = 0;
+        while (static_cast<size_t>(offset) < FILE_SIZE) {
+            auto nread = pread(file_fd, buffer.data(), buffer.size(), offset);
+            VERIFY(nread > 0);
+            for (ssize_t nwritten = 0; nwritten < nread;) {
+                auto rc = write(socket_fd, buffer.data() + nwritten, nread - nwritten);
+                VERIFY(rc > 0);
+                nwritten += rc;
+            }
+            offset += nread;
+        }
+    });
+}
+
+BENCHMARK_CASE(sendfile_file_to_socket)
+{
+    run_with_socket_pair([](int file_fd, int socket_fd) {
+        off_t offset = 0;
+        while (static_cast<size_t>(offset) < FILE_SIZE) {
+            auto nsent = sendfile(socket_fd, file_fd, &offset, FILE_SIZE - offset);
+            VERIFY(nsent > 0);
+        }
+    });
+}
+
+BENCHMARK_CASE(splice_file_to_pipe)
+{
+    int file_fd = create_test_file();
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        int fds[2];
+        VERIFY(pipe(fds) == 0);
+        Drain drain(fds[0]);
+        off_t offset = 0;
+        while (static_cast<size_t>(offset) < FILE_SIZE) {
+            auto nspliced = splice(file_fd, &offset, fds[1], nullptr, FILE_SIZE - offset, 0);
+            VERIFY(nspliced > 0);
+        }
+        close(fds[1]);
+        EXPECT_EQ(drain.join(), FILE_SIZE);
+        close(fds[0]);
+    }
+    close(file_fd);
+}
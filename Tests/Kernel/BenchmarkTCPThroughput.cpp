@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Format.h>
+#include <LibTest/TestCase.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Sends data to a sink on the host, which has to be started before running the benchmark, e.g. with `nc -lk 5201 > /dev/null`.
+// Note that QEMU's user-mode networking doesn't expose checksum or segmentation offloading, use a tap backend to measure those.
+static constexpr char const* SINK_ADDRESS = "10.0.2.2";
+static constexpr u16 SINK_PORT = 5201;
+
+static constexpr size_t TRANSFER_SIZE = 256 * MiB;
+static constexpr size_t CHUNK_SIZE = 64 * KiB;
+
+BENCHMARK_CASE(tcp_send_to_host)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    VERIFY(fd >= 0);
+
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(SINK_PORT);
+    VERIFY(inet_pton(AF_INET, SINK_ADDRESS, &address.sin_addr) == 1);
+
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        warnln("Skipping, no sink listening on {}:{}", SINK_ADDRESS, SINK_PORT);
+        close(fd);
+        return;
+    }
+
+    Array<u8, CHUNK_SIZE> chunk;
+    for (size_t i = 0; i < chunk.size(); ++i)
+        chunk[i] = static_cast<u8>(i);
+
+    size_t total_sent = 0;
+    while (total_sent < TRANSFER_SIZE) {
+        auto nsent = send(fd, chunk.data(), min(chunk.size(), TRANSFER_SIZE - total_sent), 0);
+        VERIFY(nsent > 0);
+        total_sent += nsent;
+    }
+    EXPECT_EQ(total_sent, TRANSFER_SIZE);
+    close(fd);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+static void watch(int epoll_fd, int fd, u32 events, int op = EPOLL_CTL_ADD)
+{
+    epoll_event event {};
+    event.events = events;
+    event.data.fd = fd;
+    EXPECT_EQ(epoll_ctl(epoll_fd, op, fd, &event), 0);
+}
+
+TEST_CASE(level_triggered)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    EXPECT(epoll_fd >= 0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    watch(epoll_fd, pipe_fds[0], EPOLLIN);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].data.fd, pipe_fds[0]);
+    EXPECT_EQ(events[0].events, static_cast<u32>(EPOLLIN));
+
+    // The pipe is still readable, so it is reported again.
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+
+    char buffer;
+    EXPECT_EQ(read(pipe_fds[0], &buffer, 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(edge_triggered)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    watch(epoll_fd, pipe_fds[0], EPOLLIN | EPOLLET);
+
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "y", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(one_shot)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    watch(epoll_fd, pipe_fds[0], EPOLLIN | EPOLLONESHOT);
+
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(write(pipe_fds[1], "y", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    // Modifying the entry arms it again.
+    watch(epoll_fd, pipe_fds[0], EPOLLIN | EPOLLONESHOT, EPOLL_CTL_MOD);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(wait_blocks_until_ready)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    watch(epoll_fd, pipe_fds[1], EPOLLOUT);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, -1), 1);
+    EXPECT_EQ(events[0].events, static_cast<u32>(EPOLLOUT));
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(control_errors)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    epoll_event event {};
+    event.events = EPOLLIN;
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe_fds[0], &event), -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    watch(epoll_fd, pipe_fds[0], EPOLLIN);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe_fds[0], &event), -1);
+    EXPECT_EQ(errno, EEXIST);
+
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, epoll_fd, &event), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe_fds[0], nullptr), 0);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe_fds[0], nullptr), -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(closed_descriptions_are_forgotten)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    watch(epoll_fd, pipe_fds[1], EPOLLOUT);
+    close(pipe_fds[1]);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    // A new description that reuses the file descriptor can be added right away.
+    int new_pipe_fds[2];
+    EXPECT_EQ(pipe(new_pipe_fds), 0);
+    EXPECT_EQ(new_pipe_fds[0], pipe_fds[1]);
+    watch(epoll_fd, new_pipe_fds[0], EPOLLIN);
+
+    close(pipe_fds[0]);
+    close(new_pipe_fds[0]);
+    close(new_pipe_fds[1]);
+    close(epoll_fd);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/ScopeGuard.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Several fault-around windows and read-ahead batches, with a partial page at the end.
+static constexpr size_t file_size = 3 * MiB + 123;
+
+static u8 pattern_at(size_t offset)
+{
+    return static_cast<u8>((offset / PAGE_SIZE) * 7 + offset * 13);
+}
+
+static int create_test_file()
+{
+    char path[] = "/tmp/TestInodeMmap.XXXXXX";
+    int fd = mkstemp(path);
+    VERIFY(fd >= 0);
+    unlink(path);
+
+    auto buffer = MUST(ByteBuffer::create_uninitialized(file_size));
+    for (size_t offset = 0; offset < file_size; ++offset)
+        buffer[offset] = pattern_at(offset);
+
+    size_t written = 0;
+    while (written < file_size) {
+        auto nwritten = write(fd, buffer.data() + written, file_size - written);
+        VERIFY(nwritten > 0);
+        written += nwritten;
+    }
+    return fd;
+}
+
+static size_t mapping_size()
+{
+    return align_up_to(file_size, PAGE_SIZE);
+}
+
+static u8* map_file(int fd, int prot, int flags)
+{
+    auto* ptr = (u8*)mmap(nullptr, mapping_size(), prot, flags, fd, 0);
+    VERIFY(ptr != MAP_FAILED);
+    return ptr;
+}
+
+static void expect_file_contents(u8 const* ptr)
+{
+    for (size_t offset = 0; offset < file_size; ++offset) {
+        if (ptr[offset] != pattern_at(offset)) {
+            FAIL(ByteString::formatted("Byte at offset {} is {}, expected {}", offset, ptr[offset], pattern_at(offset)));
+            return;
+        }
+    }
+
+    // The rest of the last page lies past the end of the file, and reads as zeroes.
+    for (size_t offset = file_size; offset < mapping_size(); ++offset) {
+        if (ptr[offset] != 0) {
+            FAIL(ByteString::formatted("Byte at offset {} past the end of the file is {}", offset, ptr[offset]));
+            return;
+        }
+    }
+}
+
+TEST_CASE(populated_private_mapping)
+{
+    int fd = create_test_file();
+    ScopeGuard close_fd = [&] { close(fd); };
+
+    auto* ptr = map_file(fd, PROT_READ, MAP_PRIVATE | MAP_POPULATE);
+    expect_file_contents(ptr);
+    EXPECT_EQ(munmap(ptr, mapping_size()), 0);
+}
+
+TEST_CASE(populated_shared_mapping)
+{
+    int fd = create_test_file();
+    ScopeGuard close_fd = [&] { close(fd); };
+
+    auto* ptr = map_file(fd, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE);
+    expect_file_contents(ptr);
+
+    // Writes go to the page cache that was read in, so a second mapping sees them.
+    ptr[PAGE_SIZE + 1] = ~pattern_at(PAGE_SIZE + 1);
+    auto* other = map_file(fd, PROT_READ, MAP_SHARED);
+    EXPECT_EQ(other[PAGE_SIZE + 1], static_cast<u8>(~pattern_at(PAGE_SIZE + 1)));
+
+    EXPECT_EQ(munmap(other, mapping_size()), 0);
+    EXPECT_EQ(munmap(ptr, mapping_size()), 0);
+}
+
+TEST_CASE(sequential_faults_with_read_ahead)
+{
+    int fd = create_test_file();
+    ScopeGuard close_fd = [&] { close(fd); };
+
+    // Touching one page after the other is a sequential scan, which has the kernel read ahead of the faults.
+    auto* ptr = map_file(fd, PROT_READ, MAP_PRIVATE);
+    for (size_t offset = 0; offset < mapping_size(); offset += PAGE_SIZE)
+        (void)*(u8 volatile*)(ptr + offset);
+    expect_file_contents(ptr);
+    EXPECT_EQ(munmap(ptr, mapping_size()), 0);
+}
+
+TEST_CASE(scattered_faults)
+{
+    int fd = create_test_file();
+    ScopeGuard close_fd = [&] { close(fd); };
+
+    // Faults all over the place, first going backwards, then skipping around, don't look like a sequential scan.
+    auto* ptr = map_file(fd, PROT_READ, MAP_PRIVATE);
+    auto page_count = mapping_size() / PAGE_SIZE;
+    for (size_t page = page_count; page-- > 0;) {
+        if (page % 5 == 0)
+            EXPECT_EQ(ptr[page * PAGE_SIZE], pattern_at(page * PAGE_SIZE));
+    }
+    for (size_t i = 0; i < page_count; ++i) {
+        auto page = (i * 37) % page_count;
+        auto offset = page * PAGE_SIZE + (i % PAGE_SIZE);
+        if (offset < file_size)
+            EXPECT_EQ(ptr[offset], pattern_at(offset));
+    }
+    expect_file_contents(ptr);
+    EXPECT_EQ(munmap(ptr, mapping_size()), 0);
+}
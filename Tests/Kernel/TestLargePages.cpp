@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Large enough to contain at least one large page, wherever the mapping is placed.
+static constexpr size_t mapping_size = 4 * MiB;
+
+static u8* map_large_pages()
+{
+    auto* ptr = (u8*)mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_LARGE_PAGES, -1, 0);
+    VERIFY(ptr != MAP_FAILED);
+    return ptr;
+}
+
+static u8 pattern_at(size_t offset)
+{
+    // Differs from page to page as well as within a page.
+    return static_cast<u8>((offset / PAGE_SIZE) * 31 + offset);
+}
+
+static void fill_with_pattern(u8* ptr, size_t size)
+{
+    for (size_t offset = 0; offset < size; ++offset)
+        ptr[offset] = pattern_at(offset);
+}
+
+static bool has_pattern(u8 const* ptr, size_t offset, size_t size)
+{
+    for (size_t i = offset; i < offset + size; ++i) {
+        if (ptr[i] != pattern_at(i))
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE(mprotect_inside_large_page)
+{
+    auto* ptr = map_large_pages();
+    fill_with_pattern(ptr, mapping_size);
+
+    // Changing the protection of a single page breaks the large page up, which must not lose any of its contents.
+    auto middle = mapping_size / 2;
+    EXPECT_EQ(mprotect(ptr + middle, PAGE_SIZE, PROT_READ), 0);
+    EXPECT(has_pattern(ptr, 0, mapping_size));
+
+    EXPECT_EQ(mprotect(ptr + middle, PAGE_SIZE, PROT_READ | PROT_WRITE), 0);
+    ptr[middle] = ~pattern_at(middle);
+    EXPECT_EQ(ptr[middle], static_cast<u8>(~pattern_at(middle)));
+    EXPECT(has_pattern(ptr, 0, middle));
+    EXPECT(has_pattern(ptr, middle + 1, mapping_size - middle - 1));
+
+    EXPECT_EQ(munmap(ptr, mapping_size), 0);
+}
+
+TEST_CASE(partial_munmap_inside_large_page)
+{
+    auto* ptr = map_large_pages();
+    fill_with_pattern(ptr, mapping_size);
+
+    // Punch a hole in the middle, and trim both ends.
+    auto middle = mapping_size / 2;
+    EXPECT_EQ(munmap(ptr + middle, PAGE_SIZE), 0);
+    EXPECT_EQ(munmap(ptr, PAGE_SIZE), 0);
+    EXPECT_EQ(munmap(ptr + mapping_size - PAGE_SIZE, PAGE_SIZE), 0);
+
+    EXPECT(has_pattern(ptr, PAGE_SIZE, middle - PAGE_SIZE));
+    EXPECT(has_pattern(ptr, middle + PAGE_SIZE, mapping_size - middle - 2 * PAGE_SIZE));
+
+    // What remains is still writable, page by page.
+    for (size_t offset = PAGE_SIZE; offset < middle; offset += PAGE_SIZE)
+        ptr[offset] = 0;
+    EXPECT_EQ(ptr[PAGE_SIZE], 0);
+    EXPECT(has_pattern(ptr, PAGE_SIZE + 1, PAGE_SIZE - 1));
+
+    EXPECT_EQ(munmap(ptr + PAGE_SIZE, middle - PAGE_SIZE), 0);
+    EXPECT_EQ(munmap(ptr + middle + PAGE_SIZE, mapping_size - middle - 2 * PAGE_SIZE), 0);
+}
+
+TEST_CASE(large_page_copy_on_write_after_fork)
+{
+    auto* ptr = map_large_pages();
+    fill_with_pattern(ptr, mapping_size);
+
+    pid_t pid = fork();
+    VERIFY(pid != -1);
+    if (pid == 0) {
+        // The child writes to its copy, which must not be visible to the parent.
+        for (size_t offset = 0; offset < mapping_size; offset += PAGE_SIZE)
+            ptr[offset] = ~pattern_at(offset);
+        exit(has_pattern(ptr, 1, PAGE_SIZE - 1) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), EXIT_SUCCESS);
+    EXPECT(has_pattern(ptr, 0, mapping_size));
+
+    EXPECT_EQ(munmap(ptr, mapping_size), 0);
+}
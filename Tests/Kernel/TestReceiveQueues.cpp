@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/ScopeGuard.h>
+#include <LibTest/TestCase.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// Received packets are spread over one queue per CPU, each with its own worker. These tests run several flows at
+// once, and check that the packets of every flow still arrive in the order they were sent.
+
+static constexpr size_t flow_count = 8;
+
+static sockaddr_in loopback_address(u16 port)
+{
+    sockaddr_in sin {};
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(port);
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return sin;
+}
+
+static u16 bound_port(int fd)
+{
+    sockaddr_in sin {};
+    socklen_t length = sizeof(sin);
+    VERIFY(getsockname(fd, (sockaddr*)&sin, &length) == 0);
+    return ntohs(sin.sin_port);
+}
+
+static int bind_to_loopback(int type)
+{
+    int fd = socket(AF_INET, type, 0);
+    VERIFY(fd >= 0);
+    auto sin = loopback_address(0);
+    VERIFY(bind(fd, (sockaddr*)&sin, sizeof(sin)) == 0);
+    return fd;
+}
+
+static u8 pattern_at(size_t flow, size_t offset)
+{
+    return static_cast<u8>(flow * 41 + offset * 7 + offset / 253);
+}
+
+struct UDPFlow {
+    size_t index { 0 };
+    u16 receiver_port { 0 };
+};
+
+static constexpr u32 datagrams_per_flow = 2000;
+
+struct Datagram {
+    u32 flow;
+    u32 sequence_number;
+    // Varying sizes make some datagrams take longer to handle than others.
+    u8 padding[1000];
+};
+
+static void* send_udp_flow(void* argument)
+{
+    auto const& flow = *reinterpret_cast<UDPFlow const*>(argument);
+    int fd = bind_to_loopback(SOCK_DGRAM);
+    auto destination = loopback_address(flow.receiver_port);
+
+    Datagram datagram {};
+    datagram.flow = flow.index;
+    for (u32 i = 0; i < datagrams_per_flow; ++i) {
+        datagram.sequence_number = i;
+        size_t size = offsetof(Datagram, padding) + (i * 37) % sizeof(datagram.padding);
+        VERIFY(sendto(fd, &datagram, size, 0, (sockaddr*)&destination, sizeof(destination)) == static_cast<ssize_t>(size));
+    }
+
+    close(fd);
+    return nullptr;
+}
+
+TEST_CASE(udp_flows_stay_in_order)
+{
+    int receiver_fd = bind_to_loopback(SOCK_DGRAM);
+    ScopeGuard close_receiver = [&] { close(receiver_fd); };
+
+    // Datagrams may get dropped when the receiver falls behind, so stop reading once the senders have gone quiet.
+    timeval timeout { 1, 0 };
+    VERIFY(setsockopt(receiver_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0);
+
+    Array<UDPFlow, flow_count> flows;
+    Array<pthread_t, flow_count> threads;
+    for (size_t i = 0; i < flow_count; ++i) {
+        flows[i] = { i, bound_port(receiver_fd) };
+        VERIFY(pthread_create(&threads[i], nullptr, send_udp_flow, &flows[i]) == 0);
+    }
+
+    Array<i64, flow_count> last_sequence_number;
+    last_sequence_number.fill(-1);
+    size_t received = 0;
+    for (;;) {
+        Datagram datagram {};
+        auto nread = recv(receiver_fd, &datagram, sizeof(datagram), 0);
+        if (nread < 0)
+            break;
+        VERIFY(static_cast<size_t>(nread) >= offsetof(Datagram, padding));
+        VERIFY(datagram.flow < flow_count);
+
+        auto& last = last_sequence_number[datagram.flow];
+        if (static_cast<i64>(datagram.sequence_number) <= last) {
+            FAIL(ByteString::formatted("Flow {} received datagram {} after {}", datagram.flow, datagram.sequence_number, last));
+            break;
+        }
+        last = datagram.sequence_number;
+        ++received;
+    }
+
+    for (auto thread : threads)
+        VERIFY(pthread_join(thread, nullptr) == 0);
+
+    EXPECT(received > 0);
+    for (size_t i = 0; i < flow_count; ++i)
+        EXPECT(last_sequence_number[i] >= 0);
+}
+
+static constexpr size_t bytes_per_connection = 1 * MiB;
+
+struct TCPFlow {
+    size_t index { 0 };
+    u16 server_port { 0 };
+};
+
+static void* send_tcp_flow(void* argument)
+{
+    auto const& flow = *reinterpret_cast<TCPFlow const*>(argument);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    VERIFY(fd >= 0);
+    auto destination = loopback_address(flow.server_port);
+    VERIFY(connect(fd, (sockaddr*)&destination, sizeof(destination)) == 0);
+
+    u8 chunk[4096];
+    size_t sent = 0;
+    while (sent < bytes_per_connection) {
+        auto chunk_size = min(sizeof(chunk), bytes_per_connection - sent);
+        for (size_t i = 0; i < chunk_size; ++i)
+            chunk[i] = pattern_at(flow.index, sent + i);
+        auto nsent = send(fd, chunk, chunk_size, 0);
+        VERIFY(nsent > 0);
+        sent += nsent;
+    }
+
+    close(fd);
+    return nullptr;
+}
+
+TEST_CASE(tcp_connections_stay_in_order)
+{
+    int server_fd = bind_to_loopback(SOCK_STREAM);
+    ScopeGuard close_server = [&] { close(server_fd); };
+    VERIFY(listen(server_fd, flow_count) == 0);
+
+    Array<TCPFlow, flow_count> flows;
+    Array<pthread_t, flow_count> threads;
+    Array<int, flow_count> connections;
+    for (size_t i = 0; i < flow_count; ++i) {
+        flows[i] = { i, bound_port(server_fd) };
+        VERIFY(pthread_create(&threads[i], nullptr, send_tcp_flow, &flows[i]) == 0);
+
+        // Connections are accepted in order, so the flow of each one is known.
+        connections[i] = accept(server_fd, nullptr, nullptr);
+        VERIFY(connections[i] >= 0);
+    }
+
+    // Read a little from every connection in turn, so that all of them have packets in flight at the same time.
+    Array<size_t, flow_count> received;
+    received.fill(0);
+    size_t finished = 0;
+    while (finished < flow_count) {
+        for (size_t i = 0; i < flow_count; ++i) {
+            if (received[i] == bytes_per_connection)
+                continue;
+
+            u8 chunk[4096];
+            auto nread = recv(connections[i], chunk, min(sizeof(chunk), bytes_per_connection - received[i]), 0);
+            VERIFY(nread > 0);
+            for (ssize_t j = 0; j < nread; ++j) {
+                if (chunk[j] != pattern_at(i, received[i] + j)) {
+                    FAIL(ByteString::formatted("Byte at offset {} of connection {} is {}, expected {}", received[i] + j, i, chunk[j], pattern_at(i, received[i] + j)));
+                    return;
+                }
+            }
+            received[i] += nread;
+            if (received[i] == bytes_per_connection)
+                ++finished;
+        }
+    }
+
+    for (size_t i = 0; i < flow_count; ++i) {
+        VERIFY(pthread_join(threads[i], nullptr) == 0);
+        close(connections[i]);
+    }
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/ScopeGuard.h>
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static constexpr size_t file_size = 256 * KiB + 17;
+
+static u8 pattern_at(size_t offset)
+{
+    return static_cast<u8>(offset * 7 + offset / 251);
+}
+
+static int create_test_file()
+{
+    char path[] = "/tmp/TestSendfileSplice.XXXXXX";
+    int fd = mkstemp(path);
+    VERIFY(fd >= 0);
+    unlink(path);
+
+    auto buffer = MUST(ByteBuffer::create_uninitialized(file_size));
+    for (size_t offset = 0; offset < file_size; ++offset)
+        buffer[offset] = pattern_at(offset);
+    VERIFY(write(fd, buffer.data(), buffer.size()) == static_cast<ssize_t>(buffer.size()));
+    VERIFY(lseek(fd, 0, SEEK_SET) == 0);
+    return fd;
+}
+
+static void set_nonblocking(int fd)
+{
+    VERIFY(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0);
+}
+
+// Reads exactly the given number of bytes, and checks that they continue the pattern at the given offset.
+static void expect_pattern(int fd, size_t offset, size_t size)
+{
+    auto buffer = MUST(ByteBuffer::create_uninitialized(size));
+    size_t received = 0;
+    while (received < size) {
+        auto nread = read(fd, buffer.data() + received, size - received);
+        VERIFY(nread > 0);
+        received += nread;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        if (buffer[i] != pattern_at(offset + i)) {
+            FAIL(ByteString::formatted("Byte at offset {} is {}, expected {}", offset + i, buffer[i], pattern_at(offset + i)));
+            return;
+        }
+    }
+}
+
+TEST_CASE(sendfile_with_offset)
+{
+    int file_fd = create_test_file();
+    int pipe_fds[2];
+    VERIFY(pipe(pipe_fds) == 0);
+    ScopeGuard close_fds = [&] {
+        close(file_fd);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+    };
+
+    // The offset is read and updated, but the file position is left alone.
+    off_t offset = 1000;
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, &offset, 4000), 4000);
+    EXPECT_EQ(offset, 5000);
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_CUR), 0);
+    expect_pattern(pipe_fds[0], 1000, 4000);
+
+    // Past the end of the file, there is nothing left to send.
+    offset = file_size - 10;
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, &offset, 100), 10);
+    EXPECT_EQ(offset, static_cast<off_t>(file_size));
+    expect_pattern(pipe_fds[0], file_size - 10, 10);
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, &offset, 100), 0);
+}
+
+TEST_CASE(sendfile_without_offset)
+{
+    int file_fd = create_test_file();
+    int pipe_fds[2];
+    VERIFY(pipe(pipe_fds) == 0);
+    ScopeGuard close_fds = [&] {
+        close(file_fd);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+    };
+
+    // Without an offset, the file position is used and advanced.
+    EXPECT_EQ(lseek(file_fd, 300, SEEK_SET), 300);
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, nullptr, 2000), 2000);
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_CUR), 2300);
+    expect_pattern(pipe_fds[0], 300, 2000);
+}
+
+TEST_CASE(sendfile_short_write)
+{
+    int file_fd = create_test_file();
+    int socket_fds[2];
+    VERIFY(socketpair(AF_LOCAL, SOCK_STREAM, 0, socket_fds) == 0);
+    ScopeGuard close_fds = [&] {
+        close(file_fd);
+        close(socket_fds[0]);
+        close(socket_fds[1]);
+    };
+    set_nonblocking(socket_fds[0]);
+
+    // The socket buffer is much smaller than the file, so most calls only send part of what was asked for. Whatever
+    // didn't make it is left for the next call.
+    size_t sent = 0;
+    size_t received = 0;
+    bool had_short_write = false;
+    while (received < file_size) {
+        if (sent < file_size) {
+            auto nsent = sendfile(socket_fds[0], file_fd, nullptr, file_size - sent);
+            if (nsent < 0) {
+                EXPECT_EQ(errno, EAGAIN);
+                had_short_write = true;
+            } else {
+                EXPECT(nsent > 0);
+                if (static_cast<size_t>(nsent) < file_size - sent)
+                    had_short_write = true;
+                sent += nsent;
+            }
+            EXPECT_EQ(lseek(file_fd, 0, SEEK_CUR), static_cast<off_t>(sent));
+        }
+
+        // Only take part of what has been sent, so the socket stays nearly full.
+        auto to_receive = min<size_t>(sent - received, 10000);
+        expect_pattern(socket_fds[1], received, to_receive);
+        received += to_receive;
+    }
+    EXPECT(had_short_write);
+}
+
+TEST_CASE(splice_pipe_to_socket)
+{
+    int pipe_fds[2];
+    VERIFY(pipe(pipe_fds) == 0);
+    int socket_fds[2];
+    VERIFY(socketpair(AF_LOCAL, SOCK_STREAM, 0, socket_fds) == 0);
+    ScopeGuard close_fds = [&] {
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        close(socket_fds[0]);
+        close(socket_fds[1]);
+    };
+    set_nonblocking(pipe_fds[1]);
+    set_nonblocking(socket_fds[0]);
+
+    // Data taken out of a pipe can't be put back, so none of it may get lost when the socket is full.
+    static constexpr size_t total_size = 1 * MiB;
+    u8 chunk[4096];
+    size_t written = 0;
+    size_t spliced = 0;
+    size_t received = 0;
+    bool had_short_write = false;
+    while (received < total_size) {
+        while (written < total_size) {
+            auto chunk_size = min(sizeof(chunk), total_size - written);
+            for (size_t i = 0; i < chunk_size; ++i)
+                chunk[i] = pattern_at(written + i);
+            auto nwritten = write(pipe_fds[1], chunk, chunk_size);
+            if (nwritten < 0) {
+                EXPECT_EQ(errno, EAGAIN);
+                break;
+            }
+            written += nwritten;
+        }
+
+        if (spliced < written) {
+            auto nspliced = splice(pipe_fds[0], nullptr, socket_fds[0], nullptr, written - spliced, SPLICE_F_NONBLOCK);
+            if (nspliced < 0) {
+                EXPECT_EQ(errno, EAGAIN);
+                had_short_write = true;
+            } else {
+                if (static_cast<size_t>(nspliced) < written - spliced)
+                    had_short_write = true;
+                spliced += nspliced;
+            }
+        }
+
+        auto to_receive = min<size_t>(spliced - received, 10000);
+        expect_pattern(socket_fds[1], received, to_receive);
+        received += to_receive;
+    }
+    EXPECT(had_short_write);
+    EXPECT_EQ(spliced, total_size);
+}
+
+TEST_CASE(splice_file_to_pipe_with_offset)
+{
+    int file_fd = create_test_file();
+    int pipe_fds[2];
+    VERIFY(pipe(pipe_fds) == 0);
+    ScopeGuard close_fds = [&] {
+        close(file_fd);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+    };
+
+    off_t offset = 12345;
+    EXPECT_EQ(splice(file_fd, &offset, pipe_fds[1], nullptr, 3000, 0), 3000);
+    EXPECT_EQ(offset, 15345);
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_CUR), 0);
+    expect_pattern(pipe_fds[0], 12345, 3000);
+
+    // Pipes have no offset.
+    EXPECT_EQ(splice(file_fd, nullptr, pipe_fds[1], &offset, 3000, 0), -1);
+    EXPECT_EQ(errno, ESPIPE);
+}
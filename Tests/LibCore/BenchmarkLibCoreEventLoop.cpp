@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+
+// Kept well below the usual limit of 1024 open file descriptors, as each notifier watches one end of a pipe.
+static constexpr size_t NOTIFIER_COUNT = 400;
+static constexpr size_t ITERATIONS = 20'000;
+
+struct Pipes {
+    Pipes()
+    {
+        for (size_t i = 0; i < NOTIFIER_COUNT; ++i)
+            fds.append(MUST(Core::System::pipe2(O_CLOEXEC)));
+    }
+
+    ~Pipes()
+    {
+        for (auto const& pipe : fds) {
+            MUST(Core::System::close(pipe[0]));
+            MUST(Core::System::close(pipe[1]));
+        }
+    }
+
+    void write_one_byte(size_t index)
+    {
+        u8 byte = 0;
+        MUST(Core::System::write(fds[index][1], { &byte, 1 }));
+    }
+
+    void read_one_byte(size_t index)
+    {
+        u8 byte = 0;
+        MUST(Core::System::read(fds[index][0], { &byte, 1 }));
+    }
+
+    Vector<Array<int, 2>> fds;
+};
+
+// Measures how waiting for events scales with the number of notifiers, of which only one is ready at a time.
+BENCHMARK_CASE(wake_one_of_many_notifiers)
+{
+    Core::EventLoop event_loop;
+    Pipes pipes;
+
+    size_t activation_count = 0;
+    Vector<NonnullRefPtr<Core::Notifier>> notifiers;
+    for (size_t i = 0; i < NOTIFIER_COUNT; ++i) {
+        auto notifier = Core::Notifier::construct(pipes.fds[i][0], Core::Notifier::Type::Read);
+        notifier->on_activation = [&pipes, &activation_count, i] {
+            pipes.read_one_byte(i);
+            ++activation_count;
+        };
+        notifiers.append(move(notifier));
+    }
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        pipes.write_one_byte((i * 7) % NOTIFIER_COUNT);
+        event_loop.pump();
+    }
+
+    EXPECT_EQ(activation_count, ITERATIONS);
+}
+
+// Measures the cost of adding and removing notifiers while many others are registered.
+BENCHMARK_CASE(register_and_unregister_notifiers)
+{
+    Core::EventLoop event_loop;
+    Pipes pipes;
+
+    Vector<NonnullRefPtr<Core::Notifier>> notifiers;
+    for (size_t i = 0; i < NOTIFIER_COUNT; ++i)
+        notifiers.append(Core::Notifier::construct(pipes.fds[i][0], Core::Notifier::Type::Read));
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        auto& notifier = notifiers[i % NOTIFIER_COUNT];
+        notifier->set_enabled(false);
+        notifier->set_enabled(true);
+    }
+
+    event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+}
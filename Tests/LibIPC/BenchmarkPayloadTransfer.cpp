@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/MemoryStream.h>
+#include <AK/Queue.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibIPC/File.h>
+#include <LibIPC/Message.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+#include <sys/socket.h>
+
+// Whether a payload is forced through the socket, as all payloads were before large ones were passed in shared memory.
+enum class Transfer {
+    Socket,
+    Default,
+};
+
+static constexpr size_t MESSAGES_PER_SIZE = 4;
+
+static ErrorOr<void> receive_until_filled(Core::LocalSocket& socket, Bytes bytes, Queue<IPC::File>& files)
+{
+    Vector<int> received_fds;
+
+    while (!bytes.is_empty()) {
+        auto received = TRY(socket.receive_message(bytes, 0, received_fds));
+        if (received.is_empty())
+            return Error::from_string_literal("Peer disconnected");
+
+        for (auto fd : received_fds)
+            files.enqueue(IPC::File::adopt_fd(fd));
+        bytes = bytes.slice(received.size());
+    }
+
+    return {};
+}
+
+static ErrorOr<ByteBuffer> receive_payload(Core::LocalSocket& socket, Transfer transfer)
+{
+    Queue<IPC::File> files;
+
+    u32 message_size = 0;
+    TRY(receive_until_filled(socket, { &message_size, sizeof(message_size) }, files));
+
+    auto message = TRY(ByteBuffer::create_uninitialized(message_size));
+    TRY(receive_until_filled(socket, message.bytes(), files));
+
+    FixedMemoryStream stream { message.bytes() };
+    IPC::Decoder decoder { stream, files };
+
+    if (transfer == Transfer::Default)
+        return decoder.decode<ByteBuffer>();
+
+    auto payload = TRY(ByteBuffer::create_uninitialized(TRY(decoder.decode_size())));
+    TRY(decoder.decode_into(payload.bytes()));
+    return payload;
+}
+
+static ErrorOr<void> send_payload(Core::LocalSocket& socket, ByteBuffer const& payload, Transfer transfer)
+{
+    IPC::MessageBuffer buffer;
+    IPC::Encoder encoder { buffer };
+
+    if (transfer == Transfer::Default) {
+        TRY(encoder.encode(payload));
+    } else {
+        TRY(encoder.encode_size(payload.size()));
+        TRY(encoder.append(payload.data(), payload.size()));
+    }
+
+    TRY(buffer.transfer_message(socket, true));
+    return {};
+}
+
+static void transfer_payloads(size_t payload_size, Transfer transfer)
+{
+    int fds[2] {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto sender = MUST(Core::LocalSocket::adopt_fd(fds[0]));
+    IGNORE_USE_IN_ESCAPING_LAMBDA auto receiver = MUST(Core::LocalSocket::adopt_fd(fds[1]));
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA auto payload = MUST(ByteBuffer::create_uninitialized(payload_size));
+    for (size_t i = 0; i < payload_size; ++i)
+        payload[i] = static_cast<u8>(i);
+
+    auto receiver_thread = Threading::Thread::construct([&, transfer]() -> intptr_t {
+        for (size_t i = 0; i < MESSAGES_PER_SIZE; ++i) {
+            auto received_payload = receive_payload(*receiver, transfer);
+            if (received_payload.is_error() || received_payload.value() != payload)
+                return 1;
+        }
+        return 0;
+    });
+    receiver_thread->start();
+
+    for (size_t i = 0; i < MESSAGES_PER_SIZE; ++i)
+        MUST(send_payload(*sender, payload, transfer));
+
+    auto result = receiver_thread->join<intptr_t>();
+    EXPECT(!result.is_error());
+    EXPECT_EQ(result.value(), 0);
+}
+
+#define PAYLOAD_TRANSFER_BENCHMARKS(name, size)        \
+    BENCHMARK_CASE(name##_through_socket)              \
+    {                                                  \
+        transfer_payloads(size, Transfer::Socket);     \
+    }                                                  \
+    BENCHMARK_CASE(name##_with_default_transfer)       \
+    {                                                  \
+        transfer_payloads(size, Transfer::Default);    \
+    }
+
+PAYLOAD_TRANSFER_BENCHMARKS(payload_1_kib, 1 * KiB)
+PAYLOAD_TRANSFER_BENCHMARKS(payload_64_kib, 64 * KiB)
+PAYLOAD_TRANSFER_BENCHMARKS(payload_1_mib, 1 * MiB)
+PAYLOAD_TRANSFER_BENCHMARKS(payload_16_mib, 16 * MiB)
+PAYLOAD_TRANSFER_BENCHMARKS(payload_64_mib, 64 * MiB)
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/Connection.h>
+#include <LibIPC/Encoder.h>
+#include <LibIPC/Message.h>
+#include <LibIPC/Stub.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+#include <sys/socket.h>
+
+namespace {
+
+class TestStub final : public IPC::Stub {
+public:
+    virtual u32 magic() const override { return 0x7e57; }
+    virtual ByteString name() const override { return "TestStub"; }
+    virtual ErrorOr<OwnPtr<IPC::MessageBuffer>> handle(IPC::Message const&) override { return nullptr; }
+};
+
+// Collects the deferred flushes, so that the tests decide when the current pass of the "event loop" is done.
+struct CollectingDeferredInvoker final : public IPC::DeferredInvoker {
+    explicit CollectingDeferredInvoker(Vector<Function<void()>>& callbacks)
+        : callbacks(callbacks)
+    {
+    }
+
+    virtual void schedule(Function<void()> callback) override
+    {
+        callbacks.append(move(callback));
+    }
+
+    Vector<Function<void()>>& callbacks;
+};
+
+class TestConnection final : public IPC::ConnectionBase {
+    C_OBJECT(TestConnection);
+
+public:
+    static constexpr size_t max_batched_messages = MAX_BATCHED_MESSAGES;
+
+    ErrorOr<void> post(u32 value)
+    {
+        IPC::MessageBuffer buffer;
+        IPC::Encoder encoder { buffer };
+        TRY(encoder.encode(value));
+        return post_message(move(buffer), MessageKind::Async);
+    }
+
+    void run_deferred_flushes()
+    {
+        auto callbacks = move(m_deferred_callbacks);
+        for (auto& callback : callbacks)
+            callback();
+    }
+
+private:
+    TestConnection(IPC::Stub& stub, NonnullOwnPtr<Core::LocalSocket> socket)
+        : ConnectionBase(stub, move(socket), stub.magic())
+    {
+        set_deferred_invoker(make<CollectingDeferredInvoker>(m_deferred_callbacks));
+    }
+
+    virtual void try_parse_messages(Vector<u8> const&, size_t&) override { }
+
+    Vector<Function<void()>> m_deferred_callbacks;
+};
+
+struct SocketPair {
+    NonnullOwnPtr<Core::LocalSocket> sender;
+    NonnullOwnPtr<Core::LocalSocket> receiver;
+};
+
+SocketPair create_socket_pair()
+{
+    int fds[2] {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+    return { MUST(Core::LocalSocket::adopt_fd(fds[0])), MUST(Core::LocalSocket::adopt_fd(fds[1])) };
+}
+
+void receive_until_filled(Core::LocalSocket& socket, Bytes bytes)
+{
+    while (!bytes.is_empty()) {
+        auto received = MUST(socket.read_some(bytes));
+        VERIFY(!received.is_empty());
+        bytes = bytes.slice(received.size());
+    }
+}
+
+ByteBuffer receive_message(Core::LocalSocket& socket)
+{
+    u32 message_size = 0;
+    receive_until_filled(socket, { &message_size, sizeof(message_size) });
+
+    auto message = MUST(ByteBuffer::create_uninitialized(message_size));
+    receive_until_filled(socket, message.bytes());
+    return message;
+}
+
+u32 receive_value(Core::LocalSocket& socket)
+{
+    auto message = receive_message(socket);
+    VERIFY(message.size() == sizeof(u32));
+
+    u32 value = 0;
+    memcpy(&value, message.data(), sizeof(value));
+    return value;
+}
+
+bool has_pending_data(Core::LocalSocket& socket)
+{
+    return MUST(socket.can_read_without_blocking(0));
+}
+
+}
+
+TEST_CASE(batched_messages_are_sent_in_order_once_flushed)
+{
+    Core::EventLoop event_loop;
+    TestStub stub;
+    auto sockets = create_socket_pair();
+    auto connection = TestConnection::construct(stub, move(sockets.sender));
+
+    for (u32 i = 0; i < 10; ++i)
+        MUST(connection->post(i));
+    EXPECT(!has_pending_data(*sockets.receiver));
+
+    connection->run_deferred_flushes();
+    for (u32 i = 0; i < 10; ++i)
+        EXPECT_EQ(receive_value(*sockets.receiver), i);
+    EXPECT(!has_pending_data(*sockets.receiver));
+
+    EXPECT_EQ(connection->statistics().messages_sent, 10u);
+    EXPECT_EQ(connection->statistics().send_syscalls, 1u);
+}
+
+TEST_CASE(full_batch_is_sent_right_away)
+{
+    Core::EventLoop event_loop;
+    TestStub stub;
+    auto sockets = create_socket_pair();
+    auto connection = TestConnection::construct(stub, move(sockets.sender));
+
+    for (u32 i = 0; i < TestConnection::max_batched_messages + 2; ++i)
+        MUST(connection->post(i));
+
+    // The full batch is written without waiting for the deferred flush, the rest is left for it.
+    for (u32 i = 0; i < TestConnection::max_batched_messages; ++i)
+        EXPECT_EQ(receive_value(*sockets.receiver), i);
+    EXPECT(!has_pending_data(*sockets.receiver));
+
+    connection->run_deferred_flushes();
+    EXPECT_EQ(receive_value(*sockets.receiver), TestConnection::max_batched_messages);
+    EXPECT_EQ(receive_value(*sockets.receiver), TestConnection::max_batched_messages + 1);
+}
+
+TEST_CASE(messages_posted_on_other_threads_are_not_batched)
+{
+    Core::EventLoop event_loop;
+    TestStub stub;
+    auto sockets = create_socket_pair();
+    auto connection = TestConnection::construct(stub, move(sockets.sender));
+
+    MUST(connection->post(0));
+    MUST(connection->post(1));
+
+    auto thread = Threading::Thread::construct([&]() -> intptr_t {
+        return connection->post(2).is_error() ? 1 : 0;
+    });
+    thread->start();
+    EXPECT_EQ(MUST(thread->join()), 0);
+
+    // The message of the other thread is sent right away, after the ones that were already waiting.
+    EXPECT_EQ(receive_value(*sockets.receiver), 0u);
+    EXPECT_EQ(receive_value(*sockets.receiver), 1u);
+    EXPECT_EQ(receive_value(*sockets.receiver), 2u);
+    EXPECT(!has_pending_data(*sockets.receiver));
+
+    connection->run_deferred_flushes();
+    EXPECT(!has_pending_data(*sockets.receiver));
+}
+
+TEST_CASE(partially_written_batch_is_completed)
+{
+    static constexpr size_t message_count = 32;
+    static constexpr size_t message_size = 2 * KiB + 1;
+
+    auto sockets = create_socket_pair();
+    MUST(sockets.sender->set_blocking(false));
+
+    // A small send buffer makes the batch take several writes, most of which end in the middle of a message.
+    int send_buffer_size = 4 * KiB;
+    MUST(Core::System::setsockopt(sockets.sender->fd().value(), SOL_SOCKET, SO_SNDBUF, &send_buffer_size, sizeof(send_buffer_size)));
+
+    Vector<IPC::MessageBuffer> messages;
+    for (size_t i = 0; i < message_count; ++i) {
+        IPC::MessageBuffer buffer;
+        for (size_t j = 0; j < message_size; ++j) {
+            u8 byte = static_cast<u8>(i + j);
+            MUST(buffer.append_data(&byte, 1));
+        }
+        messages.append(move(buffer));
+    }
+
+    Vector<ByteBuffer> received;
+    auto receiver_thread = Threading::Thread::construct([&]() -> intptr_t {
+        for (size_t i = 0; i < message_count; ++i)
+            received.append(receive_message(*sockets.receiver));
+        return 0;
+    });
+    receiver_thread->start();
+
+    auto writes_done = MUST(IPC::MessageBuffer::transfer_messages(messages, *sockets.sender, true));
+    EXPECT(writes_done > 1);
+    (void)MUST(receiver_thread->join());
+
+    EXPECT_EQ(received.size(), message_count);
+    for (size_t i = 0; i < received.size(); ++i) {
+        EXPECT_EQ(received[i].size(), message_size);
+        for (size_t j = 0; j < received[i].size(); ++j) {
+            if (received[i][j] != static_cast<u8>(i + j)) {
+                FAIL(ByteString::formatted("Byte {} of message {} is {}, expected {}", j, i, received[i][j], static_cast<u8>(i + j)));
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/MemoryStream.h>
+#include <AK/Queue.h>
+#include <AK/String.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibIPC/File.h>
+#include <LibIPC/Message.h>
+#include <LibTest/TestCase.h>
+#include <sys/socket.h>
+
+static ErrorOr<void> receive_until_filled(Core::LocalSocket& socket, Bytes bytes, Queue<IPC::File>& files)
+{
+    Vector<int> received_fds;
+
+    while (!bytes.is_empty()) {
+        auto received = TRY(socket.receive_message(bytes, 0, received_fds));
+        if (received.is_empty())
+            return Error::from_string_literal("Peer disconnected");
+
+        for (auto fd : received_fds)
+            files.enqueue(IPC::File::adopt_fd(fd));
+        bytes = bytes.slice(received.size());
+    }
+
+    return {};
+}
+
+// Sends the value to a peer over a socket pair, and decodes it as the peer would.
+template<typename Encoded, typename Decoded = Encoded>
+static ErrorOr<Decoded> transfer(Encoded const& value)
+{
+    int fds[2] {};
+    TRY(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto sender = TRY(Core::LocalSocket::adopt_fd(fds[0]));
+    auto receiver = TRY(Core::LocalSocket::adopt_fd(fds[1]));
+
+    IPC::MessageBuffer buffer;
+    IPC::Encoder encoder { buffer };
+    TRY(encoder.encode(value));
+    TRY(buffer.transfer_message(*sender, true));
+
+    Queue<IPC::File> files;
+
+    u32 message_size = 0;
+    TRY(receive_until_filled(*receiver, { &message_size, sizeof(message_size) }, files));
+
+    auto message = TRY(ByteBuffer::create_uninitialized(message_size));
+    TRY(receive_until_filled(*receiver, message.bytes(), files));
+
+    FixedMemoryStream stream { message.bytes() };
+    IPC::Decoder decoder { stream, files };
+    return decoder.decode<Decoded>();
+}
+
+// Large payloads are passed in shared memory, which only leaves a small message to go through the socket.
+static constexpr size_t LARGE_PAYLOAD_SIZE = IPC::SHARED_MEMORY_PAYLOAD_THRESHOLD + 4 * KiB + 3;
+
+TEST_CASE(small_payloads)
+{
+    auto string = MUST(String::from_utf8("Well hello friends 😀"sv));
+    EXPECT_EQ(MUST(transfer(string)), string);
+
+    ByteString byte_string = "Well hello friends";
+    EXPECT_EQ(MUST(transfer(byte_string)), byte_string);
+
+    auto buffer = MUST(ByteBuffer::copy("\x00\x01\x02\xff"sv.bytes()));
+    EXPECT_EQ(MUST(transfer(buffer)), buffer);
+
+    EXPECT_EQ(MUST(transfer(String {})), String {});
+    EXPECT_EQ(MUST(transfer(ByteBuffer {})), ByteBuffer {});
+}
+
+TEST_CASE(large_string)
+{
+    StringBuilder builder;
+    while (builder.length() < LARGE_PAYLOAD_SIZE)
+        builder.append_code_point(0x1f600 + (builder.length() % 64));
+    auto string = MUST(builder.to_string());
+
+    auto received = MUST(transfer(string));
+    EXPECT_EQ(received.bytes().size(), string.bytes().size());
+    EXPECT_EQ(received, string);
+}
+
+TEST_CASE(large_byte_string)
+{
+    auto byte_string = ByteString::repeated('x', LARGE_PAYLOAD_SIZE);
+
+    auto received = MUST(transfer(byte_string));
+    EXPECT_EQ(received.length(), byte_string.length());
+    EXPECT_EQ(received, byte_string);
+}
+
+TEST_CASE(large_byte_buffer)
+{
+    auto buffer = MUST(ByteBuffer::create_uninitialized(LARGE_PAYLOAD_SIZE));
+    for (size_t i = 0; i < buffer.size(); ++i)
+        buffer[i] = static_cast<u8>(i * 7);
+
+    auto received = MUST(transfer(buffer));
+    EXPECT_EQ(received.size(), buffer.size());
+    EXPECT_EQ(received, buffer);
+}
+
+TEST_CASE(large_string_with_invalid_utf8)
+{
+    auto invalid = MUST(ByteBuffer::create_uninitialized(LARGE_PAYLOAD_SIZE));
+    invalid.bytes().fill('a');
+    invalid[LARGE_PAYLOAD_SIZE / 2] = 0xff;
+    auto byte_string = ByteString { invalid.bytes() };
+
+    // A ByteString is encoded the same way as a String, so decoding it as one has to validate it.
+    auto received = transfer<ByteString, String>(byte_string);
+    EXPECT(received.is_error());
+}
@@ -48,7 +48,7 @@ static void insert_into_table(SQL::Database& db, int count)
 
         row["TextColumn"] = builder.to_byte_string();
         row["IntColumn"] = ix;
-        TRY_OR_FAIL(db.insert(row));
+        MUST(db.insert(row));
     }
 }
 
@@ -219,7 +219,7 @@ TEST_CASE(reuse_row_storage)
     SQL::Row row(*table);
     row["TextColumn"] = "text value";
     row["IntColumn"] = 12345;
-    TRY_OR_FAIL(db->insert(row));
+    MUST(db->insert(row));
     TRY_OR_FAIL(db->commit());
     auto original_size_in_bytes = MUST(db->file_size_in_bytes());
 
@@ -230,7 +230,7 @@ TEST_CASE(reuse_row_storage)
     EXPECT(size_in_bytes_after_removal <= original_size_in_bytes);
 
     // Insert same row again
-    TRY_OR_FAIL(db->insert(row));
+    MUST(db->insert(row));
     TRY_OR_FAIL(db->commit());
     auto size_in_bytes_after_reinsertion = MUST(db->file_size_in_bytes());
     EXPECT(size_in_bytes_after_reinsertion <= original_size_in_bytes);
@@ -192,3 +192,34 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+TEST_CASE(heap_read_storage_with_small_page_cache_and_write_ahead_log)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    heap->set_page_cache_size(2);
+    heap->set_max_write_ahead_log_size(3);
+
+    // Write storages spanning more blocks than fit in either the write-ahead log or the page cache
+    Vector<SQL::Block::Index> storage_block_ids;
+    for (char c = 'a'; c <= 'e'; ++c) {
+        auto storage_block_id = heap->request_new_block_index();
+        StringBuilder builder;
+        MUST(builder.try_append_repeated(c, SQL::Block::DATA_SIZE * 3));
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, builder.string_view().bytes()));
+        storage_block_ids.append(storage_block_id);
+    }
+    EXPECT(heap->has_unsynced_changes());
+
+    // Read back, before and after syncing
+    for (auto pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < storage_block_ids.size(); ++i) {
+            StringBuilder builder;
+            MUST(builder.try_append_repeated('a' + i, SQL::Block::DATA_SIZE * 3));
+            auto stored_string = TRY_OR_FAIL(heap->read_storage(storage_block_ids[i]));
+            EXPECT_EQ(builder.string_view().bytes(), stored_string.bytes());
+        }
+        MUST(heap->sync());
+        EXPECT(!heap->has_unsynced_changes());
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <unistd.h>
+
+#include <AK/ScopeGuard.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/ResultSet.h>
+#include <LibSQL/StatementCache.h>
+#include <LibSQL/Value.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+constexpr char const* db_name = "/tmp/test.db";
+
+SQL::ResultSet execute(SQL::StatementCache& cache, NonnullRefPtr<SQL::Database> database, StringView sql, Vector<SQL::Value> placeholder_values = {})
+{
+    auto statement = MUST(cache.statement_for(*database, sql));
+    auto result = statement->statement()->execute(move(database), placeholder_values);
+    if (result.is_error()) {
+        outln("{}", result.release_error().error_string());
+        VERIFY_NOT_REACHED();
+    }
+    return result.release_value();
+}
+
+void create_table(SQL::StatementCache& cache, NonnullRefPtr<SQL::Database> database)
+{
+    execute(cache, database, "CREATE SCHEMA TestSchema;"sv);
+    execute(cache, database, "CREATE TABLE TestSchema.TestTable ( TextColumn text, IntColumn integer );"sv);
+}
+
+}
+
+TEST_CASE(statement_is_parsed_once)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    SQL::StatementCache cache;
+    auto first = MUST(cache.statement_for(*database, "SELECT * FROM TestSchema.TestTable;"sv));
+    EXPECT_EQ(cache.miss_count(), 1u);
+    EXPECT_EQ(cache.hit_count(), 0u);
+
+    auto second = MUST(cache.statement_for(*database, "SELECT * FROM TestSchema.TestTable;"sv));
+    EXPECT_EQ(first.ptr(), second.ptr());
+    EXPECT_EQ(first->prepare_count(), 2u);
+    EXPECT_EQ(cache.miss_count(), 1u);
+    EXPECT_EQ(cache.hit_count(), 1u);
+
+    auto other = MUST(cache.statement_for(*database, "SELECT TextColumn FROM TestSchema.TestTable;"sv));
+    EXPECT_NE(first.ptr(), other.ptr());
+    EXPECT_EQ(cache.miss_count(), 2u);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST_CASE(syntax_errors_are_not_cached)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    SQL::StatementCache cache;
+    for (auto i = 0; i < 2; ++i) {
+        auto result = cache.statement_for(*database, "SELEKT * FROM TestSchema.TestTable;"sv);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.release_error().error(), SQL::SQLErrorCode::SyntaxError);
+    }
+
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.miss_count(), 2u);
+}
+
+TEST_CASE(schema_changes_evict_statements)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    SQL::StatementCache cache;
+    create_table(cache, database);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.eviction_count(), 1u);
+
+    auto before = MUST(cache.statement_for(*database, "SELECT * FROM TestSchema.TestTable;"sv));
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.eviction_count(), 2u);
+
+    execute(cache, database, "CREATE INDEX IntIndex ON TestSchema.TestTable ( IntColumn );"sv);
+
+    auto after = MUST(cache.statement_for(*database, "SELECT * FROM TestSchema.TestTable;"sv));
+    EXPECT_NE(before.ptr(), after.ptr());
+    EXPECT_EQ(after->prepare_count(), 1u);
+    EXPECT_EQ(cache.eviction_count(), 4u);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // Data changes leave the schema, and with it the cache, alone.
+    execute(cache, database, "INSERT INTO TestSchema.TestTable VALUES ( 'T1', 1 );"sv);
+    auto again = MUST(cache.statement_for(*database, "SELECT * FROM TestSchema.TestTable;"sv));
+    EXPECT_EQ(after.ptr(), again.ptr());
+}
+
+TEST_CASE(cache_is_bounded)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    SQL::StatementCache cache(2);
+    for (auto i = 0; i < 3; ++i)
+        (void)MUST(cache.statement_for(*database, ByteString::formatted("SELECT * FROM TestSchema.TestTable{};", i)));
+    EXPECT_EQ(cache.size(), 2u);
+
+    // Statements that didn't fit are still parsed and returned, just not kept.
+    auto uncached = MUST(cache.statement_for(*database, "SELECT * FROM TestSchema.TestTable2;"sv));
+    EXPECT_EQ(uncached->prepare_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 4u);
+}
+
+TEST_CASE(placeholders_are_bound_per_execution)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    SQL::StatementCache cache;
+    create_table(cache, database);
+
+    execute(cache, database, "INSERT INTO TestSchema.TestTable VALUES ( ?, ? );"sv, { SQL::Value("T1"sv), SQL::Value(1) });
+    execute(cache, database, "INSERT INTO TestSchema.TestTable VALUES ( ?, ? );"sv, { SQL::Value("T2"sv), SQL::Value(2) });
+
+    // Both executions share the cached statement, and neither sees the other's values.
+    auto statement = MUST(cache.statement_for(*database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = ?;"sv));
+    auto first = MUST(statement->statement()->execute(database, Vector { SQL::Value(1) }));
+    auto second = MUST(statement->statement()->execute(database, Vector { SQL::Value(2) }));
+
+    EXPECT_EQ(first.size(), 1u);
+    EXPECT_EQ(first[0].row[0], "T1"sv);
+    EXPECT_EQ(second.size(), 1u);
+    EXPECT_EQ(second[0].row[0], "T2"sv);
+
+    first = MUST(statement->statement()->execute(database, Vector { SQL::Value(1) }));
+    EXPECT_EQ(first[0].row[0], "T1"sv);
+}
+
+TEST_CASE(execution_statistics)
+{
+    SQL::CachedStatement statement(make_ref_counted<SQL::AST::ErrorStatement>());
+    EXPECT_EQ(statement.execution_count(), 0u);
+    EXPECT_EQ(statement.average_execution_time(), Duration {});
+
+    statement.record_execution(Duration::from_milliseconds(10));
+    statement.record_execution(Duration::from_milliseconds(30));
+    EXPECT_EQ(statement.execution_count(), 2u);
+    EXPECT_EQ(statement.total_execution_time(), Duration::from_milliseconds(40));
+    EXPECT_EQ(statement.average_execution_time(), Duration::from_milliseconds(20));
+    EXPECT_EQ(statement.max_execution_time(), Duration::from_milliseconds(30));
+}
@@ -384,6 +384,51 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_byte_string(), "Test_12");
 }
 
+TEST_CASE(select_join_with_filters)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+
+    for (auto count = 0; count < 100; ++count) {
+        auto result = execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable1 VALUES ( 'T{}', {} );", count, count));
+        EXPECT_EQ(result.size(), 1u);
+
+        result = execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable2 VALUES ( 'U{}', {} );", count, count % 10));
+        EXPECT_EQ(result.size(), 1u);
+    }
+
+    auto result = execute(database,
+        "SELECT TestTable1.IntColumn, TestTable2.IntColumn FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable1.IntColumn = TestTable2.IntColumn;");
+    EXPECT_EQ(result.size(), 100u);
+    for (auto& row : result) {
+        EXPECT_EQ(row.row[0], row.row[1]);
+        EXPECT(row.row[0].to_int<i32>().value() < 10);
+    }
+
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TextColumn2 = 'U13' AND TestTable2.IntColumn = TestTable1.IntColumn;");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0], "T3"sv);
+    EXPECT_EQ(result[0].row[1], "U13"sv);
+
+    result = execute(database,
+        "SELECT TextColumn1 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable1.IntColumn < 2 AND TestTable1.IntColumn < TestTable2.IntColumn;");
+    EXPECT_EQ(result.size(), 170u);
+
+    result = execute(database,
+        "SELECT TextColumn1 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable1.IntColumn = TestTable2.IntColumn AND TextColumn1 = TextColumn2;");
+    EXPECT(result.is_empty());
+
+    result = execute(database, "SELECT TextColumn1, TextColumn2 FROM TestSchema.TestTable1, TestSchema.TestTable2 LIMIT 5 OFFSET 3;");
+    EXPECT_EQ(result.size(), 5u);
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -634,6 +679,39 @@ TEST_CASE(select_with_order_limit_and_offset)
     EXPECT_EQ(result[9].row[1].to_int<i32>(), 19);
 }
 
+TEST_CASE(select_with_descending_order_and_limit)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    for (auto count = 0; count < 100; count++) {
+        auto result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_{}', {} );", count, (count * 37) % 50));
+        EXPECT(result.size() == 1);
+    }
+
+    // Each IntColumn value occurs twice, rows with equal values are returned in the order they were inserted.
+    auto result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn DESC LIMIT 5;");
+    EXPECT_EQ(result.size(), 5u);
+    EXPECT_EQ(result[0].row[1].to_int<i32>(), 49);
+    EXPECT_EQ(result[1].row[1].to_int<i32>(), 49);
+    EXPECT_EQ(result[2].row[1].to_int<i32>(), 48);
+    EXPECT_EQ(result[3].row[1].to_int<i32>(), 48);
+    EXPECT_EQ(result[4].row[1].to_int<i32>(), 47);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "Test_27");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "Test_77");
+
+    result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn DESC LIMIT 3 OFFSET 97;");
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].row[1].to_int<i32>(), 1);
+    EXPECT_EQ(result[1].row[1].to_int<i32>(), 0);
+    EXPECT_EQ(result[2].row[1].to_int<i32>(), 0);
+
+    result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn DESC LIMIT 0;");
+    EXPECT(result.is_empty());
+}
+
 TEST_CASE(select_with_limit_out_of_bounds)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -1060,4 +1138,204 @@ TEST_CASE(update_all_rows)
     }
 }
 
+TEST_CASE(select_using_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        create_table(database);
+        for (auto count = 0; count < 100; ++count) {
+            auto result = execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count, count));
+            EXPECT_EQ(result.size(), 1u);
+        }
+
+        auto result = execute(database, "EXPLAIN SELECT * FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Explain);
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "SCAN TESTTABLE"sv);
+
+        result = execute(database, "CREATE INDEX IntIndex ON TestSchema.TestTable ( IntColumn );");
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+        result = execute(database, "EXPLAIN QUERY PLAN SELECT * FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "SEARCH TESTTABLE USING INDEX INTINDEX (INTCOLUMN=?)"sv);
+
+        result = execute(database, "EXPLAIN SELECT * FROM TestSchema.TestTable WHERE 10 <= IntColumn AND IntColumn < 20;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "SEARCH TESTTABLE USING INDEX INTINDEX (INTCOLUMN>=? AND INTCOLUMN<?)"sv);
+
+        result = execute(database, "EXPLAIN SELECT * FROM TestSchema.TestTable WHERE TextColumn = 'T42';");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "SCAN TESTTABLE"sv);
+
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "T42"sv);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn > 10 AND IntColumn <= 20 ORDER BY IntColumn;");
+        EXPECT_EQ(result.size(), 10u);
+        for (auto i = 0u; i < result.size(); ++i)
+            EXPECT_EQ(result[i].row[0], i + 11);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn = ?;", placeholders(73));
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], 73);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn = 1000;");
+        EXPECT(result.is_empty());
+    }
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        auto result = execute(database, "EXPLAIN SELECT * FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "SEARCH TESTTABLE USING INDEX INTINDEX (INTCOLUMN=?)"sv);
+
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "T42"sv);
+
+        auto create_result = try_execute(database, "CREATE INDEX IntIndex ON TestSchema.TestTable ( IntColumn );");
+        EXPECT(create_result.is_error());
+        EXPECT_EQ(create_result.release_error().error(), SQL::SQLErrorCode::IndexExists);
+
+        execute(database, "CREATE INDEX IF NOT EXISTS IntIndex ON TestSchema.TestTable ( IntColumn );");
+    }
+}
+
+TEST_CASE(select_using_multi_column_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    create_table(database);
+    for (auto count = 0; count < 50; ++count) {
+        auto result = execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count % 5, count));
+        EXPECT_EQ(result.size(), 1u);
+    }
+
+    execute(database, "CREATE INDEX TextIntIndex ON TestSchema.TestTable ( TextColumn, IntColumn );");
+
+    auto result = execute(database, "EXPLAIN SELECT * FROM TestSchema.TestTable WHERE IntColumn > 20 AND TextColumn = 'T3';");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0], "SEARCH TESTTABLE USING INDEX TEXTINTINDEX (TEXTCOLUMN=? AND INTCOLUMN>?)"sv);
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn > 20 AND TextColumn = 'T3' ORDER BY IntColumn;");
+    EXPECT_EQ(result.size(), 6u);
+    for (auto i = 0u; i < result.size(); ++i)
+        EXPECT_EQ(result[i].row[0], 23 + (i * 5));
+
+    // Only the leading key parts of an index can be searched for.
+    result = execute(database, "EXPLAIN SELECT * FROM TestSchema.TestTable WHERE IntColumn = 20;");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0], "SCAN TESTTABLE"sv);
+}
+
+TEST_CASE(index_is_maintained_by_update_and_delete)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        create_table(database);
+        execute(database, "CREATE INDEX IntIndex ON TestSchema.TestTable ( IntColumn );");
+        for (auto count = 0; count < 20; ++count) {
+            auto result = execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count, count));
+            EXPECT_EQ(result.size(), 1u);
+        }
+
+        execute(database, "UPDATE TestSchema.TestTable SET IntColumn=100 WHERE IntColumn = 5;");
+        execute(database, "DELETE FROM TestSchema.TestTable WHERE IntColumn > 15;");
+
+        auto result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn = 5;");
+        EXPECT(result.is_empty());
+
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 100;");
+        EXPECT(result.is_empty());
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn >= 0 ORDER BY IntColumn;");
+        EXPECT_EQ(result.size(), 15u);
+
+        execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T100', 100 );");
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 100;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "T100"sv);
+    }
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        auto result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn >= 0 ORDER BY IntColumn;");
+        EXPECT_EQ(result.size(), 16u);
+
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 10;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0], "T10"sv);
+    }
+}
+
+TEST_CASE(unique_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    create_table(database);
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T1', 1 ), ( 'T2', 2 ), ( 'T2', 3 );");
+
+    auto result = try_execute(database, "CREATE UNIQUE INDEX TextIndex ON TestSchema.TestTable ( TextColumn );");
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.release_error().error(), SQL::SQLErrorCode::UniqueConstraintViolated);
+
+    execute(database, "CREATE UNIQUE INDEX IntIndex ON TestSchema.TestTable ( IntColumn );");
+
+    result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T4', 2 );");
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.release_error().error(), SQL::SQLErrorCode::UniqueConstraintViolated);
+
+    result = try_execute(database, "UPDATE TestSchema.TestTable SET IntColumn=1 WHERE IntColumn = 3;");
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.release_error().error(), SQL::SQLErrorCode::UniqueConstraintViolated);
+
+    // A key that was previously in use by an updated row can be used again.
+    execute(database, "UPDATE TestSchema.TestTable SET IntColumn=4 WHERE IntColumn = 3;");
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T3', 3 );");
+
+    auto select_result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable ORDER BY IntColumn;");
+    EXPECT_EQ(select_result.size(), 4u);
+    for (auto i = 0u; i < select_result.size(); ++i)
+        EXPECT_EQ(select_result[i].row[0], i + 1);
+}
+
+TEST_CASE(index_keeps_large_integers_apart)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    create_table(database);
+
+    // These two are the same number once converted to a double.
+    static constexpr i64 large_value = 1ll << 53;
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( ?, ? );", placeholders("T1"sv, large_value));
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( ?, ? );", placeholders("T2"sv, large_value + 1));
+
+    execute(database, "CREATE UNIQUE INDEX IntIndex ON TestSchema.TestTable ( IntColumn );");
+
+    auto result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = ?;", placeholders(large_value + 1));
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0], "T2"sv);
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn > 2.5 ORDER BY IntColumn;");
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].row[0], "T1"sv);
+    EXPECT_EQ(result[1].row[0], "T2"sv);
+}
+
 }
@@ -126,6 +126,43 @@ TEST_CASE(create_table)
     validate("CREATE TABLE test ( column1 varchar(1e3) );"sv, {}, "TEST"sv, { { "COLUMN1"sv, "VARCHAR"sv, { 1000 } } });
 }
 
+TEST_CASE(create_index)
+{
+    EXPECT(parse("CREATE INDEX"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON table_name"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON table_name ();"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON table_name ( column1"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name table_name ( column1 );"sv).is_error());
+    EXPECT(parse("CREATE INDEX IF index_name ON table_name ( column1 );"sv).is_error());
+    EXPECT(parse("CREATE INDEX IF NOT index_name ON table_name ( column1 );"sv).is_error());
+    EXPECT(parse("CREATE UNIQUE index_name ON table_name ( column1 );"sv).is_error());
+
+    auto validate = [](StringView sql, StringView expected_schema, StringView expected_index, StringView expected_table, Vector<StringView> expected_columns, bool expected_is_unique = false, bool expected_is_error_if_index_exists = true) {
+        auto statement = TRY_OR_FAIL(parse(sql));
+        EXPECT(is<SQL::AST::CreateIndex>(*statement));
+
+        auto const& index = static_cast<const SQL::AST::CreateIndex&>(*statement);
+        EXPECT_EQ(index.schema_name(), expected_schema);
+        EXPECT_EQ(index.index_name(), expected_index);
+        EXPECT_EQ(index.table_name(), expected_table);
+        EXPECT_EQ(index.is_unique(), expected_is_unique);
+        EXPECT_EQ(index.is_error_if_index_exists(), expected_is_error_if_index_exists);
+
+        auto const& columns = index.column_names();
+        EXPECT_EQ(columns.size(), expected_columns.size());
+        for (size_t i = 0; i < columns.size(); ++i)
+            EXPECT_EQ(columns[i], expected_columns[i]);
+    };
+
+    validate("CREATE INDEX index_name ON table_name ( column1 );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { "COLUMN1"sv });
+    validate("CREATE INDEX schema_name.index_name ON table_name ( column1 );"sv, "SCHEMA_NAME"sv, "INDEX_NAME"sv, "TABLE_NAME"sv, { "COLUMN1"sv });
+    validate("CREATE INDEX index_name ON table_name ( column1, column2 ASC );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { "COLUMN1"sv, "COLUMN2"sv });
+    validate("CREATE UNIQUE INDEX index_name ON table_name ( column1 );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { "COLUMN1"sv }, true);
+    validate("CREATE INDEX IF NOT EXISTS index_name ON table_name ( column1 );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { "COLUMN1"sv }, false, false);
+}
+
 TEST_CASE(alter_table)
 {
     // This test case only contains common error cases of the AlterTable subclasses.
@@ -783,3 +820,25 @@ TEST_CASE(describe_table)
     validate("DESCRIBE TABLE TableName;"sv, {}, "TABLENAME"sv);
     validate("DESCRIBE TABLE SchemaName.TableName;"sv, "SCHEMANAME"sv, "TABLENAME"sv);
 }
+
+TEST_CASE(explain)
+{
+    EXPECT(parse("EXPLAIN"sv).is_error());
+    EXPECT(parse("EXPLAIN;"sv).is_error());
+    EXPECT(parse("EXPLAIN QUERY SELECT * FROM table_name;"sv).is_error());
+    EXPECT(parse("EXPLAIN QUERY PLAN;"sv).is_error());
+    EXPECT(parse("EXPLAIN DESCRIBE TABLE table_name;"sv).is_error());
+
+    auto validate = [](StringView sql, StringView expected_table) {
+        auto statement = TRY_OR_FAIL(parse(sql));
+        EXPECT(is<SQL::AST::Explain>(*statement));
+
+        auto const& explain = static_cast<const SQL::AST::Explain&>(*statement);
+        auto const& table_or_subquery_list = explain.select_statement()->table_or_subquery_list();
+        EXPECT_EQ(table_or_subquery_list.size(), 1u);
+        EXPECT_EQ(table_or_subquery_list[0]->table_name(), expected_table);
+    };
+
+    validate("EXPLAIN SELECT * FROM table_name;"sv, "TABLE_NAME"sv);
+    validate("EXPLAIN QUERY PLAN SELECT * FROM table_name WHERE column1 = 1;"sv, "TABLE_NAME"sv);
+}
@@ -633,6 +633,27 @@ TEST_CASE(order_int_values)
     EXPECT(v2 > v1);
 }
 
+TEST_CASE(order_mixed_numeric_values)
+{
+    SQL::Value v1(3);
+    SQL::Value v2(2.5);
+    EXPECT(v2 < v1);
+    EXPECT(v1 > v2);
+    EXPECT_EQ(v1.compare(SQL::Value(3.0)), 0);
+    EXPECT_EQ(SQL::Value(3.0).compare(v1), 0);
+
+    // 2^53 + 1 can't be represented as a double, and mustn't compare equal to 2^53.
+    SQL::Value large_int((1ll << 53) + 1);
+    SQL::Value large_float(static_cast<double>(1ll << 53));
+    EXPECT(large_int > large_float);
+    EXPECT(large_float < large_int);
+
+    SQL::Value large_uint(NumericLimits<u64>::max());
+    EXPECT(large_uint < SQL::Value(0x1p64));
+    EXPECT(SQL::Value(-1) < SQL::Value(-0.5));
+    EXPECT(SQL::Value(0) > SQL::Value(-0.5));
+}
+
 TEST_CASE(tuple)
 {
     NonnullRefPtr<SQL::TupleDescriptor> descriptor = adopt_ref(*new SQL::TupleDescriptor);
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Matrix4x4.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayListPlayerCPU.h>
+#include <LibWeb/Painting/DisplayListRecorder.h>
+#include <LibWeb/Painting/TiledDisplayListPlayerCPU.h>
+
+using namespace Web::Painting;
+
+static constexpr Gfx::IntSize viewport_size { 200, 150 };
+// Small tiles, so that most commands straddle several of them.
+static constexpr int tile_size = 32;
+
+static Web::Painting::DisplayListRecorder::PushStackingContextParams stacking_context_params(float opacity, Gfx::IntRect source_paintable_rect, Gfx::FloatPoint translation)
+{
+    return {
+        .opacity = opacity,
+        .is_fixed_position = false,
+        .source_paintable_rect = source_paintable_rect,
+        .image_rendering = Web::CSS::ImageRendering::Auto,
+        .transform = {
+            .origin = {},
+            .matrix = Gfx::translation_matrix(Gfx::FloatVector3 { translation.x(), translation.y(), 0 }),
+        },
+    };
+}
+
+static void record_scene(DisplayListRecorder& recorder, Color moving_rect_color)
+{
+    recorder.fill_rect({ 0, 0, 200, 150 }, Color::White);
+    recorder.fill_rect({ 10, 10, 100, 50 }, Color::Red);
+    recorder.fill_rect({ 150, 100, 30, 30 }, moving_rect_color);
+    recorder.draw_rect({ 20, 70, 90, 40 }, Color::Blue);
+    recorder.draw_line({ 0, 0 }, { 199, 149 }, Color::Green, 3);
+    recorder.draw_line({ 5, 140 }, { 190, 20 }, Color::Magenta);
+    recorder.fill_ellipse({ 60, 40, 70, 50 }, Color::Cyan);
+
+    // A translated stacking context is binned command by command.
+    recorder.push_stacking_context(stacking_context_params(1.0f, { 0, 0, 80, 80 }, { 90, 30 }));
+    recorder.fill_rect({ 0, 0, 40, 40 }, Color::Yellow);
+    recorder.draw_line({ 0, 40 }, { 70, 10 }, Color::Black, 2);
+    recorder.pop_stacking_context();
+
+    // A translucent one is painted through an intermediate bitmap, and binned as a unit.
+    recorder.push_stacking_context(stacking_context_params(0.5f, { 30, 20, 120, 90 }, {}));
+    recorder.fill_rect({ 30, 20, 120, 90 }, Color::DarkBlue);
+    recorder.pop_stacking_context();
+
+    recorder.save();
+    recorder.add_clip_rect({ 100, 60, 70, 70 });
+    recorder.fill_ellipse({ 80, 50, 120, 100 }, Color::from_rgb(0xff8000));
+    recorder.restore();
+}
+
+static NonnullRefPtr<Gfx::Bitmap> create_target()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, viewport_size));
+    bitmap->fill(Color::Transparent);
+    return bitmap;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> rasterize_serially(Color moving_rect_color)
+{
+    DisplayList display_list;
+    DisplayListRecorder recorder(display_list);
+    record_scene(recorder, moving_rect_color);
+
+    auto target = create_target();
+    DisplayListPlayerCPU player(*target);
+    display_list.execute(player);
+    return target;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> rasterize_tiled(TiledDisplayListPlayerCPU& player, Color moving_rect_color)
+{
+    DisplayList display_list;
+    DisplayListRecorder recorder(display_list);
+    record_scene(recorder, moving_rect_color);
+
+    auto target = create_target();
+    player.execute(display_list, *target);
+    return target;
+}
+
+static void expect_same_pixels(Gfx::Bitmap const& expected, Gfx::Bitmap const& actual)
+{
+    for (int y = 0; y < expected.height(); ++y) {
+        for (int x = 0; x < expected.width(); ++x) {
+            if (expected.get_pixel(x, y) != actual.get_pixel(x, y)) {
+                FAIL(ByteString::formatted("Pixel at {},{} is {}, expected {}", x, y, actual.get_pixel(x, y), expected.get_pixel(x, y)));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(tiled_rasterization_matches_serial_rasterization)
+{
+    TiledDisplayListPlayerCPU player(tile_size);
+    auto tiled = rasterize_tiled(player, Color::Red);
+    auto serial = rasterize_serially(Color::Red);
+    expect_same_pixels(*serial, *tiled);
+
+    auto const& statistics = player.last_frame_statistics();
+    EXPECT_EQ(statistics.tile_count, 7u * 5u);
+    EXPECT_EQ(statistics.rasterized_tile_count, statistics.tile_count);
+}
+
+TEST_CASE(unchanged_tiles_are_reused)
+{
+    TiledDisplayListPlayerCPU player(tile_size);
+    (void)rasterize_tiled(player, Color::Red);
+
+    // Nothing changed, so every tile is taken from the previous frame.
+    auto tiled = rasterize_tiled(player, Color::Red);
+    EXPECT_EQ(player.last_frame_statistics().rasterized_tile_count, 0u);
+    expect_same_pixels(*rasterize_serially(Color::Red), *tiled);
+
+    // Only the tiles under the rect that changed color are rasterized again.
+    tiled = rasterize_tiled(player, Color::Green);
+    auto rasterized_tile_count = player.last_frame_statistics().rasterized_tile_count;
+    EXPECT(rasterized_tile_count > 0u);
+    EXPECT(rasterized_tile_count <= 4u);
+    expect_same_pixels(*rasterize_serially(Color::Green), *tiled);
+}
+
+TEST_CASE(invalidated_tiles_are_rasterized_again)
+{
+    TiledDisplayListPlayerCPU player(tile_size);
+    (void)rasterize_tiled(player, Color::Red);
+
+    player.invalidate_all_tiles();
+    auto tiled = rasterize_tiled(player, Color::Red);
+    EXPECT_EQ(player.last_frame_statistics().rasterized_tile_count, player.last_frame_statistics().tile_count);
+    expect_same_pixels(*rasterize_serially(Color::Red), *tiled);
+}
@@ -0,0 +1 @@
+var speculativeFetchCountWhileBlocked = internals.speculativeFetchCount();
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <LibTest/TestCase.h>
+#include <LookupServer/LookupCache.h>
+#include <unistd.h>
+
+using namespace LookupServer;
+
+static Answer make_answer(StringView name, RecordType type, u32 ttl, StringView data = "data"sv)
+{
+    return Answer { Name { name }, type, RecordClass::IN, ttl, data, false };
+}
+
+static Answer make_soa(u32 ttl, u32 minimum)
+{
+    // Everything before MINIMUM doesn't matter for negative caching, so it is left as zeroes.
+    Vector<u8> data;
+    data.resize(16);
+    BigEndian<u32> minimum_in_network_order = minimum;
+    data.append(reinterpret_cast<u8 const*>(&minimum_in_network_order), sizeof(minimum_in_network_order));
+    return Answer { Name { "example.com"sv }, RecordType::SOA, RecordClass::IN, ttl, ByteString { data.span() }, false };
+}
+
+static bool is_cached(LookupCache& cache, StringView name, RecordType type = RecordType::A)
+{
+    return cache.lookup(Name { name }, type).has_value();
+}
+
+TEST_CASE(least_recently_used_entry_is_evicted)
+{
+    LookupCache cache { 3 };
+    cache.put(make_answer("a.example"sv, RecordType::A, 60));
+    cache.put(make_answer("b.example"sv, RecordType::A, 60));
+    cache.put(make_answer("c.example"sv, RecordType::A, 60));
+    EXPECT_EQ(cache.size(), 3u);
+
+    // Looking up a name makes it the most recently used one, so b is the first to go.
+    EXPECT(is_cached(cache, "a.example"sv));
+    cache.put(make_answer("d.example"sv, RecordType::A, 60));
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.statistics().evictions, 1u);
+    EXPECT(!is_cached(cache, "b.example"sv));
+
+    // Storing something for a name, even a negative answer, counts as using it. Now the order is a, d, c.
+    cache.put_negative(Name { "c.example"sv }, RecordType::AAAA, 60);
+    cache.put(make_answer("e.example"sv, RecordType::A, 60));
+    EXPECT_EQ(cache.statistics().evictions, 2u);
+    EXPECT(!is_cached(cache, "a.example"sv));
+    EXPECT(is_cached(cache, "c.example"sv));
+    EXPECT(is_cached(cache, "d.example"sv));
+    EXPECT(is_cached(cache, "e.example"sv));
+}
+
+TEST_CASE(negative_answers_are_told_apart_from_misses)
+{
+    LookupCache cache { 8 };
+    Name name { "host.example"sv };
+    cache.put(make_answer("host.example"sv, RecordType::A, 60, "\x0a\x00\x00\x01"sv));
+
+    auto answers = cache.lookup(name, RecordType::A);
+    EXPECT(answers.has_value());
+    EXPECT_EQ(answers->size(), 1u);
+
+    // Nothing is known about AAAA records, so upstream has to be asked.
+    EXPECT(!cache.lookup(name, RecordType::AAAA).has_value());
+    EXPECT(!cache.lookup(Name { "other.example"sv }, RecordType::A).has_value());
+
+    // Once upstream said there are none, the cache knows they don't exist.
+    cache.put_negative(name, RecordType::AAAA, 60);
+    answers = cache.lookup(name, RecordType::AAAA);
+    EXPECT(answers.has_value());
+    EXPECT(answers->is_empty());
+    EXPECT_EQ(cache.lookup(name, RecordType::A)->size(), 1u);
+
+    // A record showing up after all replaces the negative answer.
+    cache.put(make_answer("host.example"sv, RecordType::AAAA, 60));
+    answers = cache.lookup(name, RecordType::AAAA);
+    EXPECT(answers.has_value());
+    EXPECT_EQ(answers->size(), 1u);
+
+    // And the other way around.
+    cache.put_negative(name, RecordType::A, 60);
+    answers = cache.lookup(name, RecordType::A);
+    EXPECT(answers.has_value());
+    EXPECT(answers->is_empty());
+
+    // A negative answer without a TTL must not be cached.
+    cache.put_negative(Name { "other.example"sv }, RecordType::A, 0);
+    EXPECT(!cache.lookup(Name { "other.example"sv }, RecordType::A).has_value());
+
+    EXPECT_EQ(cache.statistics().negative_hits, 2u);
+}
+
+TEST_CASE(entries_expire)
+{
+    LookupCache cache { 8 };
+    cache.put(make_answer("short.example"sv, RecordType::A, 2));
+    cache.put_negative(Name { "short.example"sv }, RecordType::AAAA, 2);
+    cache.put(make_answer("long.example"sv, RecordType::A, 600));
+    cache.put_negative(Name { "long.example"sv }, RecordType::AAAA, 600);
+
+    EXPECT(is_cached(cache, "short.example"sv, RecordType::A));
+    EXPECT(is_cached(cache, "short.example"sv, RecordType::AAAA));
+
+    sleep(3);
+
+    EXPECT(!is_cached(cache, "short.example"sv, RecordType::A));
+    EXPECT(!is_cached(cache, "short.example"sv, RecordType::AAAA));
+    EXPECT(is_cached(cache, "long.example"sv, RecordType::A));
+    EXPECT(is_cached(cache, "long.example"sv, RecordType::AAAA));
+
+    // A name whose records have all expired is dropped from the cache altogether.
+    cache.put(make_answer("other.example"sv, RecordType::A, 2));
+    EXPECT_EQ(cache.size(), 2u);
+    sleep(3);
+    cache.remove_expired();
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT(is_cached(cache, "long.example"sv, RecordType::A));
+}
+
+TEST_CASE(negative_answer_ttl)
+{
+    // The smaller of the TTL and MINIMUM of the SOA record is used.
+    EXPECT_EQ(LookupCache::negative_answer_ttl(Vector { make_soa(300, 60) }), 60u);
+    EXPECT_EQ(LookupCache::negative_answer_ttl(Vector { make_soa(60, 300) }), 60u);
+
+    // But never more than a few hours.
+    EXPECT_EQ(LookupCache::negative_answer_ttl(Vector { make_soa(LookupCache::max_negative_ttl + 1, 86400) }), LookupCache::max_negative_ttl);
+    EXPECT_EQ(LookupCache::negative_answer_ttl(Vector { make_soa(86400, 86400) }), LookupCache::max_negative_ttl);
+
+    // Other records in the authority section are skipped.
+    EXPECT_EQ(LookupCache::negative_answer_ttl(Vector { make_answer("example.com"sv, RecordType::NS, 10), make_soa(120, 600) }), 120u);
+
+    // Without an SOA record, negative answers aren't cached.
+    EXPECT(!LookupCache::negative_answer_ttl(Vector<Answer> {}).has_value());
+    EXPECT(!LookupCache::negative_answer_ttl(Vector { make_answer("example.com"sv, RecordType::NS, 10) }).has_value());
+    EXPECT(!LookupCache::negative_answer_ttl(Vector { make_answer("example.com"sv, RecordType::SOA, 10, "ab"sv) }).has_value());
+}
@@ -48,6 +48,15 @@ int inode_watcher_remove_watch(int fd, int wd)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+ssize_t splice(int in_fd, off_t* in_offset, int out_fd, off_t* out_offset, size_t length, unsigned flags)
+{
+    __pthread_maybe_cancel();
+
+    Syscall::SC_splice_params params { in_fd, in_offset, out_fd, out_offset, length, flags };
+    ssize_t rc = syscall(SC_splice, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int creat(char const* path, mode_t mode)
 {
     __pthread_maybe_cancel();
@@ -37,6 +37,8 @@ int inode_watcher_remove_watch(int fd, int wd);
 int posix_fadvise(int fd, off_t offset, off_t len, int advice);
 int posix_fallocate(int fd, off_t offset, off_t len);
 
+ssize_t splice(int in_fd, off_t* in_offset, int out_fd, off_t* out_offset, size_t length, unsigned flags);
+
 int utimensat(int dirfd, char const* path, struct timespec const times[2], int flag);
 
 __END_DECLS
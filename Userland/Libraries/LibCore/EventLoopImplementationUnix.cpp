@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BinaryHeap.h>
+#include <AK/HashTable.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
@@ -20,6 +22,15 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+// With epoll, the cost of waiting for events depends on the number of file descriptors that are ready rather than the
+// number of notifiers, which matters to services holding thousands of sockets.
+#if defined(AK_OS_LINUX) || defined(AK_OS_SERENITY)
+#    define USE_EPOLL 1
+#    include <sys/epoll.h>
+#else
+#    define USE_EPOLL 0
+#endif
+
 namespace Core {
 
 namespace {
@@ -33,6 +44,17 @@ static pthread_rwlock_t* s_thread_data_lock = nullptr;
 thread_local pthread_t s_thread_id;
 thread_local OwnPtr<ThreadData> s_this_thread_data;
 
+#if USE_EPOLL
+u32 notification_type_to_epoll_events(NotificationType type)
+{
+    u32 events = 0;
+    if (has_flag(type, NotificationType::Read))
+        events |= EPOLLIN;
+    if (has_flag(type, NotificationType::Write))
+        events |= EPOLLOUT;
+    return events;
+}
+#else
 short notification_type_to_poll_events(NotificationType type)
 {
     short events = 0;
@@ -42,6 +64,7 @@ short notification_type_to_poll_events(NotificationType type)
         events |= POLLOUT;
     return events;
 }
+#endif
 
 bool has_flag(int value, int flag)
 {
@@ -263,6 +286,11 @@ struct ThreadData {
         pthread_rwlock_wrlock(&*s_thread_data_lock);
         s_thread_data.remove(s_thread_id);
         pthread_rwlock_unlock(&*s_thread_data_lock);
+
+#if USE_EPOLL
+        if (epoll_fd != -1)
+            close(epoll_fd);
+#endif
     }
 
     void initialize_wake_pipe()
@@ -280,18 +308,94 @@ struct ThreadData {
 
         wake_pipe_fds = result.release_value();
 
+#if USE_EPOLL
+        // After a fork, the epoll instance is shared with the parent, so we need our own.
+        if (epoll_fd != -1)
+            close(epoll_fd);
+
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd < 0) {
+            perror("EventLoopImplementationUnix: epoll_create1");
+            VERIFY_NOT_REACHED();
+        }
+
+        // The wake pipe informs us of POSIX signals as well as manual calls to wake()
+        VERIFY(notifiers_by_fd.is_empty());
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = wake_pipe_fds[0];
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_pipe_fds[0], &event) < 0) {
+            perror("EventLoopImplementationUnix: epoll_ctl");
+            VERIFY_NOT_REACHED();
+        }
+
+        ready_events.resize(MAX_READY_EVENTS_PER_WAIT);
+#else
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
         VERIFY(poll_fds.size() == 0);
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifier_by_index.append(nullptr);
+#endif
+    }
+
+#if USE_EPOLL
+    // Brings the events epoll watches a file descriptor for in line with the notifiers for it.
+    void update_epoll_interest(int fd)
+    {
+        auto notifiers = notifiers_by_fd.find(fd);
+        if (notifiers == notifiers_by_fd.end() || notifiers->value.is_empty()) {
+            // The file descriptor may already have been closed, which removes it from the epoll instance.
+            (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            if (notifiers != notifiers_by_fd.end())
+                notifiers_by_fd.remove(notifiers);
+            always_ready_fds.remove(fd);
+            return;
+        }
+
+        epoll_event event {};
+        for (auto* notifier : notifiers->value)
+            event.events |= notification_type_to_epoll_events(notifier->type());
+        event.data.fd = fd;
+
+        auto rc = epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+        if (rc < 0 && errno == ENOENT)
+            rc = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+
+        if (rc == 0) {
+            always_ready_fds.remove(fd);
+            return;
+        }
+
+        // epoll refuses files that are always ready, like regular files and directories. poll() reports those as
+        // readable and writable at all times, so we do the same.
+        if (errno == EPERM) {
+            always_ready_fds.set(fd);
+            return;
+        }
+
+        dbgln("EventLoopImplementationUnix: Failed to watch fd {}: {}", fd, Error::from_errno(errno));
     }
+#endif
 
     // Each thread has its own timers, notifiers and a wake pipe.
     TimeoutSet timeouts;
 
+#if USE_EPOLL
+    static constexpr size_t MAX_READY_EVENTS_PER_WAIT = 256;
+
+    int epoll_fd { -1 };
+    Vector<epoll_event> ready_events;
+
+    // Several notifiers may watch the same file descriptor, e.g. one for reading and one for writing.
+    HashMap<int, Vector<Notifier*, 1>> notifiers_by_fd;
+
+    // The watched file descriptors that epoll can't watch, as they never block.
+    HashTable<int> always_ready_fds;
+#else
     Vector<pollfd> poll_fds;
     HashMap<Notifier*, size_t> notifier_by_ptr;
     Vector<Notifier*> notifier_by_index;
+#endif
 
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
@@ -381,7 +485,32 @@ retry:
         }
     }
 
+#if USE_EPOLL
+    // There is no point in waiting while a notifier is always ready.
+    if (!thread_data.always_ready_fds.is_empty()) {
+        timeout = 0;
+        should_wait_forever = false;
+    }
+#endif
+
 try_select_again:
+#if USE_EPOLL
+    // Wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+    int marked_fd_count = epoll_wait(thread_data.epoll_fd, thread_data.ready_events.data(), static_cast<int>(thread_data.ready_events.size()), should_wait_forever ? -1 : timeout);
+    auto time_after_poll = MonotonicTime::now_coarse();
+    // Because POSIX, we might spuriously return from epoll_wait() with EINTR; just wait again.
+    if (marked_fd_count < 0) {
+        if (errno == EINTR)
+            goto try_select_again;
+        perror("EventLoopImplementationUnix::wait_for_events: epoll_wait");
+        VERIFY_NOT_REACHED();
+    }
+
+    auto ready_events = thread_data.ready_events.span().trim(marked_fd_count);
+    bool wake_pipe_is_readable = any_of(ready_events, [&](auto const& event) {
+        return event.data.fd == thread_data.wake_pipe_fds[0] && has_flag(event.events, EPOLLIN);
+    });
+#else
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
     ErrorOr<int> error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
     auto time_after_poll = MonotonicTime::now_coarse();
@@ -393,9 +522,12 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+    bool wake_pipe_is_readable = has_flag(thread_data.poll_fds[0].revents, POLLIN);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -424,6 +556,45 @@ try_select_again:
             goto retry;
     }
 
+#if USE_EPOLL
+    // Handle file system notifiers by making them normal events.
+    for (auto const& event : ready_events) {
+        if (event.data.fd == thread_data.wake_pipe_fds[0])
+            continue;
+
+        auto notifiers = thread_data.notifiers_by_fd.get(event.data.fd);
+        if (!notifiers.has_value())
+            continue;
+
+        NotificationType ready_type = NotificationType::None;
+        if (has_flag(event.events, EPOLLIN))
+            ready_type |= NotificationType::Read;
+        if (has_flag(event.events, EPOLLOUT))
+            ready_type |= NotificationType::Write;
+        if (has_flag(event.events, EPOLLHUP))
+            ready_type |= NotificationType::HangUp;
+        if (has_flag(event.events, EPOLLERR))
+            ready_type |= NotificationType::Error;
+
+        for (auto* notifier : *notifiers) {
+            auto type = ready_type & notifier->type();
+            if (type != NotificationType::None)
+                ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd(), type));
+        }
+    }
+
+    for (auto fd : thread_data.always_ready_fds) {
+        auto notifiers = thread_data.notifiers_by_fd.get(fd);
+        if (!notifiers.has_value())
+            continue;
+
+        for (auto* notifier : *notifiers) {
+            auto type = notifier->type() & (NotificationType::Read | NotificationType::Write);
+            if (type != NotificationType::None)
+                ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd(), type));
+        }
+    }
+#else
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
         for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
@@ -444,6 +615,7 @@ try_select_again:
                 ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
         }
     }
+#endif
 
     // Handle expired timers.
     thread_data.timeouts.fire_expired(time_after_poll);
@@ -520,9 +692,14 @@ void EventLoopImplementationUnix::notify_forked_and_in_child()
 {
     auto& thread_data = ThreadData::the();
     thread_data.timeouts.clear();
+#if USE_EPOLL
+    thread_data.notifiers_by_fd.clear();
+    thread_data.always_ready_fds.clear();
+#else
     thread_data.poll_fds.clear();
     thread_data.notifier_by_ptr.clear();
     thread_data.notifier_by_index.clear();
+#endif
     thread_data.initialize_wake_pipe();
     if (auto* info = signals_info<false>()) {
         info->signal_handlers.clear();
@@ -678,6 +855,10 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
 
+#if USE_EPOLL
+    thread_data.notifiers_by_fd.ensure(notifier.fd()).append(&notifier);
+    thread_data.update_epoll_interest(notifier.fd());
+#else
     thread_data.notifier_by_ptr.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifier_by_index.append(&notifier);
     thread_data.poll_fds.append({
@@ -685,6 +866,7 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
         .events = notification_type_to_poll_events(notifier.type()),
         .revents = 0,
     });
+#endif
 
     notifier.set_owner_thread(s_thread_id);
 }
@@ -696,6 +878,13 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
         return;
 
     auto& thread_data = *thread_data_ptr;
+
+#if USE_EPOLL
+    auto notifiers = thread_data.notifiers_by_fd.get(notifier.fd());
+    VERIFY(notifiers.has_value());
+    VERIFY(notifiers->remove_first_matching([&](auto* other) { return other == &notifier; }));
+    thread_data.update_epoll_interest(notifier.fd());
+#else
     auto it = thread_data.notifier_by_ptr.find(&notifier);
     VERIFY(it != thread_data.notifier_by_ptr.end());
 
@@ -709,6 +898,7 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     }
     thread_data.poll_fds.take_last();
     thread_data.notifier_by_index.take_last();
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
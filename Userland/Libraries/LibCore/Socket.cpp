@@ -377,9 +377,14 @@ ErrorOr<void> LocalSocket::send_fd(int fd)
 
 ErrorOr<ssize_t> LocalSocket::send_message(ReadonlyBytes data, int flags, Vector<int, 1> fds)
 {
-    size_t const num_fds = fds.size();
-    if (num_fds == 0)
+    if (fds.is_empty())
         return m_helper.write(data, flags | default_flags());
+    return send_message(ReadonlySpan<ReadonlyBytes> { &data, 1 }, flags, move(fds));
+}
+
+ErrorOr<ssize_t> LocalSocket::send_message(ReadonlySpan<ReadonlyBytes> buffers, int flags, Vector<int, 1> fds)
+{
+    size_t const num_fds = fds.size();
     if (num_fds > MAX_LOCAL_SOCKET_TRANSFER_FDS)
         return Error::from_string_literal("Too many file descriptors to send");
 
@@ -394,15 +399,22 @@ ErrorOr<ssize_t> LocalSocket::send_message(ReadonlyBytes data, int flags, Vector
     header->cmsg_type = SCM_RIGHTS;
     memcpy(CMSG_DATA(header), fds.data(), fd_payload_size);
 
-    struct iovec iov {
-        .iov_base = const_cast<u8*>(data.data()),
-        .iov_len = data.size(),
-    };
+    Vector<struct iovec, 16> iovs;
+    TRY(iovs.try_ensure_capacity(buffers.size()));
+    for (auto const& buffer : buffers) {
+        iovs.unchecked_append({
+            .iov_base = const_cast<u8*>(buffer.data()),
+            .iov_len = buffer.size(),
+        });
+    }
+
     struct msghdr msg = {};
-    msg.msg_iov = &iov;
-    msg.msg_iovlen = 1;
-    msg.msg_control = header;
-    msg.msg_controllen = CMSG_LEN(fd_payload_size);
+    msg.msg_iov = iovs.data();
+    msg.msg_iovlen = iovs.size();
+    if (num_fds > 0) {
+        msg.msg_control = header;
+        msg.msg_controllen = CMSG_LEN(fd_payload_size);
+    }
 
     return TRY(Core::System::sendmsg(m_helper.fd(), &msg, default_flags() | flags));
 }
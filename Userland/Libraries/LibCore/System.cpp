@@ -38,6 +38,11 @@
 #    include <sys/sysmacros.h>
 #endif
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+#    include <fcntl.h>
+#    include <sys/sendfile.h>
+#endif
+
 #if defined(AK_OS_LINUX) && !defined(MFD_CLOEXEC)
 #    include <linux/memfd.h>
 #    include <sys/syscall.h>
@@ -697,6 +702,24 @@ ErrorOr<ssize_t> write(int fd, ReadonlyBytes buffer)
     return rc;
 }
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    ssize_t rc = ::sendfile(out_fd, in_fd, offset, count);
+    if (rc < 0)
+        return Error::from_syscall("sendfile"sv, -errno);
+    return rc;
+}
+
+ErrorOr<size_t> splice(int in_fd, off_t* in_offset, int out_fd, off_t* out_offset, size_t length, unsigned flags)
+{
+    ssize_t rc = ::splice(in_fd, in_offset, out_fd, out_offset, length, flags);
+    if (rc < 0)
+        return Error::from_syscall("splice"sv, -errno);
+    return rc;
+}
+#endif
+
 ErrorOr<void> kill(pid_t pid, int signal)
 {
     if (::kill(pid, signal) < 0)
@@ -40,7 +40,7 @@ TCPServer::~TCPServer()
     MUST(Core::System::close(m_fd));
 }
 
-ErrorOr<void> TCPServer::listen(IPv4Address const& address, u16 port, AllowAddressReuse allow_address_reuse)
+ErrorOr<void> TCPServer::listen(IPv4Address const& address, u16 port, AllowAddressReuse allow_address_reuse, int backlog)
 {
     if (m_listening)
         return Error::from_errno(EADDRINUSE);
@@ -54,15 +54,33 @@ ErrorOr<void> TCPServer::listen(IPv4Address const& address, u16 port, AllowAddre
     }
 
     TRY(Core::System::bind(m_fd, (sockaddr const*)&in, sizeof(in)));
-    TRY(Core::System::listen(m_fd, 5));
+    TRY(Core::System::listen(m_fd, backlog));
     m_listening = true;
 
+    set_up_notifier();
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<TCPServer>> TCPServer::try_create_sibling(EventReceiver* parent) const
+{
+    VERIFY(m_listening);
+
+    int fd = TRY(Core::System::dup(m_fd));
+    TRY(Core::System::fcntl(fd, F_SETFD, FD_CLOEXEC));
+
+    auto server = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) TCPServer(fd, parent)));
+    server->m_listening = true;
+    server->set_up_notifier();
+    return server;
+}
+
+void TCPServer::set_up_notifier()
+{
     m_notifier = Notifier::construct(m_fd, Notifier::Type::Read, this);
     m_notifier->on_activation = [this] {
         if (on_ready_to_accept)
             on_ready_to_accept();
     };
-    return {};
 }
 
 ErrorOr<void> TCPServer::set_blocking(bool blocking)
@@ -17,6 +17,10 @@ class TCPServer : public EventReceiver {
     C_OBJECT_ABSTRACT(TCPServer)
 public:
     static ErrorOr<NonnullRefPtr<TCPServer>> try_create(EventReceiver* parent = nullptr);
+
+    // Creates a server that accepts connections from this server's listening socket.
+    // Call this from another thread to have its event loop accept clients as well.
+    ErrorOr<NonnullRefPtr<TCPServer>> try_create_sibling(EventReceiver* parent = nullptr) const;
     virtual ~TCPServer() override;
 
     enum class AllowAddressReuse {
@@ -25,7 +29,10 @@ public:
     };
 
     bool is_listening() const { return m_listening; }
-    ErrorOr<void> listen(IPv4Address const& address, u16 port, AllowAddressReuse = AllowAddressReuse::No);
+    static constexpr int default_listen_backlog = 5;
+
+    // The backlog is the number of connections the kernel queues for us until we accept them.
+    ErrorOr<void> listen(IPv4Address const& address, u16 port, AllowAddressReuse = AllowAddressReuse::No, int backlog = default_listen_backlog);
     ErrorOr<void> set_blocking(bool blocking);
 
     ErrorOr<NonnullOwnPtr<TCPSocket>> accept();
@@ -38,6 +45,8 @@ public:
 private:
     explicit TCPServer(int fd, EventReceiver* parent = nullptr);
 
+    void set_up_notifier();
+
     int m_fd { -1 };
     bool m_listening { false };
     RefPtr<Notifier> m_notifier;
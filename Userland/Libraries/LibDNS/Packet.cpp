@@ -97,6 +97,51 @@ private:
 
 static_assert(sizeof(DNSRecordWithoutName) == 10);
 
+static ErrorOr<Answer> parse_resource_record(ReadonlyBytes bytes, size_t& offset)
+{
+    auto name = TRY(Name::parse(bytes, offset));
+    if (offset >= bytes.size() || bytes.size() - offset < sizeof(DNSRecordWithoutName))
+        return Error::from_string_literal("Unexpected EOF when parsing DNS packet");
+
+    auto const& record = *bit_cast<DNSRecordWithoutName const*>(bytes.offset_pointer(offset));
+    offset += sizeof(DNSRecordWithoutName);
+    if (record.data_length() > bytes.size() - offset)
+        return Error::from_string_literal("Unexpected EOF when parsing DNS packet");
+
+    ByteString data;
+
+    switch ((RecordType)record.type()) {
+    case RecordType::PTR: {
+        size_t dummy_offset = offset;
+        data = TRY(Name::parse(bytes, dummy_offset)).as_string();
+        break;
+    }
+    case RecordType::CNAME:
+        // Fall through
+    case RecordType::A:
+        // Fall through
+    case RecordType::TXT:
+        // Fall through
+    case RecordType::AAAA:
+        // Fall through
+    case RecordType::SRV:
+        // Fall through
+    case RecordType::SOA:
+        // NOTE: The names in SOA data may be compressed, so they only make sense within this packet.
+        //       The fixed-size fields that follow them are usable as-is though.
+        data = ReadonlyBytes { record.data(), record.data_length() };
+        break;
+    default:
+        // FIXME: Parse some other record types perhaps?
+        dbgln_if(LOOKUPSERVER_DEBUG, "data=(unimplemented record type {})", (u16)record.type());
+    }
+
+    u16 class_code = record.record_class() & ~MDNS_CACHE_FLUSH;
+    bool mdns_cache_flush = record.record_class() & MDNS_CACHE_FLUSH;
+    offset += record.data_length();
+    return Answer { name, (RecordType)record.type(), (RecordClass)class_code, record.ttl(), data, mdns_cache_flush };
+}
+
 ErrorOr<Packet> Packet::from_raw_packet(ReadonlyBytes bytes)
 {
     if (bytes.size() < sizeof(PacketHeader)) {
@@ -116,8 +161,9 @@ ErrorOr<Packet> Packet::from_raw_packet(ReadonlyBytes bytes)
     packet.m_query_or_response = header.is_response();
     packet.m_code = header.response_code();
 
-    // FIXME: Should we parse further in this case?
-    if (packet.code() != Code::NOERROR)
+    // NXDOMAIN responses carry the SOA record that says for how long the name is known not to exist (RFC 2308).
+    // FIXME: Should we parse further in the other error cases?
+    if (packet.code() != Code::NOERROR && packet.code() != Code::NXDOMAIN)
         return packet;
 
     size_t offset = sizeof(PacketHeader);
@@ -141,44 +187,19 @@ ErrorOr<Packet> Packet::from_raw_packet(ReadonlyBytes bytes)
     }
 
     for (u16 i = 0; i < header.answer_count(); ++i) {
-        auto name = TRY(Name::parse(bytes, offset));
-        if (offset >= bytes.size() || bytes.size() - offset < sizeof(DNSRecordWithoutName))
-            return Error::from_string_literal("Unexpected EOF when parsing DNS packet");
-
-        auto const& record = *bit_cast<DNSRecordWithoutName const*>(bytes.offset_pointer(offset));
-        offset += sizeof(DNSRecordWithoutName);
-        if (record.data_length() > bytes.size() - offset)
-            return Error::from_string_literal("Unexpected EOF when parsing DNS packet");
-
-        ByteString data;
+        auto answer = TRY(parse_resource_record(bytes, offset));
+        dbgln_if(LOOKUPSERVER_DEBUG, "Answer   #{}: name=_{}_, type={}, ttl={}, data=_{}_", i, answer.name(), answer.type(), answer.ttl(), answer.record_data());
+        packet.m_answers.append(move(answer));
+    }
 
-        switch ((RecordType)record.type()) {
-        case RecordType::PTR: {
-            size_t dummy_offset = offset;
-            data = TRY(Name::parse(bytes, dummy_offset)).as_string();
+    for (u16 i = 0; i < header.authority_count(); ++i) {
+        // The authority section is only advisory, so don't throw away the answers if it's malformed.
+        auto authority_or_error = parse_resource_record(bytes, offset);
+        if (authority_or_error.is_error())
             break;
-        }
-        case RecordType::CNAME:
-            // Fall through
-        case RecordType::A:
-            // Fall through
-        case RecordType::TXT:
-            // Fall through
-        case RecordType::AAAA:
-            // Fall through
-        case RecordType::SRV:
-            data = ReadonlyBytes { record.data(), record.data_length() };
-            break;
-        default:
-            // FIXME: Parse some other record types perhaps?
-            dbgln("data=(unimplemented record type {})", (u16)record.type());
-        }
-
-        dbgln_if(LOOKUPSERVER_DEBUG, "Answer   #{}: name=_{}_, type={}, ttl={}, length={}, data=_{}_", i, name, record.type(), record.ttl(), record.data_length(), data);
-        u16 class_code = record.record_class() & ~MDNS_CACHE_FLUSH;
-        bool mdns_cache_flush = record.record_class() & MDNS_CACHE_FLUSH;
-        packet.m_answers.empend(name, (RecordType)record.type(), (RecordClass)class_code, record.ttl(), data, mdns_cache_flush);
-        offset += record.data_length();
+        auto authority = authority_or_error.release_value();
+        dbgln_if(LOOKUPSERVER_DEBUG, "Authority #{}: name=_{}_, type={}, ttl={}", i, authority.name(), authority.type(), authority.ttl());
+        packet.m_authorities.append(move(authority));
     }
 
     return packet;
@@ -43,6 +43,7 @@ public:
 
     Vector<Question> const& questions() const { return m_questions; }
     Vector<Answer> const& answers() const { return m_answers; }
+    Vector<Answer> const& authorities() const { return m_authorities; }
 
     u16 question_count() const
     {
@@ -84,6 +85,7 @@ private:
     bool m_recursion_available { true };
     Vector<Question> m_questions;
     Vector<Answer> m_answers;
+    Vector<Answer> m_authorities;
 };
 
 }
@@ -255,6 +255,8 @@ ErrorOr<HttpRequest, HttpRequest::ParseError> HttpRequest::from_raw_request(Read
         request.m_url.set_paths({ resource });
     }
 
+    request.m_protocol = move(protocol);
+
     request.set_body(move(body));
 
     return request;
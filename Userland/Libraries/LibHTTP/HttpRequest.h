@@ -68,6 +68,7 @@ public:
     AK_MAKE_DEFAULT_MOVABLE(HttpRequest);
 
     ByteString const& resource() const { return m_resource; }
+    ByteString const& protocol() const { return m_protocol; }
     HeaderMap const& headers() const { return m_headers; }
 
     URL::URL const& url() const { return m_url; }
@@ -91,6 +92,7 @@ public:
 private:
     URL::URL m_url;
     ByteString m_resource;
+    ByteString m_protocol;
     Method m_method { GET };
     HeaderMap m_headers;
     ByteBuffer m_body;
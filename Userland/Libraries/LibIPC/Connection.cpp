@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
+#include <AK/HashMap.h>
 #include <LibCore/System.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/File.h>
@@ -13,6 +15,24 @@
 
 namespace IPC {
 
+// The connections with messages waiting to be sent. They are kept alive until the messages have been sent.
+static Threading::Mutex s_connections_with_pending_messages_mutex;
+static HashMap<ConnectionBase*, NonnullRefPtr<ConnectionBase>> s_connections_with_pending_messages;
+
+static void register_connection_with_pending_messages(ConnectionBase& connection)
+{
+    Threading::MutexLocker locker(s_connections_with_pending_messages_mutex);
+    s_connections_with_pending_messages.set(&connection, connection);
+}
+
+static RefPtr<ConnectionBase> unregister_connection_with_pending_messages(ConnectionBase& connection)
+{
+    Threading::MutexLocker locker(s_connections_with_pending_messages_mutex);
+    if (auto registered_connection = s_connections_with_pending_messages.take(&connection); registered_connection.has_value())
+        return registered_connection.release_value();
+    return nullptr;
+}
+
 struct CoreEventLoopDeferredInvoker final : public DeferredInvoker {
     virtual ~CoreEventLoopDeferredInvoker() = default;
 
@@ -27,10 +47,19 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
     , m_socket(move(socket))
     , m_local_endpoint_magic(local_endpoint_magic)
     , m_deferred_invoker(make<CoreEventLoopDeferredInvoker>())
+    , m_owner_thread(pthread_self())
 {
     m_responsiveness_timer = Core::Timer::create_single_shot(3000, [this] { may_have_become_unresponsive(); });
 }
 
+ConnectionBase::~ConnectionBase()
+{
+    // NOTE: A connection with pending messages is kept alive until they have been sent, unless they never were because
+    //       the process is exiting. Send them now, without touching the (possibly already destroyed) registry.
+    if (m_socket->is_open() && !m_pending_messages.is_empty())
+        (void)MessageBuffer::transfer_messages(m_pending_messages, *m_socket);
+}
+
 void ConnectionBase::set_deferred_invoker(NonnullOwnPtr<DeferredInvoker> deferred_invoker)
 {
     m_deferred_invoker = move(deferred_invoker);
@@ -48,10 +77,77 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer, MessageKind kin
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
-    if (auto result = buffer.transfer_message(*m_socket, kind == MessageKind::Sync); result.is_error()) {
-        shutdown_with_error(result.error());
-        return result.release_error();
+    // A synchronous message is waited on, so it can't wait for the end of the current pass of the event loop.
+    if (kind == MessageKind::Sync)
+        flush_pending_messages_of_all_connections();
+
+    NonnullRefPtr protect = *this;
+    Threading::MutexLocker locker(m_send_mutex);
+
+    // Messages with file descriptors are sent on their own, so that a write never carries more descriptors than it can.
+    // Messages are only batched on the thread that owns the connection, as that is where the batch is flushed. Other
+    // threads send their messages right away, after the ones that are already waiting.
+    if (kind == MessageKind::Sync || buffer.has_file_descriptors() || !pthread_equal(pthread_self(), m_owner_thread)) {
+        TRY(flush_pending_messages());
+        return transfer_messages({ &buffer, 1 }, kind);
+    }
+
+    TRY(m_pending_messages.try_append(move(buffer)));
+    if (m_pending_messages.size() >= MAX_BATCHED_MESSAGES)
+        return flush_pending_messages();
+
+    if (m_pending_messages.size() == 1) {
+        register_connection_with_pending_messages(*this);
+        m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)] {
+            (void)strong_this->flush_pending_messages();
+        });
     }
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::flush_pending_messages()
+{
+    // NOTE: This may be the last reference to the connection, so it must outlive the lock.
+    RefPtr<ConnectionBase> registered_connection;
+    Threading::MutexLocker locker(m_send_mutex);
+
+    if (m_pending_messages.is_empty())
+        return {};
+
+    auto messages = move(m_pending_messages);
+    registered_connection = unregister_connection_with_pending_messages(*this);
+
+    if (!m_socket->is_open())
+        return Error::from_string_literal("Trying to flush messages during IPC shutdown");
+    return transfer_messages(messages, MessageKind::Async);
+}
+
+void ConnectionBase::flush_pending_messages_of_all_connections()
+{
+    // A synchronous message to one peer may depend on the messages posted to another, so those are sent first.
+    Vector<NonnullRefPtr<ConnectionBase>> connections;
+    {
+        Threading::MutexLocker locker(s_connections_with_pending_messages_mutex);
+        for (auto const& it : s_connections_with_pending_messages)
+            connections.append(it.value);
+    }
+
+    for (auto& connection : connections)
+        (void)connection->flush_pending_messages();
+}
+
+ErrorOr<void> ConnectionBase::transfer_messages(Span<MessageBuffer> messages, MessageKind kind)
+{
+    auto writes_done = MessageBuffer::transfer_messages(messages, *m_socket, kind == MessageKind::Sync);
+    if (writes_done.is_error()) {
+        shutdown_with_error(writes_done.error());
+        return writes_done.release_error();
+    }
+
+    m_statistics.messages_sent += messages.size();
+    for (auto const& message : messages)
+        m_statistics.bytes_sent += message.size();
+    m_statistics.send_syscalls += writes_done.value();
 
     m_responsiveness_timer->start();
     return {};
@@ -59,6 +155,18 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer, MessageKind kin
 
 void ConnectionBase::shutdown()
 {
+    dbgln_if(IPC_DEBUG, "IPC::ConnectionBase ({:p}) shutting down: sent {} message(s), {}B in {} write(s); received {} message(s), {}B in {} read(s)",
+        this, m_statistics.messages_sent, m_statistics.bytes_sent, m_statistics.send_syscalls,
+        m_statistics.messages_received, m_statistics.bytes_received, m_statistics.receive_syscalls);
+
+    // NOTE: This may be the last reference to the connection, so it must outlive the lock.
+    RefPtr<ConnectionBase> registered_connection;
+    {
+        Threading::MutexLocker locker(m_send_mutex);
+        m_pending_messages.clear();
+        registered_connection = unregister_connection_with_pending_messages(*this);
+    }
+
     m_socket->close();
     die();
 }
@@ -87,6 +195,10 @@ void ConnectionBase::handle_messages()
             }
         }
     }
+
+    // The peer may be waiting for the responses, so send them without waiting for the end of this pass of the event loop.
+    if (auto flush_result = flush_pending_messages(); flush_result.is_error())
+        dbgln("IPC::ConnectionBase::handle_messages: {}", flush_result.error());
 }
 
 void ConnectionBase::wait_for_socket_to_become_readable()
@@ -110,7 +222,11 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
         m_unprocessed_bytes.clear();
     }
 
-    u8 buffer[4096];
+    // Large enough that a batch of messages can usually be read with a single call.
+    static constexpr size_t RECEIVE_BUFFER_SIZE = 64 * KiB;
+    if (m_receive_buffer.is_empty())
+        m_receive_buffer = TRY(ByteBuffer::create_uninitialized(RECEIVE_BUFFER_SIZE));
+
     Vector<int> received_fds;
 
     bool should_shut_down = false;
@@ -122,7 +238,8 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
     };
 
     while (m_socket->is_open()) {
-        auto maybe_bytes_read = m_socket->receive_message({ buffer, 4096 }, MSG_DONTWAIT, received_fds);
+        auto maybe_bytes_read = m_socket->receive_message(m_receive_buffer.bytes(), MSG_DONTWAIT, received_fds);
+        ++m_statistics.receive_syscalls;
         if (maybe_bytes_read.is_error()) {
             auto error = maybe_bytes_read.release_error();
             if (error.is_syscall() && error.code() == EAGAIN) {
@@ -146,6 +263,7 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
         }
 
         bytes.append(bytes_read.data(), bytes_read.size());
+        m_statistics.bytes_received += bytes_read.size();
         for (auto const& fd : received_fds)
             m_unprocessed_fds.enqueue(IPC::File::adopt_fd(fd));
     }
@@ -165,7 +283,9 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
     auto bytes = TRY(read_as_much_as_possible_from_socket_without_blocking());
 
     size_t index = 0;
+    auto message_count = m_unprocessed_messages.size();
     try_parse_messages(bytes, index);
+    m_statistics.messages_received += m_unprocessed_messages.size() - message_count;
 
     if (index < bytes.size()) {
         // Sometimes we might receive a partial message. That's okay, just stash away
@@ -189,6 +309,9 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 
 OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id)
 {
+    // Whatever we're waiting for may only be sent in response to the messages we haven't sent yet.
+    flush_pending_messages_of_all_connections();
+
     for (;;) {
         // Double check we don't already have the event waiting for us.
         // Otherwise we might end up blocked for a while for no reason.
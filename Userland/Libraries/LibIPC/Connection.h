@@ -18,7 +18,9 @@
 #include <LibIPC/File.h>
 #include <LibIPC/Forward.h>
 #include <LibIPC/Message.h>
+#include <LibThreading/Mutex.h>
 #include <errno.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <sys/socket.h>
@@ -38,7 +40,7 @@ class ConnectionBase : public Core::EventReceiver {
     C_OBJECT_ABSTRACT(ConnectionBase);
 
 public:
-    virtual ~ConnectionBase() override = default;
+    virtual ~ConnectionBase() override;
 
     void set_deferred_invoker(NonnullOwnPtr<DeferredInvoker>);
     DeferredInvoker& deferred_invoker() { return *m_deferred_invoker; }
@@ -50,6 +52,22 @@ public:
     };
     ErrorOr<void> post_message(Message const&, MessageKind = MessageKind::Async);
 
+    // Asynchronous messages posted on the thread that owns the connection are batched, and sent together once the
+    // current pass of the event loop is done with them. Messages which are waited on, or which are posted on other
+    // threads, are sent right away, along with everything posted before them.
+    ErrorOr<void> flush_pending_messages();
+    static void flush_pending_messages_of_all_connections();
+
+    struct Statistics {
+        size_t messages_sent { 0 };
+        size_t bytes_sent { 0 };
+        size_t send_syscalls { 0 };
+        size_t messages_received { 0 };
+        size_t bytes_received { 0 };
+        size_t receive_syscalls { 0 };
+    };
+    Statistics const& statistics() const { return m_statistics; }
+
     void shutdown();
     virtual void die() { }
 
@@ -69,8 +87,12 @@ protected:
     ErrorOr<void> drain_messages_from_peer();
 
     ErrorOr<void> post_message(MessageBuffer, MessageKind);
+    ErrorOr<void> transfer_messages(Span<MessageBuffer>, MessageKind);
     void handle_messages();
 
+    // The most messages that are sent with one write, well below the limit on the number of buffers of one write.
+    static constexpr size_t MAX_BATCHED_MESSAGES = 64;
+
     IPC::Stub& m_local_stub;
 
     NonnullOwnPtr<Core::LocalSocket> m_socket;
@@ -80,10 +102,20 @@ protected:
     Vector<NonnullOwnPtr<Message>> m_unprocessed_messages;
     Queue<IPC::File> m_unprocessed_fds;
     ByteBuffer m_unprocessed_bytes;
+    ByteBuffer m_receive_buffer;
+
+    // Messages may be posted from any thread. The send mutex guards the pending messages, and keeps the messages of
+    // different threads from being interleaved on the socket.
+    Threading::Mutex m_send_mutex;
+    Vector<MessageBuffer> m_pending_messages;
+    Statistics m_statistics;
 
     u32 m_local_endpoint_magic { 0 };
 
     NonnullOwnPtr<DeferredInvoker> m_deferred_invoker;
+
+    // The thread that created the connection. Messages posted on it are batched.
+    pthread_t m_owner_thread;
 };
 
 template<typename LocalEndpoint, typename PeerEndpoint>
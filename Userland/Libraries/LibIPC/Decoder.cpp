@@ -6,6 +6,7 @@
  */
 
 #include <AK/JsonValue.h>
+#include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibCore/DateTime.h>
@@ -23,22 +24,61 @@ ErrorOr<size_t> Decoder::decode_size()
     return static_cast<size_t>(TRY(decode<u32>()));
 }
 
+ErrorOr<size_t> Decoder::decode_payload_size()
+{
+    auto size = TRY(decode<u32>());
+    if (size != SHARED_MEMORY_PAYLOAD_MARKER)
+        return static_cast<size_t>(size);
+
+    auto buffer = TRY(decode<Core::AnonymousBuffer>());
+    if (!buffer.is_valid())
+        return Error::from_string_literal("Shared memory payload is missing its buffer");
+
+    m_shared_payload = move(buffer);
+    return m_shared_payload->size();
+}
+
+ErrorOr<void> Decoder::decode_payload_into(Bytes bytes)
+{
+    auto shared_payload = take_shared_payload();
+    if (!shared_payload.has_value())
+        return decode_into(bytes);
+
+    if (shared_payload->size() != bytes.size())
+        return Error::from_string_literal("Shared memory payload size mismatch");
+
+    ReadonlyBytes { shared_payload->data<u8>(), shared_payload->size() }.copy_to(bytes);
+    return {};
+}
+
+Optional<Core::AnonymousBuffer> Decoder::take_shared_payload()
+{
+    return exchange(m_shared_payload, {});
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
-    auto length = TRY(decoder.decode_size());
+    auto length = TRY(decoder.decode_payload_size());
+    if (auto payload = decoder.take_shared_payload(); payload.has_value()) {
+        // NOTE: The peer can still write to the shared memory, so the string has to be copied out of it before it is
+        //       validated, rather than validated in place.
+        FixedMemoryStream stream { ReadonlyBytes { payload->data<u8>(), payload->size() } };
+        return String::from_stream(stream, length);
+    }
+
     return String::from_stream(decoder.stream(), length);
 }
 
 template<>
 ErrorOr<ByteString> decode(Decoder& decoder)
 {
-    auto length = TRY(decoder.decode_size());
+    auto length = TRY(decoder.decode_payload_size());
     if (length == 0)
         return ByteString::empty();
 
     return ByteString::create_and_overwrite(length, [&](Bytes bytes) -> ErrorOr<void> {
-        TRY(decoder.decode_into(bytes));
+        TRY(decoder.decode_payload_into(bytes));
         return {};
     });
 }
@@ -46,14 +86,14 @@ ErrorOr<ByteString> decode(Decoder& decoder)
 template<>
 ErrorOr<ByteBuffer> decode(Decoder& decoder)
 {
-    auto length = TRY(decoder.decode_size());
+    auto length = TRY(decoder.decode_payload_size());
     if (length == 0)
         return ByteBuffer {};
 
     auto buffer = TRY(ByteBuffer::create_uninitialized(length));
     auto bytes = buffer.bytes();
 
-    TRY(decoder.decode_into(bytes));
+    TRY(decoder.decode_payload_into(bytes));
     return buffer;
 }
 
@@ -17,6 +17,7 @@
 #include <AK/Try.h>
 #include <AK/TypeList.h>
 #include <AK/Variant.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/SharedCircularQueue.h>
 #include <LibCore/Socket.h>
 #include <LibIPC/Concepts.h>
@@ -61,12 +62,19 @@ public:
 
     ErrorOr<size_t> decode_size();
 
+    // Decodes the size of a payload encoded with Encoder::encode_payload(). Its bytes must then be decoded with
+    // decode_payload_into(), or taken with take_shared_payload() if the payload was passed in shared memory.
+    ErrorOr<size_t> decode_payload_size();
+    ErrorOr<void> decode_payload_into(Bytes);
+    Optional<Core::AnonymousBuffer> take_shared_payload();
+
     Stream& stream() { return m_stream; }
     Queue<IPC::File>& files() { return m_files; }
 
 private:
     Stream& m_stream;
     Queue<IPC::File>& m_files;
+    Optional<Core::AnonymousBuffer> m_shared_payload;
 };
 
 template<Arithmetic T>
@@ -32,6 +32,22 @@ ErrorOr<void> Encoder::encode_size(size_t size)
     return encode(static_cast<u32>(size));
 }
 
+ErrorOr<void> Encoder::encode_payload(ReadonlyBytes payload)
+{
+    if (payload.size() < SHARED_MEMORY_PAYLOAD_THRESHOLD) {
+        TRY(encode_size(payload.size()));
+        TRY(append(payload.data(), payload.size()));
+        return {};
+    }
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(payload.size()));
+    payload.copy_to({ buffer.data<u8>(), buffer.size() });
+
+    TRY(encode(SHARED_MEMORY_PAYLOAD_MARKER));
+    TRY(encode(buffer));
+    return {};
+}
+
 template<>
 ErrorOr<void> encode(Encoder& encoder, float const& value)
 {
@@ -47,10 +63,7 @@ ErrorOr<void> encode(Encoder& encoder, double const& value)
 template<>
 ErrorOr<void> encode(Encoder& encoder, String const& value)
 {
-    auto bytes = value.bytes();
-    TRY(encoder.encode_size(bytes.size()));
-    TRY(encoder.append(bytes.data(), bytes.size()));
-    return {};
+    return encoder.encode_payload(value.bytes());
 }
 
 template<>
@@ -60,9 +73,7 @@ ErrorOr<void> encode(Encoder& encoder, StringView const& value)
     if (value.is_null())
         return encoder.encode(NumericLimits<u32>::max());
 
-    TRY(encoder.encode_size(value.length()));
-    TRY(encoder.append(reinterpret_cast<u8 const*>(value.characters_without_null_termination()), value.length()));
-    return {};
+    return encoder.encode_payload(value.bytes());
 }
 
 template<>
@@ -74,9 +85,7 @@ ErrorOr<void> encode(Encoder& encoder, ByteString const& value)
 template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
 {
-    TRY(encoder.encode_size(value.size()));
-    TRY(encoder.append(value.data(), value.size()));
-    return {};
+    return encoder.encode_payload(value.bytes());
 }
 
 template<>
@@ -57,6 +57,10 @@ public:
 
     ErrorOr<void> encode_size(size_t size);
 
+    // Encodes the size of the payload followed by its bytes. Payloads of at least SHARED_MEMORY_PAYLOAD_THRESHOLD bytes
+    // are copied into an anonymous buffer instead, which is passed to the peer as a file descriptor.
+    ErrorOr<void> encode_payload(ReadonlyBytes);
+
 private:
     MessageBuffer& m_buffer;
 };
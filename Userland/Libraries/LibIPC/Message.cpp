@@ -38,7 +38,7 @@ ErrorOr<void> MessageBuffer::append_file_descriptor(int fd)
     return {};
 }
 
-ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool block_event_loop)
+ErrorOr<void> MessageBuffer::write_size_header()
 {
     Checked<MessageSizeType> checked_message_size { m_data.size() };
     checked_message_size -= sizeof(MessageSizeType);
@@ -48,27 +48,42 @@ ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool bl
 
     MessageSizeType const message_size = checked_message_size.value();
     m_data.span().overwrite(0, reinterpret_cast<u8 const*>(&message_size), sizeof(message_size));
+    return {};
+}
+
+ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool block_event_loop)
+{
+    TRY(transfer_messages({ this, 1 }, socket, block_event_loop));
+    return {};
+}
 
+ErrorOr<size_t> MessageBuffer::transfer_messages(Span<MessageBuffer> messages, Core::LocalSocket& socket, bool block_event_loop)
+{
     auto raw_fds = Vector<int, 1> {};
-    auto num_fds_to_transfer = m_fds.size();
-    if (num_fds_to_transfer > 0) {
-        raw_fds.ensure_capacity(num_fds_to_transfer);
-        for (auto& owned_fd : m_fds) {
-            raw_fds.unchecked_append(owned_fd->value());
-        }
+    Vector<ReadonlyBytes, 16> buffers_to_write;
+    TRY(buffers_to_write.try_ensure_capacity(messages.size()));
+    size_t total_size = 0;
+
+    for (auto& message : messages) {
+        TRY(message.write_size_header());
+        for (auto& owned_fd : message.m_fds)
+            TRY(raw_fds.try_append(owned_fd->value()));
+
+        buffers_to_write.unchecked_append(message.m_data.span());
+        total_size += message.m_data.size();
     }
 
-    ReadonlyBytes bytes_to_write { m_data.span() };
+    auto num_fds_to_transfer = raw_fds.size();
     size_t writes_done = 0;
 
-    while (!bytes_to_write.is_empty()) {
+    while (!buffers_to_write.is_empty()) {
         ErrorOr<ssize_t> maybe_nwritten = 0;
-        if (num_fds_to_transfer > 0) {
-            maybe_nwritten = socket.send_message(bytes_to_write, 0, raw_fds);
+        if (num_fds_to_transfer > 0 || buffers_to_write.size() > 1) {
+            maybe_nwritten = socket.send_message(buffers_to_write.span(), 0, num_fds_to_transfer > 0 ? raw_fds : Vector<int, 1> {});
             if (!maybe_nwritten.is_error())
                 num_fds_to_transfer = 0;
         } else {
-            maybe_nwritten = socket.write_some(bytes_to_write);
+            maybe_nwritten = socket.write_some(buffers_to_write.first());
         }
         ++writes_done;
 
@@ -97,14 +112,21 @@ ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool bl
             }
         }
 
-        bytes_to_write = bytes_to_write.slice(maybe_nwritten.value());
+        // Drop the buffers that were written entirely, and the written part of the first one that wasn't.
+        auto nwritten = static_cast<size_t>(maybe_nwritten.value());
+        while (!buffers_to_write.is_empty() && nwritten >= buffers_to_write.first().size()) {
+            nwritten -= buffers_to_write.first().size();
+            buffers_to_write.remove(0);
+        }
+        if (!buffers_to_write.is_empty())
+            buffers_to_write.first() = buffers_to_write.first().slice(nwritten);
     }
 
     if (writes_done > 1) {
-        dbgln("LibIPC::transfer_message FIXME Warning, needed {} writes needed to send message of size {}B, this is pretty bad, as it spins on the EventLoop", writes_done, m_data.size());
+        dbgln("LibIPC::transfer_message FIXME Warning, needed {} writes needed to send {} message(s) of size {}B, this is pretty bad, as it spins on the EventLoop", writes_done, messages.size(), total_size);
     }
 
-    return {};
+    return writes_done;
 }
 
 }
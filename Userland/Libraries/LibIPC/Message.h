@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/NumericLimits.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
@@ -16,6 +17,13 @@
 
 namespace IPC {
 
+// Strings and buffers of at least this size are passed to the peer in shared memory rather than copied through the
+// socket, which would take many reads and writes of the socket buffer's size on both ends.
+constexpr size_t SHARED_MEMORY_PAYLOAD_THRESHOLD = 64 * KiB;
+
+// Encoded in place of the size of a payload which was passed in shared memory.
+constexpr u32 SHARED_MEMORY_PAYLOAD_MARKER = NumericLimits<u32>::max() - 1;
+
 class AutoCloseFileDescriptor : public RefCounted<AutoCloseFileDescriptor> {
 public:
     AutoCloseFileDescriptor(int fd)
@@ -46,7 +54,15 @@ public:
 
     ErrorOr<void> transfer_message(Core::LocalSocket& socket, bool block_event_loop = false);
 
+    // Sends the messages in order, gathering as many of them as possible into each write. Returns the number of writes.
+    static ErrorOr<size_t> transfer_messages(Span<MessageBuffer> messages, Core::LocalSocket& socket, bool block_event_loop = false);
+
+    size_t size() const { return m_data.size(); }
+    bool has_file_descriptors() const { return !m_fds.is_empty(); }
+
 private:
+    ErrorOr<void> write_size_header();
+
     Vector<u8, 1024> m_data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> m_fds;
 };
@@ -270,9 +270,7 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
-    Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
     if (collection_type == CollectionType::CollectGarbage) {
         if (m_gc_deferrals) {
@@ -285,6 +283,9 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     }
     finalize_unmarked_cells();
     sweep_dead_cells(print_report, collection_measurement_timer);
+
+    ++m_collection_count;
+    m_total_time_spent_collecting_garbage += collection_measurement_timer.elapsed_time();
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
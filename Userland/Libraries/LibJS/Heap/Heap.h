@@ -11,6 +11,7 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -66,6 +67,10 @@ public:
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     AK::JsonObject dump_graph();
 
+    // Number of collections that ran to completion, and the total time spent in them.
+    size_t collection_count() const { return m_collection_count; }
+    AK::Duration total_time_spent_collecting_garbage() const { return m_total_time_spent_collecting_garbage; }
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
@@ -160,6 +165,9 @@ private:
     bool m_should_gc_when_deferral_ends { false };
 
     bool m_collecting_garbage { false };
+
+    size_t m_collection_count { 0 };
+    AK::Duration m_total_time_spent_collecting_garbage;
 };
 
 inline void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
@@ -831,6 +831,36 @@ private:
     bool m_is_error_if_table_exists;
 };
 
+class CreateIndex : public Statement {
+public:
+    CreateIndex(ByteString schema_name, ByteString index_name, ByteString table_name, Vector<ByteString> column_names, bool is_unique, bool is_error_if_index_exists)
+        : m_schema_name(move(schema_name))
+        , m_index_name(move(index_name))
+        , m_table_name(move(table_name))
+        , m_column_names(move(column_names))
+        , m_is_unique(is_unique)
+        , m_is_error_if_index_exists(is_error_if_index_exists)
+    {
+    }
+
+    ByteString const& schema_name() const { return m_schema_name; }
+    ByteString const& index_name() const { return m_index_name; }
+    ByteString const& table_name() const { return m_table_name; }
+    Vector<ByteString> const& column_names() const { return m_column_names; }
+    bool is_unique() const { return m_is_unique; }
+    bool is_error_if_index_exists() const { return m_is_error_if_index_exists; }
+
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    ByteString m_schema_name;
+    ByteString m_index_name;
+    ByteString m_table_name;
+    Vector<ByteString> m_column_names;
+    bool m_is_unique;
+    bool m_is_error_if_index_exists;
+};
+
 class AlterTable : public Statement {
 public:
     ByteString const& schema_name() const { return m_schema_name; }
@@ -1081,6 +1111,7 @@ public:
     Vector<NonnullRefPtr<OrderingTerm>> const& ordering_term_list() const { return m_ordering_term_list; }
     RefPtr<LimitClause> const& limit_clause() const { return m_limit_clause; }
     ResultOr<ResultSet> execute(ExecutionContext&) const override;
+    ResultOr<Vector<TableAccessPlan>> plan(ExecutionContext&) const;
 
 private:
     RefPtr<CommonTableExpressionList> m_common_table_expression_list;
@@ -1107,4 +1138,18 @@ private:
     NonnullRefPtr<QualifiedTableName> m_qualified_table_name;
 };
 
+class Explain : public Statement {
+public:
+    explicit Explain(NonnullRefPtr<Select> select_statement)
+        : m_select_statement(move(select_statement))
+    {
+    }
+
+    NonnullRefPtr<Select> const& select_statement() const { return m_select_statement; }
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    NonnullRefPtr<Select> m_select_statement;
+};
+
 }
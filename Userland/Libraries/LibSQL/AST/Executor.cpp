@@ -0,0 +1,569 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AllOf.h>
+#include <AK/QuickSort.h>
+#include <AK/TypeCasts.h>
+#include <LibSQL/AST/Executor.h>
+#include <LibSQL/Meta.h>
+
+namespace SQL::AST {
+
+static NonnullRefPtr<TupleDescriptor> concatenate_descriptors(TupleDescriptor const& first, TupleDescriptor const& second)
+{
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->extend(first);
+    descriptor->extend(second);
+    return descriptor;
+}
+
+static Tuple concatenate_rows(NonnullRefPtr<TupleDescriptor> const& descriptor, Tuple const& first, Tuple const& second)
+{
+    Tuple row(descriptor);
+    VERIFY(row.size() == first.size() + second.size());
+
+    for (auto ix = 0u; ix < first.size(); ix++)
+        row[ix] = first[ix];
+    for (auto ix = 0u; ix < second.size(); ix++)
+        row[first.size() + ix] = second[ix];
+    return row;
+}
+
+SingleRowOperator::SingleRowOperator()
+    : Operator(adopt_ref(*new TupleDescriptor))
+{
+}
+
+ResultOr<Optional<Tuple>> SingleRowOperator::next(ExecutionContext&)
+{
+    if (m_done)
+        return Optional<Tuple> {};
+
+    m_done = true;
+    return Optional<Tuple> { Tuple(descriptor()) };
+}
+
+TableScanOperator::TableScanOperator(TableAccessPlan plan)
+    : Operator(plan.table().to_tuple_descriptor())
+    , m_plan(move(plan))
+{
+}
+
+ResultOr<Optional<Tuple>> TableScanOperator::next(ExecutionContext& context)
+{
+    if (!m_rows.has_value())
+        m_rows = TRY(m_plan.fetch_rows(context));
+    if (m_next_row_index >= m_rows->size())
+        return Optional<Tuple> {};
+
+    // Rows read from the heap don't know which table they belong to, so they are copied into a tuple with the table's
+    // descriptor for column names qualified with the table name to be resolved.
+    auto const& table_row = m_rows->at(m_next_row_index++);
+    Tuple row(descriptor());
+    for (auto ix = 0u; ix < min(row.size(), table_row.size()); ix++)
+        row[ix] = table_row[ix];
+    return Optional<Tuple> { move(row) };
+}
+
+FilterOperator::FilterOperator(NonnullOwnPtr<Operator> input, Vector<NonnullRefPtr<Expression>> predicates)
+    : Operator(input->descriptor())
+    , m_input(move(input))
+    , m_predicates(move(predicates))
+{
+}
+
+ResultOr<Optional<Tuple>> FilterOperator::next(ExecutionContext& context)
+{
+    while (true) {
+        auto row = TRY(m_input->next(context));
+        if (!row.has_value())
+            return Optional<Tuple> {};
+
+        context.current_row = &row.value();
+
+        bool matches = true;
+        for (auto const& predicate : m_predicates) {
+            auto result = TRY(predicate->evaluate(context)).to_bool();
+            if (!result.has_value() || !result.value()) {
+                matches = false;
+                break;
+            }
+        }
+
+        if (matches)
+            return row;
+    }
+}
+
+static NonnullOwnPtr<Operator> filtered(NonnullOwnPtr<Operator> input, Vector<NonnullRefPtr<Expression>> predicates)
+{
+    if (predicates.is_empty())
+        return input;
+    return make<FilterOperator>(move(input), move(predicates));
+}
+
+ProjectOperator::ProjectOperator(NonnullOwnPtr<Operator> input, Vector<NonnullRefPtr<Expression>> expressions)
+    : Operator(adopt_ref(*new TupleDescriptor))
+    , m_input(move(input))
+    , m_expressions(move(expressions))
+{
+    for (auto ix = 0u; ix < m_expressions.size(); ix++)
+        descriptor()->append({ .type = SQLType::Null });
+}
+
+ResultOr<Optional<Tuple>> ProjectOperator::next(ExecutionContext& context)
+{
+    auto row = TRY(m_input->next(context));
+    if (!row.has_value())
+        return Optional<Tuple> {};
+
+    context.current_row = &row.value();
+
+    Tuple projected_row(descriptor());
+    for (auto ix = 0u; ix < m_expressions.size(); ix++)
+        projected_row[ix] = TRY(m_expressions[ix]->evaluate(context));
+    return Optional<Tuple> { move(projected_row) };
+}
+
+bool SortOperator::SortedRow::operator<(SortedRow const& other) const
+{
+    // Unlike Tuple::compare(), this considers NULLs equal to each other, as sorting requires a consistent ordering.
+    auto const& sort_descriptor = *sort_key.descriptor();
+
+    for (auto ix = 0u; ix < sort_key.size(); ix++) {
+        auto const& value = sort_key[ix];
+        auto const& other_value = other.sort_key[ix];
+        if (value.is_null() && other_value.is_null())
+            continue;
+
+        auto result = value.compare(other_value);
+        if (result == 0)
+            continue;
+        if (sort_descriptor[ix].order == Order::Descending)
+            result = -result;
+        return result < 0;
+    }
+
+    return sequence_number < other.sequence_number;
+}
+
+SortOperator::SortOperator(NonnullOwnPtr<Operator> input, NonnullRefPtr<TupleDescriptor> sort_descriptor, Optional<size_t> limit)
+    : Operator(input->descriptor())
+    , m_input(move(input))
+    , m_sort_descriptor(move(sort_descriptor))
+    , m_limit(limit)
+{
+    VERIFY(m_sort_descriptor->size() <= descriptor()->size());
+}
+
+ResultOr<void> SortOperator::sort_input(ExecutionContext& context)
+{
+    IntrusiveBinaryHeap<SortedRow, LastRowFirst, NoIndexSetter> first_rows;
+    Vector<SortedRow> all_rows;
+
+    for (size_t sequence_number = 0;; ++sequence_number) {
+        auto row = TRY(m_input->next(context));
+        if (!row.has_value())
+            break;
+
+        Tuple sort_key(m_sort_descriptor);
+        auto first_sort_column = row->size() - m_sort_descriptor->size();
+        for (auto ix = 0u; ix < m_sort_descriptor->size(); ix++)
+            sort_key[ix] = (*row)[first_sort_column + ix];
+
+        SortedRow sorted_row { row.release_value(), move(sort_key), sequence_number };
+
+        if (!m_limit.has_value()) {
+            TRY(all_rows.try_append(move(sorted_row)));
+            continue;
+        }
+
+        if (first_rows.size() < *m_limit) {
+            first_rows.insert(move(sorted_row));
+        } else if (!first_rows.is_empty() && sorted_row < first_rows.peek_min()) {
+            // This row is among the first N rows seen so far, so the last of those no longer is.
+            (void)first_rows.pop_min();
+            first_rows.insert(move(sorted_row));
+        }
+    }
+
+    if (m_limit.has_value())
+        TRY(all_rows.try_extend(first_rows.nodes_in_arbitrary_order()));
+
+    quick_sort(all_rows);
+    m_sorted_rows = move(all_rows);
+    return {};
+}
+
+ResultOr<Optional<Tuple>> SortOperator::next(ExecutionContext& context)
+{
+    if (!m_sorted_rows.has_value())
+        TRY(sort_input(context));
+    if (m_next_row_index >= m_sorted_rows->size())
+        return Optional<Tuple> {};
+
+    return Optional<Tuple> { move(m_sorted_rows->at(m_next_row_index++).row) };
+}
+
+NestedLoopJoinOperator::NestedLoopJoinOperator(NonnullOwnPtr<Operator> outer, NonnullOwnPtr<Operator> inner)
+    : Operator(concatenate_descriptors(outer->descriptor(), inner->descriptor()))
+    , m_outer(move(outer))
+    , m_inner(move(inner))
+{
+}
+
+ResultOr<Optional<Tuple>> NestedLoopJoinOperator::next(ExecutionContext& context)
+{
+    if (!m_inner_rows.has_value()) {
+        Vector<Tuple> inner_rows;
+        while (true) {
+            auto row = TRY(m_inner->next(context));
+            if (!row.has_value())
+                break;
+            TRY(inner_rows.try_append(row.release_value()));
+        }
+        m_inner_rows = move(inner_rows);
+    }
+    if (m_inner_rows->is_empty())
+        return Optional<Tuple> {};
+
+    if (!m_outer_row.has_value() || m_next_inner_index >= m_inner_rows->size()) {
+        m_outer_row = TRY(m_outer->next(context));
+        if (!m_outer_row.has_value())
+            return Optional<Tuple> {};
+        m_next_inner_index = 0;
+    }
+
+    return Optional<Tuple> { concatenate_rows(descriptor(), *m_outer_row, m_inner_rows->at(m_next_inner_index++)) };
+}
+
+HashJoinOperator::HashJoinOperator(NonnullOwnPtr<Operator> probe, NonnullOwnPtr<Operator> build, Vector<NonnullRefPtr<Expression>> probe_keys, Vector<NonnullRefPtr<Expression>> build_keys)
+    : Operator(concatenate_descriptors(probe->descriptor(), build->descriptor()))
+    , m_probe(move(probe))
+    , m_build(move(build))
+    , m_probe_keys(move(probe_keys))
+    , m_build_keys(move(build_keys))
+{
+    VERIFY(!m_probe_keys.is_empty());
+    VERIFY(m_probe_keys.size() == m_build_keys.size());
+}
+
+ResultOr<Optional<Vector<Value>>> HashJoinOperator::evaluate_key(ExecutionContext& context, Tuple& row, Vector<NonnullRefPtr<Expression>> const& key_expressions)
+{
+    context.current_row = &row;
+
+    Vector<Value> key;
+    TRY(key.try_ensure_capacity(key_expressions.size()));
+
+    for (auto const& expression : key_expressions) {
+        auto value = TRY(expression->evaluate(context));
+        if (value.is_null())
+            return Optional<Vector<Value>> {};
+        key.unchecked_append(move(value));
+    }
+
+    return Optional<Vector<Value>> { move(key) };
+}
+
+u32 HashJoinOperator::hash_key(Vector<Value> const& key)
+{
+    u32 hash = 0;
+    for (auto const& value : key)
+        hash = hash == 0 ? value.hash() : pair_int_hash(hash, value.hash());
+    return hash;
+}
+
+ResultOr<void> HashJoinOperator::build_hash_table(ExecutionContext& context)
+{
+    HashMap<u32, Vector<BuildRow>> hash_table;
+
+    while (true) {
+        auto row = TRY(m_build->next(context));
+        if (!row.has_value())
+            break;
+
+        auto key = TRY(evaluate_key(context, *row, m_build_keys));
+        if (!key.has_value())
+            continue;
+
+        auto& bucket = hash_table.ensure(hash_key(*key));
+        TRY(bucket.try_append({ key.release_value(), row.release_value() }));
+    }
+
+    m_hash_table = move(hash_table);
+    return {};
+}
+
+ResultOr<Optional<Tuple>> HashJoinOperator::next(ExecutionContext& context)
+{
+    if (!m_hash_table.has_value())
+        TRY(build_hash_table(context));
+
+    while (true) {
+        while (m_candidates && m_next_candidate_index < m_candidates->size()) {
+            auto const& candidate = m_candidates->at(m_next_candidate_index++);
+
+            bool keys_are_equal = true;
+            for (auto ix = 0u; ix < m_probe_key.size(); ix++) {
+                if (m_probe_key[ix].compare(candidate.key[ix]) != 0) {
+                    keys_are_equal = false;
+                    break;
+                }
+            }
+
+            if (keys_are_equal)
+                return Optional<Tuple> { concatenate_rows(descriptor(), *m_probe_row, candidate.row) };
+        }
+
+        m_candidates = nullptr;
+        if (m_hash_table->is_empty())
+            return Optional<Tuple> {};
+
+        auto probe_row = TRY(m_probe->next(context));
+        if (!probe_row.has_value())
+            return Optional<Tuple> {};
+
+        auto key = TRY(evaluate_key(context, *probe_row, m_probe_keys));
+        if (!key.has_value())
+            continue;
+
+        auto bucket = m_hash_table->find(hash_key(*key));
+        if (bucket == m_hash_table->end())
+            continue;
+
+        m_probe_row = probe_row.release_value();
+        m_probe_key = key.release_value();
+        m_candidates = &bucket->value;
+        m_next_candidate_index = 0;
+    }
+}
+
+namespace {
+
+struct Conjunct {
+    NonnullRefPtr<Expression> expression;
+
+    // The tables the conjunct refers to, in ascending order. A conjunct referring to something that can't be tied to
+    // a single table of the statement is only evaluated once all tables have been joined.
+    Vector<size_t> tables;
+    bool is_resolved { true };
+    bool is_applied { false };
+
+    size_t stage(size_t number_of_tables) const
+    {
+        if (!is_resolved)
+            return number_of_tables - 1;
+        return tables.is_empty() ? 0 : tables.last();
+    }
+};
+
+struct EquiJoinKey {
+    NonnullRefPtr<Expression> outer_key;
+    NonnullRefPtr<Expression> inner_key;
+};
+
+}
+
+static Optional<size_t> table_of_column(ColumnNameExpression const& column, Vector<NonnullRefPtr<TableDef>> const& tables)
+{
+    for (auto ix = 0u; ix < tables.size(); ix++) {
+        if (column_refers_to_table(column, tables[ix], tables))
+            return ix;
+    }
+    return {};
+}
+
+static bool collect_tables(Expression const& expression, Vector<NonnullRefPtr<TableDef>> const& tables, Vector<size_t>& referenced_tables)
+{
+    auto collect = [&](RefPtr<Expression> const& child) {
+        return !child || collect_tables(*child, tables, referenced_tables);
+    };
+
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BlobLiteral>(expression)
+        || is<BooleanLiteral>(expression) || is<NullLiteral>(expression) || is<Placeholder>(expression)) {
+        return true;
+    }
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto table = table_of_column(static_cast<ColumnNameExpression const&>(expression), tables);
+        if (!table.has_value())
+            return false;
+        if (!referenced_tables.contains_slow(*table))
+            referenced_tables.append(*table);
+        return true;
+    }
+
+    if (is<ChainedExpression>(expression))
+        return all_of(static_cast<ChainedExpression const&>(expression).expressions(), collect);
+
+    if (is<CaseExpression>(expression)) {
+        auto const& case_expression = static_cast<CaseExpression const&>(expression);
+        return collect(case_expression.case_expression())
+            && all_of(case_expression.when_then_clauses(), [&](auto const& clause) { return collect(clause.when) && collect(clause.then); })
+            && collect(case_expression.else_expression());
+    }
+
+    // Sub-selects and table lookups can't be pushed down.
+    if (is<ExistsExpression>(expression) || is<InSelectionExpression>(expression) || is<InTableExpression>(expression))
+        return false;
+
+    if (is<InChainedExpression>(expression)) {
+        auto const& in_expression = static_cast<InChainedExpression const&>(expression);
+        return collect(in_expression.expression()) && collect(in_expression.expression_chain());
+    }
+
+    if (is<BetweenExpression>(expression)) {
+        auto const& between_expression = static_cast<BetweenExpression const&>(expression);
+        return collect(between_expression.expression()) && collect(between_expression.lhs()) && collect(between_expression.rhs());
+    }
+
+    if (is<MatchExpression>(expression)) {
+        auto const& match_expression = static_cast<MatchExpression const&>(expression);
+        return collect(match_expression.lhs()) && collect(match_expression.rhs()) && collect(match_expression.escape());
+    }
+
+    if (is<NestedDoubleExpression>(expression)) {
+        auto const& nested_expression = static_cast<NestedDoubleExpression const&>(expression);
+        return collect(nested_expression.lhs()) && collect(nested_expression.rhs());
+    }
+
+    if (is<NestedExpression>(expression))
+        return collect(static_cast<NestedExpression const&>(expression).expression());
+
+    return false;
+}
+
+static void collect_conjuncts(NonnullRefPtr<Expression> const& expression, Vector<NonnullRefPtr<TableDef>> const& tables, Vector<Conjunct>& conjuncts)
+{
+    if (is<BinaryOperatorExpression>(*expression)) {
+        auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(*expression);
+        if (binary_expression.type() == BinaryOperator::And) {
+            collect_conjuncts(binary_expression.lhs(), tables, conjuncts);
+            collect_conjuncts(binary_expression.rhs(), tables, conjuncts);
+            return;
+        }
+    }
+
+    Conjunct conjunct { expression };
+    conjunct.is_resolved = collect_tables(*expression, tables, conjunct.tables);
+    quick_sort(conjunct.tables);
+    conjuncts.append(move(conjunct));
+}
+
+static bool is_hashable(SQLType type)
+{
+    switch (type) {
+    case SQLType::Text:
+    case SQLType::Integer:
+    case SQLType::Boolean:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static Optional<SQLType> column_type(ColumnNameExpression const& column, TableDef const& table)
+{
+    for (auto const& column_def : table.columns()) {
+        if (column_def->name() == column.column_name())
+            return column_def->type();
+    }
+    return {};
+}
+
+// Returns the keys with which the table at the given position can be hash joined with the tables before it, if the
+// conjunct is an equality comparison between a column of that table and a column of a table before it.
+static Optional<EquiJoinKey> equi_join_key(Conjunct const& conjunct, size_t inner_table, Vector<NonnullRefPtr<TableDef>> const& tables)
+{
+    if (!conjunct.is_resolved || conjunct.tables.size() != 2 || conjunct.tables.last() != inner_table)
+        return {};
+    if (!is<BinaryOperatorExpression>(*conjunct.expression))
+        return {};
+
+    auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(*conjunct.expression);
+    if (binary_expression.type() != BinaryOperator::Equals)
+        return {};
+    if (!is<ColumnNameExpression>(*binary_expression.lhs()) || !is<ColumnNameExpression>(*binary_expression.rhs()))
+        return {};
+
+    auto const& lhs = static_cast<ColumnNameExpression const&>(*binary_expression.lhs());
+    auto const& rhs = static_cast<ColumnNameExpression const&>(*binary_expression.rhs());
+    auto lhs_table = *table_of_column(lhs, tables);
+    auto rhs_table = *table_of_column(rhs, tables);
+
+    // Values of different types may compare equal without hashing identically.
+    auto lhs_type = column_type(lhs, tables[lhs_table]);
+    if (!lhs_type.has_value() || !is_hashable(*lhs_type) || lhs_type != column_type(rhs, tables[rhs_table]))
+        return {};
+
+    if (rhs_table == inner_table)
+        return EquiJoinKey { binary_expression.lhs(), binary_expression.rhs() };
+    return EquiJoinKey { binary_expression.rhs(), binary_expression.lhs() };
+}
+
+NonnullOwnPtr<Operator> create_join_pipeline(Vector<TableAccessPlan> plans, RefPtr<Expression> const& where_clause)
+{
+    Vector<NonnullRefPtr<TableDef>> tables;
+    for (auto const& plan : plans)
+        tables.append(plan.table());
+
+    Vector<Conjunct> conjuncts;
+    if (where_clause)
+        collect_conjuncts(*where_clause, tables, conjuncts);
+
+    auto take_conjuncts = [&](auto predicate) {
+        Vector<NonnullRefPtr<Expression>> expressions;
+        for (auto& conjunct : conjuncts) {
+            if (conjunct.is_applied || !predicate(conjunct))
+                continue;
+            conjunct.is_applied = true;
+            expressions.append(conjunct.expression);
+        }
+        return expressions;
+    };
+
+    if (plans.is_empty())
+        return filtered(make<SingleRowOperator>(), take_conjuncts([](auto const&) { return true; }));
+
+    OwnPtr<Operator> pipeline;
+
+    for (auto ix = 0u; ix < plans.size(); ix++) {
+        // Conjuncts that only refer to this table are applied to its rows before they are joined with anything.
+        auto scan = filtered(make<TableScanOperator>(move(plans[ix])), take_conjuncts([&](auto const& conjunct) {
+            return conjunct.is_resolved && conjunct.stage(tables.size()) == ix && conjunct.tables.size() <= 1;
+        }));
+
+        if (!pipeline) {
+            pipeline = move(scan);
+        } else {
+            Vector<NonnullRefPtr<Expression>> outer_keys;
+            Vector<NonnullRefPtr<Expression>> inner_keys;
+
+            for (auto& conjunct : conjuncts) {
+                if (conjunct.is_applied)
+                    continue;
+                if (auto key = equi_join_key(conjunct, ix, tables); key.has_value()) {
+                    outer_keys.append(key->outer_key);
+                    inner_keys.append(key->inner_key);
+                    conjunct.is_applied = true;
+                }
+            }
+
+            if (inner_keys.is_empty())
+                pipeline = make<NestedLoopJoinOperator>(pipeline.release_nonnull(), move(scan));
+            else
+                pipeline = make<HashJoinOperator>(pipeline.release_nonnull(), move(scan), move(outer_keys), move(inner_keys));
+        }
+
+        pipeline = filtered(pipeline.release_nonnull(), take_conjuncts([&](auto const& conjunct) {
+            return conjunct.stage(tables.size()) == ix;
+        }));
+    }
+
+    return pipeline.release_nonnull();
+}
+
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BinaryHeap.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Result.h>
+#include <LibSQL/Row.h>
+#include <LibSQL/Tuple.h>
+#include <LibSQL/TupleDescriptor.h>
+
+namespace SQL::AST {
+
+/**
+ * An Operator is one stage of a pull-based query execution pipeline. Each call
+ * to next() produces the next row of the operator's output, pulling only as
+ * many rows from its inputs as it needs to do so, and returns an empty Optional
+ * once the output is exhausted. All rows produced by an operator share its
+ * descriptor.
+ */
+class Operator {
+    AK_MAKE_NONCOPYABLE(Operator);
+    AK_MAKE_NONMOVABLE(Operator);
+
+public:
+    virtual ~Operator() = default;
+
+    NonnullRefPtr<TupleDescriptor> const& descriptor() const { return m_descriptor; }
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) = 0;
+
+protected:
+    explicit Operator(NonnullRefPtr<TupleDescriptor> descriptor)
+        : m_descriptor(move(descriptor))
+    {
+    }
+
+private:
+    NonnullRefPtr<TupleDescriptor> m_descriptor;
+};
+
+// Produces a single row without any columns. This is the input of a SELECT statement without a FROM clause.
+class SingleRowOperator final : public Operator {
+public:
+    SingleRowOperator();
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    bool m_done { false };
+};
+
+// Produces the rows of a table, in the way described by a TableAccessPlan.
+class TableScanOperator final : public Operator {
+public:
+    explicit TableScanOperator(TableAccessPlan);
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    TableAccessPlan m_plan;
+    Optional<Vector<Row>> m_rows;
+    size_t m_next_row_index { 0 };
+};
+
+// Produces the rows of its input for which all of its predicates evaluate to true.
+class FilterOperator final : public Operator {
+public:
+    FilterOperator(NonnullOwnPtr<Operator> input, Vector<NonnullRefPtr<Expression>> predicates);
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<Operator> m_input;
+    Vector<NonnullRefPtr<Expression>> m_predicates;
+};
+
+// Produces the values of its expressions, evaluated for each row of its input.
+class ProjectOperator final : public Operator {
+public:
+    ProjectOperator(NonnullOwnPtr<Operator> input, Vector<NonnullRefPtr<Expression>> expressions);
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<Operator> m_input;
+    Vector<NonnullRefPtr<Expression>> m_expressions;
+};
+
+/**
+ * Produces the rows of its input ordered by a sort key, which consists of the
+ * input's trailing columns and is ordered as described by the sort descriptor.
+ * Rows with equal sort keys are produced in the order of the input.
+ *
+ * All rows of the input are collected and sorted when the first row is
+ * requested. If only the first N rows of the output are needed, only the N
+ * first rows seen so far are kept in a bounded heap instead, which takes
+ * O(n log N) time and O(N) memory.
+ */
+class SortOperator final : public Operator {
+public:
+    SortOperator(NonnullOwnPtr<Operator> input, NonnullRefPtr<TupleDescriptor> sort_descriptor, Optional<size_t> limit);
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    struct SortedRow {
+        Tuple row;
+        Tuple sort_key;
+        size_t sequence_number { 0 };
+
+        bool operator<(SortedRow const& other) const;
+    };
+
+    // Orders the heap of the first N rows such that its top is the last of them.
+    struct LastRowFirst {
+        bool operator()(SortedRow const& a, SortedRow const& b) const { return b < a; }
+    };
+
+    struct NoIndexSetter {
+        void operator()(SortedRow const&, size_t) const { }
+    };
+
+    ResultOr<void> sort_input(ExecutionContext&);
+
+    NonnullOwnPtr<Operator> m_input;
+    NonnullRefPtr<TupleDescriptor> m_sort_descriptor;
+    Optional<size_t> m_limit;
+
+    Optional<Vector<SortedRow>> m_sorted_rows;
+    size_t m_next_row_index { 0 };
+};
+
+/**
+ * Produces every combination of a row of the outer input followed by a row of
+ * the inner input. The outer input is streamed, while the rows of the inner
+ * input are collected once, when the first row is requested.
+ */
+class NestedLoopJoinOperator final : public Operator {
+public:
+    NestedLoopJoinOperator(NonnullOwnPtr<Operator> outer, NonnullOwnPtr<Operator> inner);
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<Operator> m_outer;
+    NonnullOwnPtr<Operator> m_inner;
+
+    Optional<Vector<Tuple>> m_inner_rows;
+    Optional<Tuple> m_outer_row;
+    size_t m_next_inner_index { 0 };
+};
+
+/**
+ * Produces the combinations of a row of the probe input followed by a row of
+ * the build input for which each probe key is equal to the corresponding build
+ * key. The build input is collected into a hash table keyed on the values of
+ * its keys when the first row is requested, after which the probe input is
+ * streamed. Rows with a NULL key never match, just as NULL is never equal to
+ * anything.
+ *
+ * The keys are hashed with Value::hash(), so their types must be such that
+ * equal values hash identically (i.e. they can't be Float).
+ */
+class HashJoinOperator final : public Operator {
+public:
+    HashJoinOperator(NonnullOwnPtr<Operator> probe, NonnullOwnPtr<Operator> build, Vector<NonnullRefPtr<Expression>> probe_keys, Vector<NonnullRefPtr<Expression>> build_keys);
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    struct BuildRow {
+        Vector<Value> key;
+        Tuple row;
+    };
+
+    ResultOr<void> build_hash_table(ExecutionContext&);
+    static ResultOr<Optional<Vector<Value>>> evaluate_key(ExecutionContext&, Tuple&, Vector<NonnullRefPtr<Expression>> const&);
+    static u32 hash_key(Vector<Value> const&);
+
+    NonnullOwnPtr<Operator> m_probe;
+    NonnullOwnPtr<Operator> m_build;
+    Vector<NonnullRefPtr<Expression>> m_probe_keys;
+    Vector<NonnullRefPtr<Expression>> m_build_keys;
+
+    Optional<HashMap<u32, Vector<BuildRow>>> m_hash_table;
+    Optional<Tuple> m_probe_row;
+    Vector<Value> m_probe_key;
+    Vector<BuildRow> const* m_candidates { nullptr };
+    size_t m_next_candidate_index { 0 };
+};
+
+/**
+ * Creates the operator pipeline producing the rows of the cartesian product of
+ * the tables in a SELECT statement which match its WHERE clause.
+ *
+ * The tables are joined in the order in which they appear in the FROM clause.
+ * Each conjunct of the WHERE clause is applied as soon as all the tables it
+ * refers to have been joined, so that rows are discarded as early as possible.
+ * A table is joined with a hash join if there are conjuncts comparing one of
+ * its columns for equality with a column of an already joined table, and with a
+ * nested loop join otherwise.
+ */
+NonnullOwnPtr<Operator> create_join_pipeline(Vector<TableAccessPlan>, RefPtr<Expression> const& where_clause);
+
+}
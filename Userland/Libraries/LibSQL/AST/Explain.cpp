@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/ResultSet.h>
+
+namespace SQL::AST {
+
+ResultOr<ResultSet> Explain::execute(ExecutionContext& context) const
+{
+    auto plans = TRY(m_select_statement->plan(context));
+
+    NonnullRefPtr<TupleDescriptor> descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->append({ "", "", "detail", SQLType::Text, Order::Ascending });
+
+    ResultSet result { SQLCommand::Explain, { "detail" } };
+    TRY(result.try_ensure_capacity(plans.size()));
+
+    for (auto const& plan : plans) {
+        Tuple tuple(descriptor);
+        tuple[0] = plan.to_byte_string();
+
+        result.insert_row(tuple, Tuple {});
+    }
+
+    return result;
+}
+
+}
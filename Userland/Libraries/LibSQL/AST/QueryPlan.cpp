@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
+#include <AK/TypeCasts.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Row.h>
+
+namespace SQL::AST {
+
+// A comparison of a column with a value that doesn't depend on the row, with the column on the left-hand side.
+struct Constraint {
+    ByteString column_name;
+    BinaryOperator op;
+    NonnullRefPtr<Expression> value;
+};
+
+static bool is_constant(Expression const& expression)
+{
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<Placeholder>(expression))
+        return true;
+    if (is<UnaryOperatorExpression>(expression))
+        return is_constant(*static_cast<UnaryOperatorExpression const&>(expression).expression());
+    return false;
+}
+
+static bool has_column(TableDef const& table, ByteString const& column_name)
+{
+    return any_of(table.columns(), [&](auto const& column) { return column->name() == column_name; });
+}
+
+bool column_refers_to_table(ColumnNameExpression const& column, TableDef const& table, Vector<NonnullRefPtr<TableDef>> const& tables_in_statement)
+{
+    if (!has_column(table, column.column_name()))
+        return false;
+    if (!column.table_name().is_empty())
+        return column.table_name() == table.name();
+
+    // An unqualified column name only refers to this table if no other table in the statement has such a column.
+    return all_of(tables_in_statement, [&](auto const& other_table) {
+        return other_table.ptr() == &table || !has_column(other_table, column.column_name());
+    });
+}
+
+static BinaryOperator with_operands_swapped(BinaryOperator op)
+{
+    switch (op) {
+    case BinaryOperator::LessThan:
+        return BinaryOperator::GreaterThan;
+    case BinaryOperator::LessThanEquals:
+        return BinaryOperator::GreaterThanEquals;
+    case BinaryOperator::GreaterThan:
+        return BinaryOperator::LessThan;
+    case BinaryOperator::GreaterThanEquals:
+        return BinaryOperator::LessThanEquals;
+    default:
+        return op;
+    }
+}
+
+static void collect_constraints(Expression const& expression, TableDef const& table, Vector<NonnullRefPtr<TableDef>> const& tables_in_statement, Vector<Constraint>& constraints)
+{
+    if (!is<BinaryOperatorExpression>(expression))
+        return;
+    auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(expression);
+
+    switch (binary_expression.type()) {
+    case BinaryOperator::And:
+        collect_constraints(binary_expression.lhs(), table, tables_in_statement, constraints);
+        collect_constraints(binary_expression.rhs(), table, tables_in_statement, constraints);
+        return;
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+    case BinaryOperator::Equals:
+        break;
+    default:
+        return;
+    }
+
+    auto try_add_constraint = [&](Expression const& column, NonnullRefPtr<Expression> const& value, BinaryOperator op) {
+        if (!is<ColumnNameExpression>(column) || !is_constant(value))
+            return false;
+
+        auto const& column_name_expression = static_cast<ColumnNameExpression const&>(column);
+        if (!column_refers_to_table(column_name_expression, table, tables_in_statement))
+            return false;
+
+        constraints.append({ column_name_expression.column_name(), op, value });
+        return true;
+    };
+
+    if (!try_add_constraint(binary_expression.lhs(), binary_expression.rhs(), binary_expression.type()))
+        try_add_constraint(binary_expression.rhs(), binary_expression.lhs(), with_operands_swapped(binary_expression.type()));
+}
+
+TableAccessPlan TableAccessPlan::create(NonnullRefPtr<TableDef> table, Vector<NonnullRefPtr<TableDef>> const& tables_in_statement, RefPtr<Expression> const& where_clause)
+{
+    TableAccessPlan plan(table);
+    if (!where_clause || table->indexes().is_empty())
+        return plan;
+
+    Vector<Constraint> constraints;
+    collect_constraints(*where_clause, table, tables_in_statement, constraints);
+    if (constraints.is_empty())
+        return plan;
+
+    size_t best_score = 0;
+
+    for (auto const& index : table->indexes()) {
+        TableAccessPlan candidate(table);
+        candidate.m_index = index;
+
+        for (auto const& part : index->key_definition()) {
+            auto equality = constraints.find_if([&](auto const& constraint) {
+                return constraint.column_name == part->name() && constraint.op == BinaryOperator::Equals;
+            });
+            if (!equality.is_end()) {
+                candidate.m_equality_values.append(equality->value);
+                continue;
+            }
+
+            for (auto const& constraint : constraints) {
+                if (constraint.column_name != part->name())
+                    continue;
+
+                if (constraint.op == BinaryOperator::GreaterThan || constraint.op == BinaryOperator::GreaterThanEquals) {
+                    if (!candidate.m_lower_bound.has_value())
+                        candidate.m_lower_bound = Bound { constraint.value, constraint.op == BinaryOperator::GreaterThanEquals };
+                } else if (constraint.op == BinaryOperator::LessThan || constraint.op == BinaryOperator::LessThanEquals) {
+                    if (!candidate.m_upper_bound.has_value())
+                        candidate.m_upper_bound = Bound { constraint.value, constraint.op == BinaryOperator::LessThanEquals };
+                }
+            }
+            break;
+        }
+
+        // Each key part matched for equality narrows the search more than any range could. Among otherwise equal
+        // candidates, a range bounded on both sides beats one bounded on one side, and a unique index matched on
+        // its whole key (which finds at most one row) beats a non-unique one.
+        auto score = candidate.m_equality_values.size() * 4;
+        score += candidate.m_lower_bound.has_value() ? 1 : 0;
+        score += candidate.m_upper_bound.has_value() ? 1 : 0;
+        if (index->unique() && candidate.m_equality_values.size() == index->size())
+            score += 2;
+
+        if (score > best_score) {
+            best_score = score;
+            plan = move(candidate);
+        }
+    }
+
+    return plan;
+}
+
+ResultOr<Vector<Row>> TableAccessPlan::fetch_rows(ExecutionContext& context) const
+{
+    if (!m_index)
+        return TRY(context.database->select_all(*m_table));
+
+    // A value that is NULL, or can't be compared with the indexed column, can't be searched for. Leave it to the
+    // WHERE clause to decide which rows it matches.
+    auto evaluate_key_part = [&](Expression const& expression, size_t key_part) -> ResultOr<Optional<Value>> {
+        auto value = TRY(expression.evaluate(context));
+        if (!value.is_type_compatible_with(m_index->key_definition()[key_part]->type()))
+            return Optional<Value> {};
+        return value;
+    };
+
+    Vector<Value> lower_bound;
+    for (auto ix = 0u; ix < m_equality_values.size(); ix++) {
+        auto value = TRY(evaluate_key_part(m_equality_values[ix], ix));
+        if (!value.has_value())
+            return TRY(context.database->select_all(*m_table));
+        lower_bound.append(value.release_value());
+    }
+
+    auto upper_bound = lower_bound;
+    auto range_key_part = m_equality_values.size();
+
+    // The index is searched with inclusive bounds, the WHERE clause filters out the rows equal to an exclusive one.
+    if (m_lower_bound.has_value()) {
+        if (auto value = TRY(evaluate_key_part(m_lower_bound->value, range_key_part)); value.has_value())
+            lower_bound.append(value.release_value());
+    }
+    if (m_upper_bound.has_value()) {
+        if (auto value = TRY(evaluate_key_part(m_upper_bound->value, range_key_part)); value.has_value())
+            upper_bound.append(value.release_value());
+    }
+
+    if (lower_bound.is_empty() && upper_bound.is_empty())
+        return TRY(context.database->select_all(*m_table));
+    return TRY(context.database->search(*m_table, *m_index, lower_bound, upper_bound));
+}
+
+ByteString TableAccessPlan::to_byte_string() const
+{
+    if (!m_index)
+        return ByteString::formatted("SCAN {}", m_table->name());
+
+    auto const& key_definition = m_index->key_definition();
+
+    Vector<ByteString> constraints;
+    for (auto ix = 0u; ix < m_equality_values.size(); ix++)
+        constraints.append(ByteString::formatted("{}=?", key_definition[ix]->name()));
+    if (m_lower_bound.has_value())
+        constraints.append(ByteString::formatted("{}{}?", key_definition[m_equality_values.size()]->name(), m_lower_bound->is_inclusive ? ">="sv : ">"sv));
+    if (m_upper_bound.has_value())
+        constraints.append(ByteString::formatted("{}{}?", key_definition[m_equality_values.size()]->name(), m_upper_bound->is_inclusive ? "<="sv : "<"sv));
+
+    return ByteString::formatted("SEARCH {} USING INDEX {} ({})", m_table->name(), m_index->name(), ByteString::join(" AND "sv, constraints));
+}
+
+}
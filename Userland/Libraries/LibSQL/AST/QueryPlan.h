@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Result.h>
+
+namespace SQL::AST {
+
+/**
+ * A TableAccessPlan describes how the rows of one table in a SELECT statement
+ * are retrieved. Without a usable index, all rows of the table are scanned.
+ * Otherwise, the WHERE clause's equality constraints on a leading part of an
+ * index's key, optionally followed by a range constraint on the next key part,
+ * are used to search the index.
+ *
+ * The rows returned by an index search are a superset of the rows matching
+ * those constraints, so the WHERE clause still has to be evaluated for each
+ * of them.
+ */
+class TableAccessPlan {
+public:
+    static TableAccessPlan create(NonnullRefPtr<TableDef>, Vector<NonnullRefPtr<TableDef>> const& tables_in_statement, RefPtr<Expression> const& where_clause);
+
+    TableDef& table() const { return *m_table; }
+    RefPtr<IndexDef> const& index() const { return m_index; }
+    bool uses_index() const { return !m_index.is_null(); }
+
+    ResultOr<Vector<Row>> fetch_rows(ExecutionContext&) const;
+    ByteString to_byte_string() const;
+
+private:
+    explicit TableAccessPlan(NonnullRefPtr<TableDef> table)
+        : m_table(move(table))
+    {
+    }
+
+    struct Bound {
+        NonnullRefPtr<Expression> value;
+        bool is_inclusive { true };
+    };
+
+    NonnullRefPtr<TableDef> m_table;
+    RefPtr<IndexDef> m_index;
+
+    // Values of the leading key parts of the index, in key order.
+    Vector<NonnullRefPtr<Expression>> m_equality_values;
+
+    // Bounds on the key part following the ones constrained by m_equality_values.
+    Optional<Bound> m_lower_bound;
+    Optional<Bound> m_upper_bound;
+};
+
+// Whether a column name in a statement refers to a column of the given table, out of all tables in the statement.
+bool column_refers_to_table(ColumnNameExpression const&, TableDef const&, Vector<NonnullRefPtr<TableDef>> const& tables_in_statement);
+
+}
@@ -6,6 +6,8 @@
 
 #include <AK/NumericLimits.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/Executor.h>
+#include <LibSQL/AST/QueryPlan.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
@@ -37,6 +39,23 @@ static ByteString result_column_name(ResultColumn const& column, size_t column_i
     return fallback_column_name();
 }
 
+ResultOr<Vector<TableAccessPlan>> Select::plan(ExecutionContext& context) const
+{
+    Vector<NonnullRefPtr<TableDef>> tables;
+    for (auto& table_descriptor : table_or_subquery_list()) {
+        if (!table_descriptor->is_table())
+            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+
+        tables.append(TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name())));
+    }
+
+    Vector<TableAccessPlan> plans;
+    TRY(plans.try_ensure_capacity(tables.size()));
+    for (auto const& table : tables)
+        plans.unchecked_append(TableAccessPlan::create(table, tables, where_clause()));
+    return plans;
+}
+
 ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 {
     Vector<NonnullRefPtr<ResultColumn const>> columns;
@@ -85,75 +104,21 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
     ResultSet result { SQLCommand::Select, move(column_names) };
 
-    auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
-    descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
-
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor->is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
-
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
-
-        auto old_descriptor_size = descriptor->size();
-        descriptor->extend(table_def->to_tuple_descriptor());
-
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
-
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
-            }
-        }
-    }
-
-    bool has_ordering { false };
     auto sort_descriptor = adopt_ref(*new TupleDescriptor);
-    for (auto& term : m_ordering_term_list) {
+    for (auto& term : m_ordering_term_list)
         sort_descriptor->append(TupleElementDescriptor { .order = term->order() });
-        has_ordering = true;
-    }
-    Tuple sort_key(sort_descriptor);
-
-    for (auto& row : rows) {
-        context.current_row = &row;
-
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
 
-        tuple.clear();
+    // The projection evaluates the result columns followed by the ordering terms, which are split again below.
+    Vector<NonnullRefPtr<Expression>> projected_expressions;
+    for (auto& col : columns)
+        projected_expressions.append(*col->expression());
+    for (auto& term : m_ordering_term_list)
+        projected_expressions.append(term->expression());
 
-        for (auto& col : columns) {
-            auto value = TRY(col->expression()->evaluate(context));
-            tuple.append(value);
-        }
-
-        if (has_ordering) {
-            sort_key.clear();
-            for (auto& term : m_ordering_term_list) {
-                auto value = TRY(term->expression()->evaluate(context));
-                sort_key.append(value);
-            }
-        }
-
-        result.insert_row(tuple, sort_key);
-    }
+    size_t limit_value = NumericLimits<size_t>::max();
+    size_t offset_value = 0;
 
     if (m_limit_clause != nullptr) {
-        size_t limit_value = NumericLimits<size_t>::max();
-        size_t offset_value = 0;
-
         auto limit = TRY(m_limit_clause->limit_expression()->evaluate(context));
         if (!limit.is_null()) {
             auto limit_value_maybe = limit.to_int<size_t>();
@@ -173,10 +138,48 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
                 offset_value = offset_value_maybe.value();
             }
         }
+    }
 
-        result.limit(offset_value, limit_value);
+    // No more rows need to be produced once those within the limit have been found.
+    Optional<size_t> row_limit;
+    if (limit_value != NumericLimits<size_t>::max())
+        row_limit = offset_value > NumericLimits<size_t>::max() - limit_value ? NumericLimits<size_t>::max() : offset_value + limit_value;
+
+    Vector<TableAccessPlan> table_plans;
+    for (auto& table_plan : TRY(plan(context))) {
+        if (table_plan.table().num_columns() != 0)
+            table_plans.append(move(table_plan));
     }
 
+    NonnullOwnPtr<Operator> pipeline = make<ProjectOperator>(create_join_pipeline(move(table_plans), where_clause()), move(projected_expressions));
+    if (!m_ordering_term_list.is_empty())
+        pipeline = make<SortOperator>(move(pipeline), sort_descriptor, row_limit);
+
+    Tuple tuple;
+    Tuple sort_key(sort_descriptor);
+
+    while (!row_limit.has_value() || result.size() < *row_limit) {
+        auto projected_row = TRY(pipeline->next(context));
+        if (!projected_row.has_value())
+            break;
+
+        tuple.clear();
+        for (auto ix = 0u; ix < columns.size(); ix++)
+            tuple.append((*projected_row)[ix]);
+
+        sort_key.clear();
+        for (auto ix = columns.size(); ix < projected_row->size(); ix++)
+            sort_key.append((*projected_row)[ix]);
+
+        result.insert_row(tuple, sort_key);
+    }
+
+    // The rows the pipeline evaluated expressions against are gone now.
+    context.current_row = nullptr;
+
+    if (m_limit_clause != nullptr)
+        result.limit(offset_value, limit_value);
+
     return result;
 }
 
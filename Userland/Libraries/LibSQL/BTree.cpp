@@ -103,6 +103,58 @@ BTreeIterator BTree::find(Key const& key)
     return end();
 }
 
+BTreeIterator BTree::lower_bound(Key const& key)
+{
+    if (!m_root)
+        initialize_root();
+
+    // Returns the first entry that is not less than the key, which may be a prefix of the tree's keys. Unlike find(),
+    // this has to go all the way down: non-leaf nodes hold entries too, and entries equal to a separator key can end
+    // up in the subtree on either side of it.
+    TreeNode* lower_bound_node = nullptr;
+    size_t lower_bound_index = 0;
+    for (auto* node = m_root.ptr(); node;) {
+        size_t ix = 0;
+        while ((ix < node->size()) && ((*node)[ix] < key))
+            ix++;
+        if (ix < node->size()) {
+            lower_bound_node = node;
+            lower_bound_index = ix;
+        }
+        if (node->is_leaf())
+            break;
+        node = node->down_node(ix);
+    }
+
+    if (!lower_bound_node)
+        return end();
+    return BTreeIterator(lower_bound_node, (int)lower_bound_index);
+}
+
+ErrorOr<void> BTree::free_storage()
+{
+    if (!m_root)
+        initialize_root();
+
+    Vector<TreeNode*> nodes { m_root.ptr() };
+    while (!nodes.is_empty()) {
+        auto* node = nodes.take_last();
+        if (!node->is_leaf()) {
+            for (auto ix = 0u; ix <= node->size(); ix++)
+                nodes.append(node->down_node(ix));
+        }
+        // The root of a tree that never had any keys inserted was never written.
+        if (serializer().has_block(node->block_index()))
+            TRY(serializer().heap().free_storage(node->block_index()));
+    }
+
+    m_root = nullptr;
+    set_block_index(0);
+    if (on_new_root)
+        on_new_root();
+    return {};
+}
+
 void BTree::list_tree()
 {
     if (!m_root)
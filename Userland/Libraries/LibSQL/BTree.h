@@ -101,9 +101,11 @@ public:
     bool update_key_pointer(Key const&);
     Optional<u32> get(Key&);
     BTreeIterator find(Key const& key);
+    BTreeIterator lower_bound(Key const& key);
     BTreeIterator begin();
     static BTreeIterator end();
     void list_tree();
+    ErrorOr<void> free_storage();
 
     Function<void(void)> on_new_root;
 
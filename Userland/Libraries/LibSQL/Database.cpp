@@ -6,6 +6,7 @@
  */
 
 #include <AK/ByteString.h>
+#include <AK/HashTable.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Heap.h>
@@ -47,6 +48,11 @@ ResultOr<void> Database::open()
         m_heap->set_table_columns_root(m_table_columns->root());
     };
 
+    m_indexes = TRY(BTree::create(m_serializer, IndexDef::index_def()->to_tuple_descriptor(), m_heap->indexes_root()));
+    m_indexes->on_new_root = [&]() {
+        m_heap->set_indexes_root(m_indexes->root());
+    };
+
     m_open = true;
 
     auto ensure_schema_exists = [&](auto schema_name) -> ResultOr<NonnullRefPtr<SchemaDef>> {
@@ -83,16 +89,32 @@ Database::~Database() = default;
 ErrorOr<void> Database::commit()
 {
     VERIFY(is_open());
+
+    while (!m_tables_with_stale_indexes.is_empty()) {
+        auto table = m_tables_with_stale_indexes.begin()->value;
+        TRY(rebuild_indexes(table));
+    }
+
     TRY(m_heap->flush());
     return {};
 }
 
+ErrorOr<void> Database::sync()
+{
+    VERIFY(is_open());
+    TRY(commit());
+    TRY(m_heap->sync());
+    return {};
+}
+
 ResultOr<void> Database::add_schema(SchemaDef const& schema)
 {
     VERIFY(is_open());
 
     if (!m_schemas->insert(schema.key()))
         return Result { SQLCommand::Unknown, SQLErrorCode::SchemaExists, schema.name() };
+
+    ++m_schema_version;
     return {};
 }
 
@@ -136,6 +158,7 @@ ResultOr<void> Database::add_table(TableDef& table)
             VERIFY_NOT_REACHED();
     }
 
+    ++m_schema_version;
     return {};
 }
 
@@ -172,9 +195,152 @@ ResultOr<NonnullRefPtr<TableDef>> Database::get_table(ByteString const& schema,
     for (auto it = m_table_columns->find(column_key); !it.is_end() && ((*it)["table_hash"].to_int<u32>() == table_hash); ++it)
         table_def->append_column(*it);
 
+    auto index_key = IndexDef::make_key(table_def);
+    for (auto it = m_indexes->find(index_key); !it.is_end() && ((*it)["table_hash"].to_int<u32>() == table_hash); ++it) {
+        auto index_def = TRY(IndexDef::create(table_def.ptr(), (*it)["index_name"].to_byte_string(), (*it)["unique"].to_int<u32>() == 1u, (*it).block_index()));
+
+        auto index_hash = index_def->hash();
+        auto key_part_key = ColumnDef::make_key(index_def);
+        for (auto part_it = m_table_columns->find(key_part_key); !part_it.is_end() && ((*part_it)["table_hash"].to_int<u32>() == index_hash); ++part_it) {
+            auto column_type = (*part_it)["column_type"].to_int<UnderlyingType<SQLType>>();
+            VERIFY(column_type.has_value());
+            index_def->append_column((*part_it)["column_name"].to_byte_string(), static_cast<SQLType>(*column_type));
+        }
+
+        table_def->append_index(index_def);
+    }
+
     return table_def;
 }
 
+static Key make_index_key(IndexDef const& index, Row const& row)
+{
+    Key key(index.to_tuple_descriptor());
+    for (auto ix = 0u; ix < index.size(); ix++)
+        key[ix] = row[index.key_definition()[ix]->name()];
+    key.set_block_index(row.block_index());
+    return key;
+}
+
+static Key make_index_prefix_key(IndexDef const& index, Vector<Value> const& values)
+{
+    VERIFY(!values.is_empty() && values.size() <= index.size());
+
+    NonnullRefPtr<TupleDescriptor> descriptor = adopt_ref(*new TupleDescriptor);
+    for (auto ix = 0u; ix < values.size(); ix++) {
+        auto const& part = index.key_definition()[ix];
+        descriptor->append({ "", "", part->name(), part->type(), part->sort_order() });
+    }
+
+    Key key(descriptor);
+    for (auto ix = 0u; ix < values.size(); ix++)
+        key[ix] = values[ix];
+    return key;
+}
+
+ResultOr<void> Database::add_index(TableDef& table, IndexDef& index)
+{
+    VERIFY(is_open());
+    VERIFY(index.parent() == &table);
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+
+    auto index_key = IndexDef::make_key(table);
+    index_key["index_name"] = index.name();
+    if (!m_indexes->find(index_key).is_end())
+        return Result { SQLCommand::Create, SQLErrorCode::IndexExists, index.name() };
+
+    // Build the tree before recording the index, so that an index which can't be created leaves nothing behind.
+    auto tree = TRY(BTree::create(m_serializer, index.to_tuple_descriptor(), false, 0));
+    tree->on_new_root = [&]() {
+        index.set_block_index(tree->root());
+    };
+
+    for (auto& row : TRY(select_all(table))) {
+        auto key = make_index_key(index, row);
+        if (index.unique()) {
+            if (auto result = verify_unique(table, index, *tree, key); result.is_error()) {
+                TRY(tree->free_storage());
+                return result.release_error();
+            }
+        }
+        tree->insert(key);
+    }
+
+    if (!m_indexes->insert(index.key()))
+        VERIFY_NOT_REACHED();
+    for (auto const& part : index.key_definition()) {
+        if (!m_table_columns->insert(part->key()))
+            VERIFY_NOT_REACHED();
+    }
+
+    table.append_index(index);
+    register_index_tree(index, move(tree));
+    ++m_schema_version;
+    return {};
+}
+
+void Database::register_index_tree(IndexDef& index, NonnullRefPtr<BTree> tree)
+{
+    tree->on_new_root = [this, index_def = NonnullRefPtr { index }, index_tree = tree.ptr()]() {
+        index_def->set_block_index(index_tree->root());
+        VERIFY(m_indexes->update_key_pointer(index_def->key()));
+    };
+    m_index_trees.set(index.hash(), move(tree));
+}
+
+ErrorOr<NonnullRefPtr<BTree>> Database::index_tree(TableDef& table, IndexDef& index)
+{
+    if (m_tables_with_stale_indexes.contains(table.hash()))
+        TRY(rebuild_indexes(table));
+
+    auto index_hash = index.hash();
+    if (auto tree = m_index_trees.get(index_hash); tree.has_value())
+        return *tree;
+
+    auto tree = TRY(BTree::create(m_serializer, index.to_tuple_descriptor(), false, index.block_index()));
+    register_index_tree(index, tree);
+    return tree;
+}
+
+ErrorOr<void> Database::rebuild_indexes(TableDef& table)
+{
+    // The BTree can't delete keys, so the indexes of a table that had rows removed are rebuilt from scratch.
+    m_tables_with_stale_indexes.remove(table.hash());
+
+    auto rows = TRY(select_all(table));
+    for (auto const& index : table.indexes()) {
+        auto tree = TRY(index_tree(table, index));
+        TRY(tree->free_storage());
+
+        for (auto const& row : rows)
+            tree->insert(make_index_key(index, row));
+    }
+
+    return {};
+}
+
+ResultOr<void> Database::verify_unique(TableDef& table, IndexDef const& index, BTree& tree, Key const& key)
+{
+    // NULLs never compare equal to each other, so they can't violate a unique constraint.
+    for (auto ix = 0u; ix < key.size(); ix++) {
+        if (key[ix].is_null())
+            return {};
+    }
+
+    for (auto it = tree.lower_bound(key); !it.is_end() && ((*it).compare(key) == 0); ++it) {
+        auto block_index = (*it).block_index();
+        if (block_index == key.block_index())
+            continue;
+
+        // Updating a row's key leaves its previous entry in the index, so only count rows that still have this key.
+        auto row = m_serializer.deserialize_block<Row>(block_index, table, block_index);
+        if (make_index_key(index, row).compare(key) == 0)
+            return Result { SQLCommand::Unknown, SQLErrorCode::UniqueConstraintViolated, index.name() };
+    }
+
+    return {};
+}
+
 ErrorOr<Vector<Row>> Database::select_all(TableDef& table)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -200,16 +366,63 @@ ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
     return ret;
 }
 
-ErrorOr<void> Database::insert(Row& row)
+ErrorOr<Vector<Row>> Database::search(TableDef& table, IndexDef& index, Vector<Value> const& lower_bound, Vector<Value> const& upper_bound)
+{
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    VERIFY(index.parent() == &table);
+
+    auto tree = TRY(index_tree(table, index));
+    auto it = lower_bound.is_empty() ? tree->begin() : tree->lower_bound(make_index_prefix_key(index, lower_bound));
+
+    Optional<Key> upper_bound_key;
+    if (!upper_bound.is_empty())
+        upper_bound_key = make_index_prefix_key(index, upper_bound);
+
+    // Both bounds are inclusive, and entries left behind by updates are not filtered out here. The caller is
+    // expected to check the returned rows against its own predicate.
+    Vector<Row> rows;
+    HashTable<Block::Index> seen_rows;
+    for (; !it.is_end(); ++it) {
+        auto const& entry = *it;
+        if (upper_bound_key.has_value() && (entry.compare(*upper_bound_key) > 0))
+            break;
+
+        auto block_index = entry.block_index();
+        if (seen_rows.set(block_index) != HashSetResult::InsertedNewEntry)
+            continue;
+        TRY(rows.try_append(m_serializer.deserialize_block<Row>(block_index, table, block_index)));
+    }
+    return rows;
+}
+
+struct PendingIndexEntry {
+    NonnullRefPtr<BTree> tree;
+    Key key;
+};
+
+ResultOr<void> Database::insert(Row& row)
 {
-    VERIFY(m_table_cache.get(row.table().key().hash()).has_value());
-    // TODO: implement table constraints such as unique, foreign key, etc.
+    auto& table = row.table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    // TODO: implement table constraints such as foreign key, etc.
+
+    Vector<PendingIndexEntry> index_entries;
+    for (auto const& index : table.indexes()) {
+        auto tree = TRY(index_tree(table, index));
+        auto key = make_index_key(index, row);
+        if (index->unique())
+            TRY(verify_unique(table, index, tree, key));
+        index_entries.append({ move(tree), move(key) });
+    }
 
     row.set_block_index(m_heap->request_new_block_index());
-    row.set_next_block_index(row.table().block_index());
-    TRY(update(row));
+    row.set_next_block_index(table.block_index());
+    TRY(write_row(row));
 
-    // TODO update indexes defined on table.
+    for (auto& entry : index_entries) {
+        entry.key.set_block_index(row.block_index());
+        entry.tree->insert(entry.key);
+    }
 
     auto table_key = row.table().key();
     table_key.set_block_index(row.block_index());
@@ -224,6 +437,8 @@ ErrorOr<void> Database::remove(Row& row)
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
 
     TRY(m_heap->free_storage(row.block_index()));
+    if (!table.indexes().is_empty())
+        m_tables_with_stale_indexes.set(table.hash(), table);
 
     if (table.block_index() == row.block_index()) {
         auto table_key = table.key();
@@ -239,7 +454,7 @@ ErrorOr<void> Database::remove(Row& row)
 
         if (current.next_block_index() == row.block_index()) {
             current.set_next_block_index(row.next_block_index());
-            TRY(update(current));
+            TRY(write_row(current));
             break;
         }
 
@@ -249,15 +464,41 @@ ErrorOr<void> Database::remove(Row& row)
     return {};
 }
 
-ErrorOr<void> Database::update(Row& tuple)
+ResultOr<void> Database::update(Row& row)
 {
-    VERIFY(m_table_cache.get(tuple.table().key().hash()).has_value());
-    // TODO: implement table constraints such as unique, foreign key, etc.
+    auto& table = row.table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    // TODO: implement table constraints such as foreign key, etc.
+
+    // Rows whose key changed get an additional index entry. The entry for the previous key stays in place until the
+    // index is next rebuilt; searches skip it because the row no longer matches.
+    Vector<PendingIndexEntry> index_entries;
+    if (!table.indexes().is_empty()) {
+        auto previous_row = m_serializer.deserialize_block<Row>(row.block_index(), table, row.block_index());
+
+        for (auto const& index : table.indexes()) {
+            auto key = make_index_key(index, row);
+            if (key.compare(make_index_key(index, previous_row)) == 0)
+                continue;
+
+            auto tree = TRY(index_tree(table, index));
+            if (index->unique())
+                TRY(verify_unique(table, index, tree, key));
+            index_entries.append({ move(tree), move(key) });
+        }
+    }
 
-    m_serializer.reset();
-    m_serializer.serialize_and_write<Tuple>(tuple);
+    TRY(write_row(row));
 
-    // TODO update indexes defined on table.
+    for (auto& entry : index_entries)
+        entry.tree->insert(entry.key);
+    return {};
+}
+
+ErrorOr<void> Database::write_row(Row& row)
+{
+    m_serializer.reset();
+    m_serializer.serialize_and_write<Tuple>(row);
     return {};
 }
 
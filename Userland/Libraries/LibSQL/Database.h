@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefPtr.h>
 #include <LibSQL/Forward.h>
@@ -31,6 +32,10 @@ public:
     ResultOr<void> open();
     bool is_open() const { return m_open; }
     ErrorOr<void> commit();
+
+    // Makes committed changes durable. See Heap::sync().
+    ErrorOr<void> sync();
+    bool has_unsynced_changes() const { return m_heap->has_unsynced_changes(); }
     ErrorOr<size_t> file_size_in_bytes() const { return m_heap->file_size_in_bytes(); }
 
     ResultOr<void> add_schema(SchemaDef const&);
@@ -41,24 +46,44 @@ public:
     static Key get_table_key(ByteString const&, ByteString const&);
     ResultOr<NonnullRefPtr<TableDef>> get_table(ByteString const&, ByteString const&);
 
+    ResultOr<void> add_index(TableDef&, IndexDef&);
+
+    // Incremented whenever a schema, table or index is added, so that anything derived from the schema can tell
+    // whether it is still up to date.
+    u64 schema_version() const { return m_schema_version; }
+
     ErrorOr<Vector<Row>> select_all(TableDef&);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
-    ErrorOr<void> insert(Row&);
+    ErrorOr<Vector<Row>> search(TableDef&, IndexDef&, Vector<Value> const& lower_bound, Vector<Value> const& upper_bound);
+    ResultOr<void> insert(Row&);
     ErrorOr<void> remove(Row&);
-    ErrorOr<void> update(Row&);
+    ResultOr<void> update(Row&);
 
 private:
     explicit Database(NonnullRefPtr<Heap>);
 
+    ErrorOr<void> write_row(Row&);
+
+    ErrorOr<NonnullRefPtr<BTree>> index_tree(TableDef&, IndexDef&);
+    void register_index_tree(IndexDef&, NonnullRefPtr<BTree>);
+    ErrorOr<void> rebuild_indexes(TableDef&);
+    ResultOr<void> verify_unique(TableDef&, IndexDef const&, BTree&, Key const&);
+
     bool m_open { false };
+    u64 m_schema_version { 0 };
     NonnullRefPtr<Heap> m_heap;
     Serializer m_serializer;
     RefPtr<BTree> m_schemas;
     RefPtr<BTree> m_tables;
     RefPtr<BTree> m_table_columns;
+    RefPtr<BTree> m_indexes;
 
     HashMap<u32, NonnullRefPtr<SchemaDef>> m_schema_cache;
     HashMap<u32, NonnullRefPtr<TableDef>> m_table_cache;
+    HashMap<u32, NonnullRefPtr<BTree>> m_index_trees;
+
+    // Tables with removed rows, whose indexes may still refer to the freed row blocks.
+    HashMap<u32, NonnullRefPtr<TableDef>> m_tables_with_stale_indexes;
 };
 
 }
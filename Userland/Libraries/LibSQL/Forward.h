@@ -9,6 +9,7 @@
 namespace SQL {
 class BTree;
 class BTreeIterator;
+class CachedStatement;
 class ColumnDef;
 class Database;
 class Heap;
@@ -23,6 +24,7 @@ class ResultSet;
 class Row;
 class SchemaDef;
 class Serializer;
+class StatementCache;
 class TableDef;
 class TreeNode;
 class Tuple;
@@ -46,6 +48,7 @@ class ColumnDefinition;
 class ColumnNameExpression;
 class CommonTableExpression;
 class CommonTableExpressionList;
+class CreateIndex;
 class CreateTable;
 class Delete;
 class DropColumn;
@@ -53,6 +56,7 @@ class DropTable;
 class ErrorExpression;
 class ErrorStatement;
 class ExistsExpression;
+class Explain;
 class Expression;
 class GroupByClause;
 class InChainedExpression;
@@ -81,6 +85,7 @@ class Select;
 class SignedNumber;
 class Statement;
 class StringLiteral;
+class TableAccessPlan;
 class TableOrSubquery;
 class Token;
 class TypeName;
@@ -14,6 +14,86 @@
 
 namespace SQL {
 
+ErrorOr<NonnullRefPtr<Page>> Page::create(Block::Index index, ByteBuffer bytes)
+{
+    VERIFY(bytes.size() == Block::SIZE);
+    return adopt_nonnull_ref_or_enomem(new (nothrow) Page(index, move(bytes)));
+}
+
+Page::Page(Block::Index index, ByteBuffer bytes)
+    : m_index(index)
+    , m_bytes(move(bytes))
+{
+}
+
+u32 Page::size_in_bytes() const
+{
+    u32 size_in_bytes;
+    memcpy(&size_in_bytes, m_bytes.offset_pointer(0), sizeof(size_in_bytes));
+    return min(size_in_bytes, Block::DATA_SIZE);
+}
+
+Block::Index Page::next_block() const
+{
+    Block::Index next_block;
+    memcpy(&next_block, m_bytes.offset_pointer(sizeof(u32)), sizeof(next_block));
+    return next_block;
+}
+
+void PageCache::set_capacity(size_t capacity)
+{
+    if (capacity < m_slots.size())
+        clear();
+    m_capacity = capacity;
+}
+
+RefPtr<Page> PageCache::get(Block::Index index)
+{
+    auto slot_index = m_slot_indices.get(index);
+    if (!slot_index.has_value())
+        return nullptr;
+
+    auto& slot = m_slots[*slot_index];
+    slot.is_referenced = true;
+    return slot.page;
+}
+
+ErrorOr<void> PageCache::set(NonnullRefPtr<Page> page)
+{
+    if (m_capacity == 0)
+        return {};
+
+    if (auto slot_index = m_slot_indices.get(page->index()); slot_index.has_value()) {
+        m_slots[*slot_index] = { move(page) };
+        return {};
+    }
+
+    if (m_slots.size() < m_capacity) {
+        TRY(m_slot_indices.try_set(page->index(), m_slots.size()));
+        TRY(m_slots.try_append({ move(page) }));
+        return {};
+    }
+
+    // Find a page that was not used since the clock hand last passed it. This takes at most one revolution.
+    while (m_slots[m_clock_hand].is_referenced) {
+        m_slots[m_clock_hand].is_referenced = false;
+        m_clock_hand = (m_clock_hand + 1) % m_slots.size();
+    }
+
+    m_slot_indices.remove(m_slots[m_clock_hand].page->index());
+    TRY(m_slot_indices.try_set(page->index(), m_clock_hand));
+    m_slots[m_clock_hand] = { move(page) };
+    m_clock_hand = (m_clock_hand + 1) % m_slots.size();
+    return {};
+}
+
+void PageCache::clear()
+{
+    m_slots.clear();
+    m_slot_indices.clear();
+    m_clock_hand = 0;
+}
+
 ErrorOr<NonnullRefPtr<Heap>> Heap::create(ByteString file_name)
 {
     return adopt_nonnull_ref_or_enomem(new (nothrow) Heap(move(file_name)));
@@ -35,6 +115,7 @@ Heap::~Heap()
 ErrorOr<void> Heap::open()
 {
     VERIFY(!m_file);
+    m_page_cache.clear();
 
     size_t file_size = 0;
     struct stat stat_buffer;
@@ -56,6 +137,7 @@ ErrorOr<void> Heap::open()
     }
 
     auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    m_file_descriptor = file->fd();
     m_file = TRY(Core::InputBufferedFile::create(move(file)));
 
     if (file_size > 0) {
@@ -79,9 +161,8 @@ ErrorOr<void> Heap::open()
     // Perform a heap scan to find all free blocks
     // FIXME: this is very inefficient; store free blocks in a persistent heap structure
     for (Block::Index index = 1; index <= m_highest_block_written; ++index) {
-        auto block_data = TRY(read_raw_block(index));
-        auto size_in_bytes = *reinterpret_cast<u32*>(block_data.data());
-        if (size_in_bytes == 0)
+        auto page = TRY(read_page(index));
+        if (page->size_in_bytes() == 0)
             TRY(m_free_block_indices.try_append(index));
     }
 
@@ -115,10 +196,10 @@ ErrorOr<ByteBuffer> Heap::read_storage(Block::Index index)
     // Reconstruct the data storage from a potential chain of blocks
     ByteBuffer data;
     while (index > 0) {
-        auto block = TRY(read_block(index));
-        dbgln_if(SQL_DEBUG, "  -> {} bytes", block.size_in_bytes());
-        TRY(data.try_append(block.data().bytes().slice(0, block.size_in_bytes())));
-        index = block.next_block();
+        auto page = TRY(read_page(index));
+        dbgln_if(SQL_DEBUG, "  -> {} bytes", page->size_in_bytes());
+        TRY(data.try_append(page->data()));
+        index = page->next_block();
     }
     return data;
 }
@@ -141,16 +222,9 @@ ErrorOr<void> Heap::write_storage(Block::Index index, ReadonlyBytes data)
         auto block_data_size = AK::min(remaining_size, Block::DATA_SIZE);
         remaining_size -= block_data_size;
 
-        ByteBuffer block_data;
-        if (has_block(index)) {
-            auto existing_block = TRY(read_block(index));
-            block_data = existing_block.data();
-            TRY(block_data.try_resize(block_data_size));
-            existing_next_block_index = existing_block.next_block();
-        } else {
-            block_data = TRY(ByteBuffer::create_uninitialized(block_data_size));
-            existing_next_block_index = 0;
-        }
+        // The block's data is overwritten entirely, only the existing chain needs to be known.
+        existing_next_block_index = has_block(index) ? TRY(read_page(index))->next_block() : 0;
+        auto block_data = TRY(ByteBuffer::create_uninitialized(block_data_size));
 
         Block::Index next_block_index = existing_next_block_index;
         if (next_block_index == 0 && remaining_size > 0)
@@ -172,30 +246,24 @@ ErrorOr<void> Heap::write_storage(Block::Index index, ReadonlyBytes data)
     return {};
 }
 
-ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
+ErrorOr<NonnullRefPtr<Page>> Heap::read_page(Block::Index index)
 {
+    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
     VERIFY(m_file);
     VERIFY(index < m_next_block);
 
     if (auto wal_entry = m_write_ahead_log.get(index); wal_entry.has_value())
-        return wal_entry.value();
+        return NonnullRefPtr { *wal_entry.value() };
+    if (auto page = m_page_cache.get(index))
+        return page.release_nonnull();
 
     TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
     auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
     TRY(m_file->read_until_filled(buffer));
-    return buffer;
-}
-
-ErrorOr<Block> Heap::read_block(Block::Index index)
-{
-    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
-
-    auto buffer = TRY(read_raw_block(index));
-    auto size_in_bytes = *reinterpret_cast<u32*>(buffer.offset_pointer(0));
-    auto next_block = *reinterpret_cast<Block::Index*>(buffer.offset_pointer(sizeof(u32)));
-    auto data = TRY(buffer.slice(Block::HEADER_SIZE, Block::DATA_SIZE));
 
-    return Block { index, size_in_bytes, next_block, move(data) };
+    auto page = TRY(Page::create(index, move(buffer)));
+    TRY(m_page_cache.set(page));
+    return page;
 }
 
 ErrorOr<void> Heap::write_raw_block(Block::Index index, ReadonlyBytes data)
@@ -220,7 +288,13 @@ ErrorOr<void> Heap::write_raw_block_to_wal(Block::Index index, ByteBuffer&& data
     VERIFY(index < m_next_block);
     VERIFY(data.size() == Block::SIZE);
 
-    TRY(m_write_ahead_log.try_set(index, move(data)));
+    auto page = TRY(Page::create(index, move(data)));
+    TRY(m_write_ahead_log.try_set(index, move(page)));
+
+    // Nothing depends on modified pages staying in memory until the next flush, so write them out early rather than
+    // letting a large modification grow the log without bounds.
+    if (m_write_ahead_log.size() >= m_max_write_ahead_log_size)
+        TRY(flush());
 
     return {};
 }
@@ -251,16 +325,15 @@ ErrorOr<void> Heap::free_storage(Block::Index index)
     VERIFY(index > 0);
 
     while (index > 0) {
-        auto block = TRY(read_block(index));
-        TRY(free_block(block));
-        index = block.next_block();
+        auto next_block = TRY(read_page(index))->next_block();
+        TRY(free_block(index));
+        index = next_block;
     }
     return {};
 }
 
-ErrorOr<void> Heap::free_block(Block const& block)
+ErrorOr<void> Heap::free_block(Block::Index index)
 {
-    auto index = block.index();
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
 
     VERIFY(index > 0);
@@ -280,50 +353,72 @@ ErrorOr<void> Heap::flush()
     quick_sort(indices);
     for (auto index : indices) {
         dbgln_if(SQL_DEBUG, "Flushing block {}", index);
-        auto& data = m_write_ahead_log.get(index).value();
-        TRY(write_raw_block(index, data));
+        NonnullRefPtr page = *m_write_ahead_log.get(index).value();
+        TRY(write_raw_block(index, page->bytes()));
+
+        // The page is now in sync with the file, and was just in use.
+        TRY(m_page_cache.set(move(page)));
+        m_has_unsynced_changes = true;
     }
     m_write_ahead_log.clear();
     dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
     return {};
 }
 
+ErrorOr<void> Heap::sync()
+{
+    VERIFY(m_file);
+    TRY(flush());
+    if (!m_has_unsynced_changes)
+        return {};
+
+    TRY(Core::System::fsync(m_file_descriptor));
+    m_has_unsynced_changes = false;
+    return {};
+}
+
 constexpr static auto FILE_ID = "SerenitySQL "sv;
 constexpr static auto VERSION_OFFSET = FILE_ID.length();
 constexpr static auto SCHEMAS_ROOT_OFFSET = VERSION_OFFSET + sizeof(u32);
 constexpr static auto TABLES_ROOT_OFFSET = SCHEMAS_ROOT_OFFSET + sizeof(u32);
 constexpr static auto TABLE_COLUMNS_ROOT_OFFSET = TABLES_ROOT_OFFSET + sizeof(u32);
 constexpr static auto USER_VALUES_OFFSET = TABLE_COLUMNS_ROOT_OFFSET + sizeof(u32);
+// The indexes root was added after the user values. Heap files written before it existed have a zero here, which
+// reads back as an empty index tree, so this did not require a version bump.
+constexpr static auto INDEXES_ROOT_OFFSET = USER_VALUES_OFFSET + 16 * sizeof(u32);
 
 ErrorOr<void> Heap::read_zero_block()
 {
     dbgln_if(SQL_DEBUG, "Read zero block from {}", name());
 
-    auto block = TRY(read_raw_block(0));
-    auto file_id_buffer = TRY(block.slice(0, FILE_ID.length()));
-    auto file_id = StringView(file_id_buffer);
+    auto page = TRY(read_page(0));
+    auto block = page->bytes();
+    auto file_id = StringView(block.slice(0, FILE_ID.length()));
     if (file_id != FILE_ID) {
         warnln("{}: Zero page corrupt. This is probably not a {} heap file"sv, name(), FILE_ID);
         return Error::from_string_literal("Heap()::read_zero_block(): Zero page corrupt. This is probably not a SerenitySQL heap file");
     }
 
-    memcpy(&m_version, block.offset_pointer(VERSION_OFFSET), sizeof(u32));
+    memcpy(&m_version, block.offset(VERSION_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Version: {}.{}", (m_version & 0xFFFF0000) >> 16, (m_version & 0x0000FFFF));
 
-    memcpy(&m_schemas_root, block.offset_pointer(SCHEMAS_ROOT_OFFSET), sizeof(u32));
+    memcpy(&m_schemas_root, block.offset(SCHEMAS_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Schemas root node: {}", m_schemas_root);
 
-    memcpy(&m_tables_root, block.offset_pointer(TABLES_ROOT_OFFSET), sizeof(u32));
+    memcpy(&m_tables_root, block.offset(TABLES_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Tables root node: {}", m_tables_root);
 
-    memcpy(&m_table_columns_root, block.offset_pointer(TABLE_COLUMNS_ROOT_OFFSET), sizeof(u32));
+    memcpy(&m_table_columns_root, block.offset(TABLE_COLUMNS_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Table columns root node: {}", m_table_columns_root);
 
-    memcpy(m_user_values.data(), block.offset_pointer(USER_VALUES_OFFSET), m_user_values.size() * sizeof(u32));
+    memcpy(m_user_values.data(), block.offset(USER_VALUES_OFFSET), m_user_values.size() * sizeof(u32));
     for (auto ix = 0u; ix < m_user_values.size(); ix++) {
         if (m_user_values[ix])
             dbgln_if(SQL_DEBUG, "User value {}: {}", ix, m_user_values[ix]);
     }
+
+    memcpy(&m_indexes_root, block.offset(INDEXES_ROOT_OFFSET), sizeof(u32));
+    dbgln_if(SQL_DEBUG, "Indexes root node: {}", m_indexes_root);
     return {};
 }
 
@@ -334,6 +429,7 @@ ErrorOr<void> Heap::update_zero_block()
     dbgln_if(SQL_DEBUG, "Schemas root node: {}", m_schemas_root);
     dbgln_if(SQL_DEBUG, "Tables root node: {}", m_tables_root);
     dbgln_if(SQL_DEBUG, "Table Columns root node: {}", m_table_columns_root);
+    dbgln_if(SQL_DEBUG, "Indexes root node: {}", m_indexes_root);
     for (auto ix = 0u; ix < m_user_values.size(); ix++) {
         if (m_user_values[ix] > 0)
             dbgln_if(SQL_DEBUG, "User value {}: {}", ix, m_user_values[ix]);
@@ -347,6 +443,7 @@ ErrorOr<void> Heap::update_zero_block()
     buffer_bytes.overwrite(TABLES_ROOT_OFFSET, &m_tables_root, sizeof(u32));
     buffer_bytes.overwrite(TABLE_COLUMNS_ROOT_OFFSET, &m_table_columns_root, sizeof(u32));
     buffer_bytes.overwrite(USER_VALUES_OFFSET, m_user_values.data(), m_user_values.size() * sizeof(u32));
+    buffer_bytes.overwrite(INDEXES_ROOT_OFFSET, &m_indexes_root, sizeof(u32));
 
     return write_raw_block_to_wal(0, move(buffer));
 }
@@ -357,6 +454,7 @@ ErrorOr<void> Heap::initialize_zero_block()
     m_schemas_root = 0;
     m_tables_root = 0;
     m_table_columns_root = 0;
+    m_indexes_root = 0;
     m_next_block = 1;
     m_highest_block_written = 0;
     for (auto& user : m_user_values)
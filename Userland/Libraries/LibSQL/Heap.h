@@ -11,7 +11,9 @@
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/File.h>
 
@@ -55,6 +57,63 @@ private:
     ByteBuffer m_data;
 };
 
+/**
+ * A Page holds the raw contents of a single block of the Heap in memory: its
+ * header followed by its data. Pages are immutable, writing to a block replaces
+ * its page instead. Holding on to a page thus gives stable access to a block's
+ * contents without having to copy them, even if the Heap evicts the page from
+ * its page cache in the meantime.
+ */
+class Page : public RefCounted<Page> {
+public:
+    static ErrorOr<NonnullRefPtr<Page>> create(Block::Index, ByteBuffer);
+
+    Block::Index index() const { return m_index; }
+    ReadonlyBytes bytes() const { return m_bytes; }
+
+    u32 size_in_bytes() const;
+    Block::Index next_block() const;
+    ReadonlyBytes data() const { return bytes().slice(Block::HEADER_SIZE, size_in_bytes()); }
+
+private:
+    Page(Block::Index, ByteBuffer);
+
+    Block::Index m_index;
+    ByteBuffer m_bytes;
+};
+
+/**
+ * A PageCache keeps up to a fixed number of pages that are in sync with the
+ * Heap's file in memory. Once it is full, pages are evicted using the clock
+ * (second chance) algorithm: pages that were used since the clock hand last
+ * passed them are skipped once.
+ */
+class PageCache {
+public:
+    explicit PageCache(size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    size_t capacity() const { return m_capacity; }
+    void set_capacity(size_t);
+
+    RefPtr<Page> get(Block::Index);
+    ErrorOr<void> set(NonnullRefPtr<Page>);
+    void clear();
+
+private:
+    struct Slot {
+        NonnullRefPtr<Page> page;
+        bool is_referenced { true };
+    };
+
+    size_t m_capacity { 0 };
+    Vector<Slot> m_slots;
+    HashMap<Block::Index, size_t> m_slot_indices;
+    size_t m_clock_hand { 0 };
+};
+
 /**
  * A Heap is a logical container for database (SQL) data. Conceptually a
  * Heap can be a database file, or a memory block, or another storage medium.
@@ -68,6 +127,12 @@ class Heap : public RefCounted<Heap> {
 public:
     static constexpr u32 VERSION = 5;
 
+    // The number of clean pages kept in memory, 1 MiB worth by default.
+    static constexpr size_t DEFAULT_PAGE_CACHE_SIZE = 1024;
+
+    // The number of modified pages kept in memory before they are written to the file, even if not flushed yet.
+    static constexpr size_t DEFAULT_MAX_WRITE_AHEAD_LOG_SIZE = 4096;
+
     static ErrorOr<NonnullRefPtr<Heap>> create(ByteString);
     virtual ~Heap();
 
@@ -76,6 +141,12 @@ public:
     ErrorOr<void> open();
     ErrorOr<size_t> file_size_in_bytes() const;
 
+    size_t page_cache_size() const { return m_page_cache.capacity(); }
+    void set_page_cache_size(size_t size) { m_page_cache.set_capacity(size); }
+
+    size_t max_write_ahead_log_size() const { return m_max_write_ahead_log_size; }
+    void set_max_write_ahead_log_size(size_t size) { m_max_write_ahead_log_size = max(size, 1u); }
+
     [[nodiscard]] bool has_block(Block::Index) const;
     [[nodiscard]] Block::Index request_new_block_index();
 
@@ -102,6 +173,15 @@ public:
         m_table_columns_root = root;
         update_zero_block().release_value_but_fixme_should_propagate_errors();
     }
+
+    Block::Index indexes_root() const { return m_indexes_root; }
+
+    void set_indexes_root(Block::Index root)
+    {
+        m_indexes_root = root;
+        update_zero_block().release_value_but_fixme_should_propagate_errors();
+    }
+
     u32 version() const { return m_version; }
 
     u32 user_value(size_t index) const
@@ -119,18 +199,23 @@ public:
     ErrorOr<void> write_storage(Block::Index, ReadonlyBytes);
     ErrorOr<void> free_storage(Block::Index);
 
+    // Writes all modified pages to the file.
     ErrorOr<void> flush();
 
+    // Makes sure everything that was flushed is stored durably, which is expensive. Callers making many changes in
+    // quick succession should sync once after all of them, rather than after each one.
+    ErrorOr<void> sync();
+    bool has_unsynced_changes() const { return m_has_unsynced_changes || !m_write_ahead_log.is_empty(); }
+
 private:
     explicit Heap(ByteString);
 
-    ErrorOr<ByteBuffer> read_raw_block(Block::Index);
+    ErrorOr<NonnullRefPtr<Page>> read_page(Block::Index);
     ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
     ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
 
-    ErrorOr<Block> read_block(Block::Index);
     ErrorOr<void> write_block(Block const&);
-    ErrorOr<void> free_block(Block const&);
+    ErrorOr<void> free_block(Block::Index);
 
     ErrorOr<void> read_zero_block();
     ErrorOr<void> initialize_zero_block();
@@ -139,14 +224,19 @@ private:
     ByteString m_name;
 
     OwnPtr<Core::InputBufferedFile> m_file;
+    int m_file_descriptor { -1 };
     Block::Index m_highest_block_written { 0 };
     Block::Index m_next_block { 1 };
     Block::Index m_schemas_root { 0 };
     Block::Index m_tables_root { 0 };
     Block::Index m_table_columns_root { 0 };
+    Block::Index m_indexes_root { 0 };
     u32 m_version { VERSION };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
+    HashMap<Block::Index, NonnullRefPtr<Page>> m_write_ahead_log;
+    size_t m_max_write_ahead_log_size { DEFAULT_MAX_WRITE_AHEAD_LOG_SIZE };
+    bool m_has_unsynced_changes { false };
+    PageCache m_page_cache { DEFAULT_PAGE_CACHE_SIZE };
     Vector<Block::Index> m_free_block_indices;
 };
 
@@ -81,10 +81,10 @@ void ColumnDef::set_default_value(Value const& default_value)
     m_default = default_value;
 }
 
-Key ColumnDef::make_key(TableDef const& table_def)
+Key ColumnDef::make_key(Relation const& parent)
 {
     Key key(index_def());
-    key["table_hash"] = table_def.key().hash();
+    key["table_hash"] = parent.hash();
     return key;
 }
 
@@ -149,6 +149,7 @@ Key IndexDef::key() const
     key["table_hash"] = parent()->key().hash();
     key["index_name"] = name();
     key["unique"] = unique() ? 1 : 0;
+    key.set_block_index(block_index());
     return key;
 }
 
@@ -214,6 +215,12 @@ void TableDef::append_column(Key const& column)
     append_column(column["column_name"].to_byte_string(), static_cast<SQLType>(*column_type));
 }
 
+void TableDef::append_index(NonnullRefPtr<IndexDef> index)
+{
+    VERIFY(index->parent() == this);
+    m_indexes.append(move(index));
+}
+
 Key TableDef::make_key(SchemaDef const& schema_def)
 {
     return TableDef::make_key(schema_def.key());
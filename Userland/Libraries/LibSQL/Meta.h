@@ -81,7 +81,7 @@ public:
     Value const& default_value() const { return m_default; }
 
     static NonnullRefPtr<IndexDef> index_def();
-    static Key make_key(TableDef const&);
+    static Key make_key(Relation const&);
 
 protected:
     ColumnDef(Relation*, size_t, ByteString, SQLType);
@@ -135,6 +135,7 @@ public:
     Key key() const override;
     void append_column(ByteString, SQLType);
     void append_column(Key const&);
+    void append_index(NonnullRefPtr<IndexDef>);
     size_t num_columns() { return m_columns.size(); }
     size_t num_indexes() { return m_indexes.size(); }
     Vector<NonnullRefPtr<ColumnDef>> const& columns() const { return m_columns; }
@@ -34,12 +34,11 @@ public:
     SQLCommand command() const { return m_command; }
     Vector<ByteString> const& column_names() const { return m_column_names; }
 
+    // Rows are expected to be inserted in the order in which they should be returned.
     void insert_row(Tuple const& row, Tuple const& sort_key);
     void limit(size_t offset, size_t limit);
 
 private:
-    size_t binary_search(Tuple const& sort_key, size_t low, size_t high);
-
     SQLCommand m_command { SQLCommand::Unknown };
     Vector<ByteString> m_column_names;
 };
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibSQL/AST/Parser.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/StatementCache.h>
+
+namespace SQL {
+
+Duration CachedStatement::average_execution_time() const
+{
+    if (m_execution_count == 0)
+        return {};
+    return Duration::from_nanoseconds(m_total_execution_time.to_nanoseconds() / static_cast<i64>(m_execution_count));
+}
+
+void CachedStatement::record_execution(Duration execution_time)
+{
+    ++m_execution_count;
+    m_total_execution_time += execution_time;
+    m_max_execution_time = max(m_max_execution_time, execution_time);
+}
+
+ResultOr<NonnullRefPtr<CachedStatement>> StatementCache::statement_for(Database const& database, StringView sql)
+{
+    // Statements prepared against an older schema are not handed out again.
+    if (m_schema_version != database.schema_version()) {
+        evict_all();
+        m_schema_version = database.schema_version();
+    }
+
+    if (auto cached = m_statements.get(sql); cached.has_value()) {
+        ++m_hit_count;
+        NonnullRefPtr statement = *cached.value();
+        statement->record_prepare();
+        return statement;
+    }
+
+    ++m_miss_count;
+
+    auto parser = AST::Parser(AST::Lexer(sql));
+    auto parsed_statement = parser.next_statement();
+    if (parser.has_errors())
+        return Result { SQLCommand::Unknown, SQLErrorCode::SyntaxError, parser.errors()[0].to_byte_string() };
+
+    auto statement = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) CachedStatement(move(parsed_statement))));
+    statement->record_prepare();
+
+    // Clients only use a handful of distinct statements. Past that, the SQL text is most likely generated on the fly
+    // and won't be seen again, so it isn't worth caching.
+    if (m_statements.size() < m_capacity)
+        m_statements.set(sql, statement);
+    return statement;
+}
+
+void StatementCache::evict_all()
+{
+    m_eviction_count += m_statements.size();
+    m_statements.clear();
+}
+
+}
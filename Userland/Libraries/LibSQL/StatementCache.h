@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/Time.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Result.h>
+
+namespace SQL {
+
+// A parsed statement, shared by everything that prepared the same SQL text, along with statistics about its executions.
+// The statement is never modified once parsed. Placeholder values are bound separately for each execution.
+class CachedStatement final : public RefCounted<CachedStatement> {
+public:
+    explicit CachedStatement(NonnullRefPtr<AST::Statement const> statement)
+        : m_statement(move(statement))
+    {
+    }
+
+    NonnullRefPtr<AST::Statement const> const& statement() const { return m_statement; }
+
+    size_t prepare_count() const { return m_prepare_count; }
+    size_t execution_count() const { return m_execution_count; }
+    Duration total_execution_time() const { return m_total_execution_time; }
+    Duration max_execution_time() const { return m_max_execution_time; }
+    Duration average_execution_time() const;
+
+    void record_prepare() { ++m_prepare_count; }
+    void record_execution(Duration execution_time);
+
+private:
+    NonnullRefPtr<AST::Statement const> m_statement;
+
+    size_t m_prepare_count { 0 };
+    size_t m_execution_count { 0 };
+    Duration m_total_execution_time;
+    Duration m_max_execution_time;
+};
+
+// Keeps the parsed statement for each SQL text prepared against a database. All cached statements are evicted when the
+// database's schema changes.
+class StatementCache {
+public:
+    static constexpr size_t default_capacity = 256;
+
+    explicit StatementCache(size_t capacity = default_capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    // Returns the cached statement for the SQL text, parsing it if it isn't cached.
+    ResultOr<NonnullRefPtr<CachedStatement>> statement_for(Database const&, StringView sql);
+
+    HashMap<ByteString, NonnullRefPtr<CachedStatement>> const& statements() const { return m_statements; }
+    size_t size() const { return m_statements.size(); }
+
+    size_t hit_count() const { return m_hit_count; }
+    size_t miss_count() const { return m_miss_count; }
+    size_t eviction_count() const { return m_eviction_count; }
+
+private:
+    void evict_all();
+
+    size_t m_capacity { default_capacity };
+    u64 m_schema_version { 0 };
+    HashMap<ByteString, NonnullRefPtr<CachedStatement>> m_statements;
+
+    size_t m_hit_count { 0 };
+    size_t m_miss_count { 0 };
+    size_t m_eviction_count { 0 };
+};
+
+}
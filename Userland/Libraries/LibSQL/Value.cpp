@@ -445,6 +445,45 @@ u32 Value::hash() const
         });
 }
 
+// Compares an integer to a double without converting either of them, as not every 64-bit integer is representable as a
+// double and rounding the double to an integer would lose its fraction.
+static int compare_integer_to_double(Integer auto value, double other)
+{
+    if (isnan(other))
+        return 1;
+
+    auto integral_part = trunc(other);
+    if (integral_part < -0x1p63)
+        return 1;
+    if (integral_part >= 0x1p64)
+        return -1;
+
+    if (integral_part < 0) {
+        if constexpr (!IsSigned<decltype(value)>) {
+            return 1;
+        } else {
+            auto other_integer = static_cast<i64>(integral_part);
+            if (value != other_integer)
+                return value < other_integer ? -1 : 1;
+        }
+    } else {
+        if constexpr (IsSigned<decltype(value)>) {
+            if (value < 0)
+                return -1;
+        }
+
+        auto other_integer = static_cast<u64>(integral_part);
+        if (static_cast<u64>(value) != other_integer)
+            return static_cast<u64>(value) < other_integer ? -1 : 1;
+    }
+
+    // The integral parts are equal, so the fraction decides.
+    auto fraction = other - integral_part;
+    if (fraction == 0)
+        return 0;
+    return fraction > 0 ? -1 : 1;
+}
+
 int Value::compare(Value const& other) const
 {
     if (is_null())
@@ -455,6 +494,9 @@ int Value::compare(Value const& other) const
     return m_value->visit(
         [&](ByteString const& value) -> int { return value.view().compare(other.to_byte_string()); },
         [&](Integer auto value) -> int {
+            if (other.type() == SQLType::Float)
+                return compare_integer_to_double(value, other.to_double().value());
+
             auto casted = other.to_int<IntegerType<decltype(value)>>();
             if (!casted.has_value())
                 return 1;
@@ -464,6 +506,12 @@ int Value::compare(Value const& other) const
             return value < *casted ? -1 : 1;
         },
         [&](double value) -> int {
+            if (other.type() == SQLType::Integer) {
+                return other.m_value->visit(
+                    [&](Integer auto other_value) -> int { return -compare_integer_to_double(other_value, value); },
+                    [](auto const&) -> int { VERIFY_NOT_REACHED(); });
+            }
+
             auto casted = other.to_double();
             if (!casted.has_value())
                 return 1;
@@ -35,8 +35,11 @@ struct ThreadPoolLooper {
             if (!wait)
                 return IterationDecision::Continue;
 
+            // Look at the queue again with m_mutex held: submit() takes it before waking us up, so work that was
+            // queued after the check above can't slip by between here and the wait.
             pool.m_mutex.lock();
-            pool.m_work_available.wait();
+            if (!pool.m_should_exit && pool.m_work_queue.with_locked([](auto& queue) { return queue.is_empty(); }))
+                pool.m_work_available.wait();
             pool.m_mutex.unlock();
         }
 
@@ -86,6 +89,7 @@ public:
     void request_exit()
     {
         m_should_exit.store(true, AK::MemoryOrder::memory_order_release);
+        MutexLocker locker(m_mutex);
         m_work_available.broadcast();
     }
 
@@ -99,24 +103,18 @@ public:
         m_work_queue.with_locked([&](auto& queue) {
             queue.enqueue({ move(work) });
         });
+        MutexLocker locker(m_mutex);
         m_work_available.broadcast();
     }
 
     void wait_for_all()
     {
-        while (true) {
-            if (m_work_queue.with_locked([](auto& queue) { return queue.is_empty(); }))
-                break;
-            m_mutex.lock();
-            m_work_done.wait();
-            m_mutex.unlock();
-        }
-
-        while (m_busy_count.load(AK::MemoryOrder::memory_order_acquire) > 0) {
-            m_mutex.lock();
-            m_work_done.wait();
-            m_mutex.unlock();
-        }
+        // Workers take m_mutex before signaling m_work_done, so checking with it held can't miss their signal.
+        MutexLocker locker(m_mutex);
+        m_work_done.wait_while([this] {
+            return !m_work_queue.with_locked([](auto& queue) { return queue.is_empty(); })
+                || m_busy_count.load(AK::MemoryOrder::memory_order_acquire) > 0;
+        });
     }
 
 private:
@@ -128,8 +126,11 @@ private:
                 Looper<ThreadPool> thread_looper { move(looper_args)... };
                 for (; !m_should_exit;) {
                     auto result = thread_looper.next(*this, true);
-                    m_busy_count--;
-                    m_work_done.signal();
+                    {
+                        MutexLocker locker(m_mutex);
+                        m_busy_count--;
+                        m_work_done.broadcast();
+                    }
                     if (result == IterationDecision::Break)
                         break;
                 }
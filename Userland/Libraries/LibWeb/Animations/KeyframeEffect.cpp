@@ -997,8 +997,14 @@ void KeyframeEffect::update_style_properties()
         }
     }
 
-    if (invalidation.relayout)
-        document.set_needs_layout();
+    if (invalidation.relayout) {
+        // NOTE: The target needing layout also covers its descendants, which inherited style changes were applied to above.
+        Layout::Node* layout_node = pseudo_element_type().has_value() ? target->get_pseudo_element_node(pseudo_element_type().value()).ptr() : target->layout_node();
+        if (layout_node)
+            layout_node->set_needs_layout();
+        else
+            document.set_needs_layout();
+    }
     if (invalidation.rebuild_layout_tree)
         document.invalidate_layout_tree();
     if (invalidation.repaint)
@@ -42,6 +42,7 @@
 #include <LibWeb/MathML/TagNames.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/NavigationTiming/EntryNames.h>
+#include <LibWeb/PerformanceMetrics.h>
 #include <LibWeb/PerformanceTimeline/EntryTypes.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/SVG/AttributeNames.h>
@@ -304,6 +305,8 @@ ErrorOr<void> initialize_main_thread_vm(HTML::EventLoop::Type type)
                 s_main_thread_vm->push_execution_context(*dummy_execution_context);
             }
 
+            PerformanceMetrics::ScopedPhase javascript_phase { PerformanceMetrics::Phase::JavaScript };
+
             // 3. Let result be job().
             auto result = job->function()();
 
@@ -2374,9 +2374,15 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
     return style;
 }
 
+StyleInvalidationData const& StyleComputer::style_invalidation_data() const
+{
+    build_rule_cache_if_needed();
+    return *m_style_invalidation_data;
+}
+
 void StyleComputer::build_rule_cache_if_needed() const
 {
-    if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
+    if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache && m_style_invalidation_data)
         return;
     const_cast<StyleComputer&>(*this).build_rule_cache();
 }
@@ -2443,6 +2449,8 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                 VERIFY_NOT_REACHED();
             }();
             for (CSS::Selector const& selector : absolutized_selectors) {
+                m_style_invalidation_data->build_invalidation_plans_for_selector(selector);
+
                 MatchingRule matching_rule {
                     shadow_root,
                     &rule,
@@ -2708,16 +2716,21 @@ void StyleComputer::build_rule_cache()
 
     build_qualified_layer_names_cache();
 
+    m_style_invalidation_data = make<StyleInvalidationData>();
+
     m_author_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::Author);
     m_user_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::User);
     m_user_agent_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
 
+    m_style_invalidation_data->did_build_invalidation_plans();
+
     m_has_has_selectors = m_author_rule_cache->has_has_selectors || m_user_rule_cache->has_has_selectors || m_user_agent_rule_cache->has_has_selectors;
 }
 
 void StyleComputer::invalidate_rule_cache()
 {
     m_author_rule_cache = nullptr;
+    m_style_invalidation_data = nullptr;
 
     // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
     //       Currently we are re-parsing the user style sheet every time we build the caches,
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/CSS/StyleInvalidationData.h>
+#include <LibWeb/DOM/Element.h>
+
+namespace Web::CSS {
+
+void InvalidationSet::include_all_from(InvalidationSet const& other)
+{
+    matches_all |= other.matches_all;
+    for (auto const& class_name : other.class_names)
+        class_names.set(class_name);
+    for (auto const& id : other.ids)
+        ids.set(id);
+    for (auto const& tag_name : other.tag_names)
+        tag_names.set(tag_name);
+    for (auto const& attribute_name : other.attribute_names)
+        attribute_names.set(attribute_name);
+}
+
+bool InvalidationSet::matches(DOM::Element const& element) const
+{
+    if (matches_all)
+        return true;
+    if (!tag_names.is_empty() && tag_names.contains(element.local_name()))
+        return true;
+    if (!ids.is_empty() && element.id().has_value() && ids.contains(*element.id()))
+        return true;
+    if (!class_names.is_empty()) {
+        for (auto const& class_name : element.class_names()) {
+            if (class_names.contains(class_name))
+                return true;
+        }
+    }
+    for (auto const& attribute_name : attribute_names) {
+        if (element.has_attribute(attribute_name))
+            return true;
+    }
+    return false;
+}
+
+void InvalidationPlan::include_all_from(InvalidationPlan const& other)
+{
+    invalidate_self |= other.invalidate_self;
+    descendants.include_all_from(other.descendants);
+    invalidate_subsequent_siblings |= other.invalidate_subsequent_siblings;
+}
+
+InvalidationPlan InvalidationPlan::everything()
+{
+    InvalidationPlan plan;
+    plan.invalidate_self = true;
+    plan.descendants.matches_all = true;
+    plan.invalidate_subsequent_siblings = true;
+    return plan;
+}
+
+// The elements a selector can match, going by the features of its rightmost compound selector.
+static InvalidationSet invalidation_set_for_subject_of(Selector const& selector)
+{
+    InvalidationSet set;
+    for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+        switch (simple_selector.type) {
+        case Selector::SimpleSelector::Type::TagName:
+            set.tag_names.set(simple_selector.qualified_name().name.lowercase_name);
+            return set;
+        case Selector::SimpleSelector::Type::Id:
+            set.ids.set(simple_selector.name());
+            return set;
+        case Selector::SimpleSelector::Type::Class:
+            set.class_names.set(simple_selector.name());
+            return set;
+        case Selector::SimpleSelector::Type::Attribute:
+            set.attribute_names.set(simple_selector.attribute().qualified_name.name.lowercase_name);
+            return set;
+        default:
+            break;
+        }
+    }
+    set.matches_all = true;
+    return set;
+}
+
+static bool is_combinator_between_siblings(Selector::Combinator combinator)
+{
+    return combinator == Selector::Combinator::NextSibling || combinator == Selector::Combinator::SubsequentSibling;
+}
+
+static bool is_combinator_between_ancestor_and_descendant(Selector::Combinator combinator)
+{
+    return combinator == Selector::Combinator::Descendant || combinator == Selector::Combinator::ImmediateChild;
+}
+
+void StyleInvalidationData::build_invalidation_plans_for_selector(Selector const& selector)
+{
+    auto const& compound_selectors = selector.compound_selectors();
+    auto const subject = invalidation_set_for_subject_of(selector);
+
+    for (size_t i = 0; i < compound_selectors.size(); ++i) {
+        // NOTE: A compound selector stores the combinator to its left, so the combinators to the right of compound
+        //       selector i are stored in the compound selectors that follow it.
+        bool only_descendant_combinators_follow = true;
+        bool only_sibling_combinators_follow = true;
+        for (size_t j = i + 1; j < compound_selectors.size(); ++j) {
+            auto combinator = compound_selectors[j].combinator;
+            if (!is_combinator_between_ancestor_and_descendant(combinator))
+                only_descendant_combinators_follow = false;
+            if (!is_combinator_between_siblings(combinator))
+                only_sibling_combinators_follow = false;
+        }
+
+        InvalidationPlan plan;
+        if (i == compound_selectors.size() - 1) {
+            plan.invalidate_self = true;
+        } else if (only_descendant_combinators_follow) {
+            plan.descendants = subject;
+        } else if (only_sibling_combinators_follow) {
+            plan.invalidate_subsequent_siblings = true;
+        } else {
+            // E.g. `.a ~ .b .c` or `.a .b + .c`: descendants of subsequent siblings, or siblings of descendants.
+            plan.descendants.matches_all = true;
+            plan.invalidate_subsequent_siblings = true;
+        }
+
+        add_plans_for_compound_selector(compound_selectors[i], plan);
+    }
+}
+
+void StyleInvalidationData::add_plans_for_compound_selector(Selector::CompoundSelector const& compound_selector, InvalidationPlan const& plan)
+{
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        switch (simple_selector.type) {
+        case Selector::SimpleSelector::Type::Id:
+            id_plans.ensure(simple_selector.name()).include_all_from(plan);
+            break;
+        case Selector::SimpleSelector::Type::Class:
+            class_plans.ensure(simple_selector.name()).include_all_from(plan);
+            break;
+        case Selector::SimpleSelector::Type::Attribute:
+            attribute_plans.ensure(simple_selector.attribute().qualified_name.name.lowercase_name).include_all_from(plan);
+            break;
+        case Selector::SimpleSelector::Type::PseudoClass: {
+            auto const& pseudo_class = simple_selector.pseudo_class();
+            pseudo_class_plans.ensure(pseudo_class.type).include_all_from(plan);
+
+            // Features inside argument selectors (e.g. :is(), :not(), :has() or :nth-child(An+B of S)) may refer to
+            // the element itself, but also to its ancestors, siblings or descendants. Only the simple case of a
+            // single compound selector applying to the element itself is tracked precisely.
+            for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+                bool applies_to_element_itself = argument_selector->compound_selectors().size() == 1
+                    && pseudo_class.type != PseudoClass::Has
+                    && pseudo_class.type != PseudoClass::NthChild
+                    && pseudo_class.type != PseudoClass::NthLastChild;
+                auto argument_plan = applies_to_element_itself ? plan : InvalidationPlan::everything();
+                for (auto const& argument_compound_selector : argument_selector->compound_selectors())
+                    add_plans_for_compound_selector(argument_compound_selector, argument_plan);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+static bool pseudo_class_may_depend_on_attributes(PseudoClass pseudo_class)
+{
+    switch (pseudo_class) {
+    // These match based on tree structure, user interaction or media state, never on the attributes of the element.
+    case PseudoClass::Active:
+    case PseudoClass::Empty:
+    case PseudoClass::FirstChild:
+    case PseudoClass::FirstOfType:
+    case PseudoClass::Focus:
+    case PseudoClass::FocusVisible:
+    case PseudoClass::FocusWithin:
+    case PseudoClass::Hover:
+    case PseudoClass::LastChild:
+    case PseudoClass::LastOfType:
+    case PseudoClass::NthChild:
+    case PseudoClass::NthLastChild:
+    case PseudoClass::NthLastOfType:
+    case PseudoClass::NthOfType:
+    case PseudoClass::OnlyChild:
+    case PseudoClass::OnlyOfType:
+    case PseudoClass::Root:
+    case PseudoClass::Scope:
+    case PseudoClass::Target:
+    case PseudoClass::TargetWithin:
+    // NOTE: The arguments of these are tracked separately.
+    case PseudoClass::Is:
+    case PseudoClass::Not:
+    case PseudoClass::Where:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void StyleInvalidationData::did_build_invalidation_plans()
+{
+    attribute_dependent_pseudo_class_plan = {};
+    for (auto const& it : pseudo_class_plans) {
+        if (pseudo_class_may_depend_on_attributes(it.key))
+            attribute_dependent_pseudo_class_plan.include_all_from(it.value);
+    }
+}
+
+}
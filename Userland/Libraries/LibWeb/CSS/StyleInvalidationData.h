@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <LibWeb/CSS/PseudoClass.h>
+#include <LibWeb/CSS/Selector.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::CSS {
+
+// A set of elements described by the features they have, e.g. "elements with class .foo or tag name span".
+struct InvalidationSet {
+    bool matches_all { false };
+    HashTable<FlyString> class_names;
+    HashTable<FlyString> ids;
+    HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> tag_names;
+    HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> attribute_names;
+
+    bool is_empty() const { return !matches_all && class_names.is_empty() && ids.is_empty() && tag_names.is_empty() && attribute_names.is_empty(); }
+    void include_all_from(InvalidationSet const&);
+
+    bool matches(DOM::Element const&) const;
+};
+
+// Which elements have to be restyled when a feature used by selectors (a class name, an ID, an attribute or the state
+// of a pseudo-class) changes on an element.
+struct InvalidationPlan {
+    bool invalidate_self { false };
+
+    // Descendants that may match a selector containing the feature to the left of a descendant or child combinator.
+    InvalidationSet descendants;
+
+    // The feature is used to the left of a sibling combinator, so subsequent siblings and their subtrees may be affected.
+    bool invalidate_subsequent_siblings { false };
+
+    bool is_empty() const { return !invalidate_self && descendants.is_empty() && !invalidate_subsequent_siblings; }
+    void include_all_from(InvalidationPlan const&);
+
+    static InvalidationPlan everything();
+};
+
+// Invalidation plans for every feature used in the selectors of a set of style sheets.
+// Features that don't appear in any selector have an empty plan, so changing them doesn't restyle anything.
+struct StyleInvalidationData {
+    HashMap<FlyString, InvalidationPlan> class_plans;
+    HashMap<FlyString, InvalidationPlan> id_plans;
+    HashMap<FlyString, InvalidationPlan, AK::ASCIICaseInsensitiveFlyStringTraits> attribute_plans;
+    HashMap<PseudoClass, InvalidationPlan> pseudo_class_plans;
+
+    // Union of the plans for pseudo-classes whose matching may depend on the value of an arbitrary attribute,
+    // such as :checked, :disabled or :lang().
+    InvalidationPlan attribute_dependent_pseudo_class_plan;
+
+    void build_invalidation_plans_for_selector(Selector const&);
+
+    // Must be called once plans for all selectors have been built.
+    void did_build_invalidation_plans();
+
+private:
+    void add_plans_for_compound_selector(Selector::CompoundSelector const&, InvalidationPlan const&);
+};
+
+}
@@ -121,6 +121,7 @@
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
+#include <LibWeb/PerformanceMetrics.h>
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
 #include <LibWeb/ResizeObserver/ResizeObserver.h>
 #include <LibWeb/ResizeObserver/ResizeObserverEntry.h>
@@ -975,6 +976,7 @@ WebIDL::ExceptionOr<void> Document::set_title(String const& title)
 void Document::tear_down_layout_tree()
 {
     m_layout_root = nullptr;
+    m_previous_layout_state = nullptr;
     m_paintable = nullptr;
 }
 
@@ -1075,6 +1077,19 @@ URL::URL Document::parse_url(StringView url) const
 }
 
 void Document::set_needs_layout()
+{
+    // NOTE: The layout root needing layout means that nothing can be reused from the previous layout.
+    if (m_layout_root) {
+        m_layout_root->set_needs_layout();
+        return;
+    }
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    schedule_layout_update();
+}
+
+void Document::set_needs_layout(Badge<Layout::Node>)
 {
     if (m_needs_layout)
         return;
@@ -1149,6 +1164,8 @@ void Document::update_layout()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    PerformanceMetrics::ScopedPhase layout_phase { PerformanceMetrics::Phase::Layout };
+
     auto* document_element = this->document_element();
     auto viewport_rect = navigable->viewport_rect();
 
@@ -1162,18 +1179,25 @@ void Document::update_layout()
         }
     }
 
-    Layout::LayoutState layout_state;
+    auto layout_state = make<Layout::LayoutState>();
+
+    // NOTE: Unless the whole tree needs layout, layout roots with an unchanged subtree can reuse their previous layout.
+    if (m_previous_layout_state && !m_layout_root->needs_layout()) {
+        auto const& previous_viewport_state = m_previous_layout_state->get(*m_layout_root);
+        if (previous_viewport_state.content_width() == viewport_rect.width() && previous_viewport_state.content_height() == viewport_rect.height())
+            layout_state->previous_layout = m_previous_layout_state.ptr();
+    }
 
     {
-        Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
+        Layout::BlockFormattingContext root_formatting_context(*layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
 
         auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
-        auto& viewport_state = layout_state.get_mutable(viewport);
+        auto& viewport_state = layout_state->get_mutable(viewport);
         viewport_state.set_content_width(viewport_rect.width());
         viewport_state.set_content_height(viewport_rect.height());
 
         if (document_element && document_element->layout_node()) {
-            auto& icb_state = layout_state.get_mutable(verify_cast<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
+            auto& icb_state = layout_state->get_mutable(verify_cast<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
             icb_state.set_content_width(viewport_rect.width());
         }
 
@@ -1183,7 +1207,21 @@ void Document::update_layout()
                 Layout::AvailableSize::make_definite(viewport_rect.height())));
     }
 
-    layout_state.commit(*m_layout_root);
+    layout_state->commit(*m_layout_root);
+
+    m_laid_out_box_count_in_last_layout_update = layout_state->laid_out_box_count();
+
+    // Keep the committed state around for the next layout update, and clear the dirty bits of the layout tree.
+    layout_state->previous_layout = nullptr;
+    layout_state->intrinsic_sizes.clear();
+    m_previous_layout_state = move(layout_state);
+
+    m_layout_root->for_each_in_inclusive_subtree([](Layout::Node& node) {
+        if (!node.needs_layout() && !node.child_needs_layout())
+            return TraversalDecision::SkipChildrenAndContinue;
+        node.reset_needs_layout();
+        return TraversalDecision::Continue;
+    });
 
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
@@ -1210,10 +1248,25 @@ void Document::update_layout()
         window->scroll_by(0, 0);
 }
 
-[[nodiscard]] static CSS::RequiredInvalidationAfterStyleChange update_style_recursively(Node& node, CSS::StyleComputer& style_computer)
+static bool custom_properties_are_equal(HashMap<FlyString, CSS::StyleProperty> const& a, HashMap<FlyString, CSS::StyleProperty> const& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (auto const& it : a) {
+        auto other = b.get(it.key);
+        if (!other.has_value() || *it.value.value != *other->value)
+            return false;
+    }
+    return true;
+}
+
+// NOTE: `parent_style_changed` is set when the element (or shadow host) that this node's children inherit from got a
+//       different computed style, in which case the children must be restyled even if nothing invalidated them.
+[[nodiscard]] static CSS::RequiredInvalidationAfterStyleChange update_style_recursively(Node& node, CSS::StyleComputer& style_computer, bool parent_style_changed, size_t& restyled_element_count)
 {
     bool const needs_full_style_update = node.document().needs_full_style_update();
     CSS::RequiredInvalidationAfterStyleChange invalidation;
+    bool children_need_inherited_style_update = false;
 
     if (node.is_element())
         style_computer.push_ancestor(static_cast<Element const&>(node));
@@ -1224,18 +1277,33 @@ void Document::update_layout()
     bool is_display_none = false;
 
     if (is<Element>(node)) {
-        if (needs_full_style_update || node.needs_style_update()) {
-            invalidation |= static_cast<Element&>(node).recompute_style();
+        auto& element = static_cast<Element&>(node);
+        if (needs_full_style_update || node.needs_style_update() || parent_style_changed) {
+            auto old_custom_properties = element.custom_properties({});
+            auto element_invalidation = element.recompute_style();
+            ++restyled_element_count;
+
+            children_need_inherited_style_update = !element_invalidation.is_none()
+                || !custom_properties_are_equal(old_custom_properties, element.custom_properties({}));
+
+            // NOTE: Values relative to the root element (e.g. rem units) can be used anywhere in the document, so a
+            //       style change on the root element turns this into a full style update.
+            if (children_need_inherited_style_update && &element == element.document().document_element())
+                element.document().set_needs_full_style_update(true);
+
+            invalidation |= element_invalidation;
         }
-        is_display_none = static_cast<Element&>(node).computed_css_values()->display().is_none();
+        is_display_none = element.computed_css_values()->display().is_none();
+    } else if (node.is_shadow_root()) {
+        children_need_inherited_style_update = parent_style_changed;
     }
     node.set_needs_style_update(false);
 
-    if (needs_full_style_update || node.child_needs_style_update()) {
+    if (needs_full_style_update || node.child_needs_style_update() || children_need_inherited_style_update) {
         if (node.is_element()) {
             if (auto shadow_root = static_cast<DOM::Element&>(node).shadow_root()) {
-                if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update()) {
-                    auto subtree_invalidation = update_style_recursively(*shadow_root, style_computer);
+                if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update() || children_need_inherited_style_update) {
+                    auto subtree_invalidation = update_style_recursively(*shadow_root, style_computer, children_need_inherited_style_update, restyled_element_count);
                     if (!is_display_none)
                         invalidation |= subtree_invalidation;
                 }
@@ -1243,8 +1311,8 @@ void Document::update_layout()
         }
 
         node.for_each_child([&](auto& child) {
-            if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update()) {
-                auto subtree_invalidation = update_style_recursively(child, style_computer);
+            if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update() || (children_need_inherited_style_update && child.is_element())) {
+                auto subtree_invalidation = update_style_recursively(child, style_computer, children_need_inherited_style_update, restyled_element_count);
                 if (!is_display_none)
                     invalidation |= subtree_invalidation;
             }
@@ -1278,6 +1346,8 @@ void Document::update_style()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    PerformanceMetrics::ScopedPhase style_phase { PerformanceMetrics::Phase::Style };
+
     // Fetch the viewport rect once, instead of repeatedly, during style computation.
     style_computer().set_viewport_rect({}, viewport_rect());
 
@@ -1285,12 +1355,13 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
-    auto invalidation = update_style_recursively(*this, style_computer());
+    size_t restyled_element_count = 0;
+    auto invalidation = update_style_recursively(*this, style_computer(), false, restyled_element_count);
+    m_restyled_element_count_in_last_style_update = restyled_element_count;
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout_tree();
     } else {
-        if (invalidation.relayout)
-            set_needs_layout();
+        // NOTE: Elements that need relayout have already marked their layout nodes as needing layout.
         if (invalidation.rebuild_stacking_context_tree)
             invalidate_stacking_context_tree();
     }
@@ -1404,10 +1475,23 @@ void Document::set_hovered_node(Node* node)
     m_hovered_node = node;
 
     auto* common_ancestor = find_common_ancestor(old_hovered_node, m_hovered_node);
-    if (common_ancestor)
-        common_ancestor->invalidate_style(StyleInvalidationReason::Hover);
-    else
-        invalidate_style(StyleInvalidationReason::Hover);
+    auto const& invalidation_data = style_computer().style_invalidation_data();
+    if (style_computer().has_has_selectors()) {
+        if (common_ancestor)
+            common_ancestor->invalidate_style(StyleInvalidationReason::Hover);
+        else
+            invalidate_style(StyleInvalidationReason::Hover);
+    } else if (auto hover_plan = invalidation_data.pseudo_class_plans.get(CSS::PseudoClass::Hover); hover_plan.has_value()) {
+        // Only the elements between the old or new hovered node and their common ancestor changed their :hover state.
+        auto invalidate_hover_chain = [&](Node* node) {
+            for (; node && node != common_ancestor; node = node->parent_or_shadow_host()) {
+                if (node->is_element())
+                    static_cast<Element&>(*node).invalidate_style_for_plan(*hover_plan);
+            }
+        };
+        invalidate_hover_chain(old_hovered_node);
+        invalidate_hover_chain(m_hovered_node);
+    }
 
     // https://w3c.github.io/uievents/#mouseout
     if (old_hovered_node && old_hovered_node != m_hovered_node) {
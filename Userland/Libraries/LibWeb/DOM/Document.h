@@ -144,6 +144,9 @@ public:
     void update_base_element(Badge<HTML::HTMLBaseElement>);
     JS::GCPtr<HTML::HTMLBaseElement const> first_base_element_with_href_in_tree_order() const;
 
+    // https://html.spec.whatwg.org/multipage/parsing.html#list-of-speculative-fetch-urls
+    HashTable<URL::URL>& list_of_speculative_fetch_urls() { return m_list_of_speculative_fetch_urls; }
+
     String url_string() const { return MUST(m_url.to_string()); }
     String document_uri() const { return url_string(); }
 
@@ -241,7 +244,16 @@ public:
     void update_paint_and_hit_testing_properties_if_needed();
     void update_animated_style_if_needed();
 
+    // Invalidates the layout of the whole document. Use Layout::Node::set_needs_layout() to only invalidate a subtree.
     void set_needs_layout();
+    void set_needs_layout(Badge<Layout::Node>);
+
+    // Number of boxes that went through layout in the most recent layout update, i.e. not counting boxes whose
+    // layout was reused from the previous update.
+    size_t laid_out_box_count_in_last_layout_update() const { return m_laid_out_box_count_in_last_layout_update; }
+
+    // Number of elements whose style was recomputed in the most recent style update.
+    size_t restyled_element_count_in_last_style_update() const { return m_restyled_element_count_in_last_style_update; }
 
     void invalidate_layout_tree();
     void invalidate_stacking_context_tree();
@@ -768,6 +780,12 @@ private:
 
     JS::GCPtr<Layout::Viewport> m_layout_root;
 
+    // The layout state committed by the previous layout update. Layout roots whose subtree hasn't changed can copy
+    // their used values from here instead of being laid out again.
+    OwnPtr<Layout::LayoutState> m_previous_layout_state;
+    size_t m_laid_out_box_count_in_last_layout_update { 0 };
+    size_t m_restyled_element_count_in_last_style_update { 0 };
+
     Optional<Color> m_normal_link_color;
     Optional<Color> m_active_link_color;
     Optional<Color> m_visited_link_color;
@@ -918,6 +936,9 @@ private:
     // NOTE: This is a cache to make finding the first <base href> element O(1).
     JS::GCPtr<HTML::HTMLBaseElement const> m_first_base_element_with_href_in_tree_order;
 
+    // https://html.spec.whatwg.org/multipage/parsing.html#list-of-speculative-fetch-urls
+    HashTable<URL::URL> m_list_of_speculative_fetch_urls;
+
     // https://html.spec.whatwg.org/multipage/images.html#list-of-available-images
     JS::GCPtr<HTML::ListOfAvailableImages> m_list_of_available_images;
 
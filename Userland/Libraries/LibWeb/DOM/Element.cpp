@@ -450,7 +450,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
     attribute_changed(local_name, old_value, value);
 
     if (old_value != value) {
-        invalidate_style_after_attribute_change(local_name);
+        invalidate_style_after_attribute_change(local_name, old_value, value);
         document().bump_dom_tree_version();
     }
 }
@@ -582,9 +582,15 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (invalidation.repaint)
         document().set_needs_to_resolve_paint_only_properties();
 
+    // NOTE: Elements with display: contents have no layout node to mark, but still affect the layout of their descendants.
+    if (invalidation.relayout && !invalidation.rebuild_layout_tree && !layout_node() && m_computed_css_values->display().is_contents())
+        document().set_needs_layout();
+
     if (!invalidation.rebuild_layout_tree && layout_node()) {
         // If we're keeping the layout tree, we can just apply the new style to the existing layout tree.
         layout_node()->apply_style(*m_computed_css_values);
+        if (invalidation.relayout)
+            layout_node()->set_needs_layout();
         if (invalidation.repaint && paintable())
             paintable()->set_needs_display();
 
@@ -601,6 +607,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
 
             if (auto* node_with_style = dynamic_cast<Layout::NodeWithStyle*>(pseudo_element->layout_node.ptr())) {
                 node_with_style->apply_style(*pseudo_element_style);
+                if (invalidation.relayout)
+                    node_with_style->set_needs_layout();
                 if (invalidation.repaint && node_with_style->paintable())
                     node_with_style->paintable()->set_needs_display();
             }
@@ -1929,13 +1937,95 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+static Vector<FlyString> class_names_from_attribute_value(Optional<String> const& value)
+{
+    Vector<FlyString> class_names;
+    if (!value.has_value())
+        return class_names;
+    for (auto class_name : value->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace))
+        class_names.append(MUST(FlyString::from_utf8(class_name)));
+    return class_names;
+}
+
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    if (document().needs_full_style_update())
+        return;
+
+    if (!is_connected()) {
+        invalidate_style(StyleInvalidationReason::ElementAttributeChange);
+        return;
+    }
+
+    // NOTE: This builds the rule cache if needed, which also determines whether there are any :has() selectors.
+    auto const& invalidation_data = document().style_computer().style_invalidation_data();
+
+    bool const is_class_or_id = attribute_name == HTML::AttributeNames::class_ || attribute_name == HTML::AttributeNames::id;
+
+    // NOTE: We can't tell which elements a :has() selector depends on, class and ID selectors match case-insensitively
+    //       in quirks mode, the presentational hints of tables and the body element apply to other elements, and the
+    //       dir, lang and disabled attributes affect pseudo-classes matched by descendants. Invalidate the
+    //       old-fashioned way in these cases.
+    if (document().style_computer().has_has_selectors()
+        || (is_class_or_id && document().in_quirks_mode())
+        || is<HTML::HTMLTableElement>(*this)
+        || is<HTML::HTMLBodyElement>(*this)
+        || attribute_name.is_one_of(HTML::AttributeNames::dir, HTML::AttributeNames::lang, HTML::AttributeNames::disabled)) {
+        invalidate_style(StyleInvalidationReason::ElementAttributeChange);
+        return;
+    }
+
+    // Any attribute may be mapped to a presentational hint, or change the state of a pseudo-class like :checked.
+    CSS::InvalidationPlan plan;
+    plan.invalidate_self = true;
+    plan.include_all_from(invalidation_data.attribute_dependent_pseudo_class_plan);
+
+    if (auto attribute_plan = invalidation_data.attribute_plans.get(attribute_name); attribute_plan.has_value())
+        plan.include_all_from(*attribute_plan);
 
-    // FIXME: This will need to become smarter when we implement the :has() selector.
-    invalidate_style(StyleInvalidationReason::ElementAttributeChange);
+    if (attribute_name == HTML::AttributeNames::class_) {
+        auto old_class_names = class_names_from_attribute_value(old_value);
+        auto new_class_names = class_names_from_attribute_value(new_value);
+        auto include_plans_for_classes_only_in = [&](Vector<FlyString> const& class_names, Vector<FlyString> const& other_class_names) {
+            for (auto const& class_name : class_names) {
+                if (other_class_names.contains_slow(class_name))
+                    continue;
+                if (auto class_plan = invalidation_data.class_plans.get(class_name); class_plan.has_value())
+                    plan.include_all_from(*class_plan);
+            }
+        };
+        include_plans_for_classes_only_in(old_class_names, new_class_names);
+        include_plans_for_classes_only_in(new_class_names, old_class_names);
+    } else if (attribute_name == HTML::AttributeNames::id) {
+        for (auto const& id : { old_value, new_value }) {
+            if (!id.has_value() || id->is_empty())
+                continue;
+            if (auto id_plan = invalidation_data.id_plans.get(FlyString { *id }); id_plan.has_value())
+                plan.include_all_from(*id_plan);
+        }
+    }
+
+    invalidate_style_for_plan(plan);
+}
+
+void Element::invalidate_style_for_plan(CSS::InvalidationPlan const& plan)
+{
+    if (plan.invalidate_self)
+        set_needs_style_update(true);
+
+    if (!plan.descendants.is_empty()) {
+        for_each_shadow_including_descendant([&](Node& node) {
+            if (node.is_element() && plan.descendants.matches(static_cast<Element const&>(node)))
+                node.set_needs_style_update(true);
+            return TraversalDecision::Continue;
+        });
+    }
+
+    // NOTE: Invalidating the style of an element also invalidates all of its subsequent siblings.
+    if (plan.invalidate_subsequent_siblings) {
+        if (auto* sibling = next_element_sibling())
+            sibling->invalidate_style(StyleInvalidationReason::ElementAttributeChange);
+    }
 }
 
 // https://www.w3.org/TR/wai-aria-1.2/#tree_exclusion
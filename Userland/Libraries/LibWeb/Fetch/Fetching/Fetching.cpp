@@ -2205,6 +2205,15 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
 
+    // NOTE: Speculative fetches are made in no-cors mode with credentials included, so only requests made the same way
+    //       by a document may be served from their responses.
+    if (request->mode() == Infrastructure::Request::Mode::NoCORS
+        && request->credentials_mode() == Infrastructure::Request::CredentialsMode::Include
+        && request->client()
+        && is<HTML::Window>(request->client()->global_object())) {
+        load_request.set_preload_document(verify_cast<HTML::Window>(request->client()->global_object()).associated_document());
+    }
+
     if (auto const* body = request->body().get_pointer<JS::NonnullGCPtr<Infrastructure::Body>>()) {
         TRY((*body)->source().visit(
             [&](ByteBuffer const& byte_buffer) -> WebIDL::ExceptionOr<void> {
@@ -29,6 +29,7 @@ enum class TraversalDecision;
 namespace Web::Painting {
 class DisplayListRecorder;
 class SVGGradientPaintStyle;
+class TiledDisplayListPlayerCPU;
 using PaintStyle = RefPtr<SVGGradientPaintStyle>;
 }
 
@@ -225,6 +226,7 @@ enum class PropertyID;
 
 struct BackgroundLayerData;
 struct CSSStyleSheetInit;
+struct InvalidationPlan;
 struct StyleSheetIdentifier;
 }
 
@@ -702,7 +702,10 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 document().list_of_available_images().add(key, *image_data, true);
 
                 set_needs_style_update(true);
-                document().set_needs_layout();
+                if (auto* layout_node = this->layout_node())
+                    layout_node->set_needs_layout();
+                else
+                    document().set_needs_layout();
 
                 // 4. If maybe omit events is not set or previousURL is not equal to urlString, then fire an event named load at the img element.
                 if (!maybe_omit_events || previous_url != url_string)
@@ -841,7 +844,10 @@ void HTMLImageElement::react_to_changes_in_the_environment()
             image_request->prepare_for_presentation(*this);
             // FIXME: This is ad-hoc, updating the layout here should probably be handled by prepare_for_presentation().
             set_needs_style_update(true);
-            document().set_needs_layout();
+            if (auto* layout_node = this->layout_node())
+                layout_node->set_needs_layout();
+            else
+                document().set_needs_layout();
 
             // 7. Fire an event named load at the img element.
             dispatch_event(DOM::Event::create(realm(), HTML::EventNames::load));
@@ -160,6 +160,7 @@ private:
     void parse_generic_raw_text_element(HTMLToken&);
     void increment_script_nesting_level();
     void decrement_script_nesting_level();
+    void start_the_speculative_html_parser();
     void reset_the_insertion_mode_appropriately();
 
     void adjust_mathml_attributes(HTMLToken&);
@@ -201,6 +202,10 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    // The length of the input when the speculative HTML parser last ran over the rest of it. Unless a script inserted
+    // more input since, there is nothing new for it to find.
+    Optional<size_t> m_input_length_at_last_speculative_parse;
+
     JS::Realm& realm();
 
     JS::GCPtr<DOM::Document> m_document;
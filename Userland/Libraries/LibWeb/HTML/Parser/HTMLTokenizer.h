@@ -130,6 +130,10 @@ public:
 
     ByteString source() const { return m_decoded_input; }
 
+    // The part of the input stream that hasn't been tokenized yet.
+    StringView unconsumed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
+    size_t input_length() const { return m_decoded_input.length(); }
+
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
     bool is_eof_inserted();
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Infra/Strings.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+SpeculativeHTMLParser::SpeculativeHTMLParser(DOM::Document& document, StringView input, bool scripting_enabled)
+    : m_document(document)
+    , m_tokenizer(input, "utf-8"sv)
+    , m_scripting_enabled(scripting_enabled)
+{
+}
+
+void SpeculativeHTMLParser::run()
+{
+    for (;;) {
+        auto token = m_tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+
+        if (token->is_start_tag()) {
+            process_start_tag(*token);
+
+            // NOTE: We have no tree builder to do this for us. Switching states keeps us from looking for tags inside
+            //       the contents of elements that aren't parsed as markup.
+            auto const& tag_name = token->tag_name();
+            if (tag_name.is_one_of(TagNames::title, TagNames::textarea))
+                m_tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+            else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes))
+                m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+            else if (tag_name == TagNames::noscript && m_scripting_enabled)
+                m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+            else if (tag_name == TagNames::script)
+                m_tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+            else if (tag_name == TagNames::plaintext)
+                break;
+            else if (tag_name == TagNames::template_)
+                ++m_template_nesting_level;
+        } else if (token->is_end_tag() && token->tag_name() == TagNames::template_) {
+            if (m_template_nesting_level > 0)
+                --m_template_nesting_level;
+        }
+    }
+}
+
+void SpeculativeHTMLParser::process_start_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    // Template contents are inert, so nothing in them is fetched.
+    if (m_template_nesting_level > 0)
+        return;
+
+    if (tag_name == TagNames::base) {
+        // If the document has no base element with an href yet, the first one found speculatively is used to resolve
+        // the URLs that follow it.
+        if (m_speculative_base_url.has_value() || m_document->first_base_element_with_href_in_tree_order())
+            return;
+        if (auto href = token.attribute(AttributeNames::href); href.has_value()) {
+            auto url = DOMURL::parse(*href, m_document->fallback_base_url());
+            if (url.is_valid())
+                m_speculative_base_url = move(url);
+        }
+        return;
+    }
+
+    // NOTE: A speculative fetch is made without an Origin header, so its response can't be used for a CORS request.
+    //       Skip elements that would be fetched in CORS mode.
+    if (token.has_attribute(AttributeNames::crossorigin))
+        return;
+
+    Optional<String> url_string;
+
+    if (tag_name == TagNames::img) {
+        // NOTE: Which source is picked from srcset depends on the layout, which we don't know yet.
+        if (token.has_attribute(AttributeNames::srcset))
+            return;
+        url_string = token.attribute(AttributeNames::src);
+    } else if (tag_name == TagNames::script) {
+        if (token.has_attribute(AttributeNames::nomodule))
+            return;
+        auto type = token.attribute(AttributeNames::type);
+        if (type.has_value() && !type->is_empty() && !MimeSniff::is_javascript_mime_type_essence_match(MUST(type->trim(Infra::ASCII_WHITESPACE))))
+            return;
+        url_string = token.attribute(AttributeNames::src);
+    } else if (tag_name == TagNames::link) {
+        auto rel = token.attribute(AttributeNames::rel);
+        if (!rel.has_value() || token.has_attribute(AttributeNames::disabled))
+            return;
+
+        bool is_stylesheet = false;
+        bool is_alternate = false;
+        bool is_preload = false;
+        for (auto keyword : rel->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+            if (keyword.equals_ignoring_ascii_case("stylesheet"sv))
+                is_stylesheet = true;
+            else if (keyword.equals_ignoring_ascii_case("alternate"sv))
+                is_alternate = true;
+            else if (keyword.equals_ignoring_ascii_case("preload"sv))
+                is_preload = true;
+        }
+
+        if (is_preload) {
+            // NOTE: Fonts are always fetched in CORS mode.
+            auto as = token.attribute(AttributeNames::as).value_or({});
+            if (!Infra::is_ascii_case_insensitive_match(as, "script"sv) && !Infra::is_ascii_case_insensitive_match(as, "style"sv) && !Infra::is_ascii_case_insensitive_match(as, "image"sv))
+                return;
+        } else if (!is_stylesheet || is_alternate) {
+            return;
+        }
+        url_string = token.attribute(AttributeNames::href);
+    }
+
+    if (!url_string.has_value() || url_string->is_empty())
+        return;
+
+    if (auto url = parse_url(*url_string); url.has_value())
+        speculative_fetch(*url);
+}
+
+Optional<URL::URL> SpeculativeHTMLParser::parse_url(String const& url_string) const
+{
+    auto url = m_speculative_base_url.has_value()
+        ? DOMURL::parse(url_string, m_speculative_base_url)
+        : m_document->parse_url(url_string);
+    if (!url.is_valid())
+        return {};
+    return url;
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+void SpeculativeHTMLParser::speculative_fetch(URL::URL const& url)
+{
+    // If document's list of speculative fetch URLs contains url, then return.
+    if (m_document->list_of_speculative_fetch_urls().contains(url))
+        return;
+
+    // Otherwise, append url to document's list of speculative fetch URLs.
+    m_document->list_of_speculative_fetch_urls().set(url);
+
+    dbgln_if(HTML_PARSER_DEBUG, "SpeculativeHTMLParser: Speculatively fetching {}", url);
+
+    // NOTE: The response is kept by the ResourceLoader until the element that needs it fetches the same URL.
+    auto request = LoadRequest::create_for_url_on_page(url, &m_document->page());
+    ResourceLoader::the().preload(request, *m_document);
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/StringView.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// NOTE: Instead of building a speculative mock tree, this runs a tokenizer over the input that the HTML parser hasn't
+//       reached yet, and speculatively fetches the resources referenced by the start tags it encounters. It runs to
+//       completion synchronously, so there is nothing to stop afterwards.
+class SpeculativeHTMLParser {
+    AK_MAKE_NONCOPYABLE(SpeculativeHTMLParser);
+    AK_MAKE_NONMOVABLE(SpeculativeHTMLParser);
+
+public:
+    SpeculativeHTMLParser(DOM::Document&, StringView input, bool scripting_enabled);
+
+    void run();
+
+private:
+    void process_start_tag(HTMLToken const&);
+    Optional<URL::URL> parse_url(String const&) const;
+    void speculative_fetch(URL::URL const&);
+
+    JS::NonnullGCPtr<DOM::Document> m_document;
+    HTMLTokenizer m_tokenizer;
+    bool m_scripting_enabled { true };
+
+    // Set by the first base element with an href attribute, if the document doesn't have one yet.
+    Optional<URL::URL> m_speculative_base_url;
+
+    size_t m_template_nesting_level { 0 };
+};
+
+}
@@ -8,6 +8,7 @@
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/Fetching.h>
 #include <LibWeb/HTML/Scripting/ModuleScript.h>
+#include <LibWeb/PerformanceMetrics.h>
 #include <LibWeb/WebIDL/DOMException.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
@@ -120,6 +121,8 @@ WebIDL::ExceptionOr<JS::GCPtr<JavaScriptModuleScript>> JavaScriptModuleScript::c
 // https://html.spec.whatwg.org/multipage/webappapis.html#run-a-module-script
 JS::Promise* JavaScriptModuleScript::run(PreventErrorReporting)
 {
+    PerformanceMetrics::ScopedPhase javascript_phase { PerformanceMetrics::Phase::JavaScript };
+
     // 1. Let settings be the settings object of script.
     auto& settings = settings_object();
 
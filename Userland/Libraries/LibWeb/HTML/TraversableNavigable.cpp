@@ -18,6 +18,8 @@
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/DisplayListPlayerCPU.h>
+#include <LibWeb/Painting/TiledDisplayListPlayerCPU.h>
+#include <LibWeb/PerformanceMetrics.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 
 #ifdef HAS_ACCELERATED_GRAPHICS
@@ -1354,6 +1356,8 @@ JS::GCPtr<DOM::Node> TraversableNavigable::currently_focused_area()
 
 void TraversableNavigable::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& target, Web::PaintOptions paint_options)
 {
+    PerformanceMetrics::ScopedPhase paint_phase { PerformanceMetrics::Phase::Paint };
+
     Painting::DisplayList display_list;
     Painting::DisplayListRecorder display_list_recorder(display_list);
 
@@ -1365,6 +1369,7 @@ void TraversableNavigable::paint(Web::DevicePixelRect const& content_rect, Gfx::
     paint_config.should_show_line_box_borders = paint_options.should_show_line_box_borders;
     paint_config.has_focus = paint_options.has_focus;
     record_display_list(display_list_recorder, paint_config);
+    PerformanceMetrics::the().did_record_display_list(display_list.command_count());
 
     auto display_list_player_type = page().client().display_list_player_type();
     if (display_list_player_type == DisplayListPlayerType::GPU) {
@@ -1379,6 +1384,10 @@ void TraversableNavigable::paint(Web::DevicePixelRect const& content_rect, Gfx::
             has_warned_about_configuration = true;
         }
 #endif
+    } else if (display_list_player_type == DisplayListPlayerType::TiledCPU) {
+        if (!m_tiled_display_list_player)
+            m_tiled_display_list_player = make<Painting::TiledDisplayListPlayerCPU>();
+        m_tiled_display_list_player->execute(display_list, target);
     } else {
         Web::Painting::DisplayListPlayerCPU player(target, display_list_player_type == DisplayListPlayerType::CPUWithExperimentalTransformSupport);
         display_list.execute(player);
@@ -132,6 +132,8 @@ private:
     JS::NonnullGCPtr<SessionHistoryTraversalQueue> m_session_history_traversal_queue;
 
     String m_window_handle;
+
+    OwnPtr<Painting::TiledDisplayListPlayerCPU> m_tiled_display_list_player;
 };
 
 struct BrowsingContextAndDocument {
@@ -184,4 +184,26 @@ void Internals::simulate_drop(double x, double y)
     page.handle_drag_and_drop_event(DragEvent::Type::Drop, position, position, UIEvents::MouseButton::Primary, 0, 0, {});
 }
 
+WebIDL::UnsignedLong Internals::laid_out_box_count_in_last_layout_update()
+{
+    auto& active_document = internals_window().associated_document();
+    // NOTE: Flush any pending layout first, so the count reflects the latest changes to the document.
+    active_document.update_layout();
+    return active_document.laid_out_box_count_in_last_layout_update();
+}
+
+WebIDL::UnsignedLong Internals::restyled_element_count_in_last_style_update()
+{
+    auto& active_document = internals_window().associated_document();
+    // NOTE: Flush any pending style changes first, so the count reflects the latest changes to the document.
+    active_document.update_style();
+    return active_document.restyled_element_count_in_last_style_update();
+}
+
+WebIDL::UnsignedLong Internals::speculative_fetch_count()
+{
+    auto& active_document = internals_window().associated_document();
+    return active_document.list_of_speculative_fetch_urls().size();
+}
+
 }
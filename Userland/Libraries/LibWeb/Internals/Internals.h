@@ -44,6 +44,10 @@ public:
     void simulate_drag_move(double x, double y);
     void simulate_drop(double x, double y);
 
+    WebIDL::UnsignedLong laid_out_box_count_in_last_layout_update();
+    WebIDL::UnsignedLong restyled_element_count_in_last_style_update();
+    WebIDL::UnsignedLong speculative_fetch_count();
+
 private:
     explicit Internals(JS::Realm&);
     virtual void initialize(JS::Realm&) override;
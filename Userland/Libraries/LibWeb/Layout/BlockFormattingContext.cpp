@@ -698,9 +698,12 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
         left_space_before_children_formatted = space_used_before_children_formatted.left;
     }
 
+    bool did_reuse_previous_layout = false;
     if (independent_formatting_context) {
-        // This box establishes a new formatting context. Pass control to it.
-        independent_formatting_context->run(box_state.available_inner_space_or_constraints_from(available_space));
+        // This box establishes a new formatting context. Pass control to it, unless its contents are unchanged.
+        did_reuse_previous_layout = m_layout_mode == LayoutMode::Normal && m_state.try_reuse_previous_layout(box);
+        if (!did_reuse_previous_layout)
+            independent_formatting_context->run(box_state.available_inner_space_or_constraints_from(available_space));
     } else {
         // This box participates in the current block container's flow.
         if (box.children_are_inline()) {
@@ -748,7 +751,7 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
 
     bottom_of_lowest_margin_box = max(bottom_of_lowest_margin_box, box_state.offset.y() + box_state.content_height() + box_state.margin_box_bottom());
 
-    if (independent_formatting_context)
+    if (independent_formatting_context && !did_reuse_previous_layout)
         independent_formatting_context->parent_context_did_dimension_child_root_box();
 }
 
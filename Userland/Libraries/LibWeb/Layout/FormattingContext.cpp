@@ -228,6 +228,9 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     if (!child_box.can_have_children())
         return {};
 
+    if (layout_mode == LayoutMode::Normal && m_state.try_reuse_previous_layout(child_box))
+        return {};
+
     auto independent_formatting_context = create_independent_formatting_context_if_needed(m_state, layout_mode, child_box);
     if (independent_formatting_context)
         independent_formatting_context->run(available_space);
@@ -278,7 +278,8 @@ void LayoutState::commit(Box& root)
 
             if (used_values.computed_svg_path().has_value() && is<Painting::SVGPathPaintable>(paintable_box)) {
                 auto& svg_geometry_paintable = static_cast<Painting::SVGPathPaintable&>(paintable_box);
-                svg_geometry_paintable.set_computed_path(move(*used_values.computed_svg_path()));
+                // NOTE: The path is copied rather than moved, as the used values may be reused by the next layout.
+                svg_geometry_paintable.set_computed_path(*used_values.computed_svg_path());
             }
         }
     }
@@ -381,6 +382,97 @@ void LayoutState::commit(Box& root)
     }
 }
 
+static bool is_independent_of_contents(CSS::Size const& size)
+{
+    return size.is_length() || size.is_percentage() || size.is_calculated();
+}
+
+bool LayoutState::try_reuse_previous_layout(Box const& root)
+{
+    // Only the top-level LayoutState does real layout, nested ones are used for intrinsic sizing.
+    if (!previous_layout || m_parent)
+        return false;
+
+    if (root.needs_layout() || root.child_needs_layout())
+        return false;
+    for (auto const* ancestor = root.parent(); ancestor; ancestor = ancestor->parent()) {
+        if (ancestor->needs_layout())
+            return false;
+    }
+
+    // Table layout sizes cells based on the results of laying out their contents.
+    if (root.display().is_table_inside() || root.display().is_internal() || root.is_table_wrapper())
+        return false;
+
+    auto const& computed_values = root.computed_values();
+    if (!is_independent_of_contents(computed_values.width()) || !is_independent_of_contents(computed_values.height()))
+        return false;
+
+    auto const* previous_used_values = previous_layout->used_values_per_layout_node.get(root).value_or(nullptr);
+    if (!previous_used_values)
+        return false;
+
+    auto const& used_values = get(root);
+    if (!used_values.has_definite_width() || !used_values.has_definite_height())
+        return false;
+    if (used_values.content_width() != previous_used_values->content_width() || used_values.content_height() != previous_used_values->content_height())
+        return false;
+
+    // Boxes whose containing block is outside of the subtree are positioned relative to something that may have changed.
+    bool has_descendant_positioned_outside_of_root = false;
+    root.for_each_in_subtree([&](Node const& node) {
+        if (!node.is_absolutely_positioned())
+            return TraversalDecision::Continue;
+        for (auto const* containing_block = node.containing_block(); containing_block; containing_block = containing_block->containing_block()) {
+            if (containing_block == &root)
+                return TraversalDecision::Continue;
+        }
+        has_descendant_positioned_outside_of_root = true;
+        return TraversalDecision::Break;
+    });
+    if (has_descendant_positioned_outside_of_root)
+        return false;
+
+    // The root's own position and box model metrics were determined by its parent formatting context, so only what
+    // was produced by laying out its contents is taken from the previous layout.
+    auto& root_used_values = get_mutable(root);
+    root_used_values.line_boxes = previous_used_values->line_boxes;
+    for (auto const& floating_descendant : previous_used_values->floating_descendants())
+        root_used_values.add_floating_descendant(*floating_descendant);
+
+    root.for_each_in_subtree([&](Node const& node) {
+        used_values_per_layout_node.remove(node);
+        return TraversalDecision::Continue;
+    });
+
+    // NOTE: Containing blocks come before their descendants in tree order, so their used values are always in place
+    //       by the time we get to a box that refers to them.
+    root.for_each_in_subtree([&](Node const& node) {
+        auto const* previous_node_used_values = previous_layout->used_values_per_layout_node.get(node).value_or(nullptr);
+        if (!previous_node_used_values)
+            return TraversalDecision::Continue;
+        auto node_used_values = adopt_own(*new UsedValues(*previous_node_used_values));
+        node_used_values->set_containing_block_used_values(&get(*node.containing_block()));
+        node_used_values->set_reused_from_previous_layout();
+        used_values_per_layout_node.set(node, move(node_used_values));
+        return TraversalDecision::Continue;
+    });
+
+    return true;
+}
+
+size_t LayoutState::laid_out_box_count() const
+{
+    // NOTE: Reused used values are marked as such rather than counted separately. Their entries may be replaced or
+    //       removed after they were reused, which a separate counter wouldn't notice.
+    size_t box_count = 0;
+    for (auto const& it : used_values_per_layout_node) {
+        if (it.key->is_box() && !it.value->is_reused_from_previous_layout())
+            ++box_count;
+    }
+    return box_count;
+}
+
 void LayoutState::UsedValues::set_node(NodeWithStyle& node, UsedValues const* containing_block_used_values)
 {
     m_node = &node;
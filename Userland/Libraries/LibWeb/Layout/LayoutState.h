@@ -46,6 +46,7 @@ struct LayoutState {
         void set_node(NodeWithStyle&, UsedValues const* containing_block_used_values);
 
         UsedValues const* containing_block_used_values() const { return m_containing_block_used_values; }
+        void set_containing_block_used_values(UsedValues const* used_values) { m_containing_block_used_values = used_values; }
 
         CSSPixels content_width() const { return m_content_width; }
         CSSPixels content_height() const { return m_content_height; }
@@ -138,6 +139,10 @@ struct LayoutState {
         void set_computed_svg_transforms(Painting::SVGGraphicsPaintable::ComputedTransforms const& computed_transforms) { m_computed_svg_transforms = computed_transforms; }
         auto const& computed_svg_transforms() const { return m_computed_svg_transforms; }
 
+        // Set on used values that were copied from the previous layout instead of being laid out again.
+        bool is_reused_from_previous_layout() const { return m_reused_from_previous_layout; }
+        void set_reused_from_previous_layout() { m_reused_from_previous_layout = true; }
+
     private:
         AvailableSize available_width_inside() const;
         AvailableSize available_height_inside() const;
@@ -157,6 +162,7 @@ struct LayoutState {
 
         bool m_has_definite_width { false };
         bool m_has_definite_height { false };
+        bool m_reused_from_previous_layout { false };
 
         HashTable<JS::GCPtr<Box const>> m_floating_descendants;
 
@@ -170,6 +176,14 @@ struct LayoutState {
     // Commits the used values produced by layout and builds a paintable tree.
     void commit(Box& root);
 
+    // If `root` is a layout root (i.e. its size doesn't depend on its contents) whose subtree hasn't needed layout
+    // since `previous_layout` was committed, and it has the same size as back then, this copies the used values of
+    // its descendants from `previous_layout` instead of laying them out again.
+    [[nodiscard]] bool try_reuse_previous_layout(Box const& root);
+
+    // Number of boxes laid out by this state, not counting boxes whose used values were reused.
+    size_t laid_out_box_count() const;
+
     // NOTE: get_mutable() will CoW the UsedValues if it's inherited from an ancestor state;
     UsedValues& get_mutable(NodeWithStyle const&);
 
@@ -193,6 +207,8 @@ struct LayoutState {
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
 
+    LayoutState const* previous_layout { nullptr };
+
 private:
     void resolve_relative_positions();
 };
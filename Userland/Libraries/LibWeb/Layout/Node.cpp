@@ -1050,6 +1050,14 @@ void Node::set_paintable(JS::GCPtr<Painting::Paintable> paintable)
     m_paintable = move(paintable);
 }
 
+void Node::set_needs_layout()
+{
+    m_needs_layout = true;
+    for (Node* ancestor = parent(); ancestor && !ancestor->m_child_needs_layout; ancestor = ancestor->parent())
+        ancestor->m_child_needs_layout = true;
+    document().set_needs_layout({});
+}
+
 JS::GCPtr<Painting::Paintable> Node::create_paintable() const
 {
     return nullptr;
@@ -68,6 +68,17 @@ public:
     Painting::Paintable const* paintable() const { return m_paintable; }
     void set_paintable(JS::GCPtr<Painting::Paintable>);
 
+    // A node that needs layout invalidates the previous layout of its entire subtree.
+    // Its ancestors are marked as having a descendant that needs layout.
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void set_needs_layout();
+    void reset_needs_layout()
+    {
+        m_needs_layout = false;
+        m_child_needs_layout = false;
+    }
+
     virtual JS::GCPtr<Painting::Paintable> create_paintable() const;
 
     DOM::Document& document();
@@ -194,6 +205,9 @@ private:
     bool m_is_flex_item { false };
     bool m_is_grid_item { false };
 
+    bool m_needs_layout { true };
+    bool m_child_needs_layout { false };
+
     GeneratedFor m_generated_for { GeneratedFor::NotGenerated };
 
     u32 m_initial_quote_nesting_level { 0 };
@@ -6,6 +6,7 @@
 
 #include "LoadRequest.h"
 #include <LibWeb/Cookie/Cookie.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/Page/Page.h>
 
 namespace Web {
@@ -32,4 +33,9 @@ LoadRequest LoadRequest::create_for_url_on_page(const URL::URL& url, Page* page)
     return request;
 }
 
+void LoadRequest::set_preload_document(DOM::Document& document)
+{
+    m_preload_document = document;
+}
+
 }
@@ -9,6 +9,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
 #include <AK/Time.h>
+#include <AK/WeakPtr.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Forward.h>
@@ -46,6 +47,11 @@ public:
     JS::GCPtr<Page> page() const { return m_page.ptr(); }
     void set_page(Page& page) { m_page = page; }
 
+    // Speculative fetches are made on behalf of a document, in no-cors mode and with credentials included. A load may
+    // only be served from one of their preloaded responses if it is made the same way, for the same document.
+    WeakPtr<DOM::Document> const& preload_document() const { return m_preload_document; }
+    void set_preload_document(DOM::Document&);
+
     unsigned hash() const
     {
         auto body_hash = string_hash((char const*)m_body.data(), m_body.size());
@@ -81,6 +87,7 @@ private:
     ByteBuffer m_body;
     Core::ElapsedTimer m_load_timer;
     JS::Handle<Page> m_page;
+    WeakPtr<DOM::Document> m_preload_document;
     bool m_main_resource { false };
 };
 
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Debug.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/Directory.h>
@@ -234,6 +235,97 @@ static bool should_block_request(LoadRequest const& request)
     return false;
 }
 
+void ResourceLoader::preload(LoadRequest& request, DOM::Document& document)
+{
+    auto const& url = request.url();
+    if (request.method() != "GET"sv || !url.scheme().is_one_of("http"sv, "https"sv, "file"sv))
+        return;
+
+    // Preloads for documents that have gone away will never be used.
+    m_preloaded_responses.remove_all_matching([](auto const& preloaded_response) { return !preloaded_response->document; });
+
+    if (any_of(m_preloaded_responses, [&](auto const& preloaded_response) { return preloaded_response->url == url && preloaded_response->document.ptr() == &document; }))
+        return;
+
+    // Make room by dropping a preload that nobody asked for. If all of them are still loading, don't preload at all.
+    if (m_preloaded_responses.size() >= max_preloaded_response_count) {
+        auto index = m_preloaded_responses.find_first_index_if([](auto const& preloaded_response) { return preloaded_response->finished; });
+        if (!index.has_value())
+            return;
+        m_preloaded_responses.remove(*index);
+    }
+
+    auto preloaded_response = adopt_ref(*new PreloadedResponse);
+    preloaded_response->url = url;
+    preloaded_response->document = document;
+
+    auto finish = [preloaded_response] {
+        preloaded_response->finished = true;
+        auto callbacks = move(preloaded_response->on_finish);
+        for (auto& callback : callbacks)
+            callback(*preloaded_response);
+    };
+
+    dbgln_if(SPAM_DEBUG, "ResourceLoader: Preloading \"{}\"", sanitized_url_for_logging(url));
+
+    // NOTE: The preloaded response is registered after starting the load, so this load doesn't pick it up itself.
+    load(
+        request,
+        [preloaded_response, finish](ReadonlyBytes data, HTTP::HeaderMap const& response_headers, Optional<u32> status_code) {
+            preloaded_response->success = true;
+            preloaded_response->body = MUST(ByteBuffer::copy(data));
+            preloaded_response->response_headers = response_headers;
+            preloaded_response->status_code = status_code;
+            finish();
+        },
+        [preloaded_response, finish](ByteString const& error, Optional<u32> status_code, ReadonlyBytes payload, HTTP::HeaderMap const& response_headers) {
+            preloaded_response->error = error;
+            preloaded_response->body = MUST(ByteBuffer::copy(payload));
+            preloaded_response->response_headers = response_headers;
+            preloaded_response->status_code = status_code;
+            finish();
+        });
+
+    m_preloaded_responses.append(move(preloaded_response));
+}
+
+RefPtr<ResourceLoader::PreloadedResponse> ResourceLoader::take_preloaded_response(LoadRequest const& request)
+{
+    if (m_preloaded_responses.is_empty() || request.method() != "GET"sv || !request.body().is_empty())
+        return nullptr;
+
+    // NOTE: Range requests (e.g. from media elements) expect a partial response, so they can't use the preload.
+    if (request.headers().contains("Range"))
+        return nullptr;
+
+    // Only loads made the same way as a speculative fetch, for the document that made it, may use its response.
+    auto const& document = request.preload_document();
+    if (!document)
+        return nullptr;
+
+    auto index = m_preloaded_responses.find_first_index_if([&](auto const& preloaded_response) {
+        return preloaded_response->url == request.url() && preloaded_response->document.ptr() == document.ptr();
+    });
+    if (!index.has_value())
+        return nullptr;
+
+    return m_preloaded_responses.take(*index);
+}
+
+bool ResourceLoader::PreloadedResponse::is_reusable() const
+{
+    auto cache_control = response_headers.get("Cache-Control");
+    if (!cache_control.has_value())
+        return true;
+
+    for (auto directive : cache_control->split_view(',')) {
+        directive = directive.trim_whitespace();
+        if (directive.equals_ignoring_ascii_case("no-store"sv) || directive.equals_ignoring_ascii_case("no-cache"sv) || directive.starts_with("max-age=0"sv, CaseSensitivity::CaseInsensitive))
+            return false;
+    }
+    return true;
+}
+
 void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback, ErrorCallback error_callback, Optional<u32> timeout, TimeoutCallback timeout_callback)
 {
     auto const& url = request.url();
@@ -246,6 +338,34 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         return;
     }
 
+    if (auto preloaded_response = take_preloaded_response(request)) {
+        auto respond = [this, request, success_callback = move(success_callback), error_callback = move(error_callback)](PreloadedResponse const& preloaded_response) mutable {
+            // A response that may not be stored can't be handed out again either, so go to the network instead.
+            if (!preloaded_response.is_reusable()) {
+                load(request, move(success_callback), move(error_callback));
+                return;
+            }
+
+            if (preloaded_response.success) {
+                log_success(request);
+                success_callback(preloaded_response.body, preloaded_response.response_headers, preloaded_response.status_code);
+            } else {
+                log_failure(request, preloaded_response.error);
+                if (error_callback)
+                    error_callback(preloaded_response.error, preloaded_response.status_code, preloaded_response.body, preloaded_response.response_headers);
+            }
+        };
+
+        if (preloaded_response->finished) {
+            Platform::EventLoopPlugin::the().deferred_invoke([preloaded_response, respond = move(respond)]() mutable {
+                respond(*preloaded_response);
+            });
+        } else {
+            preloaded_response->on_finish.append(move(respond));
+        }
+        return;
+    }
+
     auto respond_directory_page = [](LoadRequest const& request, URL::URL const& url, SuccessCallback const& success_callback, ErrorCallback const& error_callback) {
         auto maybe_response = load_file_directory_page(url);
         if (maybe_response.is_error()) {
@@ -469,6 +589,37 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_
         return;
     }
 
+    if (auto preloaded_response = take_preloaded_response(request)) {
+        auto respond = [this, request, on_headers_received = move(on_headers_received), on_data_received = move(on_data_received), on_complete = move(on_complete)](PreloadedResponse const& preloaded_response) mutable {
+            if (!preloaded_response.is_reusable()) {
+                load_unbuffered(request, move(on_headers_received), move(on_data_received), move(on_complete));
+                return;
+            }
+
+            // NOTE: Unbuffered loads hand HTTP error responses to the caller like any other response.
+            if (!preloaded_response.success && !preloaded_response.status_code.has_value()) {
+                log_failure(request, preloaded_response.error);
+                on_complete(false, preloaded_response.error.view());
+                return;
+            }
+
+            log_success(request);
+            on_headers_received(preloaded_response.response_headers, preloaded_response.status_code);
+            if (!preloaded_response.body.is_empty())
+                on_data_received(preloaded_response.body);
+            on_complete(true, {});
+        };
+
+        if (preloaded_response->finished) {
+            Platform::EventLoopPlugin::the().deferred_invoke([preloaded_response, respond = move(respond)]() mutable {
+                respond(*preloaded_response);
+            });
+        } else {
+            preloaded_response->on_finish.append(move(respond));
+        }
+        return;
+    }
+
     if (!url.scheme().is_one_of("http"sv, "https"sv, "gemini"sv)) {
         // FIXME: Non-network requests from fetch should not go through this path.
         on_complete(false, "Cannot establish connection non-network scheme"sv);
@@ -568,6 +719,7 @@ void ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
     s_resource_cache.clear();
+    m_preloaded_responses.clear();
 }
 
 void ResourceLoader::evict_from_cache(LoadRequest const& request)
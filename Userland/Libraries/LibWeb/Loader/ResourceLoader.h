@@ -90,6 +90,11 @@ public:
     void prefetch_dns(URL::URL const&);
     void preconnect(URL::URL const&);
 
+    // Starts loading a resource that is expected to be requested soon, e.g. one found by the HTML parser's speculative
+    // parsing while it is blocked on a script. The next load() or load_unbuffered() of the same URL for the same document
+    // (see LoadRequest::preload_document()) is served from the preloaded response instead of being requested again.
+    void preload(LoadRequest&, DOM::Document&);
+
     Function<void()> on_load_counter_change;
 
     int pending_loads() const { return m_pending_loads; }
@@ -124,6 +129,25 @@ private:
     ResourceLoader(NonnullRefPtr<ResourceLoaderConnector>);
     static ErrorOr<NonnullRefPtr<ResourceLoader>> try_create(NonnullRefPtr<ResourceLoaderConnector>);
 
+    struct PreloadedResponse : public RefCounted<PreloadedResponse> {
+        URL::URL url;
+        WeakPtr<DOM::Document> document;
+        bool finished { false };
+        bool success { false };
+        ByteString error;
+        Optional<u32> status_code;
+        HTTP::HeaderMap response_headers;
+        ByteBuffer body;
+        Vector<Function<void(PreloadedResponse const&)>> on_finish;
+
+        // Whether the response's cache headers allow it to be used for a later request.
+        bool is_reusable() const;
+    };
+
+    static constexpr size_t max_preloaded_response_count = 64;
+
+    RefPtr<PreloadedResponse> take_preloaded_response(LoadRequest const&);
+
     RefPtr<ResourceLoaderConnectorRequest> start_network_request(LoadRequest const&);
     void handle_network_response_headers(LoadRequest const&, HTTP::HeaderMap const&);
     void finish_network_request(NonnullRefPtr<ResourceLoaderConnectorRequest> const&);
@@ -131,6 +155,7 @@ private:
     int m_pending_loads { 0 };
 
     HashTable<NonnullRefPtr<ResourceLoaderConnectorRequest>> m_active_requests;
+    Vector<NonnullRefPtr<PreloadedResponse>> m_preloaded_responses;
     NonnullRefPtr<ResourceLoaderConnector> m_connector;
     String m_user_agent;
     String m_platform;
@@ -294,6 +294,7 @@ struct PaintOptions {
 enum class DisplayListPlayerType {
     CPU,
     CPUWithExperimentalTransformSupport,
+    TiledCPU,
     GPU,
 };
 
@@ -111,17 +111,33 @@ void DisplayList::execute(DisplayListPlayer& executor)
         executor.update_immutable_bitmap_texture_cache(immutable_bitmaps);
     }
 
+    execute_commands(executor, {});
+}
+
+void DisplayList::execute(DisplayListPlayer& executor, ReadonlySpan<size_t> command_indices)
+{
+    executor.prepare_to_execute(m_corner_clip_max_depth);
+    execute_commands(executor, command_indices);
+}
+
+void DisplayList::execute_commands(DisplayListPlayer& executor, Optional<ReadonlySpan<size_t>> command_indices)
+{
+    auto command_count = command_indices.has_value() ? command_indices->size() : m_commands.size();
+    auto item_at = [&](size_t position) -> CommandListItem& {
+        return m_commands[command_indices.has_value() ? command_indices->at(position) : position];
+    };
+
     HashTable<u32> skipped_sample_corner_commands;
     size_t next_command_index = 0;
     Vector<DisplayListPlayer&, 16> executor_stack;
     DisplayListPlayer* current_executor = &executor;
-    while (next_command_index < m_commands.size()) {
-        if (m_commands[next_command_index].skip) {
+    while (next_command_index < command_count) {
+        if (item_at(next_command_index).skip) {
             next_command_index++;
             continue;
         }
 
-        auto& command = m_commands[next_command_index++].command;
+        auto& command = item_at(next_command_index++).command;
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || current_executor->would_be_fully_clipped_by_painter(*bounding_rect))) {
             if (command.has<SampleUnderCorners>()) {
@@ -187,10 +203,11 @@ void DisplayList::execute(DisplayListPlayer& executor)
             current_executor = &executor_stack.take_last();
         } else if (result == CommandResult::SkipStackingContext) {
             auto stacking_context_nesting_level = 1;
-            while (next_command_index < m_commands.size()) {
-                if (m_commands[next_command_index].command.has<PushStackingContext>()) {
+            while (next_command_index < command_count) {
+                auto const& skipped_command = item_at(next_command_index).command;
+                if (skipped_command.has<PushStackingContext>()) {
                     stacking_context_nesting_level++;
-                } else if (m_commands[next_command_index].command.has<PopStackingContext>()) {
+                } else if (skipped_command.has<PopStackingContext>()) {
                     stacking_context_nesting_level--;
                 }
 
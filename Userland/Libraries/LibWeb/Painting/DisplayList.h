@@ -92,10 +92,20 @@ public:
     void mark_unnecessary_commands();
     void execute(DisplayListPlayer&);
 
+    // Replays only the commands at the given indices, in the given order. Used by the tiled CPU player to rasterize
+    // the subset of commands binned into a single tile.
+    void execute(DisplayListPlayer&, ReadonlySpan<size_t> command_indices);
+
+    size_t command_count() const { return m_commands.size(); }
+
     size_t corner_clip_max_depth() const { return m_corner_clip_max_depth; }
     void set_corner_clip_max_depth(size_t depth) { m_corner_clip_max_depth = depth; }
 
 private:
+    friend class TiledDisplayListPlayerCPU;
+
+    void execute_commands(DisplayListPlayer&, Optional<ReadonlySpan<size_t>> command_indices);
+
     struct CommandListItem {
         Optional<i32> scroll_frame_id;
         Command command;
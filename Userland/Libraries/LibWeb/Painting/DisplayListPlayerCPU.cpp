@@ -6,6 +6,7 @@
 
 #include <LibGfx/Filters/StackBlurFilter.h>
 #include <LibGfx/StylePainter.h>
+#include <LibThreading/Mutex.h>
 #include <LibWeb/CSS/ComputedValues.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/DisplayListPlayerCPU.h>
@@ -15,20 +16,48 @@
 
 namespace Web::Painting {
 
-DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor)
+namespace {
+
+// Players that don't share fonts with other threads aren't given a mutex, and don't pay for locking.
+class FontAccessLocker {
+public:
+    explicit FontAccessLocker(Threading::Mutex* mutex)
+        : m_mutex(mutex)
+    {
+        if (m_mutex)
+            m_mutex->lock();
+    }
+
+    ~FontAccessLocker()
+    {
+        if (m_mutex)
+            m_mutex->unlock();
+    }
+
+private:
+    Threading::Mutex* m_mutex { nullptr };
+};
+
+}
+
+DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor, Gfx::IntPoint origin, Threading::Mutex* font_access_mutex)
     : m_target_bitmap(bitmap)
     , m_enable_affine_command_executor(enable_affine_command_executor)
+    , m_base_translation(-origin)
+    , m_font_access_mutex(font_access_mutex)
 {
     stacking_contexts.append({ .painter = AK::make<Gfx::Painter>(bitmap),
         .opacity = 1.0f,
         .destination = {},
         .scaling_mode = {} });
+    painter().translate(m_base_translation);
 }
 
 DisplayListPlayerCPU::~DisplayListPlayerCPU() = default;
 
 CommandResult DisplayListPlayerCPU::draw_glyph_run(DrawGlyphRun const& command)
 {
+    FontAccessLocker locker(m_font_access_mutex);
     auto& painter = this->painter();
     auto const& glyphs = command.glyph_run->glyphs();
     auto const& font = command.glyph_run->font();
@@ -125,7 +154,7 @@ CommandResult DisplayListPlayerCPU::push_stacking_context(PushStackingContext co
     auto affine_transform = Gfx::extract_2d_affine_transform(command.transform.matrix);
 
     if (m_enable_affine_command_executor && !affine_transform.is_identity_or_translation()) {
-        auto offset = command.is_fixed_position ? Gfx::IntPoint {} : painter().translation();
+        auto offset = command.is_fixed_position ? m_base_translation : painter().translation();
         m_affine_display_list_player = AffineDisplayListPlayerCPU(painter().target(),
             Gfx::AffineTransform {}.set_translation(offset.to_type<float>()), painter().clip_rect());
         if (m_affine_display_list_player->push_stacking_context(command) == CommandResult::SkipStackingContext)
@@ -135,7 +164,7 @@ CommandResult DisplayListPlayerCPU::push_stacking_context(PushStackingContext co
 
     painter().save();
     if (command.is_fixed_position)
-        painter().translate(-painter().translation());
+        painter().translate(m_base_translation - painter().translation());
 
     if (command.mask.has_value()) {
         // TODO: Support masks and other stacking context features at the same time.
@@ -149,7 +178,7 @@ CommandResult DisplayListPlayerCPU::push_stacking_context(PushStackingContext co
             .opacity = 1,
             .destination = command.source_paintable_rect.translated(command.post_transform_translation),
             .scaling_mode = Gfx::ScalingMode::None,
-            .mask = command.mask });
+            .mask = &command.mask.value() });
         painter().translate(-command.source_paintable_rect.location());
         return CommandResult::Continue;
     }
@@ -223,7 +252,7 @@ CommandResult DisplayListPlayerCPU::pop_stacking_context(PopStackingContext cons
     // Stacking contexts that don't own their painter are simple translations, and don't need to blit anything back.
     if (stacking_context.painter.is_owned()) {
         auto& bitmap = stacking_context.painter->target();
-        if (stacking_context.mask.has_value())
+        if (stacking_context.mask)
             bitmap.apply_mask(*stacking_context.mask->mask_bitmap, stacking_context.mask->mask_kind);
         auto destination_rect = stacking_context.destination;
         if (destination_rect.size() == bitmap.size()) {
@@ -279,20 +308,23 @@ CommandResult DisplayListPlayerCPU::paint_text_shadow(PaintTextShadow const& com
     // FIXME: "Spread" the shadow somehow.
     Gfx::IntPoint const baseline_start(command.text_rect.x(), command.text_rect.y());
     shadow_painter.translate(baseline_start);
-    auto const& glyphs = command.glyph_run->glyphs();
-    auto const& font = command.glyph_run->font();
-    auto scaled_font = font.with_size(font.point_size() * static_cast<float>(command.glyph_run_scale));
-    for (auto const& glyph_or_emoji : glyphs) {
-        auto transformed_glyph = glyph_or_emoji;
-        transformed_glyph.visit([&](auto& glyph) {
-            glyph.position = glyph.position.scaled(command.glyph_run_scale);
-        });
-        if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
-            auto& glyph = transformed_glyph.get<Gfx::DrawGlyph>();
-            shadow_painter.draw_glyph(glyph.position, glyph.code_point, *scaled_font, command.color);
-        } else {
-            auto& emoji = transformed_glyph.get<Gfx::DrawEmoji>();
-            shadow_painter.draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, *scaled_font);
+    {
+        FontAccessLocker locker(m_font_access_mutex);
+        auto const& glyphs = command.glyph_run->glyphs();
+        auto const& font = command.glyph_run->font();
+        auto scaled_font = font.with_size(font.point_size() * static_cast<float>(command.glyph_run_scale));
+        for (auto const& glyph_or_emoji : glyphs) {
+            auto transformed_glyph = glyph_or_emoji;
+            transformed_glyph.visit([&](auto& glyph) {
+                glyph.position = glyph.position.scaled(command.glyph_run_scale);
+            });
+            if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
+                auto& glyph = transformed_glyph.get<Gfx::DrawGlyph>();
+                shadow_painter.draw_glyph(glyph.position, glyph.code_point, *scaled_font, command.color);
+            } else {
+                auto& emoji = transformed_glyph.get<Gfx::DrawEmoji>();
+                shadow_painter.draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, *scaled_font);
+            }
         }
     }
 
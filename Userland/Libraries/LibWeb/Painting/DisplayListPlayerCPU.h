@@ -8,6 +8,7 @@
 
 #include <AK/MaybeOwned.h>
 #include <LibGfx/ScalingMode.h>
+#include <LibThreading/Forward.h>
 #include <LibWeb/Painting/AffineDisplayListPlayerCPU.h>
 #include <LibWeb/Painting/DisplayListRecorder.h>
 
@@ -53,7 +54,11 @@ public:
     bool needs_update_immutable_bitmap_texture_cache() const override { return false; }
     void update_immutable_bitmap_texture_cache(HashMap<u32, Gfx::ImmutableBitmap const*>&) override {};
 
-    DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor = false);
+    // `origin` is the device-space position of the top-left pixel of `bitmap`. It is non-zero when a tile of the
+    // viewport is rasterized into its own bitmap.
+    // Fonts cache scaled instances and rasterized glyphs lazily, and are reference counted non-atomically. Players that
+    // run concurrently must therefore share a `font_access_mutex`, which serializes their glyph drawing.
+    DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor = false, Gfx::IntPoint origin = {}, Threading::Mutex* font_access_mutex = nullptr);
     ~DisplayListPlayerCPU();
 
     DisplayListPlayer& nested_player() override
@@ -64,6 +69,8 @@ public:
 private:
     Gfx::Bitmap& m_target_bitmap;
     bool m_enable_affine_command_executor { false };
+    Gfx::IntPoint m_base_translation;
+    Threading::Mutex* m_font_access_mutex { nullptr };
 
     Vector<RefPtr<BorderRadiusCornerClipper>> m_corner_clippers_stack;
 
@@ -72,7 +79,7 @@ private:
         float opacity;
         Gfx::IntRect destination;
         Gfx::ScalingMode scaling_mode;
-        Optional<StackingContextMask> mask = {};
+        StackingContextMask const* mask { nullptr };
     };
 
     [[nodiscard]] Gfx::Painter const& painter() const { return *stacking_contexts.last().painter; }
@@ -0,0 +1,596 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/BitCast.h>
+#include <LibCore/System.h>
+#include <LibGfx/Matrix4x4.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/Painting/DisplayListPlayerCPU.h>
+#include <LibWeb/Painting/TiledDisplayListPlayerCPU.h>
+
+namespace Web::Painting {
+
+using RasterizationWork = Function<void()>;
+
+static size_t rasterization_worker_count()
+{
+    static size_t const worker_count = max(Core::System::hardware_concurrency(), 1u) - 1;
+    return worker_count;
+}
+
+// Tiles are rasterized concurrently, but fonts are not thread-safe. See DisplayListPlayerCPU.
+static Threading::Mutex s_font_access_mutex;
+
+static Threading::ThreadPool<RasterizationWork>& rasterization_thread_pool()
+{
+    static Threading::ThreadPool<RasterizationWork> thread_pool {
+        [](RasterizationWork work) { work(); },
+        rasterization_worker_count(),
+    };
+    return thread_pool;
+}
+
+namespace {
+
+// Everything that influences the pixels produced by a command, spelled out in full rather than hashed, so that two
+// different commands can never be mistaken for one another.
+class CommandKey {
+public:
+    Vector<u32> take_words() { return move(m_words); }
+
+    void add(u32 value) { m_words.append(value); }
+    void add(int value) { add(static_cast<u32>(value)); }
+    void add(u64 value)
+    {
+        add(static_cast<u32>(value));
+        add(static_cast<u32>(value >> 32));
+    }
+    void add(bool value) { add(static_cast<u32>(value)); }
+    void add(float value) { add(bit_cast<u32>(value)); }
+    void add(double value) { add(bit_cast<u64>(value)); }
+    void add(Color color) { add(color.value()); }
+    void add(Gfx::IntPoint point)
+    {
+        add(point.x());
+        add(point.y());
+    }
+    void add(Gfx::FloatPoint point)
+    {
+        add(point.x());
+        add(point.y());
+    }
+    void add(Gfx::IntRect const& rect)
+    {
+        add(rect.location());
+        add(rect.width());
+        add(rect.height());
+    }
+    void add(Gfx::CornerRadius radius)
+    {
+        add(radius.horizontal_radius);
+        add(radius.vertical_radius);
+    }
+    void add(StringView string)
+    {
+        add(static_cast<u32>(string.length()));
+        for (size_t offset = 0; offset < string.length(); offset += sizeof(u32)) {
+            u32 word = 0;
+            __builtin_memcpy(&word, string.characters_without_null_termination() + offset, min(sizeof(u32), string.length() - offset));
+            add(word);
+        }
+    }
+    // Fonts are identified by what they are rather than by their address, which may be reused by another font once
+    // this one is gone.
+    void add(Gfx::Font const& font)
+    {
+        add(font.family().bytes_as_string_view());
+        add(font.variant().bytes_as_string_view());
+        add(font.point_size());
+        add(font.pixel_size());
+        add(static_cast<u32>(font.weight()));
+        add(static_cast<u32>(font.width()));
+        add(static_cast<u32>(font.slope()));
+    }
+
+private:
+    Vector<u32> m_words;
+};
+
+}
+
+// Returns everything that influences the pixels produced by the command, or nothing if the command refers to state
+// that may change without the command itself changing (mutable bitmaps, paint styles, paths), in which case tiles
+// containing it are rasterized on every frame.
+static Optional<Vector<u32>> command_key(Command const& command)
+{
+    CommandKey key;
+    key.add(static_cast<u32>(command.index()));
+    bool is_stable = command.visit(
+        [&](DrawGlyphRun const& command) {
+            key.add(command.glyph_run->font());
+            for (auto const& glyph_or_emoji : command.glyph_run->glyphs()) {
+                glyph_or_emoji.visit(
+                    [&](Gfx::DrawGlyph const& glyph) {
+                        key.add(glyph.position);
+                        key.add(glyph.code_point);
+                    },
+                    [&](Gfx::DrawEmoji const& emoji) {
+                        key.add(emoji.position);
+                        // NOTE: Emoji bitmaps are cached for the lifetime of the process, so their address identifies them.
+                        key.add(static_cast<u64>(bit_cast<FlatPtr>(emoji.emoji)));
+                    });
+            }
+            key.add(command.color);
+            key.add(command.rect);
+            key.add(command.translation);
+            key.add(command.scale);
+            return true;
+        },
+        [&](FillRect const& command) {
+            key.add(command.rect);
+            key.add(command.color);
+            return command.clip_paths.is_empty();
+        },
+        [&](DrawScaledImmutableBitmap const& command) {
+            key.add(command.dst_rect);
+            key.add(static_cast<u64>(command.bitmap->id()));
+            key.add(command.src_rect);
+            key.add(static_cast<u32>(command.scaling_mode));
+            return command.clip_paths.is_empty();
+        },
+        [&](SetClipRect const& command) {
+            key.add(command.rect);
+            return true;
+        },
+        [&](ClearClipRect const&) {
+            return true;
+        },
+        [&](PushStackingContext const& command) {
+            key.add(command.opacity);
+            key.add(command.is_fixed_position);
+            key.add(command.source_paintable_rect);
+            key.add(command.post_transform_translation);
+            key.add(static_cast<u32>(command.image_rendering));
+            key.add(command.transform.origin);
+            for (size_t i = 0; i < 4; ++i) {
+                for (size_t j = 0; j < 4; ++j)
+                    key.add(command.transform.matrix.elements()[i][j]);
+            }
+            return !command.mask.has_value();
+        },
+        [&](PopStackingContext const&) {
+            return true;
+        },
+        [&](FillRectWithRoundedCorners const& command) {
+            key.add(command.rect);
+            key.add(command.color);
+            key.add(command.top_left_radius);
+            key.add(command.top_right_radius);
+            key.add(command.bottom_left_radius);
+            key.add(command.bottom_right_radius);
+            return command.clip_paths.is_empty();
+        },
+        [&](DrawEllipse const& command) {
+            key.add(command.rect);
+            key.add(command.color);
+            key.add(command.thickness);
+            return true;
+        },
+        [&](FillEllipse const& command) {
+            key.add(command.rect);
+            key.add(command.color);
+            return true;
+        },
+        [&](DrawLine const& command) {
+            key.add(command.color);
+            key.add(command.from);
+            key.add(command.to);
+            key.add(command.thickness);
+            key.add(static_cast<u32>(command.style));
+            key.add(command.alternate_color);
+            return true;
+        },
+        [&](DrawRect const& command) {
+            key.add(command.rect);
+            key.add(command.color);
+            key.add(command.rough);
+            return true;
+        },
+        [&](DrawTriangleWave const& command) {
+            key.add(command.p1);
+            key.add(command.p2);
+            key.add(command.color);
+            key.add(command.amplitude);
+            key.add(command.thickness);
+            return true;
+        },
+        [&](SampleUnderCorners const& command) {
+            key.add(command.corner_radii.top_left);
+            key.add(command.corner_radii.top_right);
+            key.add(command.corner_radii.bottom_right);
+            key.add(command.corner_radii.bottom_left);
+            key.add(command.border_rect);
+            key.add(static_cast<u32>(command.corner_clip));
+            return true;
+        },
+        [&](BlitCornerClipping const& command) {
+            // Corner clipper IDs are allocated per frame and don't affect the output.
+            key.add(command.border_rect);
+            return true;
+        },
+        [](auto const&) {
+            return false;
+        });
+
+    if (!is_stable)
+        return {};
+    return key.take_words();
+}
+
+// The area a command may touch, in the coordinate space of the stacking context it is recorded in.
+static Optional<Gfx::IntRect> command_bounds(Command const& command)
+{
+    return command.visit(
+        [](DrawLine const& command) -> Optional<Gfx::IntRect> {
+            return Gfx::IntRect::from_two_points(command.from, command.to).inflated(command.thickness * 2, command.thickness * 2);
+        },
+        [](DrawTriangleWave const& command) -> Optional<Gfx::IntRect> {
+            auto margin = (command.amplitude + command.thickness) * 2;
+            return Gfx::IntRect::from_two_points(command.p1, command.p2).inflated(margin, margin);
+        },
+        [](auto const& command) -> Optional<Gfx::IntRect> {
+            if constexpr (requires { command.bounding_rect(); })
+                return command.bounding_rect();
+            else
+                return {};
+        });
+}
+
+static void prepare_paths_for_concurrent_use(Command const& command)
+{
+    // Paths segment themselves lazily on first use, which must not race between tiles sharing the same command.
+    command.visit([](auto const& command) {
+        if constexpr (requires { command.path.split_lines(); })
+            (void)command.path.split_lines();
+        if constexpr (requires { command.clip_paths; }) {
+            for (auto const& clip_path : command.clip_paths)
+                (void)clip_path.split_lines();
+        }
+    });
+}
+
+TiledDisplayListPlayerCPU::TiledDisplayListPlayerCPU(int tile_size)
+    : m_tile_size(tile_size)
+{
+    VERIFY(m_tile_size > 0);
+}
+
+TiledDisplayListPlayerCPU::~TiledDisplayListPlayerCPU() = default;
+
+void TiledDisplayListPlayerCPU::invalidate_all_tiles()
+{
+    for (auto& tile : m_tiles)
+        tile.rasterized_key = {};
+}
+
+void TiledDisplayListPlayerCPU::rebuild_tiles(Gfx::IntSize size)
+{
+    m_size = size;
+    m_columns = ceil_div(size.width(), m_tile_size);
+    m_rows = ceil_div(size.height(), m_tile_size);
+
+    m_tiles.clear_with_capacity();
+    m_tiles.ensure_capacity(m_columns * m_rows);
+    for (int row = 0; row < m_rows; ++row) {
+        for (int column = 0; column < m_columns; ++column) {
+            Gfx::IntRect rect { column * m_tile_size, row * m_tile_size, m_tile_size, m_tile_size };
+            m_tiles.unchecked_append({ .rect = rect.intersected({ {}, size }) });
+        }
+    }
+}
+
+void TiledDisplayListPlayerCPU::bin_commands(DisplayList& display_list)
+{
+    auto& commands = display_list.m_commands;
+
+    // Stacking contexts that are plain translations paint straight into their parent, so their contents are binned
+    // command by command. Their push/pop commands (and the clip rect in effect) are only emitted into a tile once
+    // something inside them actually touches that tile.
+    struct PassThroughStackingContext {
+        size_t push_index;
+        Gfx::IntPoint translation;
+        Optional<size_t> clip_at_push;
+        Optional<size_t> clip;
+    };
+    Vector<PassThroughStackingContext, 16> stacking_contexts;
+    Optional<size_t> root_clip;
+
+    struct TileBinningState {
+        size_t open_stacking_context_count { 0 };
+        Vector<Optional<size_t>, 8> emitted_clips;
+    };
+    Vector<TileBinningState> states;
+    states.resize(m_tiles.size());
+    for (auto& tile : m_tiles) {
+        tile.command_indices.clear_with_capacity();
+        if (tile.key.has_value())
+            tile.key->clear_with_capacity();
+        else
+            tile.key = Vector<u32> {};
+    }
+    for (auto& state : states)
+        state.emitted_clips.append({});
+
+    auto current_translation = [&] {
+        return stacking_contexts.is_empty() ? Gfx::IntPoint {} : stacking_contexts.last().translation;
+    };
+    auto current_clip = [&]() -> Optional<size_t>& {
+        return stacking_contexts.is_empty() ? root_clip : stacking_contexts.last().clip;
+    };
+
+    // Commands spanning several tiles are only looked at once.
+    struct CachedCommandKey {
+        bool is_computed { false };
+        Optional<Vector<u32>> words;
+    };
+    Vector<CachedCommandKey> command_keys;
+    command_keys.resize(commands.size());
+
+    auto append = [&](size_t tile_index, size_t command_index) {
+        auto& tile = m_tiles[tile_index];
+        tile.command_indices.append(command_index);
+        if (!tile.key.has_value())
+            return;
+        auto& cached_key = command_keys[command_index];
+        if (!cached_key.is_computed) {
+            cached_key.words = command_key(commands[command_index].command);
+            cached_key.is_computed = true;
+        }
+        if (!cached_key.words.has_value()) {
+            tile.key = {};
+            return;
+        }
+        // The length prefix keeps the concatenation of keys unambiguous.
+        tile.key->append(static_cast<u32>(cached_key.words->size()));
+        tile.key->extend(*cached_key.words);
+    };
+
+    auto emit_clip = [&](size_t tile_index, Optional<size_t> clip) {
+        auto& emitted_clip = states[tile_index].emitted_clips.last();
+        if (!clip.has_value() || emitted_clip == clip)
+            return;
+        append(tile_index, *clip);
+        emitted_clip = clip;
+    };
+
+    auto prepare_tile = [&](size_t tile_index) {
+        auto& state = states[tile_index];
+        while (state.open_stacking_context_count < stacking_contexts.size()) {
+            auto const& stacking_context = stacking_contexts[state.open_stacking_context_count];
+            emit_clip(tile_index, stacking_context.clip_at_push);
+            append(tile_index, stacking_context.push_index);
+            state.emitted_clips.append(state.emitted_clips.last());
+            state.open_stacking_context_count++;
+        }
+        emit_clip(tile_index, current_clip());
+    };
+
+    auto for_each_tile_intersecting = [&](Gfx::IntRect const& device_rect, auto callback) {
+        auto rect = device_rect.intersected({ {}, m_size });
+        if (rect.is_empty())
+            return;
+        auto first_column = rect.left() / m_tile_size;
+        auto last_column = (rect.right() - 1) / m_tile_size;
+        auto first_row = rect.top() / m_tile_size;
+        auto last_row = (rect.bottom() - 1) / m_tile_size;
+        for (int row = first_row; row <= last_row; ++row) {
+            for (int column = first_column; column <= last_column; ++column)
+                callback(static_cast<size_t>(row * m_columns + column));
+        }
+    };
+
+    auto find_matching_pop = [&](size_t push_index) {
+        size_t nesting_level = 0;
+        for (size_t index = push_index; index < commands.size(); ++index) {
+            if (commands[index].command.has<PushStackingContext>())
+                nesting_level++;
+            else if (commands[index].command.has<PopStackingContext>() && --nesting_level == 0)
+                return index;
+        }
+        return commands.size() - 1;
+    };
+
+    for (size_t index = 0; index < commands.size(); ++index) {
+        if (commands[index].skip)
+            continue;
+        auto const& command = commands[index].command;
+
+        if (command.has<SetClipRect>() || command.has<ClearClipRect>()) {
+            current_clip() = index;
+            continue;
+        }
+
+        if (command.has<PushStackingContext>()) {
+            auto const& push = command.get<PushStackingContext>();
+            auto affine_transform = Gfx::extract_2d_affine_transform(push.transform.matrix);
+            auto parent_translation = push.is_fixed_position ? Gfx::IntPoint {} : current_translation();
+
+            if (push.opacity == 1.0f && affine_transform.is_identity_or_translation() && !push.mask.has_value()) {
+                stacking_contexts.append({
+                    .push_index = index,
+                    .translation = parent_translation + affine_transform.translation().to_rounded<int>() + push.post_transform_translation,
+                    .clip_at_push = current_clip(),
+                    .clip = current_clip(),
+                });
+                continue;
+            }
+
+            // Everything else is painted into an intermediate bitmap that is clipped to the stacking context's
+            // destination rect, so the whole subtree can be binned as one unit.
+            Gfx::IntRect destination_rect;
+            if (push.mask.has_value()) {
+                destination_rect = push.source_paintable_rect;
+            } else {
+                auto source_rect = push.source_paintable_rect.to_type<float>().translated(-push.transform.origin);
+                destination_rect = affine_transform.map(source_rect).translated(push.transform.origin).to_rounded<int>();
+            }
+            destination_rect.translate_by(push.post_transform_translation + parent_translation);
+
+            auto pop_index = find_matching_pop(index);
+            for_each_tile_intersecting(destination_rect, [&](size_t tile_index) {
+                prepare_tile(tile_index);
+                for (size_t subtree_index = index; subtree_index <= pop_index; ++subtree_index) {
+                    if (!commands[subtree_index].skip)
+                        append(tile_index, subtree_index);
+                }
+            });
+            index = pop_index;
+            continue;
+        }
+
+        if (command.has<PopStackingContext>()) {
+            if (stacking_contexts.is_empty())
+                continue;
+            auto depth = stacking_contexts.size();
+            for (size_t tile_index = 0; tile_index < m_tiles.size(); ++tile_index) {
+                auto& state = states[tile_index];
+                if (state.open_stacking_context_count != depth)
+                    continue;
+                append(tile_index, index);
+                state.emitted_clips.take_last();
+                state.open_stacking_context_count--;
+            }
+            stacking_contexts.take_last();
+            continue;
+        }
+
+        auto bounds = command_bounds(command);
+        if (!bounds.has_value()) {
+            for (size_t tile_index = 0; tile_index < m_tiles.size(); ++tile_index) {
+                prepare_tile(tile_index);
+                append(tile_index, index);
+            }
+            continue;
+        }
+
+        for_each_tile_intersecting(bounds->translated(current_translation()), [&](size_t tile_index) {
+            prepare_tile(tile_index);
+            append(tile_index, index);
+        });
+    }
+}
+
+void TiledDisplayListPlayerCPU::rasterize_tile(DisplayList& display_list, Tile& tile)
+{
+    if (!tile.bitmap) {
+        auto bitmap_or_error = Gfx::Bitmap::create(m_format, tile.rect.size());
+        if (bitmap_or_error.is_error()) {
+            dbgln("Unable to allocate {} tile bitmap: {}", tile.rect.size(), bitmap_or_error.error());
+            return;
+        }
+        tile.bitmap = bitmap_or_error.release_value();
+    }
+
+    tile.bitmap->fill(Color::Transparent);
+    DisplayListPlayerCPU player(*tile.bitmap, false, tile.rect.location(), &s_font_access_mutex);
+    display_list.execute(player, tile.command_indices);
+    tile.rasterized_key = tile.key;
+}
+
+void TiledDisplayListPlayerCPU::copy_tile_to_target(Tile const& tile, Gfx::Bitmap& target) const
+{
+    if (!tile.bitmap)
+        return;
+    auto row_size_in_bytes = tile.rect.width() * sizeof(Gfx::ARGB32);
+    for (int y = 0; y < tile.rect.height(); ++y)
+        __builtin_memcpy(target.scanline(tile.rect.y() + y) + tile.rect.x(), tile.bitmap->scanline(y), row_size_in_bytes);
+}
+
+void TiledDisplayListPlayerCPU::execute(DisplayList& display_list, Gfx::Bitmap& target)
+{
+    m_last_frame_statistics = {};
+
+    // Backdrop filters sample whatever has been painted below them, which may lie in a neighbouring tile.
+    bool has_backdrop_filter = false;
+    for (auto const& item : display_list.m_commands) {
+        if (item.command.has<ApplyBackdropFilter>()) {
+            has_backdrop_filter = true;
+            break;
+        }
+    }
+    if (has_backdrop_filter || target.scale() != 1) {
+        DisplayListPlayerCPU player(target);
+        display_list.execute(player);
+        invalidate_all_tiles();
+        return;
+    }
+
+    if (target.size() != m_size || target.format() != m_format) {
+        m_format = target.format();
+        rebuild_tiles(target.size());
+    }
+
+    bin_commands(display_list);
+
+    Vector<size_t> tiles_to_rasterize;
+    for (size_t tile_index = 0; tile_index < m_tiles.size(); ++tile_index) {
+        auto& tile = m_tiles[tile_index];
+        m_last_frame_statistics.binned_command_count += tile.command_indices.size();
+        if (!tile.bitmap || !tile.key.has_value() || tile.key != tile.rasterized_key) {
+            tiles_to_rasterize.append(tile_index);
+            for (auto command_index : tile.command_indices)
+                prepare_paths_for_concurrent_use(display_list.m_commands[command_index].command);
+        }
+    }
+    m_last_frame_statistics.tile_count = m_tiles.size();
+    m_last_frame_statistics.rasterized_tile_count = tiles_to_rasterize.size();
+
+    struct RasterizationState {
+        Atomic<size_t> next_tile { 0 };
+        Threading::Mutex mutex;
+        Threading::ConditionVariable jobs_finished { mutex };
+        size_t pending_job_count { 0 };
+    } state;
+
+    auto rasterize_remaining_tiles = [&] {
+        while (true) {
+            auto position = state.next_tile.fetch_add(1);
+            if (position >= tiles_to_rasterize.size())
+                break;
+            rasterize_tile(display_list, m_tiles[tiles_to_rasterize[position]]);
+        }
+    };
+
+    // The calling thread rasterizes tiles too, so one tile never needs a worker.
+    size_t job_count = 0;
+    if (tiles_to_rasterize.size() > 1)
+        job_count = min(rasterization_worker_count(), tiles_to_rasterize.size() - 1);
+    state.pending_job_count = job_count;
+
+    for (size_t i = 0; i < job_count; ++i) {
+        rasterization_thread_pool().submit([&] {
+            rasterize_remaining_tiles();
+            Threading::MutexLocker locker(state.mutex);
+            state.pending_job_count--;
+            state.jobs_finished.signal();
+        });
+    }
+
+    rasterize_remaining_tiles();
+
+    {
+        Threading::MutexLocker locker(state.mutex);
+        state.jobs_finished.wait_while([&] { return state.pending_job_count > 0; });
+    }
+
+    for (auto const& tile : m_tiles)
+        copy_tile_to_target(tile, target);
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Rect.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+namespace Web::Painting {
+
+// Replays a display list by splitting the target into fixed-size tiles, binning every command into the tiles its
+// bounding rect touches, and rasterizing tiles concurrently. Tiles are kept between frames, and a tile is only
+// rasterized again if the commands binned into it differ from the ones it was last rasterized with.
+class TiledDisplayListPlayerCPU {
+    AK_MAKE_NONCOPYABLE(TiledDisplayListPlayerCPU);
+    AK_MAKE_NONMOVABLE(TiledDisplayListPlayerCPU);
+
+public:
+    static constexpr int default_tile_size = 256;
+
+    explicit TiledDisplayListPlayerCPU(int tile_size = default_tile_size);
+    ~TiledDisplayListPlayerCPU();
+
+    void execute(DisplayList&, Gfx::Bitmap& target);
+
+    void invalidate_all_tiles();
+
+    struct Statistics {
+        size_t tile_count { 0 };
+        size_t rasterized_tile_count { 0 };
+        size_t binned_command_count { 0 };
+    };
+    Statistics const& last_frame_statistics() const { return m_last_frame_statistics; }
+
+private:
+    struct Tile {
+        Gfx::IntRect rect;
+        RefPtr<Gfx::Bitmap> bitmap;
+        Vector<size_t> command_indices;
+
+        // The keys of all commands binned into the tile, this frame and when it was last rasterized. Empty if the tile
+        // has never been rasterized, or if one of its commands references state we can't cheaply compare (e.g. a
+        // mutable bitmap).
+        Optional<Vector<u32>> key;
+        Optional<Vector<u32>> rasterized_key;
+    };
+
+    void rebuild_tiles(Gfx::IntSize);
+    void bin_commands(DisplayList&);
+    void rasterize_tile(DisplayList&, Tile&);
+    void copy_tile_to_target(Tile const&, Gfx::Bitmap& target) const;
+
+    int m_tile_size { default_tile_size };
+    int m_columns { 0 };
+    int m_rows { 0 };
+    Gfx::IntSize m_size;
+    Gfx::BitmapFormat m_format { Gfx::BitmapFormat::BGRA8888 };
+    Vector<Tile> m_tiles;
+
+    Statistics m_last_frame_statistics;
+};
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Heap/Heap.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/PerformanceMetrics.h>
+
+namespace Web {
+
+PerformanceMetrics& PerformanceMetrics::the()
+{
+    static PerformanceMetrics metrics;
+    return metrics;
+}
+
+void PerformanceMetrics::attribute_elapsed_time_to_current_phase(MonotonicTime now)
+{
+    if (!m_phase_stack.is_empty())
+        m_phase_totals[to_underlying(m_phase_stack.last())].time += now - m_current_phase_start;
+    m_current_phase_start = now;
+}
+
+void PerformanceMetrics::enter_phase(Phase phase)
+{
+    attribute_elapsed_time_to_current_phase(MonotonicTime::now());
+    m_phase_stack.append(phase);
+    ++m_phase_totals[to_underlying(phase)].entry_count;
+}
+
+void PerformanceMetrics::leave_phase(Phase phase)
+{
+    VERIFY(!m_phase_stack.is_empty() && m_phase_stack.last() == phase);
+    attribute_elapsed_time_to_current_phase(MonotonicTime::now());
+    m_phase_stack.take_last();
+}
+
+void PerformanceMetrics::did_record_display_list(size_t command_count)
+{
+    ++m_display_list_count;
+    m_display_list_total_command_count += command_count;
+    m_last_display_list_command_count = command_count;
+}
+
+JsonObject PerformanceMetrics::to_json() const
+{
+    auto to_milliseconds = [](AK::Duration duration) {
+        return static_cast<double>(duration.to_nanoseconds()) / 1'000'000.0;
+    };
+
+    JsonObject phases;
+    auto add_phase = [&](Phase phase, StringView name) {
+        auto const& totals = m_phase_totals[to_underlying(phase)];
+
+        JsonObject phase_object;
+        phase_object.set("time_ms"sv, to_milliseconds(totals.time));
+        phase_object.set("count"sv, totals.entry_count);
+        phases.set(name, move(phase_object));
+    };
+#define __ENUMERATE_PERFORMANCE_METRICS_PHASE(name, json_name) add_phase(Phase::name, json_name##sv);
+    ENUMERATE_PERFORMANCE_METRICS_PHASES
+#undef __ENUMERATE_PERFORMANCE_METRICS_PHASE
+
+    auto const& heap = Bindings::main_thread_vm().heap();
+    JsonObject garbage_collection;
+    garbage_collection.set("time_ms"sv, to_milliseconds(heap.total_time_spent_collecting_garbage()));
+    garbage_collection.set("count"sv, heap.collection_count());
+    phases.set("gc"sv, move(garbage_collection));
+
+    JsonObject display_lists;
+    display_lists.set("count"sv, m_display_list_count);
+    display_lists.set("total_command_count"sv, m_display_list_total_command_count);
+    display_lists.set("last_command_count"sv, m_last_display_list_command_count);
+
+    JsonObject metrics;
+    metrics.set("phases"sv, move(phases));
+    metrics.set("display_lists"sv, move(display_lists));
+    return metrics;
+}
+
+}
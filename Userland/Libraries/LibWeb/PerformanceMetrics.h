@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/JsonObject.h>
+#include <AK/Noncopyable.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+
+namespace Web {
+
+#define ENUMERATE_PERFORMANCE_METRICS_PHASES                        \
+    __ENUMERATE_PERFORMANCE_METRICS_PHASE(HTMLParse, "html_parse")  \
+    __ENUMERATE_PERFORMANCE_METRICS_PHASE(Style, "style")           \
+    __ENUMERATE_PERFORMANCE_METRICS_PHASE(Layout, "layout")         \
+    __ENUMERATE_PERFORMANCE_METRICS_PHASE(Paint, "paint")           \
+    __ENUMERATE_PERFORMANCE_METRICS_PHASE(JavaScript, "javascript")
+
+// Cumulative time spent in each phase of loading and rendering pages in this process, used by benchmarking tools.
+// Phases nest (e.g. a script forcing a layout while the parser runs it), and time is only attributed to the innermost
+// phase, so no time is counted twice.
+class PerformanceMetrics {
+    AK_MAKE_NONCOPYABLE(PerformanceMetrics);
+    AK_MAKE_NONMOVABLE(PerformanceMetrics);
+
+public:
+    enum class Phase {
+#define __ENUMERATE_PERFORMANCE_METRICS_PHASE(name, json_name) name,
+        ENUMERATE_PERFORMANCE_METRICS_PHASES
+#undef __ENUMERATE_PERFORMANCE_METRICS_PHASE
+        __Count,
+    };
+
+    class ScopedPhase {
+        AK_MAKE_NONCOPYABLE(ScopedPhase);
+        AK_MAKE_NONMOVABLE(ScopedPhase);
+
+    public:
+        explicit ScopedPhase(Phase phase)
+            : m_phase(phase)
+        {
+            PerformanceMetrics::the().enter_phase(m_phase);
+        }
+
+        ~ScopedPhase()
+        {
+            PerformanceMetrics::the().leave_phase(m_phase);
+        }
+
+    private:
+        Phase m_phase;
+    };
+
+    static PerformanceMetrics& the();
+
+    void did_record_display_list(size_t command_count);
+
+    // Phase totals, display list sizes and garbage collection statistics, all counted since the process started.
+    JsonObject to_json() const;
+
+private:
+    PerformanceMetrics() = default;
+
+    void enter_phase(Phase);
+    void leave_phase(Phase);
+    void attribute_elapsed_time_to_current_phase(MonotonicTime now);
+
+    struct PhaseTotals {
+        AK::Duration time;
+        size_t entry_count { 0 };
+    };
+    Array<PhaseTotals, to_underlying(Phase::__Count)> m_phase_totals;
+
+    Vector<Phase, 8> m_phase_stack;
+    MonotonicTime m_current_phase_start { MonotonicTime::now() };
+
+    size_t m_display_list_count { 0 };
+    size_t m_display_list_total_command_count { 0 };
+    size_t m_last_display_list_command_count { 0 };
+};
+
+}
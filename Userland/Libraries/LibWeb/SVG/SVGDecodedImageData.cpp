@@ -101,6 +101,7 @@ RefPtr<Gfx::Bitmap> SVGDecodedImageData::render(Gfx::IntSize size) const
     switch (painting_command_executor_type) {
     case DisplayListPlayerType::CPU:
     case DisplayListPlayerType::CPUWithExperimentalTransformSupport:
+    case DisplayListPlayerType::TiledCPU:
     case DisplayListPlayerType::GPU: { // GPU painter does not have any path rasterization support so we always fall back to CPU painter
         Painting::DisplayListPlayerCPU executor { *bitmap };
         display_list.execute(executor);
@@ -17,6 +17,7 @@
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/PerformanceMetrics.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
 #include <LibWeb/WebIDL/Promise.h>
 #include <LibWeb/WebIDL/Types.h>
@@ -131,6 +132,8 @@ inline JS::Completion clean_up_on_return(HTML::EnvironmentSettingsObject& stored
 
 JS::Completion call_user_object_operation(WebIDL::CallbackType& callback, String const& operation_name, Optional<JS::Value> this_argument, JS::MarkedVector<JS::Value> args)
 {
+    PerformanceMetrics::ScopedPhase javascript_phase { PerformanceMetrics::Phase::JavaScript };
+
     // 1. Let completion be an uninitialized variable.
     JS::Completion completion;
 
@@ -208,6 +211,8 @@ JS::Completion call_user_object_operation(WebIDL::CallbackType& callback, String
 // https://webidl.spec.whatwg.org/#invoke-a-callback-function
 JS::Completion invoke_callback(WebIDL::CallbackType& callback, Optional<JS::Value> this_argument, JS::MarkedVector<JS::Value> args)
 {
+    PerformanceMetrics::ScopedPhase javascript_phase { PerformanceMetrics::Phase::JavaScript };
+
     // 1. Let completion be an uninitialized variable.
     JS::Completion completion;
 
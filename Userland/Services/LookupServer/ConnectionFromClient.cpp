@@ -64,4 +64,11 @@ Messages::LookupServer::LookupAddressResponse ConnectionFromClient::lookup_addre
         return { 1, ByteString() };
     return { 0, answers[0].record_data() };
 }
+
+Messages::LookupServer::CacheStatisticsResponse ConnectionFromClient::cache_statistics()
+{
+    auto const& cache = LookupServer::the().cache();
+    auto const& statistics = cache.statistics();
+    return { statistics.hits, statistics.negative_hits, statistics.misses, statistics.evictions, static_cast<u32>(cache.size()) };
+}
 }
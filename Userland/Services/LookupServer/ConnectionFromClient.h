@@ -27,6 +27,7 @@ private:
 
     virtual Messages::LookupServer::LookupNameResponse lookup_name(ByteString const&) override;
     virtual Messages::LookupServer::LookupAddressResponse lookup_address(ByteString const&) override;
+    virtual Messages::LookupServer::CacheStatisticsResponse cache_statistics() override;
 };
 
 }
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "LookupCache.h"
+#include <AK/Debug.h>
+#include <arpa/inet.h>
+
+namespace LookupServer {
+
+LookupCache::LookupCache(size_t max_entries)
+    : m_max_entries(max_entries)
+{
+    VERIFY(m_max_entries > 0);
+}
+
+// RFC 2308, 5. Caching Negative Answers: The SOA record in the authority section says for how long
+// we can remember that the name or record doesn't exist, that is for its TTL or its MINIMUM field, whichever is smaller.
+Optional<u32> LookupCache::negative_answer_ttl(ReadonlySpan<Answer> authorities)
+{
+    for (auto& authority : authorities) {
+        if (authority.type() != RecordType::SOA)
+            continue;
+        // MINIMUM is the last field of the SOA record.
+        auto const& data = authority.record_data();
+        if (data.length() < sizeof(u32))
+            continue;
+        u32 minimum;
+        memcpy(&minimum, data.characters() + data.length() - sizeof(u32), sizeof(minimum));
+        return min(min(authority.ttl(), static_cast<u32>(ntohl(minimum))), max_negative_ttl);
+    }
+    // Without an SOA record, negative answers must not be cached at all.
+    return {};
+}
+
+bool LookupCache::Entry::prune_expired(time_t now)
+{
+    answers.remove_all_matching([](Answer const& answer) { return answer.has_expired(); });
+    negative_expiry_times.remove_all_matching([now](RecordType, time_t expiry_time) { return expiry_time <= now; });
+    return answers.is_empty() && negative_expiry_times.is_empty();
+}
+
+Optional<Vector<Answer>> LookupCache::lookup(Name const& name, RecordType record_type)
+{
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+        m_statistics.misses++;
+        return {};
+    }
+
+    auto& entry = *it->value;
+    if (entry.prune_expired(time(nullptr))) {
+        remove_entry(entry);
+        m_statistics.misses++;
+        return {};
+    }
+
+    if (entry.negative_expiry_times.contains(record_type)) {
+        dbgln_if(LOOKUPSERVER_DEBUG, "Negative cache hit: {} has no {} records", name.as_string(), record_type);
+        m_lru_list.append(entry);
+        m_statistics.negative_hits++;
+        return Vector<Answer> {};
+    }
+
+    Vector<Answer> answers;
+    for (auto& answer : entry.answers) {
+        if (answer.type() == record_type)
+            answers.append(answer);
+    }
+    if (answers.is_empty()) {
+        m_statistics.misses++;
+        return {};
+    }
+
+    m_lru_list.append(entry);
+    m_statistics.hits++;
+    return answers;
+}
+
+void LookupCache::put(Answer const& answer)
+{
+    if (answer.has_expired())
+        return;
+
+    auto& entry = ensure_entry(answer.name());
+    if (answer.mdns_cache_flush()) {
+        auto now = time(nullptr);
+
+        entry.answers.remove_all_matching([&](Answer const& other_answer) {
+            if (other_answer.type() != answer.type() || other_answer.class_code() != answer.class_code())
+                return false;
+
+            if (other_answer.received_time() >= now - 1)
+                return false;
+
+            dbgln_if(LOOKUPSERVER_DEBUG, "Removing cache entry: {}", other_answer.name());
+            return true;
+        });
+    }
+
+    // A fresh copy of a record we already know replaces the old one, so that its TTL starts over.
+    entry.answers.remove_all_matching([&](Answer const& other_answer) {
+        return other_answer.type() == answer.type() && other_answer.class_code() == answer.class_code() && other_answer.record_data() == answer.record_data();
+    });
+    entry.answers.append(answer);
+    entry.negative_expiry_times.remove(answer.type());
+}
+
+void LookupCache::put_negative(Name const& name, RecordType record_type, u32 ttl)
+{
+    if (ttl == 0)
+        return;
+
+    auto& entry = ensure_entry(name);
+    entry.answers.remove_all_matching([&](Answer const& answer) { return answer.type() == record_type; });
+    entry.negative_expiry_times.set(record_type, time(nullptr) + ttl);
+}
+
+void LookupCache::remove_expired()
+{
+    auto now = time(nullptr);
+    Vector<Entry&> expired_entries;
+    for (auto& entry : m_lru_list) {
+        if (entry.prune_expired(now))
+            expired_entries.append(entry);
+    }
+    for (auto& entry : expired_entries)
+        remove_entry(entry);
+    dbgln_if(LOOKUPSERVER_DEBUG, "Removed {} expired cache entries, {} left", expired_entries.size(), m_entries.size());
+}
+
+LookupCache::Entry& LookupCache::ensure_entry(Name const& name)
+{
+    if (auto it = m_entries.find(name); it != m_entries.end()) {
+        m_lru_list.append(*it->value);
+        return *it->value;
+    }
+
+    if (m_entries.size() >= m_max_entries) {
+        auto* least_recently_used = m_lru_list.first();
+        VERIFY(least_recently_used);
+        dbgln_if(LOOKUPSERVER_DEBUG, "Evicting cache entry: {}", least_recently_used->name.as_string());
+        remove_entry(*least_recently_used);
+        m_statistics.evictions++;
+    }
+
+    auto entry = make<Entry>(name);
+    auto& entry_reference = *entry;
+    m_lru_list.append(entry_reference);
+    m_entries.set(name, move(entry));
+    return entry_reference;
+}
+
+void LookupCache::remove_entry(Entry& entry)
+{
+    m_lru_list.remove(entry);
+    auto it = m_entries.find(entry.name);
+    VERIFY(it != m_entries.end());
+    m_entries.remove(it);
+}
+
+}
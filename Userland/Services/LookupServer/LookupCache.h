@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibDNS/Answer.h>
+#include <LibDNS/Name.h>
+#include <time.h>
+
+namespace LookupServer {
+
+using namespace DNS;
+
+// Remembers the answers we got from upstream, as well as which records upstream told us don't exist (RFC 2308).
+// When the cache is full, the name that was used least recently is thrown out.
+class LookupCache {
+public:
+    struct Statistics {
+        u64 hits { 0 };
+        u64 negative_hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+    };
+
+    // RFC 2308 suggests not to remember that something doesn't exist for longer than a few hours.
+    static constexpr u32 max_negative_ttl = 3 * 60 * 60;
+
+    // Returns for how long a negative answer with the given authority section may be cached, if at all.
+    static Optional<u32> negative_answer_ttl(ReadonlySpan<Answer> authorities);
+
+    explicit LookupCache(size_t max_entries);
+
+    // Returns an empty vector if the record is known not to exist, and nothing if we have to ask upstream.
+    Optional<Vector<Answer>> lookup(Name const&, RecordType);
+
+    void put(Answer const&);
+    void put_negative(Name const&, RecordType, u32 ttl);
+    void remove_expired();
+
+    Statistics const& statistics() const { return m_statistics; }
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        explicit Entry(Name const& name)
+            : name(name)
+        {
+        }
+
+        bool prune_expired(time_t now);
+
+        Name name;
+        Vector<Answer> answers;
+        // When the knowledge that the name has no records of a type runs out.
+        HashMap<RecordType, time_t> negative_expiry_times;
+        IntrusiveListNode<Entry> lru_node;
+    };
+
+    Entry& ensure_entry(Name const&);
+    void remove_entry(Entry&);
+
+    size_t m_max_entries { 0 };
+    HashMap<Name, NonnullOwnPtr<Entry>, Name::Traits> m_entries;
+    // The least recently used entry comes first.
+    IntrusiveList<&Entry::lru_node> m_lru_list;
+    Statistics m_statistics;
+};
+
+}
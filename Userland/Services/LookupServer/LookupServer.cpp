@@ -11,14 +11,21 @@
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
 #include <AK/Random.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/System.h>
 #include <LibDNS/Packet.h>
+#include <arpa/inet.h>
 #include <limits.h>
+#include <netinet/in.h>
+#include <poll.h>
 #include <stdio.h>
+#include <sys/socket.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -27,6 +34,8 @@ namespace LookupServer {
 static LookupServer* s_the;
 // NOTE: This is the TTL we return for the hostname or answers from /etc/hosts.
 static constexpr u32 s_static_ttl = 86400;
+static constexpr int s_upstream_timeout_ms = 1000;
+static constexpr int s_upstream_attempts = 3;
 
 LookupServer& LookupServer::the()
 {
@@ -74,6 +83,12 @@ LookupServer::LookupServer()
     }
     m_mdns = MulticastDNS::construct(this);
 
+    m_cache_cleanup_timer = Core::Timer::create_repeating(60 * 1000, [this] {
+        m_lookup_cache.remove_expired();
+    },
+        this);
+    m_cache_cleanup_timer->start();
+
     m_server = MUST(IPC::MultiServer<ConnectionFromClient>::try_create());
 }
 
@@ -188,109 +203,79 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, RecordType record
     }
 
     // Third, try our cache.
-    if (auto cached_answers = m_lookup_cache.find(name); cached_answers != m_lookup_cache.end()) {
-        for (auto& answer : cached_answers->value) {
-            // TODO: Actually remove expired answers from the cache.
-            if (answer.type() == record_type && !answer.has_expired()) {
-                dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
-                add_answer(answer);
-            }
+    // NOTE: Requests are handled one after another, so if several clients ask for the same name at once,
+    //       all but the first one are answered from here, whether the name exists or not.
+    if (auto cached_answers = m_lookup_cache.lookup(name, record_type); cached_answers.has_value()) {
+        for (auto& answer : *cached_answers) {
+            dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
+            add_answer(answer);
         }
-        if (!answers.is_empty())
-            return answers;
+        return answers;
     }
 
     // Fourth, look up .local names using mDNS instead of DNS nameservers.
     if (name.as_string().ends_with(".local"sv)) {
         answers = TRY(m_mdns->lookup(name, record_type));
         for (auto& answer : answers)
-            put_in_cache(answer);
+            m_lookup_cache.put(answer);
         return answers;
     }
 
     // Fifth, ask the upstream nameservers.
-    for (auto& nameserver : m_nameservers) {
-        dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
-        bool did_get_response = false;
-        int retries = 3;
-        Vector<Answer> upstream_answers;
-        do {
-            auto upstream_answers_or_error = lookup(name, nameserver, did_get_response, record_type);
-            if (upstream_answers_or_error.is_error())
-                continue;
-            upstream_answers = upstream_answers_or_error.release_value();
-            if (did_get_response)
-                break;
-        } while (--retries);
-        if (!upstream_answers.is_empty()) {
-            for (auto& answer : upstream_answers) {
-                add_answer(answer);
-                put_in_cache(answer);
-            }
-            break;
-        } else {
-            if (!did_get_response)
-                dbgln("Never got a response from '{}', trying next nameserver", nameserver);
-            else
-                dbgln("Received response from '{}' but no result(s), trying next nameserver", nameserver);
-        }
-    }
-
-    // Sixth, fail.
-    if (answers.is_empty()) {
-        dbgln("Tried all nameservers but never got a response :(");
-        return Vector<Answer> {};
-    }
+    auto upstream_answers = TRY(lookup_upstream(name, record_type));
+    for (auto& answer : upstream_answers)
+        add_answer(answer);
 
     return answers;
 }
 
-ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, ByteString const& nameserver, bool& did_get_response, RecordType record_type, ShouldRandomizeCase should_randomize_case)
+struct UpstreamQuery {
+    ByteString nameserver;
+    int fd { -1 };
+    Packet request;
+    ByteBuffer request_buffer;
+    ShouldRandomizeCase should_randomize_case { ShouldRandomizeCase::Yes };
+    bool finished { false };
+};
+
+static ErrorOr<int> connect_to_nameserver(ByteString const& nameserver)
+{
+    auto address = IPv4Address::from_string(nameserver);
+    if (!address.has_value())
+        return Error::from_string_literal("Nameserver is not an IPv4 address");
+
+    auto fd = TRY(Core::System::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    sockaddr_in nameserver_address {};
+    nameserver_address.sin_family = AF_INET;
+    nameserver_address.sin_port = htons(53);
+    nameserver_address.sin_addr.s_addr = address->to_in_addr_t();
+    if (auto result = Core::System::connect(fd, bit_cast<sockaddr const*>(&nameserver_address), sizeof(nameserver_address)); result.is_error()) {
+        (void)Core::System::close(fd);
+        return result.release_error();
+    }
+    return fd;
+}
+
+static ErrorOr<void> prepare_request(UpstreamQuery& query, Name const& name, RecordType record_type)
 {
     Packet request;
     request.set_is_query();
     request.set_id(get_random_uniform(UINT16_MAX));
     Name name_in_question = name;
-    if (should_randomize_case == ShouldRandomizeCase::Yes)
+    if (query.should_randomize_case == ShouldRandomizeCase::Yes)
         name_in_question.randomize_case();
     request.add_question({ name_in_question, record_type, RecordClass::IN, false });
 
-    auto buffer = TRY(request.to_byte_buffer());
-
-    auto udp_socket = TRY(Core::UDPSocket::connect(nameserver, 53, Duration::from_seconds(1)));
-    TRY(udp_socket->set_blocking(true));
-
-    TRY(udp_socket->write_until_depleted(buffer));
-
-    u8 response_buffer[4096];
-    auto nrecv = TRY(udp_socket->read_some({ response_buffer, sizeof(response_buffer) })).size();
-    if (udp_socket->is_eof())
-        return Vector<Answer> {};
-
-    did_get_response = true;
-
-    auto response_or_error = Packet::from_raw_packet({ response_buffer, nrecv });
-    if (response_or_error.is_error())
-        return Vector<Answer> {};
-
-    auto response = response_or_error.release_value();
-
-    if (response.id() != request.id()) {
-        dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), request.id());
-        return Vector<Answer> {};
-    }
-
-    if (response.code() == Packet::Code::REFUSED) {
-        if (should_randomize_case == ShouldRandomizeCase::Yes) {
-            // Retry with 0x20 case randomization turned off.
-            return lookup(name, nameserver, did_get_response, record_type, ShouldRandomizeCase::No);
-        }
-        return Vector<Answer> {};
-    }
+    query.request_buffer = TRY(request.to_byte_buffer());
+    query.request = move(request);
+    return {};
+}
 
+static bool response_matches_request(Packet const& request, Packet const& response)
+{
     if (response.question_count() != request.question_count()) {
         dbgln("LookupServer: Question count ({} vs {}) :(", response.question_count(), request.question_count());
-        return Vector<Answer> {};
+        return false;
     }
 
     // Verify the questions in our request and in their response match, ignoring case.
@@ -304,56 +289,140 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, ByteString const&
             dbgln("Request and response questions do not match");
             dbgln("   Request: name=_{}_, type={}, class={}", request_question.name().as_string(), response_question.record_type(), response_question.class_code());
             dbgln("  Response: name=_{}_, type={}, class={}", response_question.name().as_string(), response_question.record_type(), response_question.class_code());
-            return Vector<Answer> {};
+            return false;
         }
     }
+    return true;
+}
 
-    if (response.answer_count() < 1) {
-        dbgln("LookupServer: No answers :(");
-        return Vector<Answer> {};
-    }
+ErrorOr<Vector<Answer>> LookupServer::lookup_upstream(Name const& name, RecordType record_type)
+{
+    Vector<UpstreamQuery> queries;
+    ScopeGuard close_sockets = [&] {
+        for (auto& query : queries)
+            (void)Core::System::close(query.fd);
+    };
 
-    Vector<Answer, 8> answers;
-    for (auto& answer : response.answers()) {
-        put_in_cache(answer);
-        if (answer.type() != record_type)
+    for (auto& nameserver : m_nameservers) {
+        auto fd_or_error = connect_to_nameserver(nameserver);
+        if (fd_or_error.is_error()) {
+            dbgln("LookupServer: Can't use nameserver '{}': {}", nameserver, fd_or_error.error());
             continue;
-        answers.append(answer);
+        }
+        UpstreamQuery query { .nameserver = nameserver, .fd = fd_or_error.value() };
+        TRY(queries.try_append(move(query)));
+        TRY(prepare_request(queries.last(), name, record_type));
     }
 
-    return answers;
-}
+    auto send_request = [](UpstreamQuery& query) {
+        dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", query.nameserver);
+        if (auto result = Core::System::send(query.fd, query.request_buffer.data(), query.request_buffer.size(), 0); result.is_error()) {
+            dbgln("LookupServer: Failed to send request to '{}': {}", query.nameserver, result.error());
+            query.finished = true;
+        }
+    };
 
-void LookupServer::put_in_cache(Answer const& answer)
-{
-    if (answer.has_expired())
-        return;
-
-    // Prevent the cache from growing too big.
-    // TODO: Evict least used entries.
-    if (m_lookup_cache.size() >= 256)
-        m_lookup_cache.remove(m_lookup_cache.begin());
-
-    auto it = m_lookup_cache.find(answer.name());
-    if (it == m_lookup_cache.end())
-        m_lookup_cache.set(answer.name(), { answer });
-    else {
-        if (answer.mdns_cache_flush()) {
-            auto now = time(nullptr);
-
-            it->value.remove_all_matching([&](Answer const& other_answer) {
-                if (other_answer.type() != answer.type() || other_answer.class_code() != answer.class_code())
-                    return false;
-
-                if (other_answer.received_time() >= now - 1)
-                    return false;
-
-                dbgln_if(LOOKUPSERVER_DEBUG, "Removing cache entry: {}", other_answer.name());
-                return true;
-            });
+    // NOTE: We ask all nameservers at once and go with the first one that knows an answer.
+    //       The ones saying that there is no such record are only believed once nobody else knows better.
+    Optional<Packet> negative_response;
+    for (int attempt = 0; attempt < s_upstream_attempts && !negative_response.has_value(); ++attempt) {
+        // Resending the same request means that a late response to an earlier attempt still counts.
+        for (auto& query : queries) {
+            if (!query.finished)
+                send_request(query);
         }
-        it->value.append(answer);
+
+        auto timer = Core::ElapsedTimer::start_new();
+        while (true) {
+            Vector<pollfd, 4> poll_fds;
+            Vector<UpstreamQuery&, 4> polled_queries;
+            for (auto& query : queries) {
+                if (query.finished)
+                    continue;
+                poll_fds.append({ .fd = query.fd, .events = POLLIN, .revents = 0 });
+                polled_queries.append(query);
+            }
+            if (poll_fds.is_empty())
+                break;
+
+            auto timeout = s_upstream_timeout_ms - timer.elapsed_milliseconds();
+            if (timeout <= 0)
+                break;
+            auto ready_or_error = Core::System::poll(poll_fds, static_cast<int>(timeout));
+            if (ready_or_error.is_error()) {
+                if (ready_or_error.error().code() == EINTR)
+                    continue;
+                return ready_or_error.release_error();
+            }
+            if (ready_or_error.value() == 0)
+                break;
+
+            for (size_t i = 0; i < poll_fds.size(); ++i) {
+                if (poll_fds[i].revents == 0)
+                    continue;
+                auto& query = polled_queries[i];
+
+                u8 response_buffer[4096];
+                auto nrecv_or_error = Core::System::recv(query.fd, response_buffer, sizeof(response_buffer), 0);
+                if (nrecv_or_error.is_error()) {
+                    dbgln("LookupServer: Failed to receive response from '{}': {}", query.nameserver, nrecv_or_error.error());
+                    query.finished = true;
+                    continue;
+                }
+
+                auto response_or_error = Packet::from_raw_packet({ response_buffer, static_cast<size_t>(nrecv_or_error.value()) });
+                if (response_or_error.is_error())
+                    continue;
+                auto response = response_or_error.release_value();
+
+                if (response.id() != query.request.id()) {
+                    dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), query.request.id());
+                    continue;
+                }
+
+                if (response.code() == Packet::Code::REFUSED && query.should_randomize_case == ShouldRandomizeCase::Yes) {
+                    // Retry with 0x20 case randomization turned off.
+                    query.should_randomize_case = ShouldRandomizeCase::No;
+                    TRY(prepare_request(query, name, record_type));
+                    send_request(query);
+                    continue;
+                }
+
+                if (response.code() != Packet::Code::NOERROR && response.code() != Packet::Code::NXDOMAIN) {
+                    dbgln("LookupServer: Nameserver '{}' failed to answer (code {})", query.nameserver, to_underlying(response.code()));
+                    query.finished = true;
+                    continue;
+                }
+
+                // Someone might be trying to sneak in a forged response, keep waiting for the real one.
+                if (!response_matches_request(query.request, response))
+                    continue;
+
+                Vector<Answer> answers;
+                for (auto& answer : response.answers()) {
+                    m_lookup_cache.put(answer);
+                    if (answer.type() == record_type)
+                        answers.append(answer);
+                }
+                if (!answers.is_empty())
+                    return answers;
+
+                dbgln_if(LOOKUPSERVER_DEBUG, "Received response from '{}' but no result(s)", query.nameserver);
+                query.finished = true;
+                if (!negative_response.has_value())
+                    negative_response = move(response);
+            }
+        }
+    }
+
+    if (!negative_response.has_value()) {
+        dbgln("Tried all nameservers but never got a response :(");
+        return Vector<Answer> {};
     }
+
+    if (auto ttl = LookupCache::negative_answer_ttl(negative_response->authorities()); ttl.has_value())
+        m_lookup_cache.put_negative(name, record_type, *ttl);
+    return Vector<Answer> {};
 }
 
 }
@@ -8,9 +8,11 @@
 
 #include "ConnectionFromClient.h"
 #include "DNSServer.h"
+#include "LookupCache.h"
 #include "MulticastDNS.h"
 #include <LibCore/EventReceiver.h>
 #include <LibCore/FileWatcher.h>
+#include <LibCore/Timer.h>
 #include <LibDNS/Name.h>
 #include <LibDNS/Packet.h>
 #include <LibIPC/MultiServer.h>
@@ -26,14 +28,15 @@ public:
     static LookupServer& the();
     ErrorOr<Vector<Answer>> lookup(Name const& name, RecordType record_type);
 
+    LookupCache const& cache() const { return m_lookup_cache; }
+
 private:
     LookupServer();
 
     ErrorOr<HashMap<Name, Vector<Answer>, Name::Traits>> try_load_etc_hosts();
     void load_etc_hosts();
-    void put_in_cache(Answer const&);
 
-    ErrorOr<Vector<Answer>> lookup(Name const& hostname, ByteString const& nameserver, bool& did_get_response, RecordType record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
+    ErrorOr<Vector<Answer>> lookup_upstream(Name const& name, RecordType record_type);
 
     OwnPtr<IPC::MultiServer<ConnectionFromClient>> m_server;
     RefPtr<DNSServer> m_dns_server;
@@ -41,7 +44,8 @@ private:
     Vector<ByteString> m_nameservers;
     RefPtr<Core::FileWatcher> m_file_watcher;
     HashMap<Name, Vector<Answer>, Name::Traits> m_etc_hosts;
-    HashMap<Name, Vector<Answer>, Name::Traits> m_lookup_cache;
+    LookupCache m_lookup_cache { 256 };
+    RefPtr<Core::Timer> m_cache_cleanup_timer;
 };
 
 }
@@ -14,6 +14,9 @@ namespace RequestServer::ConnectionCache {
 Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<Core::TCPSocket, Core::Socket>>>>>> g_tcp_connection_cache {};
 Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<TLS::TLSv12>>>>>> g_tls_connection_cache {};
 Threading::RWLockProtected<HashMap<ByteString, InferredServerProperties>> g_inferred_server_properties;
+Threading::RWLockProtected<HashMap<ConnectionKey, ConnectionStatistics>> g_connection_statistics;
+ConnectionLimits g_connection_limits;
+Atomic<size_t> g_connection_count { 0 };
 
 void request_did_finish(URL::URL const& url, Core::Socket const* socket)
 {
@@ -75,15 +78,21 @@ void request_did_finish(URL::URL const& url, Core::Socket const* socket)
                             return;
 
                         dbgln_if(REQUESTSERVER_DEBUG, "Removing no-longer-used connection {} (socket {})", ptr, ptr->socket);
+                        update_statistics(key, [](auto& statistics) { ++statistics.idle_connections_closed; });
                         cache.with_write_locked([&](auto& cache) {
                             auto did_remove = cache_entry.remove_first_matching([&](auto& entry) { return entry == ptr; });
                             VERIFY(did_remove);
+                            --g_connection_count;
                             if (cache_entry.is_empty())
                                 cache.remove(key);
                         });
                     });
                 };
-                connection->removal_timer->start();
+
+                auto keep_alive_time = ConnectionKeepAliveTimeMilliseconds;
+                if (g_connection_count.load() >= g_connection_limits.max_connections * 3 / 4)
+                    keep_alive_time = ConnectionKeepAliveTimeUnderPressureMilliseconds;
+                connection->removal_timer->start(keep_alive_time);
             });
         } else {
             auto timer = Core::ElapsedTimer::start_new();
@@ -102,6 +111,7 @@ void request_did_finish(URL::URL const& url, Core::Socket const* socket)
             }
 
             connection->has_started = true;
+            update_statistics(it->key, [](auto& statistics) { ++statistics.requests_started; });
             Core::deferred_invoke([&connection = *connection, &cache, url] {
                 cache.with_read_locked([&](auto&) {
                     dbgln_if(REQUESTSERVER_DEBUG, "Running next job in queue for connection {}", &connection);
@@ -127,6 +137,30 @@ void request_did_finish(URL::URL const& url, Core::Socket const* socket)
         dbgln("Unknown socket {} finished for URL {}", socket, url);
 }
 
+template<typename Cache>
+static void close_idle_connections(Cache& cache)
+{
+    cache.with_read_locked([](auto& cache) {
+        for (auto& connection : cache) {
+            for (auto& entry : *connection.value) {
+                if (entry->has_started || entry->is_being_started || !entry->removal_timer->is_active())
+                    continue;
+                // Fire the removal timer early, the connection is then removed from the cache as if it had timed out.
+                entry->removal_timer->stop();
+                if (entry->removal_timer->on_timeout)
+                    entry->removal_timer->on_timeout();
+            }
+        }
+    });
+}
+
+void close_idle_connections()
+{
+    dbgln_if(REQUESTSERVER_DEBUG, "Reached the limit of {} connections, closing idle ones", g_connection_limits.max_connections);
+    close_idle_connections(g_tls_connection_cache);
+    close_idle_connections(g_tcp_connection_cache);
+}
+
 void dump_jobs()
 {
     dbgln("=========== TLS Connection Cache ==========");
@@ -157,5 +191,18 @@ void dump_jobs()
             }
         }
     });
+    dbgln("=========== Connection Statistics ==========");
+    dbgln(" {} of at most {} connections in use", g_connection_count.load(), g_connection_limits.max_connections);
+    g_connection_statistics.with_read_locked([](auto& map) {
+        for (auto& [key, statistics] : map) {
+            dbgln(" - {}:{}", key.hostname, key.port);
+            dbgln("    Connections: {} opened, {} failed, {} closed while idle", statistics.connections_opened, statistics.connection_failures, statistics.idle_connections_closed);
+            dbgln("    Requests: {} started, {} queued", statistics.requests_started, statistics.requests_queued);
+            if (statistics.connections_opened > 0) {
+                dbgln("    Average connect time: {}ms", statistics.total_connect_time.to_milliseconds() / static_cast<i64>(statistics.connections_opened));
+                dbgln("    Requests per connection: {}", statistics.requests_started / statistics.connections_opened);
+            }
+        }
+    });
 }
 }
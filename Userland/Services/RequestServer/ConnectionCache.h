@@ -10,6 +10,7 @@
 #include <AK/Coroutine.h>
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
+#include <AK/ScopeGuard.h>
 #include <AK/Vector.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventLoop.h>
@@ -171,15 +172,51 @@ struct InferredServerProperties {
     size_t requests_served_per_connection { NumericLimits<size_t>::max() };
 };
 
+struct ConnectionLimits {
+    size_t max_connections_per_origin { 4 };
+    size_t max_connections { 64 };
+};
+
+struct ConnectionStatistics {
+    size_t connections_opened { 0 };
+    size_t connection_failures { 0 };
+    size_t idle_connections_closed { 0 };
+    size_t requests_started { 0 };
+    size_t requests_queued { 0 };
+    Duration total_connect_time {};
+};
+
 extern Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<Core::TCPSocket, Core::Socket>>>>>> g_tcp_connection_cache;
 extern Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<TLS::TLSv12>>>>>> g_tls_connection_cache;
 extern Threading::RWLockProtected<HashMap<ByteString, InferredServerProperties>> g_inferred_server_properties;
+extern Threading::RWLockProtected<HashMap<ConnectionKey, ConnectionStatistics>> g_connection_statistics;
+extern ConnectionLimits g_connection_limits;
+extern Atomic<size_t> g_connection_count;
 
 void request_did_finish(URL::URL const&, Core::Socket const*);
 void dump_jobs();
 
-constexpr static size_t MaxConcurrentConnectionsPerURL = 4;
+// Closes all connections that are currently idle, to make room for connections to other origins.
+void close_idle_connections();
+
+inline bool has_reached_connection_limit()
+{
+    return g_connection_count.load() >= g_connection_limits.max_connections;
+}
+
+inline ConnectionKey connection_key_for(URL::URL const& url, Core::ProxyData const& proxy_data)
+{
+    return { url.serialized_host().release_value_but_fixme_should_propagate_errors().to_byte_string(), url.port_or_default(), proxy_data };
+}
+
+inline void update_statistics(ConnectionKey const& key, Function<void(ConnectionStatistics&)> const& update)
+{
+    g_connection_statistics.with_write_locked([&](auto& map) { update(map.ensure(key)); });
+}
+
 constexpr static size_t ConnectionKeepAliveTimeMilliseconds = 10'000;
+// Once most of the pool is in use, idle connections are closed sooner so other origins can get one.
+constexpr static size_t ConnectionKeepAliveTimeUnderPressureMilliseconds = 1'000;
 constexpr static size_t ConnectionCacheQueueHighWatermark = 4;
 
 template<typename T>
@@ -220,6 +257,7 @@ Coroutine<ErrorOr<void>> recreate_socket_if_needed(T& connection, URL::URL const
             CO_TRY(set_socket(CO_TRY(co_await (connection.proxy.template tunnel<SocketType, SocketStorageType>(url)))));
         }
         dbgln_if(REQUESTSERVER_DEBUG, "Creating a new socket for {} -> {}", url, connection.socket);
+        update_statistics(connection_key_for(url, connection.proxy.data), [](auto& statistics) { ++statistics.connections_opened; });
     }
     co_return {};
 }
@@ -228,11 +266,11 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
 {
     using CacheEntryType = RemoveCVReference<decltype(*declval<typename RemoveCVReference<decltype(cache)>::ProtectedType>().begin()->value)>;
 
-    auto hostname = url.serialized_host().release_value_but_fixme_should_propagate_errors().to_byte_string();
-    auto& properties = g_inferred_server_properties.with_write_locked([&](auto& map) -> InferredServerProperties& { return map.ensure(hostname); });
+    auto key = connection_key_for(url, proxy_data);
+    auto& properties = g_inferred_server_properties.with_write_locked([&](auto& map) -> InferredServerProperties& { return map.ensure(key.hostname); });
 
     auto& sockets_for_url = *cache.with_write_locked([&](auto& map) -> CacheEntryType* {
-        return map.ensure({ move(hostname), url.port_or_default(), proxy_data }, [] { return make<CacheEntryType>(); }).ptr();
+        return map.ensure(key, [] { return make<CacheEntryType>(); }).ptr();
     });
 
     // Find the connection with an empty queue; if none exist, we'll find the least backed-up connection later.
@@ -251,8 +289,16 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
     size_t index;
     Proxy proxy { proxy_data };
 
+    auto can_add_connection = sockets_for_url.size() < g_connection_limits.max_connections_per_origin;
+    if (failed_to_find_a_socket && can_add_connection && has_reached_connection_limit()) {
+        // Make room for later requests by closing whatever is idle. Until then, only go over the limit for origins
+        // without any connection, as their requests would have nowhere to queue up otherwise.
+        close_idle_connections();
+        can_add_connection = sockets_for_url.is_empty();
+    }
+
     auto start_timer = Core::ElapsedTimer::start_new();
-    if (failed_to_find_a_socket && sockets_for_url.size() < ConnectionCache::MaxConcurrentConnectionsPerURL) {
+    if (failed_to_find_a_socket && can_add_connection) {
         using ConnectionType = RemoveCVReference<decltype(*declval<CacheEntryType>().at(0))>;
         cache.with_write_locked([&](auto&) {
             sockets_for_url.append(make<ConnectionType>(
@@ -262,31 +308,57 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
                 true));
             index = sockets_for_url.size() - 1;
         });
-        auto& socket_for_url = sockets_for_url[index];
-        ScopeGuard created = [&] {
+        ++g_connection_count;
+        auto* socket_for_url = sockets_for_url[index].ptr();
+        ArmedScopeGuard created = [&] {
             socket_for_url->is_being_started = false;
         };
 
+        // Drops the connection that failed to start, along with the requests that were queued up on it meanwhile.
+        auto abandon_connection = [&] {
+            update_statistics(key, [](auto& statistics) { ++statistics.connection_failures; });
+
+            created.disarm();
+            auto queued_jobs = socket_for_url->request_queue.with_write_locked([](auto& queue) { return move(queue); });
+            cache.with_write_locked([&](auto& map) {
+                auto did_remove = sockets_for_url.remove_first_matching([&](auto& entry) { return entry == socket_for_url; });
+                VERIFY(did_remove);
+                --g_connection_count;
+                if (sockets_for_url.is_empty())
+                    map.remove(key);
+            });
+
+            Core::deferred_invoke([job, queued_jobs = move(queued_jobs)]() mutable {
+                job->fail(Core::NetworkJob::Error::ConnectionFailed);
+                for (auto& queued_job : queued_jobs)
+                    queued_job.fail(Core::NetworkJob::Error::ConnectionFailed);
+            });
+        };
+
         auto connection_result = co_await proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url);
         if (connection_result.is_error()) {
             dbgln("ConnectionCache: Connection to {} failed: {}", url, connection_result.error());
-            Core::deferred_invoke([job] {
-                job->fail(Core::NetworkJob::Error::ConnectionFailed);
-            });
+            abandon_connection();
             co_return;
         }
         auto socket_result = Core::BufferedSocket<typename ConnectionType::StorageType>::create(connection_result.release_value());
         if (socket_result.is_error()) {
             dbgln("ConnectionCache: Failed to make a buffered socket for {}: {}", url, socket_result.error());
-            Core::deferred_invoke([job] {
-                job->fail(Core::NetworkJob::Error::ConnectionFailed);
-            });
+            abandon_connection();
             co_return;
         }
 
+        // Other connections to the origin may have gone away while we were connecting.
+        index = cache.with_read_locked([&](auto&) {
+            return *sockets_for_url.find_first_index_if([&](auto& entry) { return entry == socket_for_url; });
+        });
         socket_for_url->socket = socket_result.release_value();
         socket_for_url->proxy = move(proxy);
         did_add_new_connection = true;
+        update_statistics(key, [&](auto& statistics) {
+            ++statistics.connections_opened;
+            statistics.total_connect_time += start_timer.elapsed_time();
+        });
     }
     if (failed_to_find_a_socket) {
         if (!did_add_new_connection) {
@@ -317,6 +389,7 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
             queue.append(JobData::create(job));
             connection.max_queue_length = max(connection.max_queue_length, queue.size());
         });
+        update_statistics(key, [](auto& statistics) { ++statistics.requests_queued; });
         co_return;
     }
 
@@ -324,8 +397,8 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
 
     if (!connection.has_started) {
         connection.has_started = true;
-        Core::deferred_invoke([&connection, url, job = move(job), connection_time] {
-            Core::run_async_in_current_event_loop([&connection, url = move(url), job = move(job), connection_time] -> Coroutine<void> {
+        Core::deferred_invoke([&connection, url, key = move(key), job = move(job), connection_time] {
+            Core::run_async_in_current_event_loop([&connection, url = move(url), key = move(key), job = move(job), connection_time] -> Coroutine<void> {
                 auto timer = Core::ElapsedTimer::start_new();
                 // if !REQUESTSERVER_DEBUG, this is unused.
                 (void)connection_time;
@@ -336,6 +409,7 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
                         connection.job_data->timing_info.starting_connection += Duration::from_milliseconds(timer.elapsed_milliseconds());
                     }
                     dbgln("ConnectionCache: request failed to start, failed to make a socket: {}", result.error());
+                    update_statistics(key, [](auto& statistics) { ++statistics.connection_failures; });
                     Core::deferred_invoke([job] {
                         job->fail(Core::NetworkJob::Error::ConnectionFailed);
                     });
@@ -345,6 +419,7 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
                     connection.timer.start();
                     connection.current_url = url;
                     connection.job_data = JobData::create(job);
+                    update_statistics(key, [](auto& statistics) { ++statistics.requests_started; });
                     if constexpr (REQUESTSERVER_DEBUG)
                         connection.job_data->timing_info.starting_connection += Duration::from_milliseconds(timer.elapsed_milliseconds() + connection_time);
                     connection.socket->set_notifications_enabled(true);
@@ -358,6 +433,7 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
             queue.append(JobData::create(job));
             connection.max_queue_length = max(connection.max_queue_length, queue.size());
         });
+        update_statistics(key, [](auto& statistics) { ++statistics.requests_queued; });
     }
 }
 
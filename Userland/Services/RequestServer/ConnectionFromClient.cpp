@@ -5,6 +5,8 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/CharacterTypes.h>
+#include <AK/GenericLexer.h>
 #include <AK/IDAllocator.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/RefCounted.h>
@@ -195,6 +197,12 @@ void ConnectionFromClient::worker_do_work(Work work)
                 return;
             }
 
+            // Pre-connecting is speculative, so don't take connections away from requests that are actually being made.
+            if (ConnectionCache::has_reached_connection_limit()) {
+                dbgln_if(REQUESTSERVER_DEBUG, "EnsureConnection: Not pre-connecting to {}, all connections are in use", url);
+                return;
+            }
+
             auto job = Job::ensure(url);
             dbgln("EnsureConnection: Pre-connect to {}", url);
             auto do_preconnect = [&](auto& cache) {
@@ -295,8 +303,52 @@ Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(
     });
 }
 
+// Calls the callback for every origin a response hints at with a "preconnect" or "dns-prefetch" Link header, see RFC 8288.
+static void for_each_connection_hint(URL::URL const& base_url, HTTP::HeaderMap const& headers, Function<void(URL::URL const&, CacheLevel)> const& callback)
+{
+    for (auto const& header : headers.headers()) {
+        if (!header.name.equals_ignoring_ascii_case("Link"sv))
+            continue;
+
+        GenericLexer lexer { header.value };
+        while (!lexer.is_eof()) {
+            lexer.ignore_while([](char c) { return is_ascii_space(c) || c == ','; });
+            if (!lexer.consume_specific('<'))
+                break;
+            auto target = lexer.consume_until('>');
+            if (!lexer.consume_specific('>'))
+                break;
+
+            Optional<CacheLevel> cache_level;
+            for (auto parameter : lexer.consume_until(',').split_view(';')) {
+                auto name_and_value = parameter.split_view('=');
+                if (name_and_value.size() != 2 || !name_and_value[0].trim_whitespace().equals_ignoring_ascii_case("rel"sv))
+                    continue;
+                for (auto relation : name_and_value[1].trim_whitespace().trim("\""sv).split_view(' ')) {
+                    if (relation.equals_ignoring_ascii_case("preconnect"sv))
+                        cache_level = CacheLevel::CreateConnection;
+                    else if (relation.equals_ignoring_ascii_case("dns-prefetch"sv) && !cache_level.has_value())
+                        cache_level = CacheLevel::ResolveOnly;
+                }
+            }
+
+            if (!cache_level.has_value())
+                continue;
+            auto url = base_url.complete_url(target);
+            if (url.is_valid() && (url.scheme() == "http"sv || url.scheme() == "https"sv))
+                callback(url, *cache_level);
+        }
+    }
+}
+
 void ConnectionFromClient::did_receive_headers(Badge<Request>, Request& request)
 {
+    // Servers can hint at origins that subresources will be loaded from, get a head start on connecting to those.
+    for_each_connection_hint(request.url(), request.response_headers(), [&](auto const& url, auto cache_level) {
+        dbgln_if(REQUESTSERVER_DEBUG, "Link header of {} hints at {}", request.url(), url);
+        enqueue(EnsureConnection { .url = url, .cache_level = cache_level });
+    });
+
     auto lock = Threading::MutexLocker(m_ipc_mutex);
     async_headers_became_available(request.id(), request.response_headers(), request.status_code());
 }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/OwnPtr.h>
+#include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/System.h>
@@ -17,8 +18,20 @@
 #include <RequestServer/HttpsProtocol.h>
 #include <signal.h>
 
-ErrorOr<int> serenity_main(Main::Arguments)
+ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
+    auto& connection_limits = RequestServer::ConnectionCache::g_connection_limits;
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(connection_limits.max_connections_per_origin, "Maximum number of connections to a single origin", "max-connections-per-origin", 0, "count");
+    args_parser.add_option(connection_limits.max_connections, "Maximum number of connections to all origins combined", "max-connections", 0, "count");
+    args_parser.parse(arguments);
+
+    if (connection_limits.max_connections_per_origin == 0 || connection_limits.max_connections == 0) {
+        warnln("Connection limits must not be zero");
+        return 1;
+    }
+
     if constexpr (TLS_SSL_KEYLOG_DEBUG)
         TRY(Core::System::pledge("stdio inet accept thread unix cpath wpath rpath sendfd recvfd sigaction"));
     else
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/LexicalPath.h>
+#include <LibCore/EventLoop.h>
 #include <SQLServer/DatabaseConnection.h>
 #include <SQLServer/SQLStatement.h>
 
@@ -12,6 +14,7 @@ namespace SQLServer {
 
 static HashMap<SQL::ConnectionID, NonnullRefPtr<DatabaseConnection>> s_connections;
 static SQL::ConnectionID s_next_connection_id = 0;
+static HashMap<SQL::Database*, Vector<Function<void(ErrorOr<void>)>>> s_pending_syncs;
 
 static ErrorOr<NonnullRefPtr<SQL::Database>> find_or_create_database(StringView database_path, StringView database_name)
 {
@@ -61,6 +64,16 @@ DatabaseConnection::DatabaseConnection(NonnullRefPtr<SQL::Database> database, By
 void DatabaseConnection::disconnect()
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::disconnect(connection_id {}, database '{}'", connection_id(), m_database_name);
+
+    if constexpr (SQLSERVER_DEBUG) {
+        dbgln("  Statement cache: {} hits, {} misses, {} evictions", m_statement_cache.hit_count(), m_statement_cache.miss_count(), m_statement_cache.eviction_count());
+        for (auto const& [sql, statement] : m_statement_cache.statements()) {
+            dbgln("  '{}': prepared {}x, executed {}x, {}us total, {}us average, {}us max", sql,
+                statement->prepare_count(), statement->execution_count(), statement->total_execution_time().to_microseconds(),
+                statement->average_execution_time().to_microseconds(), statement->max_execution_time().to_microseconds());
+        }
+    }
+
     s_connections.remove(connection_id());
 }
 
@@ -72,4 +85,26 @@ SQL::ResultOr<SQL::StatementID> DatabaseConnection::prepare_statement(StringView
     return statement->statement_id();
 }
 
+void DatabaseConnection::sync_database(Function<void(ErrorOr<void>)> on_synced)
+{
+    auto& pending_syncs = s_pending_syncs.ensure(m_database.ptr());
+    pending_syncs.append(move(on_synced));
+    if (pending_syncs.size() > 1)
+        return;
+
+    // Statements executed before this is invoked share the sync with the first one.
+    Core::deferred_invoke([database = m_database]() {
+        auto pending_syncs = s_pending_syncs.take(database.ptr()).release_value();
+        dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection: syncing database for {} statement(s)", pending_syncs.size());
+
+        auto result = database->sync();
+        for (auto& on_synced : pending_syncs) {
+            if (result.is_error())
+                on_synced(Error::copy(result.error()));
+            else
+                on_synced({});
+        }
+    });
+}
+
 }
@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Result.h>
+#include <LibSQL/StatementCache.h>
 #include <LibSQL/Type.h>
 #include <SQLServer/Forward.h>
 
@@ -27,6 +29,13 @@ public:
     void disconnect();
     SQL::ResultOr<SQL::StatementID> prepare_statement(StringView sql);
 
+    SQL::ResultOr<NonnullRefPtr<SQL::CachedStatement>> cached_statement(StringView sql) { return m_statement_cache.statement_for(*m_database, sql); }
+    SQL::StatementCache const& statement_cache() const { return m_statement_cache; }
+
+    // Makes the changes to the database durable, then invokes the callback. Syncing is expensive, so the changes of
+    // all statements executed on the database in the same pass of the event loop are synced together (group commit).
+    void sync_database(Function<void(ErrorOr<void>)> on_synced);
+
 private:
     DatabaseConnection(NonnullRefPtr<SQL::Database> database, ByteString database_name, int client_id);
 
@@ -34,6 +43,8 @@ private:
     ByteString m_database_name;
     SQL::ConnectionID m_connection_id { 0 };
     int m_client_id { 0 };
+
+    SQL::StatementCache m_statement_cache;
 };
 
 }
@@ -4,8 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventReceiver.h>
-#include <LibSQL/AST/Parser.h>
 #include <SQLServer/ConnectionFromClient.h>
 #include <SQLServer/DatabaseConnection.h>
 #include <SQLServer/SQLStatement.h>
@@ -25,16 +25,11 @@ RefPtr<SQLStatement> SQLStatement::statement_for(SQL::StatementID statement_id)
 
 SQL::ResultOr<NonnullRefPtr<SQLStatement>> SQLStatement::create(DatabaseConnection& connection, StringView sql)
 {
-    auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
-    auto statement = parser.next_statement();
-
-    if (parser.has_errors())
-        return SQL::Result { SQL::SQLCommand::Unknown, SQL::SQLErrorCode::SyntaxError, parser.errors()[0].to_byte_string() };
-
+    auto statement = TRY(connection.cached_statement(sql));
     return TRY(adopt_nonnull_ref_or_enomem(new (nothrow) SQLStatement(connection, move(statement))));
 }
 
-SQLStatement::SQLStatement(DatabaseConnection& connection, NonnullRefPtr<SQL::AST::Statement> statement)
+SQLStatement::SQLStatement(DatabaseConnection& connection, NonnullRefPtr<CachedStatement> statement)
     : m_connection(connection)
     , m_statement_id(s_next_statement_id++)
     , m_statement(move(statement))
@@ -57,6 +52,33 @@ void SQLStatement::report_error(SQL::Result result, SQL::ExecutionID execution_i
         warnln("Cannot return execution error. Client disconnected");
 }
 
+void SQLStatement::report_success(SQL::ResultSet result, SQL::ExecutionID execution_id)
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    auto result_size = result.size();
+
+    if (should_send_result_rows(result)) {
+        client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+
+        m_ongoing_executions.set(execution_id, { move(result), result_size });
+        ready_for_next_result(execution_id);
+    } else {
+        if (result.command() == SQL::SQLCommand::Insert)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
+        else if (result.command() == SQL::SQLCommand::Update)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
+        else if (result.command() == SQL::SQLCommand::Delete)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
+        else
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
+    }
+}
+
 Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_values)
 {
     dbgln_if(SQLSERVER_DEBUG, "SQLStatement::execute(statement_id {}", statement_id());
@@ -70,37 +92,29 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
     auto execution_id = m_next_execution_id++;
 
     Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
-        auto execution_result = m_statement->execute(connection().database(), placeholder_values);
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        auto execution_result = m_statement->statement()->execute(connection().database(), placeholder_values);
+        m_statement->record_execution(timer.elapsed_time());
 
         if (execution_result.is_error()) {
             report_error(execution_result.release_error(), execution_id);
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
+        // Modifications are only reported as successful once they are durable.
+        if (!connection().database()->has_unsynced_changes()) {
+            report_success(execution_result.release_value(), execution_id);
             return;
         }
 
-        auto result = execution_result.release_value();
-        auto result_size = result.size();
-
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
-
-            m_ongoing_executions.set(execution_id, { move(result), result_size });
-            ready_for_next_result(execution_id);
-        } else {
-            if (result.command() == SQL::SQLCommand::Insert)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
-            else if (result.command() == SQL::SQLCommand::Update)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
-            else if (result.command() == SQL::SQLCommand::Delete)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
-            else
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
-        }
+        connection().sync_database([this, strong_this, result = execution_result.release_value(), execution_id](ErrorOr<void> sync_result) mutable {
+            if (sync_result.is_error()) {
+                report_error(sync_result.release_error(), execution_id);
+                return;
+            }
+
+            report_success(move(result), execution_id);
+        });
     });
 
     return execution_id;
@@ -136,6 +150,7 @@ bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
 
     switch (result.command()) {
     case SQL::SQLCommand::Describe:
+    case SQL::SQLCommand::Explain:
     case SQL::SQLCommand::Select:
         return true;
     default:
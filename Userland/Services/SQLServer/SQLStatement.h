@@ -29,10 +29,11 @@ public:
     void ready_for_next_result(SQL::ExecutionID);
 
 private:
-    SQLStatement(DatabaseConnection&, NonnullRefPtr<SQL::AST::Statement> statement);
+    SQLStatement(DatabaseConnection&, NonnullRefPtr<SQL::CachedStatement> statement);
 
     bool should_send_result_rows(SQL::ResultSet const& result) const;
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
+    void report_success(SQL::ResultSet, SQL::ExecutionID execution_id);
 
     DatabaseConnection& m_connection;
     SQL::StatementID m_statement_id { 0 };
@@ -44,7 +45,7 @@ private:
     HashMap<SQL::ExecutionID, Execution> m_ongoing_executions;
     SQL::ExecutionID m_next_execution_id { 0 };
 
-    NonnullRefPtr<SQL::AST::Statement> m_statement;
+    NonnullRefPtr<SQL::CachedStatement> m_statement;
 };
 
 }
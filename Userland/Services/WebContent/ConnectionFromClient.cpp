@@ -43,6 +43,7 @@
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
+#include <LibWeb/PerformanceMetrics.h>
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWebView/Attribute.h>
@@ -50,6 +51,7 @@
 #include <WebContent/PageClient.h>
 #include <WebContent/PageHost.h>
 #include <WebContent/WebContentClientEndpoint.h>
+#include <sys/resource.h>
 
 #ifdef AK_OS_SERENITY
 #    include <pthread.h>
@@ -931,6 +933,23 @@ static void append_gc_graph(StringBuilder& builder)
     gc_graph.serialize(builder);
 }
 
+static void append_performance_metrics(StringBuilder& builder)
+{
+    auto metrics = Web::PerformanceMetrics::the().to_json();
+
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(AK_OS_MACOS)
+        // NOTE: macOS reports the maximum resident set size in bytes, everyone else uses kilobytes.
+        metrics.set("peak_memory_kib"sv, static_cast<i64>(usage.ru_maxrss / 1024));
+#else
+        metrics.set("peak_memory_kib"sv, static_cast<i64>(usage.ru_maxrss));
+#endif
+    }
+
+    metrics.serialize(builder);
+}
+
 void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::PageInfoType type)
 {
     auto page = this->page(page_id);
@@ -963,6 +982,12 @@ void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::Page
         append_gc_graph(builder);
     }
 
+    if (has_flag(type, WebView::PageInfoType::PerformanceMetrics)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_performance_metrics(builder);
+    }
+
     async_did_get_internal_page_info(page_id, type, MUST(builder.to_string()));
 }
 
@@ -37,6 +37,7 @@ namespace WebContent {
 
 static bool s_use_gpu_painter = false;
 static bool s_use_experimental_cpu_transform_support = false;
+static bool s_use_tiled_cpu_painter = false;
 
 JS_DEFINE_ALLOCATOR(PageClient);
 
@@ -50,6 +51,11 @@ void PageClient::set_use_experimental_cpu_transform_support()
     s_use_experimental_cpu_transform_support = true;
 }
 
+void PageClient::set_use_tiled_cpu_painter()
+{
+    s_use_tiled_cpu_painter = true;
+}
+
 JS::NonnullGCPtr<PageClient> PageClient::create(JS::VM& vm, PageHost& page_host, u64 id)
 {
     return vm.heap().allocate_without_realm<PageClient>(page_host, id);
@@ -872,6 +878,8 @@ Web::DisplayListPlayerType PageClient::display_list_player_type() const
         return Web::DisplayListPlayerType::GPU;
     if (s_use_experimental_cpu_transform_support)
         return Web::DisplayListPlayerType::CPUWithExperimentalTransformSupport;
+    if (s_use_tiled_cpu_painter)
+        return Web::DisplayListPlayerType::TiledCPU;
     return Web::DisplayListPlayerType::CPU;
 }
 
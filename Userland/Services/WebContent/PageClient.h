@@ -34,6 +34,7 @@ public:
 
     static void set_use_gpu_painter();
     static void set_use_experimental_cpu_transform_support();
+    static void set_use_tiled_cpu_painter();
 
     virtual void schedule_repaint() override;
     virtual bool is_ready_to_paint() const override;
@@ -9,7 +9,6 @@
 #include <AK/Base64.h>
 #include <AK/Debug.h>
 #include <AK/LexicalPath.h>
-#include <AK/MemoryStream.h>
 #include <AK/NumberFormat.h>
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
@@ -25,11 +24,15 @@
 #include <LibURL/URL.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
+#include <WebServer/FileCache.h>
 #include <stdio.h>
 #include <unistd.h>
 
 namespace WebServer {
 
+// Connections that are kept alive are closed after this long without a request, so idle clients don't pile up.
+static constexpr int keep_alive_timeout_seconds = 5;
+
 Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket, Core::EventReceiver* parent)
     : Core::EventReceiver(parent)
     , m_socket(move(socket))
@@ -38,13 +41,21 @@ Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket, Core::EventReceive
 
 void Client::die()
 {
+    m_idle_timer->stop();
     m_socket->close();
     deferred_invoke([this] { remove_from_parent(); });
 }
 
 void Client::start()
 {
+    m_idle_timer = Core::Timer::create_single_shot(keep_alive_timeout_seconds * 1000, [this] {
+        dbgln_if(WEBSERVER_DEBUG, "Closing idle connection");
+        die();
+    });
+    m_idle_timer->start();
+
     m_socket->on_ready_to_read = [this] {
+        m_idle_timer->restart();
         if (auto result = on_ready_to_read(); result.is_error()) {
             result.error().visit(
                 [](AK::Error const& error) {
@@ -59,6 +70,102 @@ void Client::start()
     };
 }
 
+// Responses up to this size are sent with a single write together with their headers.
+static constexpr size_t max_coalesced_response_size = 64 * KiB;
+
+// This matches the header size limit of HTTP::HttpRequest::from_raw_request().
+static constexpr size_t max_request_header_size = 64 * KiB;
+
+// Returns the size of a chunked message body, including its trailer section, or nothing if more data is needed.
+static ErrorOr<Optional<size_t>> size_of_chunked_body(StringView body)
+{
+    size_t offset = 0;
+    for (;;) {
+        auto end_of_size_line = body.substring_view(offset).find("\r\n"sv);
+        if (!end_of_size_line.has_value())
+            return OptionalNone {};
+
+        auto size_line = body.substring_view(offset, *end_of_size_line);
+        if (auto start_of_extensions = size_line.find(';'); start_of_extensions.has_value())
+            size_line = size_line.substring_view(0, *start_of_extensions);
+
+        auto chunk_size = AK::StringUtils::convert_to_uint_from_hex<size_t>(size_line);
+        if (!chunk_size.has_value())
+            return Error::from_string_literal("Invalid chunk size in request body");
+
+        offset += *end_of_size_line + 2;
+        if (*chunk_size == 0)
+            break;
+
+        if (body.length() - offset < *chunk_size || body.length() - offset - *chunk_size < 2)
+            return OptionalNone {};
+        if (body.substring_view(offset + *chunk_size, 2) != "\r\n"sv)
+            return Error::from_string_literal("Chunk in request body is longer than its size");
+        offset += *chunk_size + 2;
+    }
+
+    // The last chunk is followed by optional trailer fields, and an empty line.
+    auto trailer_section = body.substring_view(offset);
+    if (trailer_section.starts_with("\r\n"sv))
+        return offset + 2;
+
+    auto end_of_trailer_section = trailer_section.find("\r\n\r\n"sv);
+    if (!end_of_trailer_section.has_value())
+        return OptionalNone {};
+    return offset + *end_of_trailer_section + 4;
+}
+
+// Returns the size of the first complete request in the buffer, or nothing if more data is needed.
+static ErrorOr<Optional<size_t>> size_of_first_request(ReadonlyBytes buffer)
+{
+    StringView data { buffer };
+    auto end_of_headers = data.find("\r\n\r\n"sv);
+    if (!end_of_headers.has_value())
+        return OptionalNone {};
+    auto start_of_body = *end_of_headers + 4;
+
+    size_t content_length = 0;
+    bool is_chunked = false;
+    for (auto line : data.substring_view(0, *end_of_headers).split_view("\r\n"sv)) {
+        auto colon = line.find(':');
+        if (!colon.has_value())
+            continue;
+
+        auto name = line.substring_view(0, *colon).trim_whitespace();
+        auto value = line.substring_view(*colon + 1).trim_whitespace();
+        if (name.equals_ignoring_ascii_case("Content-Length"sv))
+            content_length = value.to_number<size_t>().value_or(0);
+        else if (name.equals_ignoring_ascii_case("Transfer-Encoding"sv))
+            is_chunked = value.ends_with("chunked"sv, CaseSensitivity::CaseInsensitive);
+    }
+
+    // A chunked body ends with its last chunk, whatever Content-Length says. See RFC 9112 section 6.3.
+    if (is_chunked) {
+        auto body_size = TRY(size_of_chunked_body(data.substring_view(start_of_body)));
+        if (!body_size.has_value())
+            return OptionalNone {};
+        return start_of_body + *body_size;
+    }
+
+    if (buffer.size() - start_of_body < content_length)
+        return OptionalNone {};
+    return start_of_body + content_length;
+}
+
+static bool wants_keep_alive(HTTP::HttpRequest const& request)
+{
+    if (auto connection = request.headers().get("Connection"); connection.has_value()) {
+        auto value = connection->view().trim_whitespace();
+        if (value.equals_ignoring_ascii_case("close"sv))
+            return false;
+        if (value.equals_ignoring_ascii_case("keep-alive"sv))
+            return true;
+    }
+
+    // HTTP/1.1 connections are persistent unless stated otherwise, HTTP/1.0 ones are not.
+    return request.protocol() == "HTTP/1.1"sv;
+}
+
 ErrorOr<void, Client::WrappedError> Client::on_ready_to_read()
 {
     // FIXME: Mostly copied from LibWeb/WebDriver/Client.cpp. As noted there, this should be move the LibHTTP and made spec compliant.
@@ -69,34 +176,73 @@ ErrorOr<void, Client::WrappedError> Client::on_ready_to_read()
             break;
 
         auto data = TRY(m_socket->read_some(buffer));
-        TRY(m_remaining_request.try_append(StringView { data }));
+        TRY(m_remaining_request.try_append(data));
 
         if (m_socket->is_eof())
             break;
     }
 
-    if (m_remaining_request.is_empty())
-        return {};
+    // Clients may pipeline requests, so handle every complete request we have received so far, in order.
+    size_t consumed = 0;
+    while (consumed < m_remaining_request.size()) {
+        auto unhandled_data = m_remaining_request.bytes().slice(consumed);
+        auto request_size = TRY(size_of_first_request(unhandled_data));
+        if (!request_size.has_value()) {
+            if (unhandled_data.size() > max_request_header_size)
+                return HTTP::HttpRequest::ParseError::RequestTooLarge;
+            // If request is not complete we need to wait for more data to arrive
+            break;
+        }
+
+        auto raw_request = unhandled_data.trim(*request_size);
+        consumed += *request_size;
+        dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", StringView { raw_request });
 
-    auto request = TRY(m_remaining_request.to_byte_buffer());
-    dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", ByteString::copy(request));
+        auto request = TRY(HTTP::HttpRequest::from_raw_request(raw_request));
+        m_keep_alive = wants_keep_alive(request);
 
-    auto maybe_parsed_request = HTTP::HttpRequest::from_raw_request(TRY(m_remaining_request.to_byte_buffer()));
-    if (maybe_parsed_request.is_error()) {
-        if (maybe_parsed_request.error() == HTTP::HttpRequest::ParseError::RequestIncomplete) {
-            // If request is not complete we need to wait for more data to arrive
+        TRY(handle_request(request));
+
+        if (!m_keep_alive) {
+            die();
             return {};
         }
-        return maybe_parsed_request.error();
     }
 
-    m_remaining_request.clear();
+    if (consumed == m_remaining_request.size()) {
+        m_remaining_request.clear();
+    } else if (consumed > 0) {
+        auto unhandled_data = TRY(ByteBuffer::copy(m_remaining_request.bytes().slice(consumed)));
+        m_remaining_request = move(unhandled_data);
+    }
 
-    TRY(handle_request(maybe_parsed_request.value()));
+    if (m_socket->is_eof())
+        die();
 
     return {};
 }
 
+static bool is_not_modified(HTTP::HttpRequest const& request, StringView etag, StringView last_modified)
+{
+    // If-None-Match takes precedence over If-Modified-Since, see RFC 9110 section 13.2.2.
+    if (auto if_none_match = request.headers().get("If-None-Match"); if_none_match.has_value()) {
+        for (auto candidate : if_none_match->split_view(',')) {
+            candidate = candidate.trim_whitespace();
+            if (candidate.starts_with("W/"sv))
+                candidate = candidate.substring_view(2);
+            if (candidate == "*"sv || candidate == etag)
+                return true;
+        }
+        return false;
+    }
+
+    // We only ever hand out our own Last-Modified value, so clients revalidating send it back verbatim.
+    if (auto if_modified_since = request.headers().get("If-Modified-Since"); if_modified_since.has_value())
+        return if_modified_since->view().trim_whitespace() == last_modified;
+
+    return false;
+}
+
 ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
 {
     auto resource_decoded = URL::percent_decode(request.resource());
@@ -150,10 +296,12 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
         real_path = index_html_path;
     }
 
-    if (!FileSystem::exists(real_path.bytes_as_string_view())) {
+    auto st_or_error = Core::System::stat(real_path.bytes_as_string_view());
+    if (st_or_error.is_error()) {
         TRY(send_error_response(404, request));
         return false;
     }
+    auto st = st_or_error.release_value();
 
     auto is_readable_or_error = Core::System::access(real_path.bytes_as_string_view(), R_OK);
     if (is_readable_or_error.is_error()) {
@@ -161,76 +309,135 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
         return false;
     }
 
-    if (FileSystem::is_device(real_path.bytes_as_string_view())) {
+    if (!S_ISREG(st.st_mode)) {
         TRY(send_error_response(403, request));
         return false;
     }
 
-    auto stream = TRY(Core::File::open(real_path.bytes_as_string_view(), Core::File::OpenMode::Read));
-
-    auto const info = ContentInfo {
+    auto info = ContentInfo {
         .type = TRY(String::from_utf8(Core::guess_mime_type_based_on_filename(real_path.bytes_as_string_view()))),
-        .length = static_cast<u64>(TRY(FileSystem::size_from_stat(real_path.bytes_as_string_view())))
+        .etag = ByteString::formatted("\"{:x}-{:x}-{:x}\"", st.st_ino, st.st_size, st.st_mtime),
+        .last_modified = Core::DateTime::from_timestamp(st.st_mtime).to_byte_string("%a, %d %b %Y %H:%M:%S GMT"sv, Core::DateTime::LocalTime::No),
     };
-    TRY(send_response(*stream, request, move(info)));
+
+    if (is_not_modified(request, *info.etag, *info.last_modified)) {
+        TRY(send_not_modified(request, info));
+        return true;
+    }
+
+    if (static_cast<size_t>(st.st_size) <= FileCache::max_cached_file_size) {
+        auto cached_file = TRY(FileCache::the().get(real_path.to_byte_string(), st));
+        TRY(send_response(cached_file->contents(), request, move(info)));
+        return true;
+    }
+
+    // Larger files are handed to the kernel, which copies them to the socket without a detour through our address space.
+    auto file = TRY(Core::File::open(real_path.bytes_as_string_view(), Core::File::OpenMode::Read));
+    TRY(send_file_response(file->fd(), st.st_size, request, move(info)));
     return true;
 }
 
-ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+ErrorOr<void> Client::append_common_headers(StringBuilder& builder) const
 {
-    StringBuilder builder;
-    TRY(builder.try_append("HTTP/1.0 200 OK\r\n"sv));
     TRY(builder.try_append("Server: WebServer (SerenityOS)\r\n"sv));
+    if (m_keep_alive) {
+        TRY(builder.try_append("Connection: keep-alive\r\n"sv));
+        TRY(builder.try_appendff("Keep-Alive: timeout={}\r\n", keep_alive_timeout_seconds));
+    } else {
+        TRY(builder.try_append("Connection: close\r\n"sv));
+    }
+    return {};
+}
+
+ErrorOr<void> Client::append_response_headers(StringBuilder& builder, size_t content_length, ContentInfo const& content_info) const
+{
+    TRY(builder.try_append("HTTP/1.1 200 OK\r\n"sv));
+    TRY(append_common_headers(builder));
     TRY(builder.try_append("X-Frame-Options: SAMEORIGIN\r\n"sv));
     TRY(builder.try_append("X-Content-Type-Options: nosniff\r\n"sv));
-    TRY(builder.try_append("Pragma: no-cache\r\n"sv));
+    if (content_info.etag.has_value()) {
+        // Let clients keep a copy, but have them revalidate it on every use.
+        TRY(builder.try_append("Cache-Control: no-cache\r\n"sv));
+        TRY(builder.try_appendff("ETag: {}\r\n", *content_info.etag));
+    } else {
+        TRY(builder.try_append("Cache-Control: no-store\r\n"sv));
+    }
+    if (content_info.last_modified.has_value())
+        TRY(builder.try_appendff("Last-Modified: {}\r\n", *content_info.last_modified));
     if (content_info.type == "text/plain")
         TRY(builder.try_appendff("Content-Type: {}; charset=utf-8\r\n", content_info.type));
     else
         TRY(builder.try_appendff("Content-Type: {}\r\n", content_info.type));
-    TRY(builder.try_appendff("Content-Length: {}\r\n", content_info.length));
+    TRY(builder.try_appendff("Content-Length: {}\r\n", content_length));
     TRY(builder.try_append("\r\n"sv));
+    return {};
+}
 
-    auto builder_contents = TRY(builder.to_byte_buffer());
-    TRY(m_socket->write_until_depleted(builder_contents));
-    log_response(200, request);
-
-    char buffer[PAGE_SIZE];
-    do {
-        auto size = TRY(response.read_some({ buffer, sizeof(buffer) })).size();
-        if (response.is_eof() && size == 0)
-            break;
+ErrorOr<void> Client::send_response(ReadonlyBytes body, HTTP::HttpRequest const& request, ContentInfo content_info)
+{
+    StringBuilder builder;
+    TRY(append_response_headers(builder, body.size(), content_info));
+
+    // Small responses go out in a single write, so they don't end up split over two segments.
+    if (body.size() <= max_coalesced_response_size) {
+        TRY(builder.try_append(StringView { body }));
+        TRY(m_socket->write_until_depleted(builder.string_view().bytes()));
+    } else {
+        TRY(m_socket->write_until_depleted(builder.string_view().bytes()));
+        TRY(m_socket->write_until_depleted(body));
+    }
 
-        ReadonlyBytes write_buffer { buffer, size };
-        while (!write_buffer.is_empty()) {
-            auto nwritten = TRY(m_socket->write_some(write_buffer));
+    log_response(200, request);
+    return {};
+}
 
-            if (nwritten == 0) {
-                dbgln("EEEEEE got 0 bytes written!");
-            }
+ErrorOr<void> Client::send_file_response(int fd, size_t size, HTTP::HttpRequest const& request, ContentInfo content_info)
+{
+    StringBuilder builder;
+    TRY(append_response_headers(builder, size, content_info));
+    TRY(m_socket->write_until_depleted(builder.string_view().bytes()));
+
+    auto socket_fd = m_socket->fd();
+    if (!socket_fd.has_value())
+        return Error::from_errno(ENOTCONN);
+
+    off_t offset = 0;
+    while (static_cast<size_t>(offset) < size) {
+        auto nsent = TRY(Core::System::sendfile(*socket_fd, fd, &offset, size - offset));
+        if (nsent == 0)
+            return Error::from_string_literal("File was truncated while it was being sent");
+    }
 
-            write_buffer = write_buffer.slice(nwritten);
-        }
-    } while (true);
+    log_response(200, request);
+    return {};
+}
 
-    auto keep_alive = false;
-    if (auto it = request.headers().headers().find_if([](auto& header) { return header.name.equals_ignoring_ascii_case("Connection"sv); }); !it.is_end()) {
-        if (it->value.trim_whitespace().equals_ignoring_ascii_case("keep-alive"sv))
-            keep_alive = true;
-    }
-    if (!keep_alive)
-        m_socket->close();
+ErrorOr<void> Client::send_not_modified(HTTP::HttpRequest const& request, ContentInfo const& content_info)
+{
+    StringBuilder builder;
+    TRY(builder.try_append("HTTP/1.1 304 Not Modified\r\n"sv));
+    TRY(append_common_headers(builder));
+    TRY(builder.try_append("Cache-Control: no-cache\r\n"sv));
+    if (content_info.etag.has_value())
+        TRY(builder.try_appendff("ETag: {}\r\n", *content_info.etag));
+    if (content_info.last_modified.has_value())
+        TRY(builder.try_appendff("Last-Modified: {}\r\n", *content_info.last_modified));
+    TRY(builder.try_append("\r\n"sv));
+    TRY(m_socket->write_until_depleted(builder.string_view().bytes()));
 
+    log_response(304, request);
     return {};
 }
 
 ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
 {
     StringBuilder builder;
-    TRY(builder.try_append("HTTP/1.0 301 Moved Permanently\r\n"sv));
+    TRY(builder.try_append("HTTP/1.1 301 Moved Permanently\r\n"sv));
+    TRY(append_common_headers(builder));
     TRY(builder.try_append("Location: "sv));
     TRY(builder.try_append(redirect_path));
     TRY(builder.try_append("\r\n"sv));
+    TRY(builder.try_append("Content-Length: 0\r\n"sv));
     TRY(builder.try_append("\r\n"sv));
 
     auto builder_contents = TRY(builder.to_byte_buffer());
@@ -242,23 +449,23 @@ ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest
 
 static ByteString folder_image_data()
 {
-    static ByteString cache;
-    if (cache.is_empty()) {
+    // NOTE: Clients are served from several threads, so this relies on the thread-safe initialization of statics.
+    static ByteString const cache = [] {
         auto file = Core::MappedFile::map("/res/icons/16x16/filetype-folder.png"sv).release_value_but_fixme_should_propagate_errors();
         // FIXME: change to TRY() and make method fallible
-        cache = MUST(encode_base64(file->bytes())).to_byte_string();
-    }
+        return MUST(encode_base64(file->bytes())).to_byte_string();
+    }();
     return cache;
 }
 
 static ByteString file_image_data()
 {
-    static ByteString cache;
-    if (cache.is_empty()) {
+    // NOTE: Clients are served from several threads, so this relies on the thread-safe initialization of statics.
+    static ByteString const cache = [] {
         auto file = Core::MappedFile::map("/res/icons/16x16/filetype-unknown.png"sv).release_value_but_fixme_should_propagate_errors();
         // FIXME: change to TRY() and make method fallible
-        cache = MUST(encode_base64(file->bytes())).to_byte_string();
-    }
+        return MUST(encode_base64(file->bytes())).to_byte_string();
+    }();
     return cache;
 }
 
@@ -337,9 +544,7 @@ ErrorOr<void> Client::handle_directory_listing(String const& requested_path, Str
     TRY(builder.try_append("</body>\n"sv));
     TRY(builder.try_append("</html>\n"sv));
 
-    auto response = builder.to_byte_string();
-    FixedMemoryStream stream { response.bytes() };
-    return send_response(stream, request, { .type = "text/html"_string, .length = response.length() });
+    return send_response(builder.string_view().bytes(), request, { .type = "text/html"_string });
 }
 
 ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const& request, Vector<String> const& headers)
@@ -353,9 +558,10 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     TRY(content_builder.try_append("</h1></body></html>"sv));
 
     StringBuilder header_builder;
-    TRY(header_builder.try_appendff("HTTP/1.0 {} ", code));
+    TRY(header_builder.try_appendff("HTTP/1.1 {} ", code));
     TRY(header_builder.try_append(reason_phrase));
     TRY(header_builder.try_append("\r\n"sv));
+    TRY(append_common_headers(header_builder));
 
     for (auto& header : headers) {
         TRY(header_builder.try_append(header));
@@ -364,8 +570,8 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     TRY(header_builder.try_append("Content-Type: text/html; charset=UTF-8\r\n"sv));
     TRY(header_builder.try_appendff("Content-Length: {}\r\n", content_builder.length()));
     TRY(header_builder.try_append("\r\n"sv));
-    TRY(m_socket->write_until_depleted(TRY(header_builder.to_byte_buffer())));
-    TRY(m_socket->write_until_depleted(TRY(content_builder.to_byte_buffer())));
+    TRY(header_builder.try_append(content_builder.string_view()));
+    TRY(m_socket->write_until_depleted(header_builder.string_view().bytes()));
 
     log_response(code, request);
     return {};
@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/String.h>
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Socket.h>
+#include <LibCore/Timer.h>
 #include <LibHTTP/Forward.h>
 #include <LibHTTP/HttpRequest.h>
 
@@ -28,12 +30,17 @@ private:
 
     struct ContentInfo {
         String type;
-        u64 length {};
+        Optional<ByteString> etag;
+        Optional<ByteString> last_modified;
     };
 
     ErrorOr<void, WrappedError> on_ready_to_read();
     ErrorOr<bool> handle_request(HTTP::HttpRequest const&);
-    ErrorOr<void> send_response(Stream&, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<void> append_common_headers(StringBuilder&) const;
+    ErrorOr<void> append_response_headers(StringBuilder&, size_t content_length, ContentInfo const&) const;
+    ErrorOr<void> send_response(ReadonlyBytes body, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<void> send_file_response(int fd, size_t size, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<void> send_not_modified(HTTP::HttpRequest const&, ContentInfo const&);
     ErrorOr<void> send_redirect(StringView redirect, HTTP::HttpRequest const&);
     ErrorOr<void> send_error_response(unsigned code, HTTP::HttpRequest const&, Vector<String> const& headers = {});
     void die();
@@ -42,7 +49,9 @@ private:
     bool verify_credentials(Vector<HTTP::Header> const&);
 
     NonnullOwnPtr<Core::BufferedTCPSocket> m_socket;
-    StringBuilder m_remaining_request;
+    RefPtr<Core::Timer> m_idle_timer;
+    ByteBuffer m_remaining_request;
+    bool m_keep_alive { false };
 };
 
 }
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibCore/File.h>
+#include <WebServer/FileCache.h>
+
+namespace WebServer {
+
+FileCache& FileCache::the()
+{
+    static FileCache s_the;
+    return s_the;
+}
+
+ErrorOr<NonnullRefPtr<FileCache::CachedFile const>> FileCache::get(ByteString const& path, struct stat const& st)
+{
+    VERIFY(static_cast<size_t>(st.st_size) <= max_cached_file_size);
+
+    {
+        Threading::MutexLocker locker(m_mutex);
+        if (auto entry = m_entries.get(path); entry.has_value()) {
+            auto& cached_file = *entry.value();
+            if (cached_file.matches(st)) {
+                m_least_recently_used.remove(cached_file);
+                m_least_recently_used.append(cached_file);
+                return cached_file;
+            }
+
+            dbgln_if(WEBSERVER_DEBUG, "FileCache: '{}' changed on disk, reloading", path);
+            m_least_recently_used.remove(cached_file);
+            m_size -= cached_file.m_contents.size();
+            m_entries.remove(path);
+        }
+    }
+
+    // Read the file without holding the lock, so other threads can keep serving cached files meanwhile.
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    auto cached_file = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) CachedFile(path, move(contents), st)));
+
+    // The file may have been modified between the stat() and the read, in which case we serve
+    // what we read but don't remember it.
+    if (cached_file->m_contents.size() != static_cast<size_t>(st.st_size))
+        return cached_file;
+
+    Threading::MutexLocker locker(m_mutex);
+    if (m_entries.contains(path))
+        return cached_file;
+
+    evict_until_size_fits(cached_file->m_contents.size());
+    TRY(m_entries.try_set(path, cached_file));
+    m_least_recently_used.append(*cached_file);
+    m_size += cached_file->m_contents.size();
+    dbgln_if(WEBSERVER_DEBUG, "FileCache: Cached '{}' ({} bytes, {} bytes in total)", path, cached_file->m_contents.size(), m_size);
+    return cached_file;
+}
+
+void FileCache::evict_until_size_fits(size_t additional_size)
+{
+    while (!m_least_recently_used.is_empty() && m_size + additional_size > capacity) {
+        auto& victim = *m_least_recently_used.first();
+        m_least_recently_used.remove(victim);
+        m_size -= victim.m_contents.size();
+
+        // Removing the entry from the map may drop the last reference to it.
+        auto victim_path = victim.m_path;
+        m_entries.remove(victim_path);
+    }
+}
+
+}
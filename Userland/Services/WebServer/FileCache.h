@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibThreading/Mutex.h>
+#include <sys/stat.h>
+
+namespace WebServer {
+
+// Keeps the contents of small, frequently requested files in memory, so they can be
+// served without touching the file system beyond a single stat(). Entries are validated
+// against the file's inode, size and modification time, and evicted least recently used
+// first once the cache grows beyond its capacity. The cache is shared by all worker threads.
+class FileCache {
+public:
+    static constexpr size_t max_cached_file_size = 64 * KiB;
+    static constexpr size_t capacity = 16 * MiB;
+
+    class CachedFile : public AtomicRefCounted<CachedFile> {
+        friend class FileCache;
+
+    public:
+        ReadonlyBytes contents() const { return m_contents; }
+
+    private:
+        CachedFile(ByteString path, ByteBuffer contents, struct stat const& st)
+            : m_path(move(path))
+            , m_contents(move(contents))
+            , m_inode(st.st_ino)
+            , m_size(st.st_size)
+            , m_modification_time(st.st_mtime)
+        {
+        }
+
+        bool matches(struct stat const& st) const
+        {
+            return m_inode == st.st_ino && m_size == st.st_size && m_modification_time == st.st_mtime;
+        }
+
+        ByteString m_path;
+        ByteBuffer m_contents;
+        ino_t m_inode { 0 };
+        off_t m_size { 0 };
+        time_t m_modification_time { 0 };
+        IntrusiveListNode<CachedFile> m_list_node;
+    };
+
+    static FileCache& the();
+
+    // The caller has already stat()ed the file; st must describe a regular file no larger than max_cached_file_size.
+    ErrorOr<NonnullRefPtr<CachedFile const>> get(ByteString const& path, struct stat const& st);
+
+private:
+    FileCache() = default;
+
+    void evict_until_size_fits(size_t additional_size);
+
+    Threading::Mutex m_mutex;
+    HashMap<ByteString, NonnullRefPtr<CachedFile>> m_entries;
+    IntrusiveList<&CachedFile::m_list_node> m_least_recently_used;
+    size_t m_size { 0 };
+};
+
+}
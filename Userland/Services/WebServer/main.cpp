@@ -15,11 +15,36 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibMain/Main.h>
+#include <LibThreading/Thread.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
 #include <stdio.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
+static void accept_client(Core::TCPServer& server)
+{
+    auto maybe_client_socket = server.accept();
+    if (maybe_client_socket.is_error()) {
+        // All workers are woken up for a new connection, but only one of them gets to accept it.
+        if (maybe_client_socket.error().code() == EAGAIN || maybe_client_socket.error().code() == EWOULDBLOCK)
+            return;
+        warnln("Failed to accept the client: {}", maybe_client_socket.error());
+        return;
+    }
+
+    auto maybe_buffered_socket = Core::BufferedTCPSocket::create(maybe_client_socket.release_value());
+    if (maybe_buffered_socket.is_error()) {
+        warnln("Could not obtain a buffered socket for the client: {}", maybe_buffered_socket.error());
+        return;
+    }
+
+    // FIXME: Propagate errors
+    MUST(maybe_buffered_socket.value()->set_blocking(true));
+    auto client = WebServer::Client::construct(maybe_buffered_socket.release_value(), &server);
+    client->start();
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     static auto const default_listen_address = "0.0.0.0"_string;
@@ -31,12 +56,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     ByteString username;
     ByteString password;
     ByteString document_root_path = default_document_root_path.to_byte_string();
+    size_t thread_count = Core::System::hardware_concurrency();
 
     Core::ArgsParser args_parser;
     args_parser.add_option(listen_address, "IP address to listen on", "listen-address", 'l', "listen_address");
     args_parser.add_option(port, "Port to listen on", "port", 'p', "port");
     args_parser.add_option(username, "HTTP basic authentication username", "user", 'U', "username");
     args_parser.add_option(password, "HTTP basic authentication password", "pass", 'P', "password");
+    args_parser.add_option(thread_count, "Number of threads serving clients (default: number of CPUs)", "threads", 't', "count");
     args_parser.add_positional_argument(document_root_path, "Path to serve the contents of", "path", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -51,6 +78,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
+    if (thread_count == 0) {
+        warnln("At least one thread is required to serve clients.");
+        return 1;
+    }
+
     if (username.is_empty() != password.is_empty()) {
         warnln("Both username and password are required for HTTP basic authentication.");
         return 1;
@@ -62,7 +94,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
-    TRY(Core::System::pledge("stdio accept rpath inet unix"));
+    TRY(Core::System::pledge("stdio accept rpath inet unix thread"));
 
     Optional<HTTP::HttpRequest::BasicAuthenticationCredentials> credentials;
     if (!username.is_empty() && !password.is_empty())
@@ -76,25 +108,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     auto server = TRY(Core::TCPServer::try_create());
 
     server->on_ready_to_accept = [&] {
-        auto maybe_client_socket = server->accept();
-        if (maybe_client_socket.is_error()) {
-            warnln("Failed to accept the client: {}", maybe_client_socket.error());
-            return;
-        }
-
-        auto maybe_buffered_socket = Core::BufferedTCPSocket::create(maybe_client_socket.release_value());
-        if (maybe_buffered_socket.is_error()) {
-            warnln("Could not obtain a buffered socket for the client: {}", maybe_buffered_socket.error());
-            return;
-        }
-
-        // FIXME: Propagate errors
-        MUST(maybe_buffered_socket.value()->set_blocking(true));
-        auto client = WebServer::Client::construct(maybe_buffered_socket.release_value(), server);
-        client->start();
+        accept_client(*server);
     };
 
-    TRY(server->listen(ipv4_address.value(), port));
+    // Bursts of new connections would overflow the default backlog, and have their SYNs dropped until clients retry.
+    TRY(server->listen(ipv4_address.value(), port, Core::TCPServer::AllowAddressReuse::No, SOMAXCONN));
 
     out("Listening on ");
     out("\033]8;;http://{}:{}\033\\", ipv4_address.value(), server->local_port());
@@ -106,6 +124,28 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     TRY(Core::System::unveil(real_document_root_path, "r"sv));
     TRY(Core::System::unveil(nullptr, nullptr));
 
+    // The main thread serves clients as well, every further thread runs its own event loop
+    // that accepts connections from the same listening socket.
+    Vector<NonnullRefPtr<Threading::Thread>> worker_threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread = TRY(Threading::Thread::try_create([&server = *server]() -> intptr_t {
+            Core::EventLoop worker_loop;
+            auto sibling_or_error = server.try_create_sibling();
+            if (sibling_or_error.is_error()) {
+                warnln("Failed to start serving clients on a worker thread: {}", sibling_or_error.error());
+                return 1;
+            }
+            auto sibling = sibling_or_error.release_value();
+            sibling->on_ready_to_accept = [&] {
+                accept_client(*sibling);
+            };
+            return worker_loop.exec();
+        },
+            "WebServer worker"sv));
+        thread->start();
+        TRY(worker_threads.try_append(move(thread)));
+    }
+
     TRY(Core::System::pledge("stdio accept rpath"));
     return loop.exec();
 }
@@ -11,11 +11,13 @@
 #include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <AK/Function.h>
+#include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
 #include <AK/LexicalPath.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <Ladybird/Types.h>
@@ -23,6 +25,7 @@
 #include <LibCore/ConfigFile.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/Directory.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <LibCore/Promise.h>
@@ -65,7 +68,7 @@ static StringView s_current_test_path;
 
 class HeadlessWebContentView final : public WebView::ViewImplementation {
 public:
-    static ErrorOr<NonnullOwnPtr<HeadlessWebContentView>> create(Core::AnonymousBuffer theme, Gfx::IntSize const& window_size, String const& command_line, StringView web_driver_ipc_path, Ladybird::IsLayoutTestMode is_layout_test_mode = Ladybird::IsLayoutTestMode::No, Vector<ByteString> const& certificates = {}, StringView resources_folder = {})
+    static ErrorOr<NonnullOwnPtr<HeadlessWebContentView>> create(Core::AnonymousBuffer theme, Gfx::IntSize const& window_size, String const& command_line, StringView web_driver_ipc_path, Ladybird::IsLayoutTestMode is_layout_test_mode = Ladybird::IsLayoutTestMode::No, Vector<ByteString> const& certificates = {}, StringView resources_folder = {}, Ladybird::EnableTiledCPUPainting enable_tiled_cpu_painting = Ladybird::EnableTiledCPUPainting::No)
     {
         RefPtr<Protocol::RequestClient> request_client;
 
@@ -90,10 +93,12 @@ public:
         view->m_client_state.client = TRY(WebView::WebContentClient::try_create(*view));
         (void)command_line;
         (void)is_layout_test_mode;
+        (void)enable_tiled_cpu_painting;
 #else
         Ladybird::WebContentOptions web_content_options {
             .command_line = command_line,
             .executable_path = MUST(String::from_byte_string(MUST(Core::System::current_executable_path()))),
+            .enable_tiled_cpu_painting = enable_tiled_cpu_painting,
             .is_layout_test_mode = is_layout_test_mode,
         };
 
@@ -628,6 +633,218 @@ static ErrorOr<int> run_tests(HeadlessWebContentView& view, StringView test_root
     return 1;
 }
 
+static ErrorOr<Vector<ByteString>> collect_benchmark_pages(StringView benchmark_path)
+{
+    Vector<ByteString> pages;
+
+    if (FileSystem::is_directory(benchmark_path)) {
+        TRY(Core::Directory::for_each_entry(benchmark_path, Core::DirIterator::SkipDots, [&](Core::DirectoryEntry const& entry, Core::Directory const&) -> ErrorOr<IterationDecision> {
+            if (entry.type == Core::DirectoryEntry::Type::Directory)
+                return IterationDecision::Continue;
+            if (!entry.name.ends_with(".html"sv) && !entry.name.ends_with(".svg"sv))
+                return IterationDecision::Continue;
+            pages.append(TRY(FileSystem::real_path(LexicalPath::join(benchmark_path, entry.name).string())));
+            return IterationDecision::Continue;
+        }));
+        quick_sort(pages);
+        return pages;
+    }
+
+    // Otherwise, the path is a file listing one page per line. Relative paths are relative to the list itself.
+    auto list_path = LexicalPath(TRY(FileSystem::real_path(benchmark_path)));
+    auto file = TRY(Core::File::open(benchmark_path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+
+    for (auto line : StringView { contents }.lines()) {
+        line = line.trim_whitespace();
+        if (line.is_empty() || line.starts_with('#'))
+            continue;
+        auto path = LexicalPath::absolute_path(list_path.dirname(), line);
+        pages.append(TRY(FileSystem::real_path(path)));
+    }
+    return pages;
+}
+
+static ErrorOr<JsonObject> request_performance_metrics(HeadlessWebContentView& view)
+{
+    auto promise = view.request_internal_page_info(WebView::PageInfoType::PerformanceMetrics);
+    auto metrics = TRY(promise->await());
+
+    auto json = TRY(JsonValue::from_string(metrics));
+    if (!json.is_object())
+        return Error::from_string_literal("Performance metrics are not a JSON object");
+    return json.as_object();
+}
+
+// WebContent reports totals since it started, so the metrics of one page load are the difference between the totals
+// after and before loading it.
+static JsonObject performance_metrics_for_load(JsonObject const& before, JsonObject const& after)
+{
+    JsonObject phases;
+    auto const& phases_before = before.get_object("phases"sv).value();
+    after.get_object("phases"sv)->for_each_member([&](auto const& name, JsonValue const& phase_after) {
+        auto const& phase_before = phases_before.get_object(name).value();
+
+        JsonObject phase;
+        phase.set("time_ms"sv, phase_after.as_object().get_double_with_precision_loss("time_ms"sv).value() - phase_before.get_double_with_precision_loss("time_ms"sv).value());
+        phase.set("count"sv, phase_after.as_object().get_u64("count"sv).value() - phase_before.get_u64("count"sv).value());
+        phases.set(name, move(phase));
+    });
+
+    auto const& display_lists_before = before.get_object("display_lists"sv).value();
+    auto const& display_lists_after = after.get_object("display_lists"sv).value();
+
+    JsonObject display_lists;
+    display_lists.set("count"sv, display_lists_after.get_u64("count"sv).value() - display_lists_before.get_u64("count"sv).value());
+    display_lists.set("total_command_count"sv, display_lists_after.get_u64("total_command_count"sv).value() - display_lists_before.get_u64("total_command_count"sv).value());
+    display_lists.set("last_command_count"sv, display_lists_after.get_u64("last_command_count"sv).value());
+
+    JsonObject metrics;
+    metrics.set("phases"sv, move(phases));
+    metrics.set("display_lists"sv, move(display_lists));
+    if (auto peak_memory = after.get_u64("peak_memory_kib"sv); peak_memory.has_value())
+        metrics.set("peak_memory_kib"sv, *peak_memory);
+    return metrics;
+}
+
+static ErrorOr<JsonObject> run_benchmark_iteration(HeadlessWebContentView& view, URL::URL const& url, int timeout_in_milliseconds = DEFAULT_TIMEOUT_MS)
+{
+    // NOTE: The callbacks below hold on to the promises and the URL themselves, as the view may still call them after
+    //       this iteration has given up on a load.
+    auto await_load = [&](URL::URL const& url_to_load, NonnullRefPtr<Core::Promise<void>> promise, StringView timeout_message) -> ErrorOr<void> {
+        auto timeout_timer = Core::Timer::create_single_shot(timeout_in_milliseconds, [promise, timeout_message] {
+            promise->reject(Error::from_string_view(timeout_message));
+        });
+
+        view.load(url_to_load);
+        timeout_timer->start();
+
+        auto result = promise->await();
+        timeout_timer->stop();
+        view.on_load_finish = {};
+        return result;
+    };
+
+    // Start from a blank document, so that tearing down the previous page isn't measured.
+    auto blank_promise = Core::Promise<void>::construct();
+    view.on_load_finish = [blank_promise](auto const&) { blank_promise->resolve(); };
+    view.on_text_test_finish = {};
+    TRY(await_load(URL::URL("about:blank"sv), blank_promise, "Timed out waiting for about:blank to load"sv));
+
+    auto metrics_before = TRY(request_performance_metrics(view));
+
+    auto load_promise = Core::Promise<void>::construct();
+    view.on_load_finish = [&view, url, load_promise](auto const& loaded_url) {
+        // NOTE: We don't want subframe loads to end the measurement.
+        if (!url.equals(loaded_url, URL::ExcludeFragment::Yes))
+            return;
+
+        // NOTE: Taking a screenshot makes sure the loaded page has been laid out and painted at least once.
+        (void)view.take_screenshot();
+        load_promise->resolve();
+    };
+
+    auto load_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    TRY(await_load(url, load_promise, "Timed out waiting for the page to load"sv));
+
+    auto load_time = load_timer.elapsed_time();
+    auto metrics_after = TRY(request_performance_metrics(view));
+
+    auto metrics = performance_metrics_for_load(metrics_before, metrics_after);
+    metrics.set("load_time_ms"sv, static_cast<double>(load_time.to_nanoseconds()) / 1'000'000.0);
+    return metrics;
+}
+
+static JsonObject summarize_benchmark_timings(Vector<double> timings)
+{
+    quick_sort(timings);
+
+    double total = 0;
+    for (auto timing : timings)
+        total += timing;
+
+    JsonObject summary;
+    summary.set("min"sv, timings.first());
+    summary.set("median"sv, timings[timings.size() / 2]);
+    summary.set("mean"sv, total / static_cast<double>(timings.size()));
+    summary.set("max"sv, timings.last());
+    return summary;
+}
+
+static ErrorOr<int> run_benchmark(HeadlessWebContentView& view, StringView benchmark_path, size_t iteration_count)
+{
+    if (iteration_count == 0) {
+        warnln("The number of benchmark iterations must be at least 1");
+        return 1;
+    }
+
+    view.clear_content_filters();
+
+    auto pages = TRY(collect_benchmark_pages(benchmark_path));
+    if (pages.is_empty()) {
+        warnln("No pages to benchmark found in {}", benchmark_path);
+        return 1;
+    }
+
+    JsonArray results;
+    bool had_failures = false;
+
+    for (auto const& page : pages) {
+        warnln("Benchmarking {} ({} iterations)", page, iteration_count);
+        s_current_test_path = page;
+
+        auto url = URL::create_with_file_scheme(page);
+
+        JsonArray iterations;
+        Vector<double> load_timings;
+        OrderedHashMap<ByteString, Vector<double>> phase_timings;
+        Optional<ByteString> error;
+
+        for (size_t i = 0; i < iteration_count; ++i) {
+            auto metrics_or_error = run_benchmark_iteration(view, url);
+            if (metrics_or_error.is_error()) {
+                error = ByteString::formatted("{}", metrics_or_error.error());
+                break;
+            }
+
+            auto metrics = metrics_or_error.release_value();
+            load_timings.append(metrics.get_double_with_precision_loss("load_time_ms"sv).value());
+            metrics.get_object("phases"sv)->for_each_member([&](auto const& name, JsonValue const& phase) {
+                phase_timings.ensure(name).append(phase.as_object().get_double_with_precision_loss("time_ms"sv).value());
+            });
+            iterations.must_append(move(metrics));
+        }
+
+        JsonObject result;
+        result.set("path"sv, page);
+        result.set("iterations"sv, move(iterations));
+
+        if (error.has_value()) {
+            warnln("Failed to benchmark {}: {}", page, *error);
+            result.set("error"sv, error.release_value());
+            had_failures = true;
+        } else {
+            JsonObject phase_summaries;
+            for (auto& it : phase_timings)
+                phase_summaries.set(it.key, summarize_benchmark_timings(move(it.value)));
+
+            JsonObject summary;
+            summary.set("load_time_ms"sv, summarize_benchmark_timings(move(load_timings)));
+            summary.set("phase_time_ms"sv, move(phase_summaries));
+            result.set("summary"sv, move(summary));
+        }
+
+        results.must_append(move(result));
+    }
+
+    JsonObject report;
+    report.set("iteration_count"sv, iteration_count);
+    report.set("pages"sv, move(results));
+    outln("{}", report.to_byte_string());
+
+    return had_failures ? 1 : 0;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     Core::EventLoop event_loop;
@@ -641,8 +858,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool dump_text = false;
     bool dump_gc_graph = false;
     bool is_layout_test_mode = false;
+    bool use_tiled_cpu_painting = false;
     StringView test_root_path;
     ByteString test_glob;
+    StringView benchmark_path;
+    size_t benchmark_iteration_count = 5;
     Vector<ByteString> certificates;
 
 #if !defined(AK_OS_SERENITY)
@@ -659,9 +879,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
     args_parser.add_option(dump_failed_ref_tests, "Dump screenshots of failing ref tests", "dump-failed-ref-tests", 'D');
     args_parser.add_option(dump_gc_graph, "Dump GC graph", "dump-gc-graph", 'G');
+    args_parser.add_option(benchmark_path, "Load the pages in a directory, or listed in a file, and report timings as JSON", "benchmark", 0, "path");
+    args_parser.add_option(benchmark_iteration_count, "Number of times each page is loaded by --benchmark (default: 5)", "benchmark-iterations", 0, "n");
     args_parser.add_option(resources_folder, "Path of the base resources folder (defaults to /res)", "resources", 'r', "resources-root-path");
     args_parser.add_option(web_driver_ipc_path, "Path to the WebDriver IPC socket", "webdriver-ipc-path", 0, "path");
     args_parser.add_option(is_layout_test_mode, "Enable layout test mode", "layout-test-mode");
+    args_parser.add_option(use_tiled_cpu_painting, "Rasterize tiles of the page concurrently", "tiled-cpu-painting");
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_positional_argument(raw_url, "URL to open", "url", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
@@ -685,13 +908,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     StringBuilder command_line_builder;
     command_line_builder.join(' ', arguments.strings);
-    auto view = TRY(HeadlessWebContentView::create(move(theme), window_size, MUST(command_line_builder.to_string()), web_driver_ipc_path, is_layout_test_mode ? Ladybird::IsLayoutTestMode::Yes : Ladybird::IsLayoutTestMode::No, certificates, resources_folder));
+    auto view = TRY(HeadlessWebContentView::create(move(theme), window_size, MUST(command_line_builder.to_string()), web_driver_ipc_path, is_layout_test_mode ? Ladybird::IsLayoutTestMode::Yes : Ladybird::IsLayoutTestMode::No, certificates, resources_folder, use_tiled_cpu_painting ? Ladybird::EnableTiledCPUPainting::Yes : Ladybird::EnableTiledCPUPainting::No));
 
     if (!test_root_path.is_empty()) {
         test_glob = ByteString::formatted("*{}*", test_glob);
         return run_tests(*view, test_root_path, test_glob, dump_failed_ref_tests, dump_gc_graph);
     }
 
+    if (!benchmark_path.is_empty())
+        return run_benchmark(*view, benchmark_path, benchmark_iteration_count);
+
     auto url = WebView::sanitize_url(raw_url);
     if (!url.has_value()) {
         warnln("Invalid URL: \"{}\"", raw_url);
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/NumberFormat.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <LibThreading/Thread.h>
+
+struct Options {
+    ByteString host;
+    u16 port { 0 };
+    ByteString request;
+    size_t pipeline_depth { 1 };
+    bool keep_alive { true };
+};
+
+struct ConnectionStatistics {
+    size_t completed_requests { 0 };
+    size_t unsuccessful_responses { 0 };
+    size_t opened_connections { 0 };
+    u64 received_bytes { 0 };
+    Vector<i64> latencies_in_microseconds;
+    Optional<ByteString> error;
+};
+
+struct Response {
+    unsigned status_code { 0 };
+    size_t size { 0 };
+    bool connection_close { false };
+};
+
+// Returns the first response in the buffer, or nothing if more data is needed.
+static ErrorOr<Optional<Response>> parse_response(ReadonlyBytes buffer)
+{
+    StringView data { buffer };
+    auto end_of_headers = data.find("\r\n\r\n"sv);
+    if (!end_of_headers.has_value())
+        return OptionalNone {};
+
+    auto lines = data.substring_view(0, *end_of_headers).split_view("\r\n"sv);
+    if (lines.is_empty())
+        return Error::from_string_literal("Received an empty response");
+
+    auto status_line = lines[0].split_view(' ');
+    if (status_line.size() < 2 || !status_line[0].starts_with("HTTP/"sv))
+        return Error::from_string_literal("Received a malformed status line");
+
+    auto status_code = status_line[1].to_number<unsigned>();
+    if (!status_code.has_value())
+        return Error::from_string_literal("Received a malformed status code");
+
+    Response response { .status_code = *status_code };
+    size_t content_length = 0;
+    for (auto line : lines.span().slice(1)) {
+        auto colon = line.find(':');
+        if (!colon.has_value())
+            continue;
+        auto name = line.substring_view(0, *colon).trim_whitespace();
+        auto value = line.substring_view(*colon + 1).trim_whitespace();
+        if (name.equals_ignoring_ascii_case("Content-Length"sv)) {
+            auto maybe_content_length = value.to_number<size_t>();
+            if (!maybe_content_length.has_value())
+                return Error::from_string_literal("Received a malformed Content-Length");
+            content_length = *maybe_content_length;
+        } else if (name.equals_ignoring_ascii_case("Connection"sv)) {
+            response.connection_close = value.equals_ignoring_ascii_case("close"sv);
+        }
+    }
+
+    // Responses to conditional requests come without a body.
+    if (response.status_code == 304)
+        content_length = 0;
+
+    response.size = *end_of_headers + 4 + content_length;
+    if (buffer.size() < response.size)
+        return OptionalNone {};
+    return response;
+}
+
+static ErrorOr<Response> receive_response(Core::TCPSocket& socket, ByteBuffer& buffer)
+{
+    auto chunk = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+    for (;;) {
+        if (auto response = TRY(parse_response(buffer)); response.has_value()) {
+            auto unparsed_data = TRY(ByteBuffer::copy(buffer.bytes().slice(response->size)));
+            buffer = move(unparsed_data);
+            return *response;
+        }
+
+        auto bytes = TRY(socket.read_some(chunk));
+        if (bytes.is_empty())
+            return Error::from_string_literal("Connection was closed by the server");
+        TRY(buffer.try_append(bytes));
+    }
+}
+
+static ErrorOr<void> run_connection(Options const& options, size_t request_count, ConnectionStatistics& statistics)
+{
+    TRY(statistics.latencies_in_microseconds.try_ensure_capacity(request_count));
+
+    // With pipelining, a whole batch of requests is sent with a single write.
+    StringBuilder batch_builder;
+    for (size_t i = 0; i < options.pipeline_depth; ++i)
+        TRY(batch_builder.try_append(options.request));
+    auto batch = batch_builder.string_view();
+
+    OwnPtr<Core::TCPSocket> socket;
+    ByteBuffer buffer;
+    while (statistics.completed_requests < request_count) {
+        if (!socket) {
+            socket = TRY(Core::TCPSocket::connect(options.host, options.port));
+            TRY(socket->set_blocking(true));
+            buffer.clear();
+            ++statistics.opened_connections;
+        }
+
+        auto batch_size = min(options.pipeline_depth, request_count - statistics.completed_requests);
+        auto start_time = MonotonicTime::now();
+        TRY(socket->write_until_depleted(batch.substring_view(0, batch_size * options.request.length()).bytes()));
+
+        bool connection_closed = false;
+        for (size_t i = 0; i < batch_size; ++i) {
+            auto response = TRY(receive_response(*socket, buffer));
+            statistics.latencies_in_microseconds.unchecked_append((MonotonicTime::now() - start_time).to_microseconds());
+            statistics.received_bytes += response.size;
+            ++statistics.completed_requests;
+            if (response.status_code >= 400)
+                ++statistics.unsuccessful_responses;
+            if (response.connection_close) {
+                connection_closed = true;
+                if (i + 1 < batch_size)
+                    return Error::from_string_literal("Server closed the connection while requests were still pending");
+            }
+        }
+
+        if (connection_closed || !options.keep_alive)
+            socket = nullptr;
+    }
+
+    return {};
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    TRY(Core::System::pledge("stdio inet unix thread"));
+
+    ByteString host;
+    int port = 8000;
+    StringView path = "/"sv;
+    size_t connection_count = 8;
+    size_t request_count = 10000;
+    size_t pipeline_depth = 1;
+    bool no_keep_alive = false;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Measure the throughput and latency of an HTTP server.");
+    args_parser.add_option(port, "Port to connect to (default: 8000)", "port", 'p', "port");
+    args_parser.add_option(connection_count, "Number of concurrent connections (default: 8)", "connections", 'c', "count");
+    args_parser.add_option(request_count, "Total number of requests (default: 10000)", "requests", 'n', "count");
+    args_parser.add_option(pipeline_depth, "Number of requests sent at once on each connection (default: 1)", "pipeline", 'P', "depth");
+    args_parser.add_option(no_keep_alive, "Open a new connection for every request", "no-keep-alive", 'k');
+    args_parser.add_positional_argument(host, "Host to connect to", "host");
+    args_parser.add_positional_argument(path, "Path to request (default: /)", "path", Core::ArgsParser::Required::No);
+    args_parser.parse(arguments);
+
+    if ((u16)port != port) {
+        warnln("Invalid port number: {}", port);
+        return 1;
+    }
+
+    if (connection_count == 0 || request_count == 0 || pipeline_depth == 0) {
+        warnln("The number of connections, requests and the pipeline depth must not be zero.");
+        return 1;
+    }
+
+    if (no_keep_alive && pipeline_depth > 1) {
+        warnln("Pipelining requires persistent connections.");
+        return 1;
+    }
+
+    connection_count = min(connection_count, request_count);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Options options {
+        .host = host,
+        .port = static_cast<u16>(port),
+        .request = ByteString::formatted("GET {} HTTP/1.1\r\nHost: {}\r\nConnection: {}\r\n\r\n", path, host, no_keep_alive ? "close"sv : "keep-alive"sv),
+        .pipeline_depth = pipeline_depth,
+        .keep_alive = !no_keep_alive,
+    };
+
+    Vector<ConnectionStatistics> statistics;
+    TRY(statistics.try_resize(connection_count));
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    for (size_t i = 0; i < connection_count; ++i) {
+        auto requests_for_connection = request_count / connection_count + (i < request_count % connection_count ? 1 : 0);
+        auto thread = TRY(Threading::Thread::try_create([&options, requests_for_connection, connection_statistics = &statistics[i]]() -> intptr_t {
+            if (auto result = run_connection(options, requests_for_connection, *connection_statistics); result.is_error())
+                connection_statistics->error = ByteString::formatted("{}", result.error());
+            return 0;
+        },
+            "http-bench"sv));
+        thread->start();
+        TRY(threads.try_append(move(thread)));
+    }
+
+    for (auto& thread : threads)
+        (void)thread->join();
+    auto elapsed_seconds = static_cast<double>(timer.elapsed_time().to_microseconds()) / 1'000'000;
+
+    size_t completed_requests = 0;
+    size_t unsuccessful_responses = 0;
+    size_t opened_connections = 0;
+    u64 received_bytes = 0;
+    Vector<i64> latencies;
+    for (auto& connection_statistics : statistics) {
+        completed_requests += connection_statistics.completed_requests;
+        unsuccessful_responses += connection_statistics.unsuccessful_responses;
+        opened_connections += connection_statistics.opened_connections;
+        received_bytes += connection_statistics.received_bytes;
+        TRY(latencies.try_extend(connection_statistics.latencies_in_microseconds));
+        if (connection_statistics.error.has_value())
+            warnln("Connection failed: {}", *connection_statistics.error);
+    }
+
+    outln("Completed {} of {} requests in {:.3}s over {} connections", completed_requests, request_count, elapsed_seconds, opened_connections);
+    if (completed_requests == 0)
+        return 1;
+
+    outln("Requests per second:    {:.1}", completed_requests / elapsed_seconds);
+    outln("Transfer rate:          {}/s", human_readable_size(static_cast<u64>(received_bytes / elapsed_seconds)));
+    outln("Unsuccessful responses: {}", unsuccessful_responses);
+
+    quick_sort(latencies);
+    auto percentile = [&](size_t percent) {
+        return static_cast<double>(latencies[min(latencies.size() - 1, latencies.size() * percent / 100)]) / 1000;
+    };
+    outln("Latency (ms):           min {:.3}, p50 {:.3}, p90 {:.3}, p99 {:.3}, max {:.3}",
+        static_cast<double>(latencies.first()) / 1000, percentile(50), percentile(90), percentile(99), static_cast<double>(latencies.last()) / 1000);
+
+    return completed_requests == request_count ? 0 : 1;
+}
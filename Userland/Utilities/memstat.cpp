@@ -45,6 +45,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     u64 physical_uncommitted = json.get_u64("physical_uncommitted"sv).value_or(0);
     u32 kmalloc_call_count = json.get_u32("kmalloc_call_count"sv).value_or(0);
     u32 kfree_call_count = json.get_u32("kfree_call_count"sv).value_or(0);
+    u64 physical_cached = json.get_u64("physical_cached"sv).value_or(0);
+    u64 physical_cache_hits = json.get_u64("physical_cache_hits"sv).value_or(0);
+    u64 physical_cache_misses = json.get_u64("physical_cache_misses"sv).value_or(0);
+    u64 physical_zeroed = json.get_u64("physical_zeroed"sv).value_or(0);
+    u64 physical_zeroed_hits = json.get_u64("physical_zeroed_hits"sv).value_or(0);
+    u64 physical_zeroed_misses = json.get_u64("physical_zeroed_misses"sv).value_or(0);
 
     u64 kmalloc_bytes_total = kmalloc_allocated + kmalloc_available;
     u64 physical_pages_total = physical_allocated + physical_available;
@@ -66,5 +72,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     outln("Kmalloc call count: {}", kmalloc_call_count);
     outln("Kfree call count: {}", kfree_call_count);
     outln("Kmalloc/Kfree delta: {}", TRY(String::formatted("{:+}", kmalloc_call_count - kfree_call_count)));
+
+    auto hit_rate = [](u64 hits, u64 misses) {
+        if (hits + misses == 0)
+            return 0.0;
+        return 100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses);
+    };
+    outln("Physical page cache: {} pages, {} hits, {} misses ({:.1}% hit rate)", physical_cached, physical_cache_hits, physical_cache_misses, hit_rate(physical_cache_hits, physical_cache_misses));
+    outln("Zeroed page pool: {} pages, {} hits, {} misses ({:.1}% hit rate)", physical_zeroed, physical_zeroed_hits, physical_zeroed_misses, hit_rate(physical_zeroed_hits, physical_zeroed_misses));
     return 0;
 }